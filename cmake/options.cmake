@@ -15,6 +15,7 @@ option(USE_SCRIPTPCH    "Use precompiled headers when compiling scripts"
 option(USE_COREPCH      "Use precompiled headers when compiling servers"              1)
 option(WITH_WARNINGS    "Show all warnings during compile"                            0)
 option(WITH_COREDEBUG   "Include additional debug-code in core"                       0)
+option(WITH_BENCHMARKS  "Build the .bench commands, never enable on a live realm"     0)
 
 option(WITHOUT_GIT      "Disable the GIT testing routines"                            0)
 
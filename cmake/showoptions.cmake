@@ -80,6 +80,13 @@ if( WIN32 )
   endif()
 endif( WIN32 )
 
+if( WITH_BENCHMARKS )
+  message("* Build .bench commands  : Yes")
+  add_definitions(-DWITH_BENCHMARKS)
+else()
+  message("* Build .bench commands  : No  (default)")
+endif()
+
 if( ENABLE_PERFORMANCE_LOGGING )
   message("* Use Performance Log    : Yes")
   add_definitions(-DPERFORMANCELOG_ENABLED)
@@ -0,0 +1 @@
+ALTER TABLE `mail` ADD KEY `idx_expire_time` (`expire_time`);
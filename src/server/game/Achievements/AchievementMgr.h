@@ -252,6 +252,8 @@ class AchievementMgr
         void RemoveTimedAchievement(AchievementCriteriaTimedTypes type, uint32 entry);   // used for quest and scripted timed achievements
 
         uint32 GetAchievementPoints() const { return _achievementPoints; }
+        // The completed achievements stay, the progress must have been saved
+        void UnloadCriteriaProgress() { m_criteriaProgress.clear(); }
     private:
         void SendAchievementEarned(AchievementEntry const* achievement) const;
         void SendCriteriaUpdate(AchievementCriteriaEntry const* entry, CriteriaProgress const* progress, uint32 timeElapsed, bool timedCompleted) const;
@@ -18,6 +18,7 @@
  */
 
 #include "Anticheat.h"
+#include "AnticheatSink.h"
 #include "Language.h"
 #include "ObjectMgr.h"
 #include "Player.h"
@@ -64,6 +65,50 @@ static AntiCheatCheckEntry AntiCheatCheckList[] =
     { false, CHECK_MAX,                     NULL                           }
 };
 
+static_assert(sizeof(AntiCheatCheckList) / sizeof(AntiCheatCheckList[0]) <= ANTICHEAT_MAX_CHECKS, "ANTICHEAT_MAX_CHECKS is too small");
+
+// AntiCheatCheckList by check type
+static AntiCheatCheckEntry* AntiCheatCheckTable[CHECK_MAX];
+
+static struct AntiCheatCheckTableInit
+{
+    AntiCheatCheckTableInit()
+    {
+        for (uint16 i = 0; AntiCheatCheckList[i].checkType != CHECK_MAX; ++i)
+            AntiCheatCheckTable[AntiCheatCheckList[i].checkType] = &AntiCheatCheckList[i];
+    }
+} antiCheatCheckTableInit;
+
+static bool CanFly(Unit* mover)
+{
+    return mover->HasAuraType(SPELL_AURA_FLY)
+        || mover->HasAuraType(SPELL_AURA_MOD_INCREASE_VEHICLE_FLIGHT_SPEED)
+        || mover->HasAuraType(SPELL_AURA_MOD_INCREASE_FLIGHT_SPEED)
+        || mover->HasAuraType(SPELL_AURA_MOD_INCREASE_MOUNTED_FLIGHT_SPEED)
+        || mover->HasAuraType(SPELL_AURA_MOD_MOUNTED_FLIGHT_SPEED_ALWAYS)
+        || mover->HasAuraType(SPELL_AURA_MOD_VEHICLE_SPEED_ALWAYS)
+        || mover->HasAuraType(SPELL_AURA_MOD_FLIGHT_SPEED_NOT_STACK);
+}
+
+static bool CanWaterWalk(Unit* mover)
+{
+    return mover->HasAuraType(SPELL_AURA_WATER_WALK)
+        || mover->HasAura(60068)
+        || mover->HasAura(61081)
+        || mover->HasAuraType(SPELL_AURA_GHOST);
+}
+
+static UnitMoveType GetMoveType(MovementInfo const& movementInfo)
+{
+    if (movementInfo.HasMovementFlag(MOVEMENTFLAG_FLYING))
+        return MOVE_FLIGHT;
+    if (movementInfo.HasMovementFlag(MOVEMENTFLAG_SWIMMING))
+        return MOVE_SWIM;
+    if (movementInfo.HasMovementFlag(MOVEMENTFLAG_WALKING))
+        return MOVE_WALK;
+    return MOVE_RUN;
+}
+
 AntiCheat::AntiCheat(Player* player)
 {
     m_player              = player;
@@ -79,16 +124,21 @@ AntiCheat::AntiCheat(Player* player)
     m_currentDeltaZ       = 0.0f;
     m_lastfalltime        = 0;
     m_lastfallz           = 0.0f;
-    m_immuneTime          = getMSTime();
-    m_lastClientTime      = getMSTime();
+    m_now                 = getMSTime();
+    m_immuneTime          = m_now;
+    m_lastClientTime      = m_now;
     m_lastLiveState       = ALIVE;
-    m_counters.clear();
-    m_oldCheckTime.clear();
-    m_lastalarmtime.clear();
-    m_lastactiontime.clear();
+    m_currentSample       = NULL;
+    m_actionTaken         = false;
+    m_heightCacheSize     = 0;
+    m_heightCacheNext     = 0;
     SetImmune(ANTICHEAT_DEFAULT_DELTA);
 }
 
+AntiCheat::~AntiCheat()
+{
+}
+
 void AntiCheat::DeleteOldLogs()
 {
     uint32 const days = sWorld->getIntConfig(CONFIG_ANTICHEAT_DELETE_LOGS);
@@ -107,10 +157,116 @@ bool AntiCheat::CheckNull()
 
 AntiCheatCheckEntry* AntiCheat::_FindCheck(AntiCheatCheck checktype)
 {
-    for(uint16 i = 0; AntiCheatCheckList[i].checkType != CHECK_MAX; ++i)
-        if (AntiCheatCheckList[i].checkType == checktype)
-            return &AntiCheatCheckList[i];
-    return NULL;
+    return checktype < CHECK_MAX ? AntiCheatCheckTable[checktype] : NULL;
+}
+
+AntiCheat::CheckState& AntiCheat::_GetState(AntiCheatCheck checktype)
+{
+    return m_checkStates[_FindCheck(checktype) - AntiCheatCheckList];
+}
+
+void AntiCheat::AddMovementSample(MovementInfo const& movementInfo, Opcodes opcode)
+{
+    if (!sWorld->getBoolConfig(CONFIG_ANTICHEAT_ENABLED) ||
+        GetPlayer()->GetSession()->GetSecurity() > int32(sWorld->getIntConfig(CONFIG_ANTICHEAT_GMLEVEL)))
+        return;
+
+    // a player flooding movement packets has them checked right away instead of queuing them without end
+    if (m_samples.size() >= ANTICHEAT_MAX_SAMPLES)
+        ProcessMovementSamples();
+
+    Unit* mover = GetPlayer()->m_mover;
+
+    m_samples.resize(m_samples.size() + 1);
+    AntiCheatMovementSample& sample = m_samples.back();
+    sample.Info = movementInfo;
+    sample.MoverPos.Relocate(mover);
+    sample.PlayerPos.Relocate(GetPlayer());
+    sample.MapId = GetPlayer()->GetMapId();
+    sample.InstanceId = GetPlayer()->GetInstanceId();
+    sample.ServerTime = getMSTime();
+    sample.Opcode = opcode;
+
+    // a dismount, an aura removed or a transport left later in the same update must not change how the packet is judged
+    sample.Speed = mover->GetSpeed(GetMoveType(movementInfo));
+    sample.Flags = 0;
+    if (IsMovementExempt(mover))
+        sample.Flags |= ANTICHEAT_SAMPLE_EXEMPT;
+    if (CanFly(mover))
+        sample.Flags |= ANTICHEAT_SAMPLE_CAN_FLY;
+    if (mover->HasAuraType(SPELL_AURA_FEATHER_FALL))
+        sample.Flags |= ANTICHEAT_SAMPLE_FEATHER_FALL;
+    if (CanWaterWalk(mover))
+        sample.Flags |= ANTICHEAT_SAMPLE_WATER_WALK;
+}
+
+uint32 AntiCheat::ProcessMovementSamples()
+{
+    if (m_samples.empty())
+        return 0;
+
+    // ground heights may have changed since the last batch
+    m_heightCacheSize = 0;
+    m_heightCacheNext = 0;
+
+    for (std::vector<AntiCheatMovementSample>::iterator itr = m_samples.begin(); itr != m_samples.end(); ++itr)
+    {
+        // the positions of a sample taken before a far teleport are from the other map or instance
+        if (itr->MapId != GetPlayer()->GetMapId() || itr->InstanceId != GetPlayer()->GetInstanceId())
+            continue;
+
+        m_currentSample       = &*itr;
+        m_currentmovementInfo = &itr->Info;
+        m_currentOpcode       = itr->Opcode;
+        m_now                 = itr->ServerTime;
+        _DoAntiCheatCheck(CHECK_MOVEMENT);
+    }
+
+    uint32 const count = m_samples.size();
+    m_currentSample       = NULL;
+    m_currentmovementInfo = NULL;
+    m_samples.clear();
+    return count;
+}
+
+Position const* AntiCheat::GetMoverPos()
+{
+    if (m_currentSample)
+        return &m_currentSample->MoverPos;
+
+    return GetMover();
+}
+
+Position const* AntiCheat::GetPlayerPos()
+{
+    if (m_currentSample)
+        return &m_currentSample->PlayerPos;
+
+    return GetPlayer();
+}
+
+// samples of a player standing or moving slowly ask the heights of the same points again and again
+float AntiCheat::GetHeight(float x, float y, float z)
+{
+    if (m_currentSample)
+        for (uint32 i = 0; i < m_heightCacheSize; ++i)
+            if (m_heightCache[i].x == x && m_heightCache[i].y == y && m_heightCache[i].z == z)
+                return m_heightCache[i].height;
+
+    float const height = GetMover()->GetMap()->GetHeight(x, y, z);
+    if (m_currentSample)
+    {
+        HeightCacheEntry& entry = m_heightCache[m_heightCacheNext];
+        entry.x = x;
+        entry.y = y;
+        entry.z = z;
+        entry.height = height;
+        m_heightCacheNext = (m_heightCacheNext + 1) % ANTICHEAT_HEIGHT_CACHE_SIZE;
+        if (m_heightCacheSize < ANTICHEAT_HEIGHT_CACHE_SIZE)
+            ++m_heightCacheSize;
+    }
+
+    return height;
 }
 
 AntiCheatConfig const* AntiCheat::_FindConfig(AntiCheatCheck checkType)
@@ -118,8 +274,13 @@ AntiCheatConfig const* AntiCheat::_FindConfig(AntiCheatCheck checkType)
     return sObjectMgr->GetAntiCheatConfig(checkType);
 }
 
-bool AntiCheat::_DoAntiCheatCheck(AntiCheatCheck checktype)
+// mainChecked: called for a subcheck right after its main check found the checks needed
+bool AntiCheat::_DoAntiCheatCheck(AntiCheatCheck checktype, bool mainChecked)
 {
+    // movement samples carry the time of their packet
+    if (!m_currentSample && !mainChecked)
+        m_now = getMSTime();
+
     m_currentConfig = _FindConfig(checktype);
 
     if (!m_currentConfig)
@@ -129,47 +290,53 @@ bool AntiCheat::_DoAntiCheatCheck(AntiCheatCheck checktype)
     if (!_check)
         return true;
 
-    if (_check->active && CheckTimer(checktype) && CheckNeeded(checktype))
-    {
-        if (m_counters.find(checktype) == m_counters.end())
-            m_counters[checktype] = 0;
+    if (checktype < 100)
+        m_actionTaken = false;
 
+    CheckState& state = m_checkStates[_check - AntiCheatCheckList];
+    bool const timerPassed = _check->active && CheckTimer(checktype);
+    bool needed = _check->active && _CheckNeeded(checktype, mainChecked);
+
+    if (timerPassed && needed)
+    {
         if (!(this->*(_check->Handler))() && !isImmune())
         {
             if (m_currentConfig->disableOperation)
                 return false;
 
-            ++m_counters[checktype];
-
-            if (m_lastalarmtime.find(checktype) == m_lastalarmtime.end())
-                m_lastalarmtime[checktype] = 0;
-
-            m_lastalarmtime[checktype] = getMSTime();
+            ++state.counter;
+            state.lastAlarmTime = m_now;
 
-            if (m_counters[checktype] >= m_currentConfig->alarmsCount)
+            if (state.counter >= m_currentConfig->alarmsCount)
             {
                 DoAntiCheatAction(checktype);
-                m_counters[checktype] = 0;
+                state.counter = 0;
             }
         }
         else
         {
-            if (getMSTimeDiff(m_lastalarmtime[checktype], getMSTime()) > 30
-                || (m_currentConfig->checkParam[0] > 0 && m_currentConfig->alarmsCount > 1 && getMSTimeDiff(m_lastalarmtime[checktype],getMSTime()) > m_currentConfig->checkParam[0]))
+            if (getMSTimeDiff(state.lastAlarmTime, m_now) > 30
+                || (m_currentConfig->checkParam[0] > 0 && m_currentConfig->alarmsCount > 1 && getMSTimeDiff(state.lastAlarmTime, m_now) > m_currentConfig->checkParam[0]))
             {
-                m_counters[checktype] = 0;
+                state.counter = 0;
             }
         }
-        m_oldCheckTime[checktype] = getMSTime();
+        state.oldCheckTime = m_now;
+        state.timed = true;
+
+        // the main check may have changed the mover, so its conditions are asked again before the subchecks,
+        // which then only ask their own ones
+        if (checktype < 100)
+            needed = CheckNeeded(checktype);
     }
 
-    if (checktype < 100 && _check->active && CheckNeeded(checktype))
+    if (checktype < 100 && needed)
         for (uint16 i = 1; i < 99; ++i )
         {
             uint32 const subcheck = checktype * 100 + i;
-            if (AntiCheatConfig const* config = _FindConfig(AntiCheatCheck(subcheck)))
+            if (_FindConfig(AntiCheatCheck(subcheck)))
             {
-                if (!_DoAntiCheatCheck(AntiCheatCheck(subcheck)))
+                if (!_DoAntiCheatCheck(AntiCheatCheck(subcheck), !m_actionTaken))
                     return false;
             }
             else
@@ -185,15 +352,14 @@ bool AntiCheat::CheckTimer(AntiCheatCheck checkType)
     if (!config->checkPeriod)
         return true;
 
-    uint32 const currentTime = getMSTime();
-
-    if (m_oldCheckTime.find(checkType) == m_oldCheckTime.end())
-        m_oldCheckTime[checkType] = currentTime;
-
-    if (currentTime - m_oldCheckTime[checkType] >= config->checkPeriod)
-        return true;
+    CheckState& state = _GetState(checkType);
+    if (!state.timed)
+    {
+        state.oldCheckTime = m_now;
+        state.timed = true;
+    }
 
-    return false;
+    return m_now - state.oldCheckTime >= config->checkPeriod;
 }
 
 void AntiCheat::DoAntiCheatAction(AntiCheatCheck checkType)
@@ -202,38 +368,47 @@ void AntiCheat::DoAntiCheatAction(AntiCheatCheck checkType)
     if (!config)
         return;
 
-    if (m_lastactiontime.find(checkType) == m_lastactiontime.end())
-        m_lastactiontime.insert(std::make_pair(checkType, 0));
+    // the actions may change the mover, its checks are asked again before the subchecks
+    m_actionTaken = true;
 
-    if (getMSTime() - m_lastactiontime[checkType] >= 30000)
+    CheckState& state = _GetState(checkType);
+    if (m_now - state.lastActionTime >= 30000)
     {
-        m_lastactiontime[checkType] = getMSTime();
-
-        std::string name = GetPlayer()->GetName();
+        state.lastActionTime = m_now;
+
+        // logs, announcements, bans and the log row are left to the world thread
+        AntiCheatViolation violation;
+        violation.AccountId = GetPlayer()->GetSession()->GetAccountId();
+        violation.Guid = GetPlayer()->GetGUIDLow();
+        violation.CheckType = checkType;
+        violation.Time = uint32(time(NULL));
+        violation.IntValue = m_currentCheaterData.intvalue;
+        violation.FloatValue = m_currentCheaterData.floatvalue;
+        violation.Actions = ANTICHEAT_VIOLATION_STORE;
+        violation.BanDuration = 0;
+        strncpy(violation.Name, GetPlayer()->GetName().c_str(), ANTICHEAT_VIOLATION_NAME_SIZE - 1);
+        violation.Name[ANTICHEAT_VIOLATION_NAME_SIZE - 1] = '\0';
 
         for (int i=0; i < ANTICHEAT_ACTION_PARAMETERS; ++i )
         {
             switch (config->actionType[i])
             {
                 case ANTICHEAT_ACTION_LOG:
-                    sLog->outInfo(LOG_FILTER_ANTICHEAT, "[Anticheat] Account: %u Player: %s - Possible %s (ival: %u, fval: %f)",
-                        GetPlayer()->GetSession()->GetAccountId(), name.c_str(), config->description.c_str(), m_currentCheaterData.intvalue, m_currentCheaterData.floatvalue);
+                    violation.Actions |= ANTICHEAT_VIOLATION_LOG;
                     break;
                 case ANTICHEAT_ACTION_ANNOUNCE_GM:
-                    sWorld->SendGMText(config->messageNum, name.c_str(), config->description.c_str());
+                    violation.Actions |= ANTICHEAT_VIOLATION_ANNOUNCE_GM;
                     break;
                 case ANTICHEAT_ACTION_ANNOUNCE_ALL:
-                    sWorld->SendWorldText(config->messageNum, name.c_str(), config->description.c_str());
+                    violation.Actions |= ANTICHEAT_VIOLATION_ANNOUNCE_ALL;
                     break;
                 case ANTICHEAT_ACTION_KICK:
                     GetPlayer()->GetSession()->KickPlayer();
                     break;
                 case ANTICHEAT_ACTION_BAN:
-                {
-                    sWorld->BanAccount(BAN_CHARACTER, name.c_str(), TimeToTimestampStr(config->actionParam[i]),
-                        std::string("Possible " + config->description).c_str(), "Devastation Anticheat");
+                    violation.Actions |= ANTICHEAT_VIOLATION_BAN_CHARACTER;
+                    violation.BanDuration = config->actionParam[i];
                     break;
-                }
                 case ANTICHEAT_ACTION_SHEEP:
                 {
                     if (Aura* aura = GetPlayer()->AddAura(RAND(28272, 118, 28271, 28272, 61025, 61721, 71319), GetPlayer()))
@@ -260,59 +435,62 @@ void AntiCheat::DoAntiCheatAction(AntiCheatCheck checkType)
             }
         }
 
-        PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_INS_ANTICHEAT_LOG);
-
-        stmt->setUInt32(0, GetPlayer()->GetGUIDLow());
-        stmt->setUInt32(1, checkType);
-        stmt->setUInt32(2, time(NULL));
-        stmt->setUInt32(3, m_currentCheaterData.intvalue);
-        stmt->setFloat (4, m_currentCheaterData.floatvalue);
-
-        CharacterDatabase.Execute(stmt);
+        sAntiCheatSink->AddViolation(violation);
     }
 }
 
 bool AntiCheat::CheckNeeded(AntiCheatCheck checktype)
 {
-    if (!sWorld->getBoolConfig(CONFIG_ANTICHEAT_ENABLED) || !GetPlayer()->IsInWorld() || GetPlayer()->IsBeingTeleported()
-        || GetPlayer()->GetSession()->GetSecurity() > int32(sWorld->getIntConfig(CONFIG_ANTICHEAT_GMLEVEL)) ||
-            GetMover()->HasAuraType(SPELL_AURA_MOD_CONFUSE))
-                return false;
-
-    AntiCheatCheck checkMainType = (checktype >= 100) ? AntiCheatCheck(checktype / 100) : checktype;
+    return _CheckNeeded(checktype, false);
+}
 
-    switch (checkMainType)
+// mainChecked: the conditions of the main check were just found true, only those of the subcheck are left
+bool AntiCheat::_CheckNeeded(AntiCheatCheck checktype, bool mainChecked)
+{
+    if (!mainChecked)
     {
-        case CHECK_NULL:
-            return false;
-            break;
-        case CHECK_MOVEMENT:
-        {
-            if (GetPlayer()->GetTransport()/* || GetPlayer()->HasUnitMovementFlag(MOVEMENTFLAG_ONTRANSPORT)*/ || GetPlayer()->HasFlag(UNIT_FIELD_FLAGS, UNIT_FLAG_CONFUSED) ||
-                GetPlayer()->HasFlag(PLAYER_FLAGS, PLAYER_FLAGS_GHOST) || GetMover()->GetMotionMaster()->GetCurrentMovementGeneratorType() == FLIGHT_MOTION_TYPE ||
-                GetPlayer()->isInFlight())	//delete GetPlayer()->HasFlag(PLAYER_FLAGS, PLAYER_FLAGS_GHOST) after sur no kick without cheat
+        if (!sWorld->getBoolConfig(CONFIG_ANTICHEAT_ENABLED) || !GetPlayer()->IsInWorld()
+            || GetPlayer()->GetSession()->GetSecurity() > int32(sWorld->getIntConfig(CONFIG_ANTICHEAT_GMLEVEL)))
                 return false;
-            break;
-        }
-        case CHECK_SPELL:
-            break;
-        case CHECK_QUEST:
+
+        // movement packets are judged by the state of their arrival
+        if (m_currentSample ? m_currentSample->HasFlag(ANTICHEAT_SAMPLE_EXEMPT) :
+            (GetPlayer()->IsBeingTeleported() || GetMover()->HasAuraType(SPELL_AURA_MOD_CONFUSE)))
             return false;
-            break;
-        case CHECK_TRANSPORT:
+
+        AntiCheatCheck checkMainType = (checktype >= 100) ? AntiCheatCheck(checktype / 100) : checktype;
+
+        switch (checkMainType)
         {
-            if (!isActiveMover())
+            case CHECK_NULL:
+                return false;
+                break;
+            case CHECK_MOVEMENT:
+            {
+                if (!m_currentSample && IsMovementExempt(GetMover()))
+                    return false;
+                break;
+            }
+            case CHECK_SPELL:
+                break;
+            case CHECK_QUEST:
+                return false;
+                break;
+            case CHECK_TRANSPORT:
+            {
+                if (!isActiveMover())
+                    return false;
+                break;
+            }
+            case CHECK_WARDEN:
+                return false;
+                break;
+            case CHECK_DAMAGE:
+            case CHECK_ITEM:
+                break;
+            default:
                 return false;
-            break;
         }
-        case CHECK_WARDEN:
-            return false;
-            break;
-        case CHECK_DAMAGE:
-        case CHECK_ITEM:
-            break;
-        default:
-            return false;
     }
 
     if (checktype < 100 )
@@ -342,7 +520,7 @@ bool AntiCheat::CheckNeeded(AntiCheatCheck checktype)
         case CHECK_MOVEMENT_AIRJUMP:
             if (isCanFly() ||
                 !isActiveMover() ||
-                GetMover()->HasAuraType(SPELL_AURA_FEATHER_FALL) ||
+                (m_currentSample ? m_currentSample->HasFlag(ANTICHEAT_SAMPLE_FEATHER_FALL) : GetMover()->HasAuraType(SPELL_AURA_FEATHER_FALL)) ||
                 GetMover()->GetBaseMap()->IsUnderWater(m_currentmovementInfo->pos.m_positionX, m_currentmovementInfo->pos.m_positionY, m_currentmovementInfo->pos.m_positionZ-5.0f))
                 return false;
             break;
@@ -365,6 +543,16 @@ bool AntiCheat::CheckNeeded(AntiCheatCheck checktype)
     return true;
 }
 
+// the movement of the mover is not its own
+bool AntiCheat::IsMovementExempt(Unit* mover)
+{
+    //delete GetPlayer()->HasFlag(PLAYER_FLAGS, PLAYER_FLAGS_GHOST) after sur no kick without cheat
+    return GetPlayer()->IsBeingTeleported() || mover->HasAuraType(SPELL_AURA_MOD_CONFUSE) ||
+        GetPlayer()->GetTransport()/* || GetPlayer()->HasUnitMovementFlag(MOVEMENTFLAG_ONTRANSPORT)*/ || GetPlayer()->HasFlag(UNIT_FIELD_FLAGS, UNIT_FLAG_CONFUSED) ||
+        GetPlayer()->HasFlag(PLAYER_FLAGS, PLAYER_FLAGS_GHOST) || mover->GetMotionMaster()->GetCurrentMovementGeneratorType() == FLIGHT_MOTION_TYPE ||
+        GetPlayer()->isInFlight();
+}
+
 bool AntiCheat::CheckMovement()
 {
     if (GetPlayer()->m_mover != GetPlayer() && isActiveMover())
@@ -387,9 +575,10 @@ bool AntiCheat::CheckMovement()
 
     SetLastLiveState(GetPlayer()->getDeathState());
 
-    float delta_x   = GetMover()->GetPositionX() - m_currentmovementInfo->pos.m_positionX;
-    float delta_y   = GetMover()->GetPositionY() - m_currentmovementInfo->pos.m_positionY;
-    m_currentDeltaZ = GetMover()->GetPositionZ() - m_currentmovementInfo->pos.m_positionX;
+    Position const* moverPos = GetMoverPos();
+    float delta_x   = moverPos->GetPositionX() - m_currentmovementInfo->pos.m_positionX;
+    float delta_y   = moverPos->GetPositionY() - m_currentmovementInfo->pos.m_positionY;
+    m_currentDeltaZ = moverPos->GetPositionZ() - m_currentmovementInfo->pos.m_positionX;
     m_currentDelta = sqrt(delta_x * delta_x + delta_y * delta_y);
     m_MovedLen += m_currentDelta;
     return true;
@@ -397,8 +586,7 @@ bool AntiCheat::CheckMovement()
 
 bool AntiCheat::CheckSpeed()
 {
-    float speedRate   = 1.0f;
-    int   serverDelta = getMSTimeDiff(m_oldCheckTime[CHECK_MOVEMENT_SPEED],getMSTime());
+    int   serverDelta = getMSTimeDiff(_GetState(CHECK_MOVEMENT_SPEED).oldCheckTime, m_now);
 
     if (m_currentTimeSkipped > 0 && (float)m_currentTimeSkipped < serverDelta)
     {
@@ -417,30 +605,9 @@ bool AntiCheat::CheckSpeed()
     float moveSpeed = m_MovedLen / delta_t;
 
     m_MovedLen = 0.0f;
-    std::string mode;
 
-    if (m_currentmovementInfo->HasMovementFlag(MOVEMENTFLAG_FLYING))
-    {
-        speedRate = GetMover()->GetSpeed(MOVE_FLIGHT);
-        mode = "MOVE_FLIGHT";
-    }
-    else if (m_currentmovementInfo->HasMovementFlag(MOVEMENTFLAG_SWIMMING))
-    {
-        speedRate = GetMover()->GetSpeed(MOVE_SWIM);
-        mode = "MOVE_SWIM";
-    }
-    else if (m_currentmovementInfo->HasMovementFlag(MOVEMENTFLAG_WALKING))
-    {
-        speedRate = GetMover()->GetSpeed(MOVE_WALK);
-        mode = "MOVE_WALK";
-    }
-    else
-    {
-        speedRate = GetMover()->GetSpeed(MOVE_RUN);
-        mode = "MOVE_RUN";
-    }
-
-    if ( moveSpeed / speedRate <= m_currentConfig->checkFloatParam[0] )
+    float const speed = m_currentSample ? m_currentSample->Speed : GetMover()->GetSpeed(GetMoveType(*m_currentmovementInfo));
+    if (moveSpeed <= speed * m_currentConfig->checkFloatParam[0])
         return true;
 
     m_currentCheaterData = CheaterData(moveSpeed);
@@ -449,10 +616,7 @@ bool AntiCheat::CheckSpeed()
 
 bool AntiCheat::CheckWaterWalking()
 {
-    if  (GetMover()->HasAuraType(SPELL_AURA_WATER_WALK)
-        || GetMover()->HasAura(60068)
-        || GetMover()->HasAura(61081)
-        || GetMover()->HasAuraType(SPELL_AURA_GHOST))
+    if (m_currentSample ? m_currentSample->HasFlag(ANTICHEAT_SAMPLE_WATER_WALK) : CanWaterWalk(GetMover()))
         return true;
 
     m_currentCheaterData = CheaterData();
@@ -476,7 +640,7 @@ bool AntiCheat::CheckMountain()
     if ( m_currentDeltaZ > 0 )
         return true;
 
-    int32 const serverDelta = getMSTimeDiff(m_oldCheckTime[CHECK_MOVEMENT_MOUNTAIN], getMSTime());
+    int32 const serverDelta = getMSTimeDiff(_GetState(CHECK_MOVEMENT_MOUNTAIN).oldCheckTime, m_now);
     float const zSpeed = - m_currentDeltaZ / serverDelta;
     float const tg_z = (m_currentDelta > 0.0f) ? (-m_currentDeltaZ / m_currentDelta) : -99999;
 
@@ -511,20 +675,21 @@ bool AntiCheat::CheckFly()
     if (!m_currentmovementInfo->HasMovementFlag(MovementFlags(MOVEMENTFLAG_CAN_FLY | MOVEMENTFLAG_FLYING | MOVEMENTFLAG_ROOT)))
         return true;
 
-    if (GetMover()->HasAuraType(SPELL_AURA_FEATHER_FALL))
+    if (m_currentSample ? m_currentSample->HasFlag(ANTICHEAT_SAMPLE_FEATHER_FALL) : GetMover()->HasAuraType(SPELL_AURA_FEATHER_FALL))
         return true;
 
-    float ground_z = GetMover()->GetMap()->GetHeight(GetPlayer()->GetPositionX(),GetPlayer()->GetPositionY(),MAX_HEIGHT);
-    float floor_z  = GetMover()->GetMap()->GetHeight(GetPlayer()->GetPositionX(),GetPlayer()->GetPositionY(),GetPlayer()->GetPositionZ());
+    Position const* playerPos = GetPlayerPos();
+    float ground_z = GetHeight(playerPos->GetPositionX(), playerPos->GetPositionY(), MAX_HEIGHT);
+    float floor_z  = GetHeight(playerPos->GetPositionX(), playerPos->GetPositionY(), playerPos->GetPositionZ());
     float map_z    = ((floor_z <= (INVALID_HEIGHT+5.0f)) ? ground_z : floor_z);
 
-    if (map_z + m_currentConfig->checkFloatParam[0] > GetPlayer()->GetPositionZ() && map_z > (INVALID_HEIGHT + m_currentConfig->checkFloatParam[0] + 5.0f))
+    if (map_z + m_currentConfig->checkFloatParam[0] > playerPos->GetPositionZ() && map_z > (INVALID_HEIGHT + m_currentConfig->checkFloatParam[0] + 5.0f))
         return true;
 
     if (m_currentDeltaZ > 0.0f)
         return true;
 
-    m_currentCheaterData = CheaterData(uint32(map_z + m_currentConfig->checkFloatParam[0]), GetPlayer()->GetPositionZ());
+    m_currentCheaterData = CheaterData(uint32(map_z + m_currentConfig->checkFloatParam[0]), playerPos->GetPositionZ());
     return false;
 }
 
@@ -537,13 +702,14 @@ bool AntiCheat::CheckAirJump()
         return true;
     */
 
-    float ground_z = GetMover()->GetMap()->GetHeight(GetMover()->GetPositionX(),GetMover()->GetPositionY(),MAX_HEIGHT);
-    float floor_z = GetMover()->GetMap()->GetHeight(GetMover()->GetPositionX(),GetMover()->GetPositionY(),GetMover()->GetPositionZ());
+    Position const* moverPos = GetMoverPos();
+    float ground_z = GetHeight(moverPos->GetPositionX(), moverPos->GetPositionY(), MAX_HEIGHT);
+    float floor_z = GetHeight(moverPos->GetPositionX(), moverPos->GetPositionY(), moverPos->GetPositionZ());
     float map_z = ((floor_z <= (INVALID_HEIGHT+5.0f)) ? ground_z : floor_z);
 
-    if  (!((map_z + m_currentConfig->checkFloatParam[0] + m_currentConfig->checkFloatParam[1] < GetPlayer()->GetPositionZ() &&
+    if  (!((map_z + m_currentConfig->checkFloatParam[0] + m_currentConfig->checkFloatParam[1] < GetPlayerPos()->GetPositionZ() &&
             (m_currentmovementInfo->GetMovementFlags() & (MOVEMENTFLAG_FALLING_FAR | MOVEMENTFLAG_PENDING_STOP)) == 0) ||
-                (map_z + m_currentConfig->checkFloatParam[0] < GetMover()->GetPositionZ() && m_currentOpcode == MSG_MOVE_JUMP)))
+                (map_z + m_currentConfig->checkFloatParam[0] < moverPos->GetPositionZ() && m_currentOpcode == MSG_MOVE_JUMP)))
                     return true;
 
     if (m_currentDeltaZ > 0.0f)
@@ -563,7 +729,7 @@ bool AntiCheat::CheckTp2Plane()
 
     float plane_z = 0.0f;
 
-    plane_z = GetMover()->GetMap()->GetHeight(m_currentmovementInfo->pos.m_positionX, m_currentmovementInfo->pos.m_positionY, MAX_HEIGHT) - m_currentmovementInfo->pos.m_positionZ;
+    plane_z = GetHeight(m_currentmovementInfo->pos.m_positionX, m_currentmovementInfo->pos.m_positionY, MAX_HEIGHT) - m_currentmovementInfo->pos.m_positionZ;
     plane_z = (plane_z < -500.0f) ? 0 : plane_z;
     if(plane_z < m_currentConfig->checkFloatParam[1] && plane_z > -m_currentConfig->checkFloatParam[1])
         return true;
@@ -574,21 +740,22 @@ bool AntiCheat::CheckTp2Plane()
 
 bool AntiCheat::CheckZAxis()
 {
-    if (m_currentDeltaZ > 0.0f && fabs(GetPlayer()->GetPositionZ()) < MAX_HEIGHT)
+    Position const* playerPos = GetPlayerPos();
+    if (m_currentDeltaZ > 0.0f && fabs(playerPos->GetPositionZ()) < MAX_HEIGHT)
         return true;
 
-    float delta_x   = GetPlayer()->GetPositionX() - m_currentmovementInfo->pos.m_positionX;
-    float delta_y   = GetPlayer()->GetPositionY() - m_currentmovementInfo->pos.m_positionY;
+    float delta_x   = playerPos->GetPositionX() - m_currentmovementInfo->pos.m_positionX;
+    float delta_y   = playerPos->GetPositionY() - m_currentmovementInfo->pos.m_positionY;
 
     if(fabs(delta_x) > m_currentConfig->checkFloatParam[0] || fabs(delta_y) > m_currentConfig->checkFloatParam[0])
         return true;
 
-    float delta_z   = GetPlayer()->GetPositionZ() - m_currentmovementInfo->pos.m_positionZ;
+    float delta_z   = playerPos->GetPositionZ() - m_currentmovementInfo->pos.m_positionZ;
 
-    if (fabs(delta_z) < m_currentConfig->checkFloatParam[1] && fabs(GetPlayer()->GetPositionZ()) < MAX_HEIGHT)
+    if (fabs(delta_z) < m_currentConfig->checkFloatParam[1] && fabs(playerPos->GetPositionZ()) < MAX_HEIGHT)
         return true;
 
-    m_currentCheaterData = CheaterData(fabs(delta_z), fabs(GetPlayer()->GetPositionZ()));
+    m_currentCheaterData = CheaterData(fabs(delta_z), fabs(playerPos->GetPositionZ()));
     return false;
 }
 
@@ -648,7 +815,6 @@ bool AntiCheat::CheckSpellFamily()
         return true;
 
     bool checkPassed = true;
-    std::string mode = "";
 
     SkillLineAbilityMapBounds const& skill_bounds = sSpellMgr->GetSkillLineAbilityMapBounds(m_currentspellID);
     for(SkillLineAbilityMap::const_iterator _spell_idx = skill_bounds.first; _spell_idx != skill_bounds.second; ++_spell_idx)
@@ -658,11 +824,9 @@ bool AntiCheat::CheckSpellFamily()
         if (!pSkill)
             continue;
 
+        // GM spell
         if (pSkill->id == 769)
-        {
             checkPassed = false;
-            mode = " it is GM spell!";
-        }
     }
 
     if (checkPassed)
@@ -720,16 +884,10 @@ bool AntiCheat::CheckMeleeDamage()
 
 bool AntiCheat::isCanFly()
 {
-    if (GetMover()->HasAuraType(SPELL_AURA_FLY)
-        || GetMover()->HasAuraType(SPELL_AURA_MOD_INCREASE_VEHICLE_FLIGHT_SPEED)
-        || GetMover()->HasAuraType(SPELL_AURA_MOD_INCREASE_FLIGHT_SPEED)
-        || GetMover()->HasAuraType(SPELL_AURA_MOD_INCREASE_MOUNTED_FLIGHT_SPEED)
-        || GetMover()->HasAuraType(SPELL_AURA_MOD_MOUNTED_FLIGHT_SPEED_ALWAYS)
-        || GetMover()->HasAuraType(SPELL_AURA_MOD_VEHICLE_SPEED_ALWAYS)
-        || GetMover()->HasAuraType(SPELL_AURA_MOD_FLIGHT_SPEED_NOT_STACK))
-        return true;
+    if (m_currentSample)
+        return m_currentSample->HasFlag(ANTICHEAT_SAMPLE_CAN_FLY);
 
-    return false;
+    return CanFly(GetMover());
 }
 
 bool AntiCheat::isInFall()
@@ -739,12 +897,12 @@ bool AntiCheat::isInFall()
 
 bool AntiCheat::isImmune()
 {
-    return m_immuneTime > getMSTime();
+    return m_immuneTime > m_now;
 }
 
 void AntiCheat::SetImmune(uint32 timeDelta)
 {
-    m_immuneTime = getMSTime() + timeDelta;
+    m_immuneTime = m_now + timeDelta;
 }
 
 void AntiCheat::SetLastLiveState(DeathState state)
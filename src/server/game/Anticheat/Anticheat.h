@@ -32,11 +32,40 @@ struct MovementInfo;
 struct AntiCheatCheckEntry;
 struct AntiCheatConfig;
 
+#define ANTICHEAT_MAX_CHECKS        32                  // entries of AntiCheatCheckList
+#define ANTICHEAT_MAX_SAMPLES       64                  // movement samples of a player checked at once at most
+#define ANTICHEAT_HEIGHT_CACHE_SIZE 4
+
+// State of the mover when a movement packet arrived, the checks of the packet must not see later changes
+enum AntiCheatSampleFlags
+{
+    ANTICHEAT_SAMPLE_EXEMPT         = 0x01,             // on a transport or a flight path, confused, a ghost or being teleported
+    ANTICHEAT_SAMPLE_CAN_FLY        = 0x02,
+    ANTICHEAT_SAMPLE_FEATHER_FALL   = 0x04,
+    ANTICHEAT_SAMPLE_WATER_WALK     = 0x08
+};
+
+// A movement packet waiting for the movement checks of its map update
+struct AntiCheatMovementSample
+{
+    MovementInfo Info;
+    Position MoverPos;                                  // where mover and player were when the packet arrived
+    Position PlayerPos;
+    uint32 MapId;
+    uint32 InstanceId;
+    uint32 ServerTime;
+    Opcodes Opcode;
+    float Speed;                                        // of the mover for the move type of the packet
+    uint8 Flags;                                        // AntiCheatSampleFlags
+
+    bool HasFlag(AntiCheatSampleFlags flag) const { return (Flags & flag) != 0; }
+};
+
 class AntiCheat
 {
     public:
         explicit AntiCheat(Player* player);
-        ~AntiCheat() {}
+        ~AntiCheat();
 
         static void DeleteOldLogs();
 
@@ -54,6 +83,11 @@ class AntiCheat
         // Checks
         bool CheckNeeded(AntiCheatCheck checktype);
 
+        // Movement packets are only queued by the handlers, the movement checks of the players of a map run
+        // together once per map update, see Map::Update
+        void AddMovementSample(MovementInfo const& movementInfo, Opcodes opcode);
+        uint32 ProcessMovementSamples();                // returns the number of samples checked
+
         // Check selectors
         bool DoAntiCheatCheck(AntiCheatCheck checkType, MovementInfo& movementInfo, Opcodes opcode = NULL_OPCODE)
         {
@@ -140,11 +174,35 @@ class AntiCheat
 		bool CheckWardenTimeOut();
 
     private:
+        // state of one check, by the index of the check in AntiCheatCheckList
+        struct CheckState
+        {
+            CheckState() : counter(0), oldCheckTime(0), lastAlarmTime(0), lastActionTime(0), timed(false) {}
+
+            uint32 counter;                             // counter of alarms
+            uint32 oldCheckTime;                        // last time when check processed
+            uint32 lastAlarmTime;                       // last time when alarm generated
+            uint32 lastActionTime;                      // last time when action is called
+            bool   timed;                               // oldCheckTime was set
+        };
+
+        struct HeightCacheEntry
+        {
+            float x, y, z;
+            float height;
+        };
+
         // Internal fuctions
         bool                       CheckTimer(AntiCheatCheck checkType);
-        bool                       _DoAntiCheatCheck(AntiCheatCheck checktype);
+        bool                       _DoAntiCheatCheck(AntiCheatCheck checktype, bool mainChecked = false);
+        bool                       _CheckNeeded(AntiCheatCheck checktype, bool mainChecked);
+        bool                       IsMovementExempt(Unit* mover);
         AntiCheatCheckEntry*       _FindCheck(AntiCheatCheck checktype);
         AntiCheatConfig const*     _FindConfig(AntiCheatCheck checktype);
+        CheckState&                _GetState(AntiCheatCheck checktype);
+        float                      GetHeight(float x, float y, float z);
+        Position const*            GetMoverPos();
+        Position const*            GetPlayerPos();
         Player*                    GetPlayer() { return m_player;};
         Unit*                      GetMover()  { return m_currentMover;};
 
@@ -159,12 +217,18 @@ class AntiCheat
         DeathState                              m_lastLiveState;
         float                                   m_lastfallz;
         Player*                                 m_player;
-        std::map<AntiCheatCheck, uint32>        m_counters;               // counter of alarms
-        std::map<AntiCheatCheck, uint32>        m_oldCheckTime;           // last time when check processed
-        std::map<AntiCheatCheck, uint32>        m_lastalarmtime;          // last time when alarm generated
-        std::map<AntiCheatCheck, uint32>        m_lastactiontime;         // last time when action is called
+        CheckState                              m_checkStates[ANTICHEAT_MAX_CHECKS];
+        std::vector<AntiCheatMovementSample>    m_samples;                // waiting for the map update
+
+        // Per batch cache of the ground heights
+        HeightCacheEntry           m_heightCache[ANTICHEAT_HEIGHT_CACHE_SIZE];
+        uint32                     m_heightCacheSize;
+        uint32                     m_heightCacheNext;
 
         // Variables for current check
+        uint32                     m_now;                   // server time of the packet checked
+        AntiCheatMovementSample const* m_currentSample;
+        bool                       m_actionTaken;           // the conditions of the main check may have changed
         Unit*                      m_currentMover;
         MovementInfo*              m_currentmovementInfo;
         uint32                     m_currentDamage;
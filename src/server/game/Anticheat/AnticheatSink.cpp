@@ -0,0 +1,238 @@
+/*
+ * Copyright (C) 2008-2013 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "AnticheatSink.h"
+#include "AccountMgr.h"
+#include "AnticheatConfig.h"
+#include "Log.h"
+#include "ObjectMgr.h"
+#include "WardenCheckMgr.h"
+#include "World.h"
+
+AntiCheatSink::AntiCheatSink() : _head(0), _size(0), _dropped(0), _processed(0), _maxBatch(0), _reportedDropped(0),
+    _lastPrune(time(NULL))
+{
+}
+
+void AntiCheatSink::AddViolation(AntiCheatViolation const& violation)
+{
+    TRINITY_GUARD(ACE_Thread_Mutex, _lock);
+
+    if (_size == ANTICHEAT_VIOLATION_QUEUE_SIZE)
+    {
+        ++_dropped;
+        return;
+    }
+
+    _queue[(_head + _size) % ANTICHEAT_VIOLATION_QUEUE_SIZE] = violation;
+    ++_size;
+}
+
+uint32 AntiCheatSink::GetQueuedCount()
+{
+    TRINITY_GUARD(ACE_Thread_Mutex, _lock);
+    return _size;
+}
+
+uint32 AntiCheatSink::GetDroppedCount()
+{
+    TRINITY_GUARD(ACE_Thread_Mutex, _lock);
+    return _dropped;
+}
+
+void AntiCheatSink::Update()
+{
+    uint32 count;
+    uint32 dropped;
+    {
+        TRINITY_GUARD(ACE_Thread_Mutex, _lock);
+
+        count = _size;
+        dropped = _dropped;
+        for (uint32 i = 0; i < count; ++i)
+            _batch[i] = _queue[(_head + i) % ANTICHEAT_VIOLATION_QUEUE_SIZE];
+
+        _head = (_head + count) % ANTICHEAT_VIOLATION_QUEUE_SIZE;
+        _size = 0;
+    }
+
+    if (dropped != _reportedDropped)
+    {
+        sLog->outWarn(LOG_FILTER_ANTICHEAT, "AntiCheatSink: %u violations were lost, the queue of %u violations was full.",
+            dropped - _reportedDropped, uint32(ANTICHEAT_VIOLATION_QUEUE_SIZE));
+        _reportedDropped = dropped;
+    }
+
+    uint32 const now = uint32(time(NULL));
+    uint32 const repeatWindow = sWorld->getIntConfig(CONFIG_ANTICHEAT_VIOLATION_REPEAT_WINDOW);
+
+    if (now - _lastPrune >= ANTICHEAT_SINK_PRUNE_INTERVAL)
+        Prune(now, repeatWindow);
+
+    if (!count)
+        return;
+
+    _processed += count;
+    if (count > _maxBatch)
+        _maxBatch = count;
+
+    uint32 const accountLimit = sWorld->getIntConfig(CONFIG_ANTICHEAT_VIOLATIONS_PER_ACCOUNT);
+    SQLTransaction trans;
+
+    for (uint32 i = 0; i < count; ++i)
+    {
+        AntiCheatViolation const& violation = _batch[i];
+        AntiCheatCheckCounters& counters = _counters[violation.CheckType];
+        ++counters.Reported;
+
+        // banned accounts are kicked, further bans until they are would only hit the database again
+        if (violation.Actions & ANTICHEAT_VIOLATION_BAN)
+        {
+            AccountState& account = _accounts[violation.AccountId];
+            if (!account.BanTime || violation.Time >= account.BanTime + repeatWindow)
+            {
+                account.BanTime = violation.Time;
+                ++counters.Bans;
+                Ban(violation);
+            }
+        }
+
+        if (!(violation.Actions & ANTICHEAT_VIOLATION_REPORT))
+            continue;
+
+        RepeatState& repeat = _repeats[MAKE_PAIR64(violation.CheckType, violation.AccountId)];
+        if ((repeat.LastTime && violation.Time < repeat.LastTime + repeatWindow) ||
+            (accountLimit && !TakeAccountSlot(_accounts[violation.AccountId], violation.Time, accountLimit)))
+        {
+            ++repeat.Repeats;
+            ++counters.Suppressed;
+            continue;
+        }
+
+        Report(violation, repeat.Repeats, counters, trans);
+        repeat.LastTime = violation.Time;
+        repeat.Repeats = 0;
+    }
+
+    if (trans)
+        CharacterDatabase.CommitTransaction(trans, 0, SQL_PRIORITY_LOW);
+}
+
+bool AntiCheatSink::TakeAccountSlot(AccountState& account, uint32 time, uint32 accountLimit)
+{
+    if (time >= account.WindowStart + MINUTE)
+    {
+        account.WindowStart = time;
+        account.Reported = 0;
+    }
+
+    if (account.Reported >= accountLimit)
+        return false;
+
+    ++account.Reported;
+    return true;
+}
+
+void AntiCheatSink::Report(AntiCheatViolation const& violation, uint32 repeats, AntiCheatCheckCounters& counters,
+    SQLTransaction& trans)
+{
+    // the config may have been reloaded since the check
+    AntiCheatConfig const* config = sObjectMgr->GetAntiCheatConfig(AntiCheatCheck(violation.CheckType));
+    if (!config)
+        return;
+
+    if (violation.Actions & ANTICHEAT_VIOLATION_LOG)
+    {
+        if (repeats)
+            sLog->outInfo(LOG_FILTER_ANTICHEAT, "[Anticheat] Account: %u Player: %s - Possible %s (ival: %u, fval: %f, %u repeats not reported)",
+                violation.AccountId, violation.Name, config->description.c_str(), violation.IntValue, violation.FloatValue, repeats);
+        else
+            sLog->outInfo(LOG_FILTER_ANTICHEAT, "[Anticheat] Account: %u Player: %s - Possible %s (ival: %u, fval: %f)",
+                violation.AccountId, violation.Name, config->description.c_str(), violation.IntValue, violation.FloatValue);
+    }
+
+    if (violation.Actions & ANTICHEAT_VIOLATION_ANNOUNCE_GM)
+        sWorld->SendGMText(config->messageNum, violation.Name, config->description.c_str());
+
+    if (violation.Actions & ANTICHEAT_VIOLATION_ANNOUNCE_ALL)
+        sWorld->SendWorldText(config->messageNum, violation.Name, config->description.c_str());
+
+    if (violation.Actions & ANTICHEAT_VIOLATION_STORE)
+    {
+        if (!trans)
+            trans = CharacterDatabase.BeginTransaction();
+
+        PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_INS_ANTICHEAT_LOG);
+        stmt->setUInt32(0, violation.Guid);
+        stmt->setUInt32(1, violation.CheckType);
+        stmt->setUInt32(2, violation.Time);
+        stmt->setUInt32(3, violation.IntValue);
+        stmt->setFloat (4, violation.FloatValue);
+        trans->Append(stmt);
+
+        ++counters.Stored;
+    }
+}
+
+void AntiCheatSink::Ban(AntiCheatViolation const& violation)
+{
+    if (violation.Actions & ANTICHEAT_VIOLATION_BAN_CHARACTER)
+    {
+        std::string reason = "Possible ";
+        if (AntiCheatConfig const* config = sObjectMgr->GetAntiCheatConfig(AntiCheatCheck(violation.CheckType)))
+            reason += config->description;
+
+        sWorld->BanAccount(BAN_CHARACTER, violation.Name, TimeToTimestampStr(violation.BanDuration), reason, "Devastation Anticheat");
+    }
+
+    if (violation.Actions & ANTICHEAT_VIOLATION_BAN_ACCOUNT)
+    {
+        std::stringstream duration;
+        duration << violation.BanDuration << "s";
+        std::string accountName;
+        AccountMgr::GetName(violation.AccountId, accountName);
+        std::stringstream banReason;
+        banReason << "Warden Anticheat Violation";
+        // only failed warden checks have one, not wrong signatures or timings
+        if (violation.CheckType == CHECK_WARDEN)
+            if (WardenCheck* check = sWardenCheckMgr->GetWardenDataById(violation.IntValue))
+                banReason << ": " << check->Comment << " (CheckId: " << check->CheckId << ")";
+
+        sWorld->BanAccount(BAN_ACCOUNT, accountName, duration.str(), banReason.str(), "Server");
+    }
+}
+
+void AntiCheatSink::Prune(uint32 now, uint32 repeatWindow)
+{
+    for (UNORDERED_MAP<uint64, RepeatState>::iterator itr = _repeats.begin(); itr != _repeats.end();)
+    {
+        if (now >= itr->second.LastTime + repeatWindow)
+            _repeats.erase(itr++);
+        else
+            ++itr;
+    }
+
+    for (UNORDERED_MAP<uint32, AccountState>::iterator itr = _accounts.begin(); itr != _accounts.end();)
+    {
+        if (now >= itr->second.WindowStart + MINUTE && now >= itr->second.BanTime + repeatWindow)
+            _accounts.erase(itr++);
+        else
+            ++itr;
+    }
+
+    _lastPrune = now;
+}
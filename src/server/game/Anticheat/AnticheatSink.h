@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) 2008-2013 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_ANTICHEATSINK_H
+#define TRINITY_ANTICHEATSINK_H
+
+#include "Common.h"
+#include "DatabaseEnv.h"
+#include <ace/Null_Mutex.h>
+#include <ace/Singleton.h>
+#include <ace/Thread_Mutex.h>
+
+#define ANTICHEAT_VIOLATION_QUEUE_SIZE  1024                // violations waiting for the world update at most
+#define ANTICHEAT_VIOLATION_NAME_SIZE   48
+#define ANTICHEAT_SINK_PRUNE_INTERVAL   MINUTE              // seconds between cleanups of the repeat and account states
+
+// What the world thread still has to do for a violation
+enum AntiCheatViolationAction
+{
+    ANTICHEAT_VIOLATION_LOG             = 0x01,
+    ANTICHEAT_VIOLATION_ANNOUNCE_GM     = 0x02,
+    ANTICHEAT_VIOLATION_ANNOUNCE_ALL    = 0x04,
+    ANTICHEAT_VIOLATION_STORE           = 0x08,             // row in the anticheat log table
+    ANTICHEAT_VIOLATION_BAN_CHARACTER   = 0x10,
+    ANTICHEAT_VIOLATION_BAN_ACCOUNT     = 0x20,
+
+    ANTICHEAT_VIOLATION_REPORT          = ANTICHEAT_VIOLATION_LOG | ANTICHEAT_VIOLATION_ANNOUNCE_GM |
+                                          ANTICHEAT_VIOLATION_ANNOUNCE_ALL | ANTICHEAT_VIOLATION_STORE,
+    ANTICHEAT_VIOLATION_BAN             = ANTICHEAT_VIOLATION_BAN_CHARACTER | ANTICHEAT_VIOLATION_BAN_ACCOUNT
+};
+
+// One violation of an anticheat or warden check, copied into the queue as is
+struct AntiCheatViolation
+{
+    uint32 AccountId;
+    uint32 Guid;                                            // low guid of the character, 0 before login
+    uint32 CheckType;                                       // AntiCheatCheck
+    uint32 Time;
+    uint32 IntValue;                                        // CHECK_WARDEN: id of the failed warden check
+    float FloatValue;
+    uint32 Actions;                                         // AntiCheatViolationAction flags
+    uint32 BanDuration;
+    char Name[ANTICHEAT_VIOLATION_NAME_SIZE];               // character name, empty before login
+};
+
+struct AntiCheatCheckCounters
+{
+    AntiCheatCheckCounters() : Reported(0), Suppressed(0), Stored(0), Bans(0) { }
+
+    uint32 Reported;
+    uint32 Suppressed;                                      // repeats and violations over the account limit
+    uint32 Stored;
+    uint32 Bans;
+};
+
+/**
+ * Collects the violations found by the anticheat and warden checks and acts on them in the world thread.
+ *
+ * The checks only copy a fixed size violation into a preallocated ring, the map threads never log, touch the
+ * database or walk the sessions for them. Update, called by the world update after the maps were updated,
+ * takes the whole ring at once and then:
+ *  - reports a check failed by an account again only once per Anticheat.ViolationRepeatWindow, counting the
+ *    repeats in between,
+ *  - reports at most Anticheat.ViolationsPerAccount violations of an account per minute,
+ *  - writes the rows of all the violations reported in one transaction,
+ *  - bans an account at most once per repeat window.
+ */
+class AntiCheatSink
+{
+    friend class ACE_Singleton<AntiCheatSink, ACE_Null_Mutex>;
+
+  public:
+    typedef std::map<uint32, AntiCheatCheckCounters> CounterMap;    // by check type
+
+    // may be called by any thread
+    void AddViolation(AntiCheatViolation const& violation);
+
+    // world thread only
+    void Update();
+
+    CounterMap const& GetCounters() const { return _counters; }
+    uint32 GetQueuedCount();
+    uint32 GetDroppedCount();
+    uint32 GetProcessedCount() const { return _processed; }
+    uint32 GetMaxBatchSize() const { return _maxBatch; }
+
+  private:
+    AntiCheatSink();
+    ~AntiCheatSink() { }
+
+    struct RepeatState
+    {
+        RepeatState() : LastTime(0), Repeats(0) { }
+
+        uint32 LastTime;
+        uint32 Repeats;                                     // since the last report
+    };
+
+    struct AccountState
+    {
+        AccountState() : WindowStart(0), Reported(0), BanTime(0) { }
+
+        uint32 WindowStart;
+        uint32 Reported;                                    // since WindowStart
+        uint32 BanTime;
+    };
+
+    static bool TakeAccountSlot(AccountState& account, uint32 time, uint32 accountLimit);
+
+    void Report(AntiCheatViolation const& violation, uint32 repeats, AntiCheatCheckCounters& counters, SQLTransaction& trans);
+    void Ban(AntiCheatViolation const& violation);
+    void Prune(uint32 now, uint32 repeatWindow);
+
+    // ring of the waiting violations, a plain mutex is enough as violations are rare and the lock is only
+    // held to copy one of them in or to copy the ring out once per world update
+    ACE_Thread_Mutex _lock;
+    AntiCheatViolation _queue[ANTICHEAT_VIOLATION_QUEUE_SIZE];
+    uint32 _head;
+    uint32 _size;
+    uint32 _dropped;                                        // violations lost as the ring was full
+
+    // world thread
+    AntiCheatViolation _batch[ANTICHEAT_VIOLATION_QUEUE_SIZE];
+    UNORDERED_MAP<uint64, RepeatState> _repeats;            // by account << 32 | check type
+    UNORDERED_MAP<uint32, AccountState> _accounts;
+    CounterMap _counters;
+    uint32 _processed;
+    uint32 _maxBatch;
+    uint32 _reportedDropped;
+    uint32 _lastPrune;
+};
+
+#define sAntiCheatSink ACE_Singleton<AntiCheatSink, ACE_Null_Mutex>::instance()
+
+#endif
@@ -387,9 +387,10 @@ bool AuctionHouseMgr::RemoveAItem(uint32 id, bool deleteItem)
 
 void AuctionHouseMgr::Update()
 {
-    mHordeAuctions.Update();
-    mAllianceAuctions.Update();
-    mNeutralAuctions.Update();
+    uint32 maxExpired = sWorld->getIntConfig(CONFIG_AUCTION_EXPIRY_BATCH_SIZE);
+    mHordeAuctions.Update(maxExpired);
+    mAllianceAuctions.Update(maxExpired);
+    mNeutralAuctions.Update(maxExpired);
 }
 
 AuctionHouseEntry const* AuctionHouseMgr::GetAuctionHouseEntry(uint32 factionTemplateId)
@@ -437,12 +438,16 @@ void AuctionHouseObject::AddAuction(AuctionEntry* auction)
     ASSERT(auction);
 
     AuctionsMap[auction->Id] = auction;
+    _expiryQueue.insert(std::make_pair(auction->expire_time, auction->Id));
+    _searchIndex.Insert(auction, sAuctionMgr->GetAItem(auction->itemGUIDLow));
     sScriptMgr->OnAuctionAdd(this, auction);
 }
 
 bool AuctionHouseObject::RemoveAuction(AuctionEntry* auction, uint32 /*itemEntry*/)
 {
     bool wasInMap = AuctionsMap.erase(auction->Id) ? true : false;
+    _expiryQueue.erase(std::make_pair(auction->expire_time, auction->Id));
+    _searchIndex.Remove(auction);
 
     sScriptMgr->OnAuctionRemove(this, auction);
 
@@ -453,29 +458,26 @@ bool AuctionHouseObject::RemoveAuction(AuctionEntry* auction, uint32 /*itemEntry
     return wasInMap;
 }
 
-void AuctionHouseObject::Update()
+uint32 AuctionHouseObject::Update(uint32 maxExpired)
 {
     time_t curTime = sWorld->GetGameTime();
-    ///- Handle expired auctions
+    uint32 expired = 0;
 
-    // If storage is empty, no need to update. next == NULL in this case.
-    if (AuctionsMap.empty())
-        return;
-
-    PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_AUCTION_BY_TIME);
-    stmt->setUInt32(0, (uint32)curTime+60);
-    PreparedQueryResult result = CharacterDatabase.Query(stmt);
-
-    if (!result)
-        return;
-
-    do
+    ///- Handle expired auctions, in order of their end until the slice is full
+    while (!_expiryQueue.empty() && expired < maxExpired)
     {
-        // from auctionhousehandler.cpp, creates auction pointer & player pointer
-        AuctionEntry* auction = GetAuction(result->Fetch()->GetUInt32());
+        ExpiryQueue::iterator itr = _expiryQueue.begin();
+        if (itr->first > curTime)
+            break;
 
+        AuctionEntry* auction = GetAuction(itr->second);
         if (!auction)
+        {
+            _expiryQueue.erase(itr);
             continue;
+        }
+
+        ++expired;
 
         SQLTransaction trans = CharacterDatabase.BeginTransaction();
 
@@ -505,7 +507,8 @@ void AuctionHouseObject::Update()
         sAuctionMgr->RemoveAItem(auction->itemGUIDLow);
         RemoveAuction(auction, itemEntry);
     }
-    while (result->NextRow());
+
+    return expired;
 }
 
 void AuctionHouseObject::BuildListBidderItems(WorldPacket& data, Player* player, uint32& count, uint32& totalcount)
@@ -543,96 +546,26 @@ void AuctionHouseObject::BuildListAuctionItems(WorldPacket& data, Player* player
     uint32 inventoryType, uint32 itemClass, uint32 itemSubClass, uint32 quality,
     uint32& count, uint32& totalcount)
 {
-    int loc_idx = player->GetSession()->GetSessionDbLocaleIndex();
-    int locdbc_idx = player->GetSession()->GetSessionDbcLocale();
-
-    time_t curTime = sWorld->GetGameTime();
-
-    for (AuctionEntryMap::const_iterator itr = AuctionsMap.begin(); itr != AuctionsMap.end(); ++itr)
+    AuctionSearchQuery query;
+    query.Name = wsearchedname;
+    query.LevelMin = levelmin;
+    query.LevelMax = levelmax;
+    query.Usable = usable;
+    query.InventoryType = inventoryType;
+    query.ItemClass = itemClass;
+    query.ItemSubClass = itemSubClass;
+    query.Quality = quality;
+
+    std::vector<AuctionEntry*> auctions;
+    _searchIndex.Search(query, player->GetSession()->GetSessionDbLocaleIndex(), player, sWorld->GetGameTime(), auctions);
+
+    for (uint32 i = listfrom; i < auctions.size() && count < 50; ++i)
     {
-        AuctionEntry* Aentry = itr->second;
-
-        // Skip expired auctions
-        if (Aentry->expire_time < curTime)
-            continue;
-
-        Item* item = sAuctionMgr->GetAItem(Aentry->itemGUIDLow);
-        if (!item)
-            continue;
-
-        ItemTemplate const* proto = item->GetTemplate();
-
-        if (itemClass != 0xffffffff && proto->Class != itemClass)
-            continue;
-
-        if (itemSubClass != 0xffffffff && proto->SubClass != itemSubClass)
-            continue;
-
-        if (inventoryType != 0xffffffff && proto->InventoryType != inventoryType)
-            continue;
-
-        if (quality != 0xffffffff && proto->Quality != quality)
-            continue;
-
-        if (levelmin != 0x00 && (proto->RequiredLevel < levelmin || (levelmax != 0x00 && proto->RequiredLevel > levelmax)))
-            continue;
-
-        if (usable != 0x00 && player->CanUseItem(item) != EQUIP_ERR_OK)
-            continue;
-
-        // Allow search by suffix (ie: of the Monkey) or partial name (ie: Monkey)
-        // No need to do any of this if no search term was entered
-        if (!wsearchedname.empty())
-        {
-            std::string name = proto->Name1;
-            if (name.empty())
-                continue;
-
-            // local name
-            if (loc_idx >= 0)
-                if (ItemLocale const* il = sObjectMgr->GetItemLocale(proto->ItemId))
-                    ObjectMgr::GetLocaleString(il->Name, loc_idx, name);
-
-            // DO NOT use GetItemEnchantMod(proto->RandomProperty) as it may return a result
-            //  that matches the search but it may not equal item->GetItemRandomPropertyId()
-            //  used in BuildAuctionInfo() which then causes wrong items to be listed
-            int32 propRefID = item->GetItemRandomPropertyId();
-
-            if (propRefID)
-            {
-                // Append the suffix to the name (ie: of the Monkey) if one exists
-                // These are found in ItemRandomProperties.dbc, not ItemRandomSuffix.dbc
-                //  even though the DBC names seem misleading
-                const ItemRandomPropertiesEntry* itemRandProp = sItemRandomPropertiesStore.LookupEntry(propRefID);
-
-                if (itemRandProp)
-                {
-                    char* temp = itemRandProp->nameSuffix;
-
-                    // dbc local name
-                    if (temp)
-                    {
-                        // Append the suffix (ie: of the Monkey) to the name using localization
-                        // or default enUS if localization is invalid
-                        name += ' ';
-                        name += temp[locdbc_idx >= 0 ? locdbc_idx : LOCALE_enUS];
-                    }
-                }
-            }
-
-            // Perform the search (with or without suffix)
-            if (!Utf8FitTo(name, wsearchedname))
-                continue;
-        }
-
-        // Add the item if no search term or if entered search term was found
-        if (count < 50 && totalcount >= listfrom)
-        {
-            ++count;
-            Aentry->BuildAuctionInfo(data);
-        }
-        ++totalcount;
+        ++count;
+        auctions[i]->BuildAuctionInfo(data);
     }
+
+    totalcount += auctions.size();
 }
 
 //this function inserts to WorldPacket auction's data
@@ -24,6 +24,7 @@
 #include "Common.h"
 #include "DatabaseEnv.h"
 #include "DBCStructure.h"
+#include "AuctionSearchIndex.h"
 
 class Item;
 class Player;
@@ -97,6 +98,8 @@ struct AuctionEntry
 };
 
 //this class is used as auctionhouse instance
+//Auctions only change in the world thread (thread unsafe auction handlers and Update), which never runs
+//together with the map updates, so the list handlers processed by the map threads read a stable house
 class AuctionHouseObject
 {
   public:
@@ -109,6 +112,7 @@ class AuctionHouseObject
     }
 
     typedef std::map<uint32, AuctionEntry*> AuctionEntryMap;
+    typedef std::set<std::pair<time_t, uint32> > ExpiryQueue;  // auction ids by end time
 
     uint32 Getcount() const { return AuctionsMap.size(); }
 
@@ -125,7 +129,8 @@ class AuctionHouseObject
 
     bool RemoveAuction(AuctionEntry* auction, uint32 itemEntry);
 
-    void Update();
+    // settles at most maxExpired ended auctions, the oldest first, returns how many
+    uint32 Update(uint32 maxExpired);
 
     void BuildListBidderItems(WorldPacket& data, Player* player, uint32& count, uint32& totalcount);
     void BuildListOwnerItems(WorldPacket& data, Player* player, uint32& count, uint32& totalcount);
@@ -134,8 +139,12 @@ class AuctionHouseObject
         uint32 inventoryType, uint32 itemClass, uint32 itemSubClass, uint32 quality,
         uint32& count, uint32& totalcount);
 
+    AuctionSearchIndex const& GetSearchIndex() const { return _searchIndex; }
+
   private:
     AuctionEntryMap AuctionsMap;
+    AuctionSearchIndex _searchIndex;
+    ExpiryQueue _expiryQueue;
 
     // storage for "next" auction item for next Update()
     AuctionEntryMap::const_iterator next;
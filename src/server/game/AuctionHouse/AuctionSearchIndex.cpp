@@ -0,0 +1,389 @@
+/*
+ * Copyright (C) 2008-2013 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "AuctionSearchIndex.h"
+#include "AuctionHouseMgr.h"
+#include "DBCStores.h"
+#include "Item.h"
+#include "ObjectMgr.h"
+#include "Player.h"
+
+namespace
+{
+    bool CompareAuctionIds(AuctionEntry const* left, AuctionEntry const* right)
+    {
+        return left->Id < right->Id;
+    }
+
+    // swaps the last entry into the freed slot
+    template<class T, class SLOT>
+    void EraseSlot(std::vector<T*>& list, uint32 slot, SLOT member)
+    {
+        if (slot + 1 != list.size())
+        {
+            list[slot] = list.back();
+            list[slot]->*member = slot;
+        }
+
+        list.pop_back();
+    }
+}
+
+AuctionSearchIndex::~AuctionSearchIndex()
+{
+    for (LocaleMap::iterator itr = _locales.begin(); itr != _locales.end(); ++itr)
+        delete itr->second;
+}
+
+void AuctionSearchIndex::Insert(AuctionEntry* auction, Item const* item)
+{
+    // the auctions of missing items were never listed
+    if (!item)
+        return;
+
+    ItemTemplate const* proto = item->GetTemplate();
+    if (!proto || _entries.find(auction->Id) != _entries.end())
+        return;
+
+    Entry& entry = _entries[auction->Id];
+    entry.Auction = auction;
+    entry.ItemClass = proto->Class;
+    entry.ItemSubClass = proto->SubClass;
+    entry.InventoryType = proto->InventoryType;
+    entry.Quality = proto->Quality;
+    entry.RequiredLevel = proto->RequiredLevel;
+
+    // DO NOT use GetItemEnchantMod(proto->RandomProperty), the listed name is the one of the actual property
+    int32 randomPropertyId = item->GetItemRandomPropertyId();
+    entry.NameKey = MakeNameKey(proto->ItemId, randomPropertyId);
+
+    EntryList& bucket = _buckets[MakeBucketKey(entry.ItemClass, entry.ItemSubClass)];
+    entry.BucketSlot = bucket.size();
+    bucket.push_back(&entry);
+
+    NameGroup& group = _names[entry.NameKey];
+    if (group.Entries.empty())
+    {
+        group.ItemEntry = proto->ItemId;
+        group.RandomPropertyId = randomPropertyId;
+
+        for (LocaleMap::iterator itr = _locales.begin(); itr != _locales.end(); ++itr)
+            AddName(*itr->second, LocaleConstant(itr->first), entry.NameKey, group);
+    }
+
+    entry.NameSlot = group.Entries.size();
+    group.Entries.push_back(&entry);
+}
+
+void AuctionSearchIndex::Remove(AuctionEntry const* auction)
+{
+    EntryMap::iterator itr = _entries.find(auction->Id);
+    if (itr == _entries.end())
+        return;
+
+    Entry& entry = itr->second;
+
+    BucketMap::iterator bucket = _buckets.find(MakeBucketKey(entry.ItemClass, entry.ItemSubClass));
+    ASSERT(bucket != _buckets.end());
+    EraseSlot(bucket->second, entry.BucketSlot, &Entry::BucketSlot);
+    if (bucket->second.empty())
+        _buckets.erase(bucket);
+
+    NameMap::iterator group = _names.find(entry.NameKey);
+    ASSERT(group != _names.end());
+    EraseSlot(group->second.Entries, entry.NameSlot, &Entry::NameSlot);
+    if (group->second.Entries.empty())
+    {
+        for (LocaleMap::iterator locale = _locales.begin(); locale != _locales.end(); ++locale)
+            RemoveName(*locale->second, entry.NameKey);
+
+        _names.erase(group);
+    }
+
+    _entries.erase(itr);
+}
+
+bool AuctionSearchIndex::Matches(Entry const& entry, AuctionSearchQuery const& query, Player* player, time_t curTime) const
+{
+    // Skip expired auctions
+    if (entry.Auction->expire_time < curTime)
+        return false;
+
+    if (query.ItemClass != AUCTION_SEARCH_ANY && entry.ItemClass != query.ItemClass)
+        return false;
+
+    if (query.ItemSubClass != AUCTION_SEARCH_ANY && entry.ItemSubClass != query.ItemSubClass)
+        return false;
+
+    if (query.InventoryType != AUCTION_SEARCH_ANY && entry.InventoryType != query.InventoryType)
+        return false;
+
+    if (query.Quality != AUCTION_SEARCH_ANY && entry.Quality != query.Quality)
+        return false;
+
+    if (query.LevelMin != 0x00 && (entry.RequiredLevel < query.LevelMin || (query.LevelMax != 0x00 && entry.RequiredLevel > query.LevelMax)))
+        return false;
+
+    if (query.Usable != 0x00)
+    {
+        Item* item = sAuctionMgr->GetAItem(entry.Auction->itemGUIDLow);
+        if (!item || !player || player->CanUseItem(item) != EQUIP_ERR_OK)
+            return false;
+    }
+
+    return true;
+}
+
+void AuctionSearchIndex::Search(AuctionSearchQuery const& query, LocaleConstant dbLocale, Player* player, time_t curTime,
+    std::vector<AuctionEntry*>& results) const
+{
+    size_t first = results.size();
+
+    if (!query.Name.empty())
+    {
+        LocaleNames& locale = GetLocaleNames(dbLocale);
+
+        // candidates are the names holding the rarest piece of the searched text, or all names for short texts
+        std::vector<uint64> const* candidates = NULL;
+        std::vector<uint64> grams;
+        GetGrams(query.Name, grams);
+        for (std::vector<uint64>::const_iterator gram = grams.begin(); gram != grams.end(); ++gram)
+        {
+            UNORDERED_MAP<uint64, std::vector<uint64> >::const_iterator posting = locale.Grams.find(*gram);
+            if (posting == locale.Grams.end())
+                return;
+
+            if (!candidates || posting->second.size() < candidates->size())
+                candidates = &posting->second;
+        }
+
+        std::vector<uint64> allNames;
+        if (!candidates)
+        {
+            allNames.reserve(locale.Names.size());
+            for (UNORDERED_MAP<uint64, std::wstring>::const_iterator itr = locale.Names.begin(); itr != locale.Names.end(); ++itr)
+                allNames.push_back(itr->first);
+            candidates = &allNames;
+        }
+
+        for (std::vector<uint64>::const_iterator key = candidates->begin(); key != candidates->end(); ++key)
+        {
+            UNORDERED_MAP<uint64, std::wstring>::const_iterator name = locale.Names.find(*key);
+            if (name == locale.Names.end() || name->second.find(query.Name) == std::wstring::npos)
+                continue;
+
+            NameMap::const_iterator group = _names.find(*key);
+            if (group == _names.end())
+                continue;
+
+            for (EntryList::const_iterator itr = group->second.Entries.begin(); itr != group->second.Entries.end(); ++itr)
+                if (Matches(**itr, query, player, curTime))
+                    results.push_back((*itr)->Auction);
+        }
+    }
+    else
+    {
+        // one bucket for a subclass, the range of a class or everything
+        BucketMap::const_iterator begin = _buckets.begin();
+        BucketMap::const_iterator end = _buckets.end();
+        if (query.ItemClass != AUCTION_SEARCH_ANY)
+        {
+            // no such classes, the key would wrap around
+            if (query.ItemClass > 0xFFFF)
+                return;
+
+            if (query.ItemSubClass != AUCTION_SEARCH_ANY)
+            {
+                begin = _buckets.find(MakeBucketKey(query.ItemClass, query.ItemSubClass));
+                if (begin == _buckets.end())
+                    return;
+
+                end = begin;
+                ++end;
+            }
+            else
+            {
+                begin = _buckets.lower_bound(MakeBucketKey(query.ItemClass, 0));
+                end = _buckets.lower_bound(MakeBucketKey(query.ItemClass + 1, 0));
+            }
+        }
+
+        for (BucketMap::const_iterator bucket = begin; bucket != end; ++bucket)
+            for (EntryList::const_iterator itr = bucket->second.begin(); itr != bucket->second.end(); ++itr)
+                if (Matches(**itr, query, player, curTime))
+                    results.push_back((*itr)->Auction);
+    }
+
+    // same order as the auction map, so pages stay stable between requests
+    std::sort(results.begin() + first, results.end(), CompareAuctionIds);
+}
+
+bool AuctionSearchIndex::BuildName(uint32 itemEntry, int32 randomPropertyId, LocaleConstant dbLocale, std::wstring& name)
+{
+    ItemTemplate const* proto = sObjectMgr->GetItemTemplate(itemEntry);
+    if (!proto || proto->Name1.empty())
+        return false;
+
+    std::string text = proto->Name1;
+
+    // local name
+    if (dbLocale >= 0)
+        if (ItemLocale const* il = sObjectMgr->GetItemLocale(proto->ItemId))
+            ObjectMgr::GetLocaleString(il->Name, dbLocale, text);
+
+    // Append the suffix to the name (ie: of the Monkey) if one exists
+    // These are found in ItemRandomProperties.dbc, not ItemRandomSuffix.dbc
+    //  even though the DBC names seem misleading
+    if (randomPropertyId)
+    {
+        if (ItemRandomPropertiesEntry const* itemRandProp = sItemRandomPropertiesStore.LookupEntry(randomPropertyId))
+        {
+            if (itemRandProp->nameSuffix && *itemRandProp->nameSuffix)
+            {
+                text += ' ';
+                text += itemRandProp->nameSuffix;
+            }
+        }
+    }
+
+    if (!Utf8toWStr(text, name))
+        return false;
+
+    wstrToLower(name);
+    return true;
+}
+
+// distinct pieces of AUCTION_SEARCH_GRAM_LENGTH characters, nothing for shorter texts
+void AuctionSearchIndex::GetGrams(std::wstring const& text, std::vector<uint64>& grams)
+{
+    if (text.size() < AUCTION_SEARCH_GRAM_LENGTH)
+        return;
+
+    grams.reserve(text.size() - AUCTION_SEARCH_GRAM_LENGTH + 1);
+    for (size_t i = 0; i + AUCTION_SEARCH_GRAM_LENGTH <= text.size(); ++i)
+    {
+        uint64 gram = 0;
+        for (size_t j = 0; j < AUCTION_SEARCH_GRAM_LENGTH; ++j)
+            gram = (gram << 21) | (uint64(text[i + j]) & 0x1FFFFF);     // unicode code points have 21 bits
+
+        grams.push_back(gram);
+    }
+
+    std::sort(grams.begin(), grams.end());
+    grams.erase(std::unique(grams.begin(), grams.end()), grams.end());
+}
+
+AuctionSearchIndex::LocaleNames& AuctionSearchIndex::GetLocaleNames(LocaleConstant dbLocale) const
+{
+    TRINITY_GUARD(ACE_Thread_Mutex, _localesLock);
+
+    LocaleMap::iterator itr = _locales.find(dbLocale);
+    if (itr != _locales.end())
+        return *itr->second;
+
+    LocaleNames* locale = new LocaleNames();
+    _locales[dbLocale] = locale;
+
+    for (NameMap::const_iterator group = _names.begin(); group != _names.end(); ++group)
+        AddName(*locale, dbLocale, group->first, group->second);
+
+    return *locale;
+}
+
+void AuctionSearchIndex::AddName(LocaleNames& locale, LocaleConstant dbLocale, uint64 nameKey, NameGroup const& group) const
+{
+    std::wstring name;
+    if (!BuildName(group.ItemEntry, group.RandomPropertyId, dbLocale, name))
+        return;
+
+    std::vector<uint64> grams;
+    GetGrams(name, grams);
+    for (std::vector<uint64>::const_iterator gram = grams.begin(); gram != grams.end(); ++gram)
+        locale.Grams[*gram].push_back(nameKey);
+
+    locale.Names[nameKey].swap(name);
+}
+
+void AuctionSearchIndex::RemoveName(LocaleNames& locale, uint64 nameKey) const
+{
+    UNORDERED_MAP<uint64, std::wstring>::iterator name = locale.Names.find(nameKey);
+    if (name == locale.Names.end())
+        return;
+
+    std::vector<uint64> grams;
+    GetGrams(name->second, grams);
+    for (std::vector<uint64>::const_iterator gram = grams.begin(); gram != grams.end(); ++gram)
+    {
+        UNORDERED_MAP<uint64, std::vector<uint64> >::iterator posting = locale.Grams.find(*gram);
+        if (posting == locale.Grams.end())
+            continue;
+
+        std::vector<uint64>& keys = posting->second;
+        std::vector<uint64>::iterator key = std::find(keys.begin(), keys.end(), nameKey);
+        if (key != keys.end())
+        {
+            *key = keys.back();
+            keys.pop_back();
+        }
+
+        if (keys.empty())
+            locale.Grams.erase(posting);
+    }
+
+    locale.Names.erase(name);
+}
+
+bool AuctionSearchIndex::MatchesByScan(AuctionEntry const* auction, AuctionSearchQuery const& query, LocaleConstant dbLocale,
+    Player* player, time_t curTime)
+{
+    // Skip expired auctions
+    if (auction->expire_time < curTime)
+        return false;
+
+    Item* item = sAuctionMgr->GetAItem(auction->itemGUIDLow);
+    if (!item)
+        return false;
+
+    ItemTemplate const* proto = item->GetTemplate();
+
+    if (query.ItemClass != AUCTION_SEARCH_ANY && proto->Class != query.ItemClass)
+        return false;
+
+    if (query.ItemSubClass != AUCTION_SEARCH_ANY && proto->SubClass != query.ItemSubClass)
+        return false;
+
+    if (query.InventoryType != AUCTION_SEARCH_ANY && proto->InventoryType != query.InventoryType)
+        return false;
+
+    if (query.Quality != AUCTION_SEARCH_ANY && proto->Quality != query.Quality)
+        return false;
+
+    if (query.LevelMin != 0x00 && (proto->RequiredLevel < query.LevelMin || (query.LevelMax != 0x00 && proto->RequiredLevel > query.LevelMax)))
+        return false;
+
+    if (query.Usable != 0x00 && (!player || player->CanUseItem(item) != EQUIP_ERR_OK))
+        return false;
+
+    if (query.Name.empty())
+        return true;
+
+    std::wstring name;
+    if (!BuildName(proto->ItemId, item->GetItemRandomPropertyId(), dbLocale, name))
+        return false;
+
+    return name.find(query.Name) != std::wstring::npos;
+}
@@ -0,0 +1,131 @@
+/*
+ * Copyright (C) 2008-2013 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_AUCTIONSEARCHINDEX_H
+#define TRINITY_AUCTIONSEARCHINDEX_H
+
+#include "Common.h"
+#include <ace/Thread_Mutex.h>
+
+struct AuctionEntry;
+class Item;
+class Player;
+
+#define AUCTION_SEARCH_ANY          0xFFFFFFFF
+#define AUCTION_SEARCH_GRAM_LENGTH  3                       // characters per indexed piece of name
+
+// Filters of CMSG_AUCTION_LIST_ITEMS
+struct AuctionSearchQuery
+{
+    AuctionSearchQuery() : LevelMin(0), LevelMax(0), Usable(0), InventoryType(AUCTION_SEARCH_ANY),
+        ItemClass(AUCTION_SEARCH_ANY), ItemSubClass(AUCTION_SEARCH_ANY), Quality(AUCTION_SEARCH_ANY) { }
+
+    std::wstring Name;                                      // lower case, empty for any
+    uint8 LevelMin;
+    uint8 LevelMax;
+    uint8 Usable;
+    uint32 InventoryType;
+    uint32 ItemClass;
+    uint32 ItemSubClass;
+    uint32 Quality;
+};
+
+/**
+ * Secondary index of the auctions of one auction house, kept up to date by AddAuction and RemoveAuction.
+ *
+ * Auctions are bucketed by item class and subclass, so browsing a category only visits its auctions.
+ * Name searches go through the distinct names (item entry and random property) instead of the auctions:
+ * the lower case name of every distinct item is built once per database locale, the first time someone
+ * searches in that locale, and the names are indexed by the AUCTION_SEARCH_GRAM_LENGTH character pieces
+ * they contain. A search only checks the names holding the rarest piece of the searched text.
+ */
+class AuctionSearchIndex
+{
+  public:
+    AuctionSearchIndex() { }
+    ~AuctionSearchIndex();
+
+    void Insert(AuctionEntry* auction, Item const* item);
+    void Remove(AuctionEntry const* auction);
+
+    // appends the matching auctions ordered by id, player is only needed for usable searches
+    void Search(AuctionSearchQuery const& query, LocaleConstant dbLocale, Player* player, time_t curTime,
+        std::vector<AuctionEntry*>& results) const;
+
+    // filter of the former linear search, kept as reference for .bench auction
+    static bool MatchesByScan(AuctionEntry const* auction, AuctionSearchQuery const& query, LocaleConstant dbLocale,
+        Player* player, time_t curTime);
+
+    uint32 GetSize() const { return _entries.size(); }
+    uint32 GetNameCount() const { return _names.size(); }
+    uint32 GetLocaleCount() const { return _locales.size(); }
+
+  private:
+    struct Entry
+    {
+        AuctionEntry* Auction;
+        uint32 ItemClass;
+        uint32 ItemSubClass;
+        uint32 InventoryType;
+        uint32 Quality;
+        uint32 RequiredLevel;
+        uint64 NameKey;
+        uint32 BucketSlot;
+        uint32 NameSlot;
+    };
+
+    typedef std::vector<Entry*> EntryList;
+
+    // auctions of items with the same name
+    struct NameGroup
+    {
+        uint32 ItemEntry;
+        int32 RandomPropertyId;
+        EntryList Entries;
+    };
+
+    // lower case names of one locale and the names holding each piece of text
+    struct LocaleNames
+    {
+        UNORDERED_MAP<uint64, std::wstring> Names;
+        UNORDERED_MAP<uint64, std::vector<uint64> > Grams;
+    };
+
+    typedef UNORDERED_MAP<uint32, Entry> EntryMap;          // by auction id
+    typedef std::map<uint32, EntryList> BucketMap;          // by item class << 16 | subclass
+    typedef UNORDERED_MAP<uint64, NameGroup> NameMap;       // by item entry << 32 | random property
+    typedef UNORDERED_MAP<uint32, LocaleNames*> LocaleMap;  // by db locale
+
+    static uint32 MakeBucketKey(uint32 itemClass, uint32 itemSubClass) { return (itemClass << 16) | (itemSubClass & 0xFFFF); }
+    static uint64 MakeNameKey(uint32 itemEntry, int32 randomPropertyId) { return (uint64(itemEntry) << 32) | uint32(randomPropertyId); }
+    static bool BuildName(uint32 itemEntry, int32 randomPropertyId, LocaleConstant dbLocale, std::wstring& name);
+    static void GetGrams(std::wstring const& text, std::vector<uint64>& grams);
+
+    bool Matches(Entry const& entry, AuctionSearchQuery const& query, Player* player, time_t curTime) const;
+
+    LocaleNames& GetLocaleNames(LocaleConstant dbLocale) const;
+    void AddName(LocaleNames& locale, LocaleConstant dbLocale, uint64 nameKey, NameGroup const& group) const;
+    void RemoveName(LocaleNames& locale, uint64 nameKey) const;
+
+    EntryMap _entries;
+    BucketMap _buckets;
+    NameMap _names;
+    mutable LocaleMap _locales;                             // built by the first search in a locale
+    mutable ACE_Thread_Mutex _localesLock;                  // searches of several map threads may build them
+};
+
+#endif
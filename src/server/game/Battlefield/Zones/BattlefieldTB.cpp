@@ -388,116 +388,119 @@ void BattlefieldTB::OnBattleStart()
             if (Creature* creature = unit->ToCreature())
                 HideNpc(creature);
 
-    HashMapHolder<Player>::MapType const& plist = sObjectAccessor->GetPlayers();
-    for (HashMapHolder<Player>::MapType::const_iterator itr = plist.begin(); itr != plist.end(); ++itr)
+    for (uint32 stripe = 0; stripe < HashMapHolder<Player>::STRIPE_COUNT; ++stripe)
     {
-        if (Player* player = itr->second)
+        HashMapHolder<Player>::MapType const& plist = sObjectAccessor->GetPlayers(stripe);
+        for (HashMapHolder<Player>::MapType::const_iterator itr = plist.begin(); itr != plist.end(); ++itr)
         {
-            SendUpdateWorldState(WS_TB_BATTLE_TIMER_ENABLED, 1);
-            SendUpdateWorldState(WS_TB_BATTLE_TIMER, (time(NULL) + GetTimer() / 1000));
-            SendUpdateWorldState(WS_TB_COUNTER_BUILDINGS, 0);
-            SendUpdateWorldState(WS_TB_COUNTER_BUILDINGS_ENABLED, 1);
-            SendUpdateWorldState(WS_TB_HORDE_DEFENCE, 0);
-            SendUpdateWorldState(WS_TB_ALLIANCE_DEFENCE, 0);
-            SendUpdateWorldState(WS_TB_NEXT_BATTLE_TIMER_ENABLED, 0);
-            SendUpdateWorldState(WS_TB_KEEP_HORDE_DEFENCE, GetDefenderTeam() == TEAM_HORDE ? 1 : 0);
-            SendUpdateWorldState(WS_TB_KEEP_ALLIANCE_DEFENCE, GetDefenderTeam() == TEAM_ALLIANCE ? 1 : 0);
-            SendUpdateWorldState(WS_TB_ALLIANCE_ATTACK, GetAttackerTeam() == TEAM_ALLIANCE ? 1 : 0);
-            SendUpdateWorldState(WS_TB_HORDE_ATTACK, GetAttackerTeam() == TEAM_HORDE ? 1 : 0);
-
-            switch (GetDefenderTeam())
+            if (Player* player = itr->second)
             {
-                case TEAM_ALLIANCE:
+                SendUpdateWorldState(WS_TB_BATTLE_TIMER_ENABLED, 1);
+                SendUpdateWorldState(WS_TB_BATTLE_TIMER, (time(NULL) + GetTimer() / 1000));
+                SendUpdateWorldState(WS_TB_COUNTER_BUILDINGS, 0);
+                SendUpdateWorldState(WS_TB_COUNTER_BUILDINGS_ENABLED, 1);
+                SendUpdateWorldState(WS_TB_HORDE_DEFENCE, 0);
+                SendUpdateWorldState(WS_TB_ALLIANCE_DEFENCE, 0);
+                SendUpdateWorldState(WS_TB_NEXT_BATTLE_TIMER_ENABLED, 0);
+                SendUpdateWorldState(WS_TB_KEEP_HORDE_DEFENCE, GetDefenderTeam() == TEAM_HORDE ? 1 : 0);
+                SendUpdateWorldState(WS_TB_KEEP_ALLIANCE_DEFENCE, GetDefenderTeam() == TEAM_ALLIANCE ? 1 : 0);
+                SendUpdateWorldState(WS_TB_ALLIANCE_ATTACK, GetAttackerTeam() == TEAM_ALLIANCE ? 1 : 0);
+                SendUpdateWorldState(WS_TB_HORDE_ATTACK, GetAttackerTeam() == TEAM_HORDE ? 1 : 0);
+
+                switch (GetDefenderTeam())
                 {
-                    for (int i = 0; i < MAX_CP_DIFF; i++)
-                    {
-                        if (i == ALLIANCE_DEFENCE)
-                            SendUpdateWorldState(WS_TB_SOUTH_CAPTURE_POINT + i, 1);
-                        else
-                            SendUpdateWorldState(WS_TB_SOUTH_CAPTURE_POINT + i, 0);
-                    }
-                    for (int i = 0; i < MAX_CP_DIFF; i++)
+                    case TEAM_ALLIANCE:
                     {
-                        if (i == ALLIANCE_DEFENCE)
-                            SendUpdateWorldState(WS_TB_EAST_CAPTURE_POINT + i, 1);
-                        else
-                            SendUpdateWorldState(WS_TB_EAST_CAPTURE_POINT + i, 0);
-                    }
-                    for (int i = 0; i < MAX_CP_DIFF; i++)
-                    {
-                        if (i == ALLIANCE_DEFENCE)
-                            SendUpdateWorldState(WS_TB_WEST_CAPTURE_POINT + i, 1);
-                        else
-                            SendUpdateWorldState(WS_TB_WEST_CAPTURE_POINT + i, 0);
-                    }
-                    for (int i = 0; i < BUILDING_MAX_DIFF; i++)
-                    {
-                        if (i == BUILDING_ALLIANCE_DEFENCE)
-                            SendUpdateWorldState(WS_TB_EAST_SPIRE + i, 1);
-                        else
-                            SendUpdateWorldState(WS_TB_EAST_SPIRE + i, 0);
-                    }
-                    for (int i = 0; i < BUILDING_MAX_DIFF; i++)
-                    {
-                        if (i == BUILDING_ALLIANCE_DEFENCE)
-                            SendUpdateWorldState(WS_TB_SOUTH_SPIRE + i, 1);
-                        else
-                            SendUpdateWorldState(WS_TB_SOUTH_SPIRE + i, 0);
-                    }
-                    for (int i = 0; i < BUILDING_MAX_DIFF; i++)
-                    {
-                        if (i == BUILDING_ALLIANCE_DEFENCE)
-                            SendUpdateWorldState(WS_TB_WEST_SPIRE + i, 1);
-                        else
-                            SendUpdateWorldState(WS_TB_WEST_SPIRE + i, 0);
-                    }
-                    break;
-                }
-                case TEAM_HORDE:
-                {
-                    for (int i = 0; i < MAX_CP_DIFF; i++)
-                    {
-                        if (i == HORDE_DEFENCE)
-                            SendUpdateWorldState(WS_TB_SOUTH_CAPTURE_POINT + i, 1);
-                        else
-                            SendUpdateWorldState(WS_TB_SOUTH_CAPTURE_POINT + i, 0);
-                    }
-                    for (int i = 0; i < MAX_CP_DIFF; i++)
-                    {
-                        if (i == HORDE_DEFENCE)
-                            SendUpdateWorldState(WS_TB_EAST_CAPTURE_POINT + i, 1);
-                        else
-                            SendUpdateWorldState(WS_TB_EAST_CAPTURE_POINT + i, 0);
-                    }
-                    for (int i = 0; i < MAX_CP_DIFF; i++)
-                    {
-                        if (i == HORDE_DEFENCE)
-                            SendUpdateWorldState(WS_TB_WEST_CAPTURE_POINT + i, 1);
-                        else
-                            SendUpdateWorldState(WS_TB_WEST_CAPTURE_POINT + i, 0);
-                    }
-                    for (int i = 0; i < BUILDING_MAX_DIFF; i++)
-                    {
-                        if (i == BUILDING_HORDE_DEFENCE)
-                            SendUpdateWorldState(WS_TB_EAST_SPIRE + i, 1);
-                        else
-                            SendUpdateWorldState(WS_TB_EAST_SPIRE + i, 0);
-                    }
-                    for (int i = 0; i < BUILDING_MAX_DIFF; i++)
-                    {
-                        if (i == BUILDING_HORDE_DEFENCE)
-                            SendUpdateWorldState(WS_TB_SOUTH_SPIRE + i, 1);
-                        else
-                            SendUpdateWorldState(WS_TB_SOUTH_SPIRE + i, 0);
+                        for (int i = 0; i < MAX_CP_DIFF; i++)
+                        {
+                            if (i == ALLIANCE_DEFENCE)
+                                SendUpdateWorldState(WS_TB_SOUTH_CAPTURE_POINT + i, 1);
+                            else
+                                SendUpdateWorldState(WS_TB_SOUTH_CAPTURE_POINT + i, 0);
+                        }
+                        for (int i = 0; i < MAX_CP_DIFF; i++)
+                        {
+                            if (i == ALLIANCE_DEFENCE)
+                                SendUpdateWorldState(WS_TB_EAST_CAPTURE_POINT + i, 1);
+                            else
+                                SendUpdateWorldState(WS_TB_EAST_CAPTURE_POINT + i, 0);
+                        }
+                        for (int i = 0; i < MAX_CP_DIFF; i++)
+                        {
+                            if (i == ALLIANCE_DEFENCE)
+                                SendUpdateWorldState(WS_TB_WEST_CAPTURE_POINT + i, 1);
+                            else
+                                SendUpdateWorldState(WS_TB_WEST_CAPTURE_POINT + i, 0);
+                        }
+                        for (int i = 0; i < BUILDING_MAX_DIFF; i++)
+                        {
+                            if (i == BUILDING_ALLIANCE_DEFENCE)
+                                SendUpdateWorldState(WS_TB_EAST_SPIRE + i, 1);
+                            else
+                                SendUpdateWorldState(WS_TB_EAST_SPIRE + i, 0);
+                        }
+                        for (int i = 0; i < BUILDING_MAX_DIFF; i++)
+                        {
+                            if (i == BUILDING_ALLIANCE_DEFENCE)
+                                SendUpdateWorldState(WS_TB_SOUTH_SPIRE + i, 1);
+                            else
+                                SendUpdateWorldState(WS_TB_SOUTH_SPIRE + i, 0);
+                        }
+                        for (int i = 0; i < BUILDING_MAX_DIFF; i++)
+                        {
+                            if (i == BUILDING_ALLIANCE_DEFENCE)
+                                SendUpdateWorldState(WS_TB_WEST_SPIRE + i, 1);
+                            else
+                                SendUpdateWorldState(WS_TB_WEST_SPIRE + i, 0);
+                        }
+                        break;
                     }
-                    for (int i = 0; i < BUILDING_MAX_DIFF; i++)
+                    case TEAM_HORDE:
                     {
-                        if (i == BUILDING_ALLIANCE_DEFENCE)
-                            SendUpdateWorldState(WS_TB_WEST_SPIRE + i, 1);
-                        else
-                            SendUpdateWorldState(WS_TB_WEST_SPIRE + i, 0);
+                        for (int i = 0; i < MAX_CP_DIFF; i++)
+                        {
+                            if (i == HORDE_DEFENCE)
+                                SendUpdateWorldState(WS_TB_SOUTH_CAPTURE_POINT + i, 1);
+                            else
+                                SendUpdateWorldState(WS_TB_SOUTH_CAPTURE_POINT + i, 0);
+                        }
+                        for (int i = 0; i < MAX_CP_DIFF; i++)
+                        {
+                            if (i == HORDE_DEFENCE)
+                                SendUpdateWorldState(WS_TB_EAST_CAPTURE_POINT + i, 1);
+                            else
+                                SendUpdateWorldState(WS_TB_EAST_CAPTURE_POINT + i, 0);
+                        }
+                        for (int i = 0; i < MAX_CP_DIFF; i++)
+                        {
+                            if (i == HORDE_DEFENCE)
+                                SendUpdateWorldState(WS_TB_WEST_CAPTURE_POINT + i, 1);
+                            else
+                                SendUpdateWorldState(WS_TB_WEST_CAPTURE_POINT + i, 0);
+                        }
+                        for (int i = 0; i < BUILDING_MAX_DIFF; i++)
+                        {
+                            if (i == BUILDING_HORDE_DEFENCE)
+                                SendUpdateWorldState(WS_TB_EAST_SPIRE + i, 1);
+                            else
+                                SendUpdateWorldState(WS_TB_EAST_SPIRE + i, 0);
+                        }
+                        for (int i = 0; i < BUILDING_MAX_DIFF; i++)
+                        {
+                            if (i == BUILDING_HORDE_DEFENCE)
+                                SendUpdateWorldState(WS_TB_SOUTH_SPIRE + i, 1);
+                            else
+                                SendUpdateWorldState(WS_TB_SOUTH_SPIRE + i, 0);
+                        }
+                        for (int i = 0; i < BUILDING_MAX_DIFF; i++)
+                        {
+                            if (i == BUILDING_ALLIANCE_DEFENCE)
+                                SendUpdateWorldState(WS_TB_WEST_SPIRE + i, 1);
+                            else
+                                SendUpdateWorldState(WS_TB_WEST_SPIRE + i, 0);
+                        }
+                        break;
                     }
-                    break;
                 }
             }
         }
@@ -784,115 +787,118 @@ void BattlefieldTB::OnBattleEnd(bool endbytimer)
                 }
             }
 
-            HashMapHolder<Player>::MapType const& plist = sObjectAccessor->GetPlayers();
-            for (HashMapHolder<Player>::MapType::const_iterator itr = plist.begin(); itr != plist.end(); ++itr)
+            for (uint32 stripe = 0; stripe < HashMapHolder<Player>::STRIPE_COUNT; ++stripe)
             {
-                if (Player* player = itr->second)
+                HashMapHolder<Player>::MapType const& plist = sObjectAccessor->GetPlayers(stripe);
+                for (HashMapHolder<Player>::MapType::const_iterator itr = plist.begin(); itr != plist.end(); ++itr)
                 {
-                    SendUpdateWorldState(WS_TB_BATTLE_TIMER_ENABLED, 0);
-                    SendUpdateWorldState(WS_TB_BATTLE_TIMER, 0);
-                    SendUpdateWorldState(WS_TB_COUNTER_BUILDINGS, 0);
-                    SendUpdateWorldState(WS_TB_COUNTER_BUILDINGS_ENABLED, 0);
-                    SendUpdateWorldState(WS_TB_HORDE_DEFENCE, 0);
-                    SendUpdateWorldState(WS_TB_ALLIANCE_DEFENCE, 0);
-                    SendUpdateWorldState(WS_TB_NEXT_BATTLE_TIMER_ENABLED, 1);
-                    SendUpdateWorldState(WS_TB_NEXT_BATTLE_TIMER, (!IsWarTime() ? time(NULL) + (GetTimer() / 1000) : 0));
-                    SendUpdateWorldState(WS_TB_KEEP_HORDE_DEFENCE, GetDefenderTeam() == TEAM_HORDE ? 1 : 0);
-                    SendUpdateWorldState(WS_TB_KEEP_ALLIANCE_DEFENCE, GetDefenderTeam() == TEAM_ALLIANCE ? 1 : 0);
-                    SendUpdateWorldState(WS_TB_ALLIANCE_ATTACK, 0);
-                    SendUpdateWorldState(WS_TB_HORDE_ATTACK, 0);
-
-                    switch (GetDefenderTeam())
+                    if (Player* player = itr->second)
                     {
-                        case TEAM_ALLIANCE:
-                            for (int i = 0; i < MAX_CP_DIFF; i++)
-                            {
-                                if (i == ALLIANCE_DEFENCE)
-                                    SendUpdateWorldState(WS_TB_SOUTH_CAPTURE_POINT + i, 1);
-                                else
-                                    SendUpdateWorldState(WS_TB_SOUTH_CAPTURE_POINT + i, 0);
-                            }
-                            for (int i = 0; i < MAX_CP_DIFF; i++)
-                            {
-                                if (i == ALLIANCE_DEFENCE)
-                                    SendUpdateWorldState(WS_TB_EAST_CAPTURE_POINT + i, 1);
-                                else
-                                    SendUpdateWorldState(WS_TB_EAST_CAPTURE_POINT + i, 0);
-                            }
-                            for (int i = 0; i < MAX_CP_DIFF; i++)
-                            {
-                                if (i == ALLIANCE_DEFENCE)
-                                    SendUpdateWorldState(WS_TB_WEST_CAPTURE_POINT + i, 1);
-                                else
-                                    SendUpdateWorldState(WS_TB_WEST_CAPTURE_POINT + i, 0);
-                            }
-                            for (int i = 0; i < BUILDING_MAX_DIFF; i++)
-                            {
-                                if (i == BUILDING_ALLIANCE_DEFENCE)
-                                    SendUpdateWorldState(WS_TB_EAST_SPIRE + i, 1);
-                                else
-                                    SendUpdateWorldState(WS_TB_EAST_SPIRE + i, 0);
-                            }
-                            for (int i = 0; i < BUILDING_MAX_DIFF; i++)
-                            {
-                                if (i == BUILDING_ALLIANCE_DEFENCE)
-                                    SendUpdateWorldState(WS_TB_SOUTH_SPIRE + i, 1);
-                                else
-                                    SendUpdateWorldState(WS_TB_SOUTH_SPIRE + i, 0);
-                            }
-                            for (int i = 0; i < BUILDING_MAX_DIFF; i++)
-                            {
-                                if (i == BUILDING_ALLIANCE_DEFENCE)
-                                    SendUpdateWorldState(WS_TB_WEST_SPIRE + i, 1);
-                                else
-                                    SendUpdateWorldState(WS_TB_WEST_SPIRE + i, 0);
-                            }
-                            break;
+                        SendUpdateWorldState(WS_TB_BATTLE_TIMER_ENABLED, 0);
+                        SendUpdateWorldState(WS_TB_BATTLE_TIMER, 0);
+                        SendUpdateWorldState(WS_TB_COUNTER_BUILDINGS, 0);
+                        SendUpdateWorldState(WS_TB_COUNTER_BUILDINGS_ENABLED, 0);
+                        SendUpdateWorldState(WS_TB_HORDE_DEFENCE, 0);
+                        SendUpdateWorldState(WS_TB_ALLIANCE_DEFENCE, 0);
+                        SendUpdateWorldState(WS_TB_NEXT_BATTLE_TIMER_ENABLED, 1);
+                        SendUpdateWorldState(WS_TB_NEXT_BATTLE_TIMER, (!IsWarTime() ? time(NULL) + (GetTimer() / 1000) : 0));
+                        SendUpdateWorldState(WS_TB_KEEP_HORDE_DEFENCE, GetDefenderTeam() == TEAM_HORDE ? 1 : 0);
+                        SendUpdateWorldState(WS_TB_KEEP_ALLIANCE_DEFENCE, GetDefenderTeam() == TEAM_ALLIANCE ? 1 : 0);
+                        SendUpdateWorldState(WS_TB_ALLIANCE_ATTACK, 0);
+                        SendUpdateWorldState(WS_TB_HORDE_ATTACK, 0);
+
+                        switch (GetDefenderTeam())
+                        {
+                            case TEAM_ALLIANCE:
+                                for (int i = 0; i < MAX_CP_DIFF; i++)
+                                {
+                                    if (i == ALLIANCE_DEFENCE)
+                                        SendUpdateWorldState(WS_TB_SOUTH_CAPTURE_POINT + i, 1);
+                                    else
+                                        SendUpdateWorldState(WS_TB_SOUTH_CAPTURE_POINT + i, 0);
+                                }
+                                for (int i = 0; i < MAX_CP_DIFF; i++)
+                                {
+                                    if (i == ALLIANCE_DEFENCE)
+                                        SendUpdateWorldState(WS_TB_EAST_CAPTURE_POINT + i, 1);
+                                    else
+                                        SendUpdateWorldState(WS_TB_EAST_CAPTURE_POINT + i, 0);
+                                }
+                                for (int i = 0; i < MAX_CP_DIFF; i++)
+                                {
+                                    if (i == ALLIANCE_DEFENCE)
+                                        SendUpdateWorldState(WS_TB_WEST_CAPTURE_POINT + i, 1);
+                                    else
+                                        SendUpdateWorldState(WS_TB_WEST_CAPTURE_POINT + i, 0);
+                                }
+                                for (int i = 0; i < BUILDING_MAX_DIFF; i++)
+                                {
+                                    if (i == BUILDING_ALLIANCE_DEFENCE)
+                                        SendUpdateWorldState(WS_TB_EAST_SPIRE + i, 1);
+                                    else
+                                        SendUpdateWorldState(WS_TB_EAST_SPIRE + i, 0);
+                                }
+                                for (int i = 0; i < BUILDING_MAX_DIFF; i++)
+                                {
+                                    if (i == BUILDING_ALLIANCE_DEFENCE)
+                                        SendUpdateWorldState(WS_TB_SOUTH_SPIRE + i, 1);
+                                    else
+                                        SendUpdateWorldState(WS_TB_SOUTH_SPIRE + i, 0);
+                                }
+                                for (int i = 0; i < BUILDING_MAX_DIFF; i++)
+                                {
+                                    if (i == BUILDING_ALLIANCE_DEFENCE)
+                                        SendUpdateWorldState(WS_TB_WEST_SPIRE + i, 1);
+                                    else
+                                        SendUpdateWorldState(WS_TB_WEST_SPIRE + i, 0);
+                                }
+                                break;
 
-                        case TEAM_HORDE:
-                            for (int i = 0; i < MAX_CP_DIFF; i++)
-                            {
-                                if (i == HORDE_DEFENCE)
-                                    SendUpdateWorldState(WS_TB_SOUTH_CAPTURE_POINT + i, 1);
-                                else
-                                    SendUpdateWorldState(WS_TB_SOUTH_CAPTURE_POINT + i, 0);
-                            }
-                            for (int i = 0; i < MAX_CP_DIFF; i++)
-                            {
-                                if (i == HORDE_DEFENCE)
-                                    SendUpdateWorldState(WS_TB_EAST_CAPTURE_POINT + i, 1);
-                                else
-                                    SendUpdateWorldState(WS_TB_EAST_CAPTURE_POINT + i, 0);
-                            }
-                            for (int i = 0; i < MAX_CP_DIFF; i++)
-                            {
-                                if (i == HORDE_DEFENCE)
-                                    SendUpdateWorldState(WS_TB_WEST_CAPTURE_POINT + i, 1);
-                                else
-                                    SendUpdateWorldState(WS_TB_WEST_CAPTURE_POINT + i, 0);
-                            }
-                            for (int i = 0; i < BUILDING_MAX_DIFF; i++)
-                            {
-                                if (i == BUILDING_HORDE_DEFENCE)
-                                    SendUpdateWorldState(WS_TB_EAST_SPIRE + i, 1);
-                                else
-                                    SendUpdateWorldState(WS_TB_EAST_SPIRE + i, 0);
-                            }
-                            for (int i = 0; i < BUILDING_MAX_DIFF; i++)
-                            {
-                                if (i == BUILDING_HORDE_DEFENCE)
-                                    SendUpdateWorldState(WS_TB_SOUTH_SPIRE + i, 1);
-                                else
-                                    SendUpdateWorldState(WS_TB_SOUTH_SPIRE + i, 0);
-                            }
-                            for (int i = 0; i < BUILDING_MAX_DIFF; i++)
-                            {
-                                if (i == BUILDING_HORDE_DEFENCE)
-                                    SendUpdateWorldState(WS_TB_WEST_SPIRE + i, 1);
-                                else
-                                    SendUpdateWorldState(WS_TB_WEST_SPIRE + i, 0);
-                            }
-                            break;
+                            case TEAM_HORDE:
+                                for (int i = 0; i < MAX_CP_DIFF; i++)
+                                {
+                                    if (i == HORDE_DEFENCE)
+                                        SendUpdateWorldState(WS_TB_SOUTH_CAPTURE_POINT + i, 1);
+                                    else
+                                        SendUpdateWorldState(WS_TB_SOUTH_CAPTURE_POINT + i, 0);
+                                }
+                                for (int i = 0; i < MAX_CP_DIFF; i++)
+                                {
+                                    if (i == HORDE_DEFENCE)
+                                        SendUpdateWorldState(WS_TB_EAST_CAPTURE_POINT + i, 1);
+                                    else
+                                        SendUpdateWorldState(WS_TB_EAST_CAPTURE_POINT + i, 0);
+                                }
+                                for (int i = 0; i < MAX_CP_DIFF; i++)
+                                {
+                                    if (i == HORDE_DEFENCE)
+                                        SendUpdateWorldState(WS_TB_WEST_CAPTURE_POINT + i, 1);
+                                    else
+                                        SendUpdateWorldState(WS_TB_WEST_CAPTURE_POINT + i, 0);
+                                }
+                                for (int i = 0; i < BUILDING_MAX_DIFF; i++)
+                                {
+                                    if (i == BUILDING_HORDE_DEFENCE)
+                                        SendUpdateWorldState(WS_TB_EAST_SPIRE + i, 1);
+                                    else
+                                        SendUpdateWorldState(WS_TB_EAST_SPIRE + i, 0);
+                                }
+                                for (int i = 0; i < BUILDING_MAX_DIFF; i++)
+                                {
+                                    if (i == BUILDING_HORDE_DEFENCE)
+                                        SendUpdateWorldState(WS_TB_SOUTH_SPIRE + i, 1);
+                                    else
+                                        SendUpdateWorldState(WS_TB_SOUTH_SPIRE + i, 0);
+                                }
+                                for (int i = 0; i < BUILDING_MAX_DIFF; i++)
+                                {
+                                    if (i == BUILDING_HORDE_DEFENCE)
+                                        SendUpdateWorldState(WS_TB_WEST_SPIRE + i, 1);
+                                    else
+                                        SendUpdateWorldState(WS_TB_WEST_SPIRE + i, 0);
+                                }
+                                break;
+                        }
                     }
                 }
             }
@@ -53,9 +53,12 @@ void CalendarMgr::LoadFromDB()
     uint32 count = 0;
     _maxEventId = 0;
     _maxInviteId = 0;
+    std::set<uint64> eventIds;
+    std::set<uint64> inviteIds;
 
-    //                                                       0   1        2      3            4     5        6          7      8
-    if (QueryResult result = CharacterDatabase.Query("SELECT id, creator, title, description, type, dungeon, eventtime, flags, time2 FROM calendar_events"))
+    //                                                       0      1           2         3               4        5           6             7         8         9
+    if (QueryResult result = CharacterDatabase.Query("SELECT ce.id, ce.creator, ce.title, ce.description, ce.type, ce.dungeon, ce.eventtime, ce.flags, ce.time2, gm.guildid "
+        "FROM calendar_events ce LEFT JOIN guild_member gm ON gm.guid = ce.creator"))
         do
         {
             Field* fields = result->Fetch();
@@ -72,12 +75,13 @@ void CalendarMgr::LoadFromDB()
             uint32 guildId = 0;
 
             if (flags & CALENDAR_FLAG_GUILD_EVENT || flags & CALENDAR_FLAG_WITHOUT_INVITES)
-                guildId = Player::GetGuildIdFromDB(creatorGUID);
+                guildId = fields[9].GetUInt32();
 
             CalendarEvent* calendarEvent = new CalendarEvent(eventId, creatorGUID, guildId, type, dungeonId, time_t(eventTime), flags, time_t(timezoneTime), title, description);
             _events.insert(calendarEvent);
 
             _maxEventId = std::max(_maxEventId, eventId);
+            eventIds.insert(eventId);
 
             ++count;
         }
@@ -105,6 +109,7 @@ void CalendarMgr::LoadFromDB()
             _invites[eventId].push_back(invite);
 
             _maxInviteId = std::max(_maxInviteId, inviteId);
+            inviteIds.insert(inviteId);
 
             ++count;
         }
@@ -112,12 +117,13 @@ void CalendarMgr::LoadFromDB()
 
     sLog->outInfo(LOG_FILTER_SERVER_LOADING, ">> Loaded %u calendar invites", count);
 
+    // GetEvent and GetInvite walk all of them
     for (uint64 i = 1; i < _maxEventId; ++i)
-        if (!GetEvent(i))
+        if (eventIds.find(i) == eventIds.end())
             _freeEventIds.push_back(i);
 
     for (uint64 i = 1; i < _maxInviteId; ++i)
-        if (!GetInvite(i))
+        if (inviteIds.find(i) == inviteIds.end())
             _freeInviteIds.push_back(i);
 }
 
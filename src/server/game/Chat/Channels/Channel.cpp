@@ -199,10 +199,10 @@ void Channel::JoinChannel(Player* player, std::string const& pass)
         SendToAll(&data);
     }
 
-    PlayerInfo pinfo;
+    PlayerInfo& pinfo = playersStore[guid];
     pinfo.player = guid;
     pinfo.flags = MEMBER_FLAG_NONE;
-    playersStore[guid] = pinfo;
+    AddMember(player, pinfo);
 
     WorldPacket data;
     MakeYouJoined(&data);
@@ -251,7 +251,7 @@ void Channel::LeaveChannel(Player* player, bool send)
 
     bool changeowner = playersStore[guid].IsOwner();
 
-    playersStore.erase(guid);
+    RemoveMember(playersStore.find(guid));
     if (_announce && (!AccountMgr::IsGMAccount(player->GetSession()->GetSecurity()) ||
                        !sWorld->getBoolConfig(CONFIG_SILENTLY_GM_JOIN_TO_CHANNEL)))
     {
@@ -339,7 +339,7 @@ void Channel::KickOrBan(Player const* player, std::string const& badname, bool b
         SendToAll(&data);
     }
 
-    playersStore.erase(victim);
+    RemoveMember(playersStore.find(victim));
     bad->LeftChannel(this);
 
     if (changeowner && _ownership && !playersStore.empty())
@@ -549,11 +549,11 @@ void Channel::List(Player const* player)
     uint32 count  = 0;
     for (PlayerContainer::const_iterator i = playersStore.begin(); i != playersStore.end(); ++i)
     {
-        Player* member = ObjectAccessor::FindPlayer(i->first);
+        Player* member = i->second.member;
 
         // PLAYER can't see MODERATOR, GAME MASTER, ADMINISTRATOR characters
         // MODERATOR, GAME MASTER, ADMINISTRATOR can see all
-        if (member && (!AccountMgr::IsPlayerAccount(player->GetSession()->GetSecurity()) || member->GetSession()->GetSecurity() <= AccountTypes(gmLevelInWhoList)) &&
+        if (member && member->IsInWorld() && (!AccountMgr::IsPlayerAccount(player->GetSession()->GetSecurity()) || member->GetSession()->GetSecurity() <= AccountTypes(gmLevelInWhoList)) &&
             member->IsVisibleGloballyFor(player))
         {
             data << uint64(i->first);
@@ -633,7 +633,7 @@ void Channel::Say(uint64 guid, std::string const& what, uint32 lang)
     data << uint64(guid);
     data << uint32(what.size() + 1);
     data << what;
-    Player* player = ObjectAccessor::FindPlayer(guid);
+    Player* player = playersStore[guid].member;
     data << uint8(player ? player->GetChatTag() : 0);
 
     SendToAll(&data, !playersStore[guid].IsModerator() ? guid : false);
@@ -728,19 +728,112 @@ void Channel::SetOwner(uint64 guid, bool exclaim)
     }
 }
 
+void Channel::AddMember(Player* player, PlayerInfo& pinfo)
+{
+    pinfo.member = player;
+    if (!_freeSlots.empty())
+    {
+        pinfo.slot = _freeSlots.back();
+        _freeSlots.pop_back();
+        _members[pinfo.slot] = player;
+    }
+    else
+    {
+        pinfo.slot = _members.size();
+        _members.push_back(player);
+        if (_skipMask.size() * 32 < _members.size())
+            _skipMask.push_back(0);
+    }
+
+    LinkIgnores(pinfo);
+}
+
+void Channel::RemoveMember(PlayerContainer::iterator itr)
+{
+    PlayerInfo& pinfo = itr->second;
+    if (pinfo.slot != CHANNEL_NO_SLOT)
+    {
+        UnlinkIgnores(pinfo);
+        _members[pinfo.slot] = NULL;
+        _freeSlots.push_back(pinfo.slot);
+
+        // last member gone, a full channel does not keep its slots
+        if (_freeSlots.size() == _members.size())
+        {
+            _members.clear();
+            _freeSlots.clear();
+            _skipMask.clear();
+        }
+    }
+
+    playersStore.erase(itr);
+}
+
+void Channel::LinkIgnores(PlayerInfo& pinfo)
+{
+    if (PlayerSocial* social = pinfo.member->GetSocial())
+        social->GetIgnoredGuids(pinfo.ignores);
+
+    for (std::vector<uint32>::const_iterator itr = pinfo.ignores.begin(); itr != pinfo.ignores.end(); ++itr)
+        _ignoredBy[*itr].push_back(pinfo.slot);
+}
+
+void Channel::UnlinkIgnores(PlayerInfo& pinfo)
+{
+    for (std::vector<uint32>::const_iterator itr = pinfo.ignores.begin(); itr != pinfo.ignores.end(); ++itr)
+    {
+        IgnoreMap::iterator ignored = _ignoredBy.find(*itr);
+        if (ignored == _ignoredBy.end())
+            continue;
+
+        std::vector<uint32>& slots = ignored->second;
+        std::vector<uint32>::iterator slot = std::find(slots.begin(), slots.end(), pinfo.slot);
+        if (slot != slots.end())
+        {
+            *slot = slots.back();
+            slots.pop_back();
+        }
+
+        if (slots.empty())
+            _ignoredBy.erase(ignored);
+    }
+
+    pinfo.ignores.clear();
+}
+
+void Channel::UpdateIgnores(Player* player)
+{
+    PlayerContainer::iterator itr = playersStore.find(player->GetGUID());
+    if (itr == playersStore.end() || itr->second.slot == CHANNEL_NO_SLOT)
+        return;
+
+    UnlinkIgnores(itr->second);
+    LinkIgnores(itr->second);
+}
+
 void Channel::SendToAll(WorldPacket* data, uint64 guid)
 {
-    for (PlayerContainer::const_iterator i = playersStore.begin(); i != playersStore.end(); ++i)
-        if (Player* player = ObjectAccessor::FindPlayer(i->first))
-            if (!guid || !player->GetSocial()->HasIgnore(GUID_LOPART(guid)))
+    // the members ignoring the sender are masked out for this broadcast
+    IgnoreMap::const_iterator ignored = guid ? _ignoredBy.find(GUID_LOPART(guid)) : _ignoredBy.end();
+    if (ignored != _ignoredBy.end())
+        for (std::vector<uint32>::const_iterator itr = ignored->second.begin(); itr != ignored->second.end(); ++itr)
+            _skipMask[*itr >> 5] |= 1u << (*itr & 31);
+
+    for (uint32 slot = 0; slot < _members.size(); ++slot)
+        if (Player* player = _members[slot])
+            if (player->IsInWorld() && !(_skipMask[slot >> 5] & (1u << (slot & 31))))
                 player->GetSession()->SendPacket(data);
+
+    if (ignored != _ignoredBy.end())
+        for (std::vector<uint32>::const_iterator itr = ignored->second.begin(); itr != ignored->second.end(); ++itr)
+            _skipMask[*itr >> 5] &= ~(1u << (*itr & 31));
 }
 
 void Channel::SendToAllButOne(WorldPacket* data, uint64 who)
 {
-    for (PlayerContainer::const_iterator i = playersStore.begin(); i != playersStore.end(); ++i)
-        if (i->first != who)
-            if (Player* player = ObjectAccessor::FindPlayer(i->first))
+    for (std::vector<Player*>::const_iterator itr = _members.begin(); itr != _members.end(); ++itr)
+        if (Player* player = *itr)
+            if (player->IsInWorld() && player->GetGUID() != who)
                 player->GetSession()->SendPacket(data);
 }
 
@@ -30,6 +30,8 @@
 
 class Player;
 
+#define CHANNEL_NO_SLOT 0xFFFFFFFF
+
 enum ChatNotify
 {
     CHAT_JOINED_NOTICE                = 0x00,           //+ "%s joined channel.";
@@ -122,8 +124,13 @@ class Channel
 {
     struct PlayerInfo
     {
+        PlayerInfo() : player(0), flags(MEMBER_FLAG_NONE), member(NULL), slot(CHANNEL_NO_SLOT) { }
+
         uint64 player;
         uint8 flags;
+        Player* member;                                 // set while joined, members leave before they are deleted
+        uint32 slot;                                    // in _members
+        std::vector<uint32> ignores;                    // low guids this member is listed under in _ignoredBy
 
         bool HasFlag(uint8 flag) const { return flags & flag; }
         void SetFlag(uint8 flag) { if (!HasFlag(flag)) flags |= flag; }
@@ -184,6 +191,7 @@ class Channel
         void DeVoice(uint64 guid1, uint64 guid2);
         void JoinNotify(uint64 guid);                                           // invisible notify
         void LeaveNotify(uint64 guid);                                          // invisible notify
+        void UpdateIgnores(Player* player);                                     // the ignore list of a member changed
         void SetOwnership(bool ownership) { _ownership = ownership; };
         static void CleanOldChannelsInDB();
 
@@ -226,6 +234,13 @@ class Channel
         void MakeVoiceOn(WorldPacket* data, uint64 guid);                       //+ 0x22
         void MakeVoiceOff(WorldPacket* data, uint64 guid);                      //+ 0x23
 
+        typedef std::map<uint64, PlayerInfo> PlayerContainer;
+
+        void AddMember(Player* player, PlayerInfo& pinfo);
+        void RemoveMember(PlayerContainer::iterator itr);
+        void LinkIgnores(PlayerInfo& pinfo);
+        void UnlinkIgnores(PlayerInfo& pinfo);
+
         void SendToAll(WorldPacket* data, uint64 guid = 0);
         void SendToAllButOne(WorldPacket* data, uint64 who);
         void SendToOne(WorldPacket* data, uint64 who);
@@ -268,8 +283,8 @@ class Channel
             }
         }
 
-        typedef std::map<uint64, PlayerInfo> PlayerContainer;
         typedef std::set<uint64> BannedContainer;
+        typedef UNORDERED_MAP<uint32, std::vector<uint32> > IgnoreMap;          // slots of the members ignoring a low guid
 
         bool _announce;
         bool _ownership;
@@ -282,6 +297,12 @@ class Channel
         std::string _password;
         PlayerContainer playersStore;
         BannedContainer bannedStore;
+
+        // members by slot for the broadcasts, NULL for free slots
+        std::vector<Player*> _members;
+        std::vector<uint32> _freeSlots;
+        IgnoreMap _ignoredBy;
+        std::vector<uint32> _skipMask;                                          // bit per slot, only set during a broadcast
 };
 #endif
 
@@ -99,6 +99,8 @@ HostileReference::HostileReference(Unit* refUnit, ThreatManager* threatManager,
     iUnitGuid = refUnit->GetGUID();
     iOnline = true;
     iAccessible = true;
+    iHeapIndex = 0;
+    iSequence = 0;
 }
 
 //============================================================
@@ -260,6 +262,8 @@ void ThreatContainer::clearReferences()
     }
 
     iThreatList.clear();
+    iThreatHeap.clear();
+    iReferences.clear();
 }
 
 //============================================================
@@ -269,15 +273,106 @@ HostileReference* ThreatContainer::getReferenceByTarget(Unit* victim) const
     if (!victim)
         return NULL;
 
-    uint64 const guid = victim->GetGUID();
-    for (ThreatContainer::StorageType::const_iterator i = iThreatList.begin(); i != iThreatList.end(); ++i)
+    UNORDERED_MAP<uint64, HostileReference*>::const_iterator itr = iReferences.find(victim->GetGUID());
+    return itr != iReferences.end() ? itr->second : NULL;
+}
+
+//============================================================
+
+void ThreatContainer::addReference(HostileReference* hostileRef)
+{
+    if (contains(hostileRef))
+        return;
+
+    hostileRef->iListPosition = iThreatList.insert(iThreatList.end(), hostileRef);
+    hostileRef->iSequence = iSequence++;
+    hostileRef->iHeapIndex = iThreatHeap.size();
+    iThreatHeap.push_back(hostileRef);
+    siftUp(hostileRef->iHeapIndex);
+    iReferences[hostileRef->getUnitGuid()] = hostileRef;
+    iDirty = true;
+}
+
+//============================================================
+
+void ThreatContainer::remove(HostileReference* hostileRef)
+{
+    if (!contains(hostileRef))
+        return;
+
+    iThreatList.erase(hostileRef->iListPosition);
+    iReferences.erase(hostileRef->getUnitGuid());
+
+    // the last reference of the heap takes the free place and is moved to where it belongs
+    uint32 index = hostileRef->iHeapIndex;
+    HostileReference* last = iThreatHeap.back();
+    iThreatHeap.pop_back();
+    if (last != hostileRef)
+    {
+        iThreatHeap[index] = last;
+        last->iHeapIndex = index;
+        siftUp(index);
+        siftDown(last->iHeapIndex);
+    }
+}
+
+//============================================================
+
+void ThreatContainer::threatChanged(HostileReference* hostileRef)
+{
+    if (!contains(hostileRef))
+        return;
+
+    siftUp(hostileRef->iHeapIndex);
+    siftDown(hostileRef->iHeapIndex);
+    iDirty = true;
+}
+
+//============================================================
+
+void ThreatContainer::siftUp(uint32 index)
+{
+    HostileReference* ref = iThreatHeap[index];
+    while (index > 0)
+    {
+        uint32 parent = (index - 1) / 2;
+        if (!isHigherThreat(ref, iThreatHeap[parent]))
+            break;
+
+        iThreatHeap[index] = iThreatHeap[parent];
+        iThreatHeap[index]->iHeapIndex = index;
+        index = parent;
+    }
+
+    iThreatHeap[index] = ref;
+    ref->iHeapIndex = index;
+}
+
+//============================================================
+
+void ThreatContainer::siftDown(uint32 index)
+{
+    HostileReference* ref = iThreatHeap[index];
+    uint32 size = iThreatHeap.size();
+    while (true)
     {
-        HostileReference* ref = (*i);
-        if (ref && ref->getUnitGuid() == guid)
-            return ref;
+        uint32 child = 2 * index + 1;
+        if (child >= size)
+            break;
+
+        if (child + 1 < size && isHigherThreat(iThreatHeap[child + 1], iThreatHeap[child]))
+            ++child;
+
+        if (!isHigherThreat(iThreatHeap[child], ref))
+            break;
+
+        iThreatHeap[index] = iThreatHeap[child];
+        iThreatHeap[index]->iHeapIndex = index;
+        index = child;
     }
 
-    return NULL;
+    iThreatHeap[index] = ref;
+    ref->iHeapIndex = index;
 }
 
 //============================================================
@@ -302,14 +397,64 @@ void ThreatContainer::modifyThreatPercent(Unit* victim, int32 percent)
 //============================================================
 // Check if the list is dirty and sort if necessary
 
-void ThreatContainer::update()
+void ThreatContainer::update() const
 {
     if (iDirty && iThreatList.size() > 1)
-        iThreatList.sort(Trinity::ThreatOrderPred());
+        iThreatList.sort(isHigherThreat);
 
     iDirty = false;
 }
 
+//============================================================
+// Visits the references of a threat heap by decreasing threat without changing it,
+// only the part of the heap that is actually visited gets ordered
+
+class ThreatHeapWalker
+{
+    public:
+        explicit ThreatHeapWalker(ThreatContainer::HeapType const& heap) : _heap(heap) { reset(); }
+
+        void reset()
+        {
+            _frontier.clear();
+            if (!_heap.empty())
+                _frontier.push_back(0);
+        }
+
+        HostileReference* next()
+        {
+            if (_frontier.empty())
+                return NULL;
+
+            std::pop_heap(_frontier.begin(), _frontier.end(), IndexOrder(_heap));
+            uint32 index = _frontier.back();
+            _frontier.pop_back();
+
+            for (uint32 child = 2 * index + 1; child <= 2 * index + 2 && child < _heap.size(); ++child)
+            {
+                _frontier.push_back(child);
+                std::push_heap(_frontier.begin(), _frontier.end(), IndexOrder(_heap));
+            }
+
+            return _heap[index];
+        }
+
+        // true if the reference returned by the last next() was the last one
+        bool isLast() const { return _frontier.empty(); }
+
+    private:
+        // orders _frontier as a max-heap of heap positions
+        struct IndexOrder
+        {
+            explicit IndexOrder(ThreatContainer::HeapType const& heap) : Heap(heap) { }
+            bool operator()(uint32 a, uint32 b) const { return ThreatContainer::isHigherThreat(Heap[b], Heap[a]); }
+            ThreatContainer::HeapType const& Heap;
+        };
+
+        ThreatContainer::HeapType const& _heap;
+        std::vector<uint32> _frontier;
+};
+
 //============================================================
 // return the next best victim
 // could be the current victim
@@ -320,32 +465,27 @@ HostileReference* ThreatContainer::selectNextVictim(Creature* attacker, HostileR
     bool found = false;
     bool noPriorityTargetFound = false;
 
-    ThreatContainer::StorageType::const_iterator lastRef = iThreatList.end();
-    --lastRef;
-
-    for (ThreatContainer::StorageType::const_iterator iter = iThreatList.begin(); iter != iThreatList.end() && !found;)
+    ThreatHeapWalker walker(iThreatHeap);
+    while (!found && (currentRef = walker.next()))
     {
-        currentRef = (*iter);
-
         Unit* target = currentRef->getTarget();
         ASSERT(target);                                     // if the ref has status online the target must be there !
 
         // some units are prefered in comparison to others
         if (target && attacker && target->IsInWorld() && attacker->IsInWorld() && target->isAlive() && attacker->isAlive() && !noPriorityTargetFound && (target->IsImmunedToDamage(attacker->GetMeleeDamageSchoolMask()) || target->HasNegativeAuraWithInterruptFlag(AURA_INTERRUPT_FLAG_TAKE_DAMAGE)))
         {
-            if (iter != lastRef)
+            if (!walker.isLast())
             {
                 // current victim is a second choice target, so don't compare threat with it below
                 if (currentRef == currentVictim)
                     currentVictim = NULL;
-                ++iter;
                 continue;
             }
             else
             {
                 // if we reached to this point, everyone in the threatlist is a second choice target. In such a situation the target with the highest threat should be attacked.
                 noPriorityTargetFound = true;
-                iter = iThreatList.begin();
+                walker.reset();
                 continue;
             }
         }
@@ -378,7 +518,6 @@ HostileReference* ThreatContainer::selectNextVictim(Creature* attacker, HostileR
                 break;
             }
         }
-        ++iter;
     }
     if (!found)
         currentRef = NULL;
@@ -461,7 +600,6 @@ void ThreatManager::modifyThreatPercent(Unit* victim, int32 percent)
 
 Unit* ThreatManager::getHostilTarget()
 {
-    iThreatContainer.update();
     HostileReference* nextVictim = iThreatContainer.selectNextVictim(getOwner()->ToCreature(), getCurrentVictim());
     setCurrentVictim(nextVictim);
     return getCurrentVictim() != NULL ? getCurrentVictim()->getTarget() : NULL;
@@ -525,9 +663,10 @@ void ThreatManager::processThreatEvent(ThreatRefStatusChangeEvent* threatRefStat
     switch (threatRefStatusChangeEvent->getType())
     {
         case UEV_THREAT_REF_THREAT_CHANGE:
-            if ((getCurrentVictim() == hostilRef && threatRefStatusChangeEvent->getFValue()<0.0f) ||
-                (getCurrentVictim() != hostilRef && threatRefStatusChangeEvent->getFValue()>0.0f))
-                setDirty(true);                             // the order in the threat list might have changed
+            if (hostilRef->isOnline())
+                iThreatContainer.threatChanged(hostilRef);
+            else
+                iThreatOfflineContainer.threatChanged(hostilRef);
             break;
         case UEV_THREAT_REF_ONLINE_STATUS:
             if (!hostilRef->isOnline())
@@ -545,8 +684,8 @@ void ThreatManager::processThreatEvent(ThreatRefStatusChangeEvent* threatRefStat
             {
                 if (getCurrentVictim() && hostilRef->getThreat() > (1.1f * getCurrentVictim()->getThreat()))
                     setDirty(true);
-                iThreatContainer.addReference(hostilRef);
                 iThreatOfflineContainer.remove(hostilRef);
+                iThreatContainer.addReference(hostilRef);
             }
             break;
         case UEV_THREAT_REF_REMOVE_FROM_LIST:
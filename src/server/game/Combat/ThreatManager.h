@@ -25,6 +25,7 @@
 #include "UnitEvents.h"
 
 #include <list>
+#include <vector>
 
 //==============================================================
 
@@ -125,6 +126,8 @@ class HostileReference : public Reference<Unit, ThreatManager>
         // Tell our refFrom (source) object, that the link is cut (Target destroyed)
         void sourceObjectDestroyLink();
     private:
+        friend class ThreatContainer;
+
         // Inform the source, that the status of that reference was changed
         void fireStatusChanged(ThreatRefStatusChangeEvent& threatRefStatusChangeEvent);
 
@@ -135,19 +138,27 @@ class HostileReference : public Reference<Unit, ThreatManager>
         uint64 iUnitGuid;
         bool iOnline;
         bool iAccessible;
+
+        // Position in the ThreatContainer holding the reference, kept up to date by the container
+        uint32 iHeapIndex;
+        uint32 iSequence;                                   // insertion order, breaks ties between equal threats
+        std::list<HostileReference*>::iterator iListPosition;
 };
 
 //==============================================================
 class ThreatManager;
 
+// The references are kept in a max-heap ordered by threat, so the most hated reference is known at any time
+// and a threat change costs O(log n). The list sorted by threat that scripts walk is only sorted when asked for.
 class ThreatContainer
 {
         friend class ThreatManager;
 
     public:
         typedef std::list<HostileReference*> StorageType;
+        typedef std::vector<HostileReference*> HeapType;
 
-        ThreatContainer(): iDirty(false) { }
+        ThreatContainer(): iDirty(false), iSequence(0) { }
 
         ~ThreatContainer() { clearReferences(); }
 
@@ -163,36 +174,50 @@ class ThreatContainer
 
         bool empty() const
         {
-            return iThreatList.empty();
+            return iThreatHeap.empty();
         }
 
         HostileReference* getMostHated() const
         {
-            return iThreatList.empty() ? NULL : iThreatList.front();
+            return iThreatHeap.empty() ? NULL : iThreatHeap.front();
         }
 
         HostileReference* getReferenceByTarget(Unit* victim) const;
 
-        StorageType const & getThreatList() const { return iThreatList; }
+        StorageType const & getThreatList() const { update(); return iThreatList; }
 
-    private:
-        void remove(HostileReference* hostileRef)
+        // true if a comes before b in the threat order
+        static bool isHigherThreat(HostileReference const* a, HostileReference const* b)
         {
-            iThreatList.remove(hostileRef);
+            return a->getThreat() > b->getThreat() || (a->getThreat() == b->getThreat() && a->iSequence < b->iSequence);
         }
 
-        void addReference(HostileReference* hostileRef)
+    private:
+        bool contains(HostileReference* hostileRef) const
         {
-            iThreatList.push_back(hostileRef);
+            return hostileRef->iHeapIndex < iThreatHeap.size() && iThreatHeap[hostileRef->iHeapIndex] == hostileRef;
         }
 
+        void remove(HostileReference* hostileRef);
+
+        void addReference(HostileReference* hostileRef);
+
+        // Restore the heap order after the threat of the reference changed
+        void threatChanged(HostileReference* hostileRef);
+
         void clearReferences();
 
         // Sort the list if necessary
-        void update();
+        void update() const;
+
+        void siftUp(uint32 index);
+        void siftDown(uint32 index);
 
-        StorageType iThreatList;
-        bool iDirty;
+        mutable StorageType iThreatList;
+        HeapType iThreatHeap;
+        UNORDERED_MAP<uint64, HostileReference*> iReferences;
+        mutable bool iDirty;
+        uint32 iSequence;
 };
 
 //=================================================
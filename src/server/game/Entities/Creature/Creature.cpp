@@ -202,6 +202,7 @@ void Creature::RemoveFromWorld()
             m_zoneScript->OnCreatureRemove(this);
         if (m_formation)
             sFormationMgr->RemoveCreatureFromGroup(m_formation, this);
+        m_deathTimer.Cancel();
         Unit::RemoveFromWorld();
         sObjectAccessor->RemoveObject(this);
     }
@@ -487,6 +488,10 @@ bool Creature::UpdateEntry(uint32 Entry, uint32 team, const CreatureData* data)
 
 void Creature::Update(uint32 diff)
 {
+    // nothing to do for a dead creature before its respawn time
+    if (m_deathState == DEAD && m_deathTimer.IsPending(GetMap()->GetTimers(), m_respawnTime))
+        return;
+
     if (IsAIEnabled && TriggerJustRespawned)
     {
         TriggerJustRespawned = false;
@@ -604,7 +609,7 @@ void Creature::Update(uint32 diff)
                 }
                 else m_groupLootTimer -= diff;
             }
-            else if (m_corpseRemoveTime <= time(NULL))
+            else if (!m_deathTimer.IsPending(GetMap()->GetTimers(), m_corpseRemoveTime) && m_corpseRemoveTime <= time(NULL))
             {
                 RemoveCorpse(false);
                 sLog->outDebug(LOG_FILTER_UNITS, "Removing corpse... %u ", GetUInt32Value(OBJECT_FIELD_ENTRY));
@@ -26,6 +26,8 @@
 #include "LootMgr.h"
 #include "DatabaseEnv.h"
 #include "Cell.h"
+#include "ObjectPool.h"
+#include "TimerWheel.h"
 
 #include <list>
 
@@ -492,6 +494,9 @@ class Creature : public Unit, public GridObject<Creature>, public MapCreature
         explicit Creature(bool isWorldObject = false);
         virtual ~Creature();
 
+        static void* operator new(size_t size) { return ObjectPool<Creature>::Allocate(size); }
+        static void operator delete(void* ptr, size_t size) { ObjectPool<Creature>::Deallocate(ptr, size); }
+
         void AddToWorld();
         void RemoveFromWorld();
 
@@ -795,6 +800,7 @@ class Creature : public Unit, public GridObject<Creature>, public MapCreature
         /// Timers
         time_t m_corpseRemoveTime;                          // (msecs)timer for death or corpse disappearance
         time_t m_respawnTime;                               // (secs) time of next respawn
+        DeadlineTimer m_deathTimer;                         // wakes the corpse removal or respawn check of Update() up
         uint32 m_respawnDelay;                              // (secs) delay between corpse disappearance and respawning
         uint32 m_corpseDelay;                               // (secs) delay between death and corpse disappearance
         float m_respawnradius;
@@ -26,7 +26,7 @@
 
 TempSummon::TempSummon(SummonPropertiesEntry const* properties, Unit* owner, bool isWorldObject) :
 Creature(isWorldObject), m_Properties(properties), m_type(TEMPSUMMON_MANUAL_DESPAWN),
-m_timer(0), m_lifetime(0)
+m_timer(0), m_lifetime(0), m_despawnTimer(*this)
 {
     m_summonerGUID = owner ? owner->GetGUID() : 0;
     m_unitTypeMask |= UNIT_MASK_SUMMON;
@@ -52,13 +52,9 @@ void TempSummon::Update(uint32 diff)
             break;
         case TEMPSUMMON_TIMED_DESPAWN:
         {
-            if (m_timer <= diff)
-            {
-                UnSummon();
-                return;
-            }
-
-            m_timer -= diff;
+            // unsummoned by m_despawnTimer, started again here after a type change or a map change
+            if (!m_despawnTimer.IsScheduled())
+                GetMap()->GetTimers().Schedule(&m_despawnTimer, m_timer);
             break;
         }
         case TEMPSUMMON_TIMED_DESPAWN_OUT_OF_COMBAT:
@@ -176,6 +172,9 @@ void TempSummon::InitStats(uint32 duration)
     if (m_type == TEMPSUMMON_MANUAL_DESPAWN)
         m_type = (duration == 0) ? TEMPSUMMON_DEAD_DESPAWN : TEMPSUMMON_TIMED_DESPAWN;
 
+    if (m_type == TEMPSUMMON_TIMED_DESPAWN)
+        GetMap()->GetTimers().Schedule(&m_despawnTimer, m_timer);
+
     Unit* owner = GetSummoner();
 
     if (owner && isTrigger() && m_spells[0])
@@ -225,6 +224,34 @@ void TempSummon::InitSummon()
 void TempSummon::SetTempSummonType(TempSummonType type)
 {
     m_type = type;
+
+    if (m_type != TEMPSUMMON_TIMED_DESPAWN)
+        StopDespawnTimer();
+}
+
+uint32 TempSummon::GetTimer() const
+{
+    if (!m_despawnTimer.IsScheduled())
+        return m_timer;
+
+    uint64 now = m_despawnTimer.GetWheel()->GetTime();
+    return m_despawnTimer.GetExpiry() > now ? uint32(m_despawnTimer.GetExpiry() - now) : 0;
+}
+
+// keeps the remaining lifetime in m_timer
+void TempSummon::StopDespawnTimer()
+{
+    if (!m_despawnTimer.IsScheduled())
+        return;
+
+    m_timer = GetTimer();
+    m_despawnTimer.Cancel();
+}
+
+void TempSummonDespawnTimer::OnExpire()
+{
+    if (m_owner.IsInWorld())
+        m_owner.UnSummon();
 }
 
 void TempSummon::UnSummon(uint32 msTime)
@@ -289,6 +316,7 @@ void TempSummon::RemoveFromWorld()
     //if (GetOwnerGUID())
     //    sLog->outError(LOG_FILTER_UNITS, "Unit %u has owner guid when removed from world", GetEntry());
 
+    StopDespawnTimer();
     Creature::RemoveFromWorld();
 }
 
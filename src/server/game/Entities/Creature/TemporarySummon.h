@@ -37,6 +37,19 @@ struct TempSummonData
     uint32 time;         ///< Despawn time, usable only with certain temp summon types
 };
 
+class TempSummon;
+
+// Unsummons a TEMPSUMMON_TIMED_DESPAWN summon at the end of its lifetime, also outside of the updated cells
+class TempSummonDespawnTimer : public TimerWheelEntry
+{
+    public:
+        explicit TempSummonDespawnTimer(TempSummon& owner) : m_owner(owner) { }
+        void OnExpire();
+
+    private:
+        TempSummon& m_owner;
+};
+
 class TempSummon : public Creature
 {
     public:
@@ -52,13 +65,16 @@ class TempSummon : public Creature
         Unit* GetSummoner() const;
         uint64 GetSummonerGUID() const { return m_summonerGUID; }
         TempSummonType const& GetSummonType() { return m_type; }
-        uint32 GetTimer() { return m_timer; }
+        uint32 GetTimer() const;
 
         const SummonPropertiesEntry* const m_Properties;
     private:
+        void StopDespawnTimer();
+
         TempSummonType m_type;
         uint32 m_timer;
         uint32 m_lifetime;
+        TempSummonDespawnTimer m_despawnTimer;
         uint64 m_summonerGUID;
 };
 
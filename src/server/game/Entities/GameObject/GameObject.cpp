@@ -159,6 +159,7 @@ void GameObject::RemoveFromWorld()
         if (m_model)
             if (GetMap()->ContainsGameObjectModel(*m_model))
                 GetMap()->RemoveGameObjectModel(*m_model);
+        m_respawnTimer.Cancel();
         WorldObject::RemoveFromWorld();
         sObjectAccessor->RemoveObject(this);
     }
@@ -367,7 +368,7 @@ void GameObject::Update(uint32 diff)
         }
         case GO_READY:
         {
-            if (m_respawnTime > 0)                          // timer on
+            if (m_respawnTime > 0 && !m_respawnTimer.IsPending(GetMap()->GetTimers(), m_respawnTime)) // timer on and expired
             {
                 time_t now = time(NULL);
                 if (m_respawnTime <= now)            // timer expired
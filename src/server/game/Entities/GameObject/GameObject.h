@@ -25,6 +25,8 @@
 #include "Object.h"
 #include "LootMgr.h"
 #include "DatabaseEnv.h"
+#include "ObjectPool.h"
+#include "TimerWheel.h"
 
 class GameObjectAI;
 
@@ -642,6 +644,9 @@ class GameObject : public WorldObject, public GridObject<GameObject>
         explicit GameObject();
         ~GameObject();
 
+        static void* operator new(size_t size) { return ObjectPool<GameObject>::Allocate(size); }
+        static void operator delete(void* ptr, size_t size) { ObjectPool<GameObject>::Deallocate(ptr, size); }
+
         void AddToWorld();
         void RemoveFromWorld();
         void CleanupsBeforeDelete(bool finalCleanup = true);
@@ -848,6 +853,7 @@ class GameObject : public WorldObject, public GridObject<GameObject>
         bool AIM_Initialize();
         uint32      m_spellId;
         time_t      m_respawnTime;                          // (secs) time of next respawn (or despawn if GO have owner()),
+        DeadlineTimer m_respawnTimer;                       // wakes the respawn check of Update() up
         uint32      m_respawnDelayTime;                     // (secs) if 0 then current GO state no dependent from timer
         LootState   m_lootState;
         bool        m_spawnedByDefault;
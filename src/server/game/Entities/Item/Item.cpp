@@ -258,6 +258,7 @@ Item::Item()
     m_refundRecipient = 0;
     m_paidMoney = 0;
     m_paidExtendedCost = 0;
+    m_updateMap = NULL;
 }
 
 bool Item::Create(uint32 guidlow, uint32 itemid, Player const* owner)
@@ -1087,9 +1088,30 @@ void Item::BuildUpdate(UpdateDataMapType& data_map)
 {
     if (Player* owner = GetOwner())
         BuildFieldsUpdate(owner, data_map);
+    m_updateMap = NULL;
     ClearUpdateMask(false);
 }
 
+// Items are sent by the map of their owner, also while the owner is being removed from the world
+bool Item::AddToObjectUpdate()
+{
+    Player* owner = ObjectAccessor::GetObjectInOrOutOfWorld(GetOwnerGUID(), (Player*)NULL);
+    if (!owner || !owner->FindMap())
+        return false;
+
+    m_updateMap = owner->GetMap();
+    m_updateMap->AddUpdateObject(this);
+    return true;
+}
+
+// Only called while queued, the owner's current map may not be the one the item was queued on
+void Item::RemoveFromObjectUpdate()
+{
+    if (m_updateMap)
+        m_updateMap->RemoveUpdateObject(this);
+    m_updateMap = NULL;
+}
+
 void Item::SaveRefundDataToDB()
 {
     SQLTransaction trans = CharacterDatabase.BeginTransaction();
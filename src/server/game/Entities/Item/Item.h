@@ -28,6 +28,7 @@
 class SpellInfo;
 class Bag;
 class Unit;
+class Map;
 
 struct ItemSetEffect
 {
@@ -356,6 +357,8 @@ class Item : public Object
         bool CheckSoulboundTradeExpire();
 
         void BuildUpdate(UpdateDataMapType&);
+        bool AddToObjectUpdate();
+        void RemoveFromObjectUpdate();
 
         uint32 GetScriptId() const { return GetTemplate()->ScriptId; }
 
@@ -388,5 +391,6 @@ class Item : public Object
         uint32 m_paidMoney;
         uint32 m_paidExtendedCost;
         AllowedLooterSet allowedGUIDs;
+        Map* m_updateMap;                                   // map whose update set holds the item, the owner may have left it since
 };
 #endif
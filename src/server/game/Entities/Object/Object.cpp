@@ -93,6 +93,10 @@ Object::Object() : m_PackGUID(sizeof(uint64)+1)
 
 WorldObject::~WorldObject()
 {
+    // grid references unlink themselves on delete
+    if (m_spatialIndex)
+        m_spatialIndex->Remove(this);
+
     // this may happen because there are many !create/delete
     if (IsWorldObject() && m_currMap)
     {
@@ -121,7 +125,6 @@ Object::~Object()
     {
         sLog->outFatal(LOG_FILTER_GENERAL, "Object::~Object - guid=%lu, typeid=%d, entry=%u deleted but still in update list!!", GetGUID(), GetTypeId(), GetEntry());
         ASSERT(false);
-        sObjectAccessor->RemoveUpdateObject(this);
     }
 
     delete [] m_uint32Values;
@@ -299,6 +302,59 @@ void Object::BuildValuesUpdateBlockForPlayer(UpdateData* data, Player* target) c
     data->AddUpdateBlock(buf);
 }
 
+void Object::BuildValuesUpdateBlockForPlayer(UpdateData* data, Player* target, ValuesUpdateCache& cache) const
+{
+    uint32* flags = NULL;
+    uint32 visibleFlag = GetUpdateFieldData(target, flags);
+
+    ValuesUpdateCache::Block* block = cache.Find(visibleFlag);
+    if (!block)
+    {
+        // First observer of this visibility class, serialize the block and remember where the per player fields are
+        block = cache.Add(visibleFlag);
+        ByteBuffer& buf = block->Data;
+
+        buf << uint8(UPDATETYPE_VALUES);
+        buf.append(GetPackGUID());
+
+        UpdateMask updateMask;
+        uint32 valCount = m_valuesCount;
+        if (GetTypeId() == TYPEID_PLAYER && target != this)
+            valCount = PLAYER_END_NOT_SELF;
+
+        updateMask.SetCount(valCount);
+
+        _SetUpdateBits(&updateMask, target);
+        _BuildValuesUpdate(UPDATETYPE_VALUES, &buf, &updateMask, target, &block->TargetFields);
+
+        data->AddUpdateBlock(buf);
+        ++cache.Serialized;
+        return;
+    }
+
+    ++cache.Reused;
+    if (block->TargetFields.empty())
+    {
+        data->AddUpdateBlock(block->Data);
+        return;
+    }
+
+    bool isActivateToQuest = false;
+    if (isType(TYPEMASK_GAMEOBJECT) && !ToGameObject()->IsTransport())
+        isActivateToQuest = ToGameObject()->ActivateToQuest(target) || target->isGameMaster();
+
+    ByteBuffer buf(block->Data);
+    for (ValuesUpdateCache::FieldPositions::const_iterator itr = block->TargetFields.begin(); itr != block->TargetFields.end(); ++itr)
+    {
+        if (isType(TYPEMASK_UNIT))
+            buf.put<uint32>(itr->second, _GetUnitFieldValueFor(itr->first, target));
+        else
+            buf.put<uint32>(itr->second, _GetGameObjectFieldValueFor(itr->first, target, isActivateToQuest));
+    }
+
+    data->AddUpdateBlock(buf);
+}
+
 void Object::BuildOutOfRangeUpdateBlock(UpdateData* data) const
 {
     data->AddOutOfRangeGUID(GetGUID());
@@ -656,7 +712,7 @@ void Object::_BuildMovementUpdate(ByteBuffer* data, uint16 flags) const
         *data << uint32(getMSTime());                       // Unknown - getMSTime is wrong.
 }
 
-void Object::_BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, UpdateMask* updateMask, Player* target) const
+void Object::_BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, UpdateMask* updateMask, Player* target, ValuesUpdateCache::FieldPositions* targetFields) const
 {
     if (!target)
         return;
@@ -710,6 +766,11 @@ void Object::_BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, UpdateMask*
     *data << (uint8)updateMask->GetBlockCount();
     updateMask->AppendToPacket(data);
 
+    _AppendValues(data, updateMask, valCount, target, IsActivateToQuest, targetFields);
+}
+
+void Object::_AppendValues(ByteBuffer* data, UpdateMask* updateMask, uint32 valCount, Player* target, bool isActivateToQuest, ValuesUpdateCache::FieldPositions* targetFields) const
+{
     // 2 specialized loops for speed optimization in non-unit case
     if (isType(TYPEMASK_UNIT))                               // unit (creature/player) case
     {
@@ -717,240 +778,270 @@ void Object::_BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, UpdateMask*
         {
             if (updateMask->GetBit(index))
             {
-                if (index == UNIT_NPC_FLAGS)
-                {
-                    // remove custom flag before sending
-                    uint32 appendValue = m_uint32Values[index];
+                if (targetFields && _IsTargetDependentField(index))
+                    targetFields->push_back(std::make_pair(index, data->wpos()));
 
-                    if (GetTypeId() == TYPEID_UNIT)
-                    {
-                        if (!target->canSeeSpellClickOn(this->ToCreature()))
-                            appendValue &= ~UNIT_NPC_FLAG_SPELLCLICK;
+                *data << _GetUnitFieldValueFor(index, target);
+            }
+        }
+    }
+    else if (isType(TYPEMASK_GAMEOBJECT))                    // gameobject case
+    {
+        for (uint16 index = 0; index < valCount; ++index)
+        {
+            if (updateMask->GetBit(index))
+            {
+                if (targetFields && _IsTargetDependentField(index))
+                    targetFields->push_back(std::make_pair(index, data->wpos()));
+
+                *data << _GetGameObjectFieldValueFor(index, target, isActivateToQuest);
+            }
+        }
+    }
+    else                                                    // other objects case (no special index checks)
+    {
+        for (uint16 index = 0; index < valCount; ++index)
+        {
+            if (updateMask->GetBit(index))
+            {
+                // send in current format (float as float, uint32 as uint32)
+                *data << m_uint32Values[index];
+            }
+        }
+    }
+}
 
-                        if (appendValue & UNIT_NPC_FLAG_TRAINER)
+bool Object::_IsTargetDependentField(uint16 index) const
+{
+    if (isType(TYPEMASK_UNIT))
+    {
+        switch (index)
+        {
+            case UNIT_NPC_FLAGS:
+            case UNIT_FIELD_AURASTATE:
+            case UNIT_FIELD_FLAGS:
+            case UNIT_FIELD_DISPLAYID:
+            case UNIT_DYNAMIC_FLAGS:
+            case UNIT_FIELD_BYTES_2:
+            case UNIT_FIELD_FACTIONTEMPLATE:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    if (isType(TYPEMASK_GAMEOBJECT))
+        return index == GAMEOBJECT_DYNAMIC || index == GAMEOBJECT_FLAGS;
+
+    return false;
+}
+
+uint32 Object::_GetUnitFieldValueFor(uint16 index, Player* target) const
+{
+    if (index == UNIT_NPC_FLAGS)
+    {
+        // remove custom flag before sending
+        uint32 appendValue = m_uint32Values[index];
+
+        if (GetTypeId() == TYPEID_UNIT)
+        {
+            if (!target->canSeeSpellClickOn(this->ToCreature()))
+                appendValue &= ~UNIT_NPC_FLAG_SPELLCLICK;
+
+            if (appendValue & UNIT_NPC_FLAG_TRAINER)
+            {
+                if (!this->ToCreature()->isCanTrainingOf(target, false))
+                    appendValue &= ~(UNIT_NPC_FLAG_TRAINER | UNIT_NPC_FLAG_TRAINER_CLASS | UNIT_NPC_FLAG_TRAINER_PROFESSION);
+            }
+        }
+
+        return appendValue;
+    }
+    else if (index == UNIT_FIELD_AURASTATE)
+    {
+        // Check per caster aura states to not enable using a pell in client if specified aura is not by target
+        return ((Unit*)this)->BuildAuraStateUpdateForTarget(target);
+    }
+    // FIXME: Some values at server stored in float format but must be sent to client in uint32 format
+    else if (index >= UNIT_FIELD_BASEATTACKTIME && index <= UNIT_FIELD_RANGEDATTACKTIME)
+    {
+        // convert from float to uint32 and send
+        return uint32(m_floatValues[index] < 0 ? 0 : m_floatValues[index]);
+    }
+    // there are some float values which may be negative or can't get negative due to other checks
+    else if ((index >= UNIT_FIELD_NEGSTAT0   && index <= UNIT_FIELD_NEGSTAT4) ||
+        (index >= UNIT_FIELD_RESISTANCEBUFFMODSPOSITIVE  && index <= (UNIT_FIELD_RESISTANCEBUFFMODSPOSITIVE + 6)) ||
+        (index >= UNIT_FIELD_RESISTANCEBUFFMODSNEGATIVE  && index <= (UNIT_FIELD_RESISTANCEBUFFMODSNEGATIVE + 6)) ||
+        (index >= UNIT_FIELD_POSSTAT0   && index <= UNIT_FIELD_POSSTAT4))
+    {
+        return uint32(m_floatValues[index]);
+    }
+    // Gamemasters should be always able to select units - remove not selectable flag
+    else if (index == UNIT_FIELD_FLAGS)
+    {
+        if (target->isGameMaster())
+            return m_uint32Values[index] & ~UNIT_FLAG_NOT_SELECTABLE;
+
+        return m_uint32Values[index];
+    }
+    // use modelid_a if not gm, _h if gm for CREATURE_FLAG_EXTRA_TRIGGER creatures
+    else if (index == UNIT_FIELD_DISPLAYID)
+    {
+        if (GetTypeId() == TYPEID_UNIT)
+        {
+            CreatureTemplate const* cinfo = ToCreature()->GetCreatureTemplate();
+
+            // this also applies for transform auras
+            if (SpellInfo const* transform = sSpellMgr->GetSpellInfo(ToUnit()->getTransForm()))
+                for (uint8 i = 0; i < MAX_SPELL_EFFECTS; ++i)
+                    if (transform->Effects[i].IsAura(SPELL_AURA_TRANSFORM))
+                        if (CreatureTemplate const* transformInfo = sObjectMgr->GetCreatureTemplate(transform->Effects[i].MiscValue))
                         {
-                            if (!this->ToCreature()->isCanTrainingOf(target, false))
-                                appendValue &= ~(UNIT_NPC_FLAG_TRAINER | UNIT_NPC_FLAG_TRAINER_CLASS | UNIT_NPC_FLAG_TRAINER_PROFESSION);
+                            cinfo = transformInfo;
+                            break;
                         }
-                    }
 
-                    *data << uint32(appendValue);
-                }
-                else if (index == UNIT_FIELD_AURASTATE)
-                {
-                    // Check per caster aura states to not enable using a pell in client if specified aura is not by target
-                    *data << ((Unit*)this)->BuildAuraStateUpdateForTarget(target);
-                }
-                // FIXME: Some values at server stored in float format but must be sent to client in uint32 format
-                else if (index >= UNIT_FIELD_BASEATTACKTIME && index <= UNIT_FIELD_RANGEDATTACKTIME)
-                {
-                    // convert from float to uint32 and send
-                    *data << uint32(m_floatValues[index] < 0 ? 0 : m_floatValues[index]);
-                }
-                // there are some float values which may be negative or can't get negative due to other checks
-                else if ((index >= UNIT_FIELD_NEGSTAT0   && index <= UNIT_FIELD_NEGSTAT4) ||
-                    (index >= UNIT_FIELD_RESISTANCEBUFFMODSPOSITIVE  && index <= (UNIT_FIELD_RESISTANCEBUFFMODSPOSITIVE + 6)) ||
-                    (index >= UNIT_FIELD_RESISTANCEBUFFMODSNEGATIVE  && index <= (UNIT_FIELD_RESISTANCEBUFFMODSNEGATIVE + 6)) ||
-                    (index >= UNIT_FIELD_POSSTAT0   && index <= UNIT_FIELD_POSSTAT4))
-                {
-                    *data << uint32(m_floatValues[index]);
-                }
-                // Gamemasters should be always able to select units - remove not selectable flag
-                else if (index == UNIT_FIELD_FLAGS)
-                {
-                    if (target->isGameMaster())
-                        *data << (m_uint32Values[index] & ~UNIT_FLAG_NOT_SELECTABLE);
-                    else
-                        *data << m_uint32Values[index];
-                }
-                // use modelid_a if not gm, _h if gm for CREATURE_FLAG_EXTRA_TRIGGER creatures
-                else if (index == UNIT_FIELD_DISPLAYID)
+            if (cinfo->flags_extra & CREATURE_FLAG_EXTRA_TRIGGER)
+            {
+                if (target->isGameMaster())
                 {
-                    if (GetTypeId() == TYPEID_UNIT)
-                    {
-                        CreatureTemplate const* cinfo = ToCreature()->GetCreatureTemplate();
-
-                        // this also applies for transform auras
-                        if (SpellInfo const* transform = sSpellMgr->GetSpellInfo(ToUnit()->getTransForm()))
-                            for (uint8 i = 0; i < MAX_SPELL_EFFECTS; ++i)
-                                if (transform->Effects[i].IsAura(SPELL_AURA_TRANSFORM))
-                                    if (CreatureTemplate const* transformInfo = sObjectMgr->GetCreatureTemplate(transform->Effects[i].MiscValue))
-                                    {
-                                        cinfo = transformInfo;
-                                        break;
-                                    }
-
-                        if (cinfo->flags_extra & CREATURE_FLAG_EXTRA_TRIGGER)
-                        {
-                            if (target->isGameMaster())
-                            {
-                                if (cinfo->Modelid1)
-                                    *data << cinfo->Modelid1;//Modelid1 is a visible model for gms
-                                else
-                                    *data << 17519; // world invisible trigger's model
-                            }
-                            else
-                            {
-                                if (cinfo->Modelid2)
-                                    *data << cinfo->Modelid2;//Modelid2 is an invisible model for players
-                                else
-                                    *data << 11686; // world invisible trigger's model
-                            }
-                        }
-                        else
-                            *data << m_uint32Values[index];
-                    }
-                    else
-                        *data << m_uint32Values[index];
+                    if (cinfo->Modelid1)
+                        return cinfo->Modelid1;//Modelid1 is a visible model for gms
+
+                    return 17519; // world invisible trigger's model
                 }
-                // hide lootable animation for unallowed players
-                else if (index == UNIT_DYNAMIC_FLAGS)
+                else
                 {
-                    uint32 dynamicFlags = m_uint32Values[index];
+                    if (cinfo->Modelid2)
+                        return cinfo->Modelid2;//Modelid2 is an invisible model for players
 
-                    if (Creature const* creature = ToCreature())
-                    {
-                        if (creature->hasLootRecipient())
-                        {
-                            if (creature->isTappedBy(target))
-                            {
-                                dynamicFlags |= (UNIT_DYNFLAG_TAPPED | UNIT_DYNFLAG_TAPPED_BY_PLAYER);
-                            }
-                            else
-                            {
-                                dynamicFlags |= UNIT_DYNFLAG_TAPPED;
-                                dynamicFlags &= ~UNIT_DYNFLAG_TAPPED_BY_PLAYER;
-                            }
-                        }
-                        else
-                        {
-                            dynamicFlags &= ~UNIT_DYNFLAG_TAPPED;
-                            dynamicFlags &= ~UNIT_DYNFLAG_TAPPED_BY_PLAYER;
-                        }
+                    return 11686; // world invisible trigger's model
+                }
+            }
+        }
 
-                        if (!target->isAllowedToLoot(creature))
-                            dynamicFlags &= ~UNIT_DYNFLAG_LOOTABLE;
-                    }
+        return m_uint32Values[index];
+    }
+    // hide lootable animation for unallowed players
+    else if (index == UNIT_DYNAMIC_FLAGS)
+    {
+        uint32 dynamicFlags = m_uint32Values[index];
 
-                    // unit UNIT_DYNFLAG_TRACK_UNIT should only be sent to caster of SPELL_AURA_MOD_STALKED auras
-                    if (Unit const* unit = ToUnit())
-                        if (dynamicFlags & UNIT_DYNFLAG_TRACK_UNIT)
-                            if (!unit->HasAuraTypeWithCaster(SPELL_AURA_MOD_STALKED, target->GetGUID()))
-                                dynamicFlags &= ~UNIT_DYNFLAG_TRACK_UNIT;
-                    *data << dynamicFlags;
-                }
-                // FG: pretend that OTHER players in own group are friendly ("blue")
-                else if (index == UNIT_FIELD_BYTES_2 || index == UNIT_FIELD_FACTIONTEMPLATE)
+        if (Creature const* creature = ToCreature())
+        {
+            if (creature->hasLootRecipient())
+            {
+                if (creature->isTappedBy(target))
                 {
-                    Unit const* unit = ToUnit();
-                    if (unit->IsControlledByPlayer() && target != this && sWorld->getBoolConfig(CONFIG_ALLOW_TWO_SIDE_INTERACTION_GROUP) && unit->IsInRaidWith(target))
-                    {
-                        FactionTemplateEntry const* ft1 = unit->getFactionTemplateEntry();
-                        FactionTemplateEntry const* ft2 = target->getFactionTemplateEntry();
-                        if (ft1 && ft2 && !ft1->IsFriendlyTo(*ft2))
-                        {
-                            if (index == UNIT_FIELD_BYTES_2)
-                            {
-                                // Allow targetting opposite faction in party when enabled in config
-                                *data << (m_uint32Values[index] & ((UNIT_BYTE2_FLAG_SANCTUARY /*| UNIT_BYTE2_FLAG_AURAS | UNIT_BYTE2_FLAG_UNK5*/) << 8)); // this flag is at uint8 offset 1 !!
-                            }
-                            else
-                            {
-                                // pretend that all other HOSTILE players have own faction, to allow follow, heal, rezz (trade wont work)
-                                uint32 faction = target->getFaction();
-                                *data << uint32(faction);
-                            }
-                        }
-                        else
-                            *data << m_uint32Values[index];
-                    }
-                    else
-                        *data << m_uint32Values[index];
+                    dynamicFlags |= (UNIT_DYNFLAG_TAPPED | UNIT_DYNFLAG_TAPPED_BY_PLAYER);
                 }
                 else
                 {
-                    // send in current format (float as float, uint32 as uint32)
-                    *data << m_uint32Values[index];
+                    dynamicFlags |= UNIT_DYNFLAG_TAPPED;
+                    dynamicFlags &= ~UNIT_DYNFLAG_TAPPED_BY_PLAYER;
                 }
             }
+            else
+            {
+                dynamicFlags &= ~UNIT_DYNFLAG_TAPPED;
+                dynamicFlags &= ~UNIT_DYNFLAG_TAPPED_BY_PLAYER;
+            }
+
+            if (!target->isAllowedToLoot(creature))
+                dynamicFlags &= ~UNIT_DYNFLAG_LOOTABLE;
         }
+
+        // unit UNIT_DYNFLAG_TRACK_UNIT should only be sent to caster of SPELL_AURA_MOD_STALKED auras
+        if (Unit const* unit = ToUnit())
+            if (dynamicFlags & UNIT_DYNFLAG_TRACK_UNIT)
+                if (!unit->HasAuraTypeWithCaster(SPELL_AURA_MOD_STALKED, target->GetGUID()))
+                    dynamicFlags &= ~UNIT_DYNFLAG_TRACK_UNIT;
+
+        return dynamicFlags;
     }
-    else if (isType(TYPEMASK_GAMEOBJECT))                    // gameobject case
+    // FG: pretend that OTHER players in own group are friendly ("blue")
+    else if (index == UNIT_FIELD_BYTES_2 || index == UNIT_FIELD_FACTIONTEMPLATE)
     {
-        for (uint16 index = 0; index < valCount; ++index)
+        Unit const* unit = ToUnit();
+        if (unit->IsControlledByPlayer() && target != this && sWorld->getBoolConfig(CONFIG_ALLOW_TWO_SIDE_INTERACTION_GROUP) && unit->IsInRaidWith(target))
         {
-            if (updateMask->GetBit(index))
+            FactionTemplateEntry const* ft1 = unit->getFactionTemplateEntry();
+            FactionTemplateEntry const* ft2 = target->getFactionTemplateEntry();
+            if (ft1 && ft2 && !ft1->IsFriendlyTo(*ft2))
             {
-                // send in current format (float as float, uint32 as uint32)
-                if (index == GAMEOBJECT_DYNAMIC)
+                if (index == UNIT_FIELD_BYTES_2)
                 {
-                    if (IsActivateToQuest)
-                    {
-                        switch (ToGameObject()->GetGoType())
-                        {
-                            case GAMEOBJECT_TYPE_QUESTGIVER:
-                                *data << uint16(GO_DYNFLAG_LO_ACTIVATE);
-                                break;
-                            case GAMEOBJECT_TYPE_CHEST:
-                                if (target->isGameMaster())
-                                    *data << uint16(GO_DYNFLAG_LO_ACTIVATE);
-                                else
-                                    *data << uint16(GO_DYNFLAG_LO_ACTIVATE | GO_DYNFLAG_LO_SPARKLE);
-                                break;
-                            case GAMEOBJECT_TYPE_GENERIC:
-                                if (target->isGameMaster())
-                                    *data << uint16(0);
-                                else
-                                    *data << uint16(GO_DYNFLAG_LO_SPARKLE);
-                                break;
-                            case GAMEOBJECT_TYPE_GOOBER:
-                                if (target->isGameMaster())
-                                    *data << uint16(GO_DYNFLAG_LO_ACTIVATE);
-                                else
-                                    *data << uint16(GO_DYNFLAG_LO_ACTIVATE | GO_DYNFLAG_LO_SPARKLE);
-                                break;
-                            default:
-                                *data << uint16(0); // unknown, not happen.
-                                break;
-                        }
-                    }
-                    else
-                        *data << uint16(0);         // disable quest object
-
-                    *data << uint16(-1);
+                    // Allow targetting opposite faction in party when enabled in config
+                    return m_uint32Values[index] & ((UNIT_BYTE2_FLAG_SANCTUARY /*| UNIT_BYTE2_FLAG_AURAS | UNIT_BYTE2_FLAG_UNK5*/) << 8); // this flag is at uint8 offset 1 !!
                 }
-                else if (index == GAMEOBJECT_FLAGS)
-                {
-                    uint32 flags = m_uint32Values[index];
-                    if (ToGameObject()->GetGoType() == GAMEOBJECT_TYPE_CHEST)
-                        if (ToGameObject()->GetGOInfo()->chest.groupLootRules && !ToGameObject()->IsLootAllowedFor(target))
-                            flags |= GO_FLAG_LOCKED | GO_FLAG_NOT_SELECTABLE;
 
-                    *data << flags;
-                }
-                else if (index == GAMEOBJECT_BYTES_1)
-                {
-                    if (((GameObject*)this)->GetGOInfo()->type == GAMEOBJECT_TYPE_TRANSPORT)
-                        *data << uint32(m_uint32Values[index] | GO_STATE_TRANSPORT_SPEC);
-                    else
-                        *data << uint32(m_uint32Values[index]);
-                }
-                else
-                    *data << m_uint32Values[index];                // other cases
+                // pretend that all other HOSTILE players have own faction, to allow follow, heal, rezz (trade wont work)
+                return target->getFaction();
             }
         }
+
+        return m_uint32Values[index];
     }
-    else                                                    // other objects case (no special index checks)
+
+    // send in current format (float as float, uint32 as uint32)
+    return m_uint32Values[index];
+}
+
+uint32 Object::_GetGameObjectFieldValueFor(uint16 index, Player* target, bool isActivateToQuest) const
+{
+    // send in current format (float as float, uint32 as uint32)
+    if (index == GAMEOBJECT_DYNAMIC)
     {
-        for (uint16 index = 0; index < valCount; ++index)
+        // low half: dynamic flags for this player, high half: always -1
+        uint16 dynFlags = 0;                                // disable quest object
+        if (isActivateToQuest)
         {
-            if (updateMask->GetBit(index))
+            switch (ToGameObject()->GetGoType())
             {
-                // send in current format (float as float, uint32 as uint32)
-                *data << m_uint32Values[index];
+                case GAMEOBJECT_TYPE_QUESTGIVER:
+                    dynFlags = GO_DYNFLAG_LO_ACTIVATE;
+                    break;
+                case GAMEOBJECT_TYPE_CHEST:
+                    if (target->isGameMaster())
+                        dynFlags = GO_DYNFLAG_LO_ACTIVATE;
+                    else
+                        dynFlags = GO_DYNFLAG_LO_ACTIVATE | GO_DYNFLAG_LO_SPARKLE;
+                    break;
+                case GAMEOBJECT_TYPE_GENERIC:
+                    if (!target->isGameMaster())
+                        dynFlags = GO_DYNFLAG_LO_SPARKLE;
+                    break;
+                case GAMEOBJECT_TYPE_GOOBER:
+                    if (target->isGameMaster())
+                        dynFlags = GO_DYNFLAG_LO_ACTIVATE;
+                    else
+                        dynFlags = GO_DYNFLAG_LO_ACTIVATE | GO_DYNFLAG_LO_SPARKLE;
+                    break;
+                default:
+                    break;                                  // unknown, not happen.
             }
         }
+
+        return MAKE_PAIR32(dynFlags, uint16(-1));
     }
+    else if (index == GAMEOBJECT_FLAGS)
+    {
+        uint32 flags = m_uint32Values[index];
+        if (ToGameObject()->GetGoType() == GAMEOBJECT_TYPE_CHEST)
+            if (ToGameObject()->GetGOInfo()->chest.groupLootRules && !ToGameObject()->IsLootAllowedFor(target))
+                flags |= GO_FLAG_LOCKED | GO_FLAG_NOT_SELECTABLE;
+
+        return flags;
+    }
+    else if (index == GAMEOBJECT_BYTES_1)
+    {
+        if (((GameObject*)this)->GetGOInfo()->type == GAMEOBJECT_TYPE_TRANSPORT)
+            return uint32(m_uint32Values[index] | GO_STATE_TRANSPORT_SPEC);
+
+        return uint32(m_uint32Values[index]);
+    }
+
+    return m_uint32Values[index];                // other cases
 }
 
 void Object::ClearUpdateMask(bool remove)
@@ -960,12 +1051,12 @@ void Object::ClearUpdateMask(bool remove)
     if (m_objectUpdated)
     {
         if (remove)
-            sObjectAccessor->RemoveUpdateObject(this);
+            RemoveFromObjectUpdate();
         m_objectUpdated = false;
     }
 }
 
-void Object::BuildFieldsUpdate(Player* player, UpdateDataMapType& data_map) const
+void Object::BuildFieldsUpdate(Player* player, UpdateDataMapType& data_map, ValuesUpdateCache* cache) const
 {
     UpdateDataMapType::iterator iter = data_map.find(player);
 
@@ -976,7 +1067,10 @@ void Object::BuildFieldsUpdate(Player* player, UpdateDataMapType& data_map) cons
         iter = p.first;
     }
 
-    BuildValuesUpdateBlockForPlayer(&iter->second, iter->first);
+    if (cache)
+        BuildValuesUpdateBlockForPlayer(&iter->second, iter->first, *cache);
+    else
+        BuildValuesUpdateBlockForPlayer(&iter->second, iter->first);
 }
 
 uint32 Object::GetUpdateFieldData(Player const* target, uint32*& flags) const
@@ -1085,11 +1179,7 @@ void Object::SetInt32Value(uint16 index, int32 value)
         m_int32Values[index] = value;
         _changesMask.SetBit(index);
 
-        if (m_inWorld && !m_objectUpdated)
-        {
-            sObjectAccessor->AddUpdateObject(this);
-            m_objectUpdated = true;
-        }
+        AddToObjectUpdateIfNeeded();
     }
 }
 
@@ -1102,11 +1192,7 @@ void Object::SetUInt32Value(uint16 index, uint32 value)
         m_uint32Values[index] = value;
         _changesMask.SetBit(index);
 
-        if (m_inWorld && !m_objectUpdated)
-        {
-            sObjectAccessor->AddUpdateObject(this);
-            m_objectUpdated = true;
-        }
+        AddToObjectUpdateIfNeeded();
     }
 }
 
@@ -1128,11 +1214,7 @@ void Object::SetUInt64Value(uint16 index, uint64 value)
         _changesMask.SetBit(index);
         _changesMask.SetBit(index + 1);
 
-        if (m_inWorld && !m_objectUpdated)
-        {
-            sObjectAccessor->AddUpdateObject(this);
-            m_objectUpdated = true;
-        }
+        AddToObjectUpdateIfNeeded();
     }
 }
 
@@ -1146,11 +1228,7 @@ bool Object::AddUInt64Value(uint16 index, uint64 value)
         _changesMask.SetBit(index);
         _changesMask.SetBit(index + 1);
 
-        if (m_inWorld && !m_objectUpdated)
-        {
-            sObjectAccessor->AddUpdateObject(this);
-            m_objectUpdated = true;
-        }
+        AddToObjectUpdateIfNeeded();
 
         return true;
     }
@@ -1168,11 +1246,7 @@ bool Object::RemoveUInt64Value(uint16 index, uint64 value)
         _changesMask.SetBit(index);
         _changesMask.SetBit(index + 1);
 
-        if (m_inWorld && !m_objectUpdated)
-        {
-            sObjectAccessor->AddUpdateObject(this);
-            m_objectUpdated = true;
-        }
+        AddToObjectUpdateIfNeeded();
 
         return true;
     }
@@ -1189,11 +1263,12 @@ void Object::SetFloatValue(uint16 index, float value)
         m_floatValues[index] = value;
         _changesMask.SetBit(index);
 
-        if (m_inWorld && !m_objectUpdated)
-        {
-            sObjectAccessor->AddUpdateObject(this);
-            m_objectUpdated = true;
-        }
+        // the object size, searches of the spatial index reach as far as the largest one
+        if (index == UNIT_FIELD_COMBATREACH)
+            if (Unit* unit = ToUnit())
+                unit->UpdateSpatialIndexObjectSize();
+
+        AddToObjectUpdateIfNeeded();
     }
 }
 
@@ -1213,11 +1288,7 @@ void Object::SetByteValue(uint16 index, uint8 offset, uint8 value)
         m_uint32Values[index] |= uint32(uint32(value) << (offset * 8));
         _changesMask.SetBit(index);
 
-        if (m_inWorld && !m_objectUpdated)
-        {
-            sObjectAccessor->AddUpdateObject(this);
-            m_objectUpdated = true;
-        }
+        AddToObjectUpdateIfNeeded();
     }
 }
 
@@ -1237,11 +1308,7 @@ void Object::SetUInt16Value(uint16 index, uint8 offset, uint16 value)
         m_uint32Values[index] |= uint32(uint32(value) << (offset * 16));
         _changesMask.SetBit(index);
 
-        if (m_inWorld && !m_objectUpdated)
-        {
-            sObjectAccessor->AddUpdateObject(this);
-            m_objectUpdated = true;
-        }
+        AddToObjectUpdateIfNeeded();
     }
 }
 
@@ -1304,11 +1371,7 @@ void Object::SetFlag(uint16 index, uint32 newFlag)
         m_uint32Values[index] = newval;
         _changesMask.SetBit(index);
 
-        if (m_inWorld && !m_objectUpdated)
-        {
-            sObjectAccessor->AddUpdateObject(this);
-            m_objectUpdated = true;
-        }
+        AddToObjectUpdateIfNeeded();
     }
 }
 
@@ -1325,11 +1388,7 @@ void Object::RemoveFlag(uint16 index, uint32 oldFlag)
         m_uint32Values[index] = newval;
         _changesMask.SetBit(index);
 
-        if (m_inWorld && !m_objectUpdated)
-        {
-            sObjectAccessor->AddUpdateObject(this);
-            m_objectUpdated = true;
-        }
+        AddToObjectUpdateIfNeeded();
     }
 }
 
@@ -1348,11 +1407,7 @@ void Object::SetByteFlag(uint16 index, uint8 offset, uint8 newFlag)
         m_uint32Values[index] |= uint32(uint32(newFlag) << (offset * 8));
         _changesMask.SetBit(index);
 
-        if (m_inWorld && !m_objectUpdated)
-        {
-            sObjectAccessor->AddUpdateObject(this);
-            m_objectUpdated = true;
-        }
+        AddToObjectUpdateIfNeeded();
     }
 }
 
@@ -1371,11 +1426,7 @@ void Object::RemoveByteFlag(uint16 index, uint8 offset, uint8 oldFlag)
         m_uint32Values[index] &= ~uint32(uint32(oldFlag) << (offset * 8));
         _changesMask.SetBit(index);
 
-        if (m_inWorld && !m_objectUpdated)
-        {
-            sObjectAccessor->AddUpdateObject(this);
-            m_objectUpdated = true;
-        }
+        AddToObjectUpdateIfNeeded();
     }
 }
 
@@ -1424,7 +1475,7 @@ void MovementInfo::OutDebug()
 
 WorldObject::WorldObject(bool isWorldObject): WorldLocation(),
 m_name(""), m_isActive(false), m_isWorldObject(isWorldObject), m_zoneScript(NULL),
-m_transport(NULL), m_currMap(NULL), m_InstanceId(0),
+m_transport(NULL), m_currMap(NULL), m_spatialIndex(NULL), m_spatialKey(0), m_spatialSlot(0), m_spatialContainer(0), m_InstanceId(0),
 m_phaseMask(PHASEMASK_NORMAL), m_notifyflags(0), m_executed_notifies(0)
 {
     m_serverSideVisibility.SetValue(SERVERSIDE_VISIBILITY_GHOST, GHOST_VISIBILITY_ALIVE | GHOST_VISIBILITY_GHOST);
@@ -1439,6 +1490,30 @@ void WorldObject::SetWorldObject(bool on)
     GetMap()->AddObjectToSwitchList(this, on);
 }
 
+void WorldObject::AddToSpatialIndex()
+{
+    if (Map* map = FindMap())
+        if (SpatialHashIndex* index = map->GetSpatialIndex())
+            index->Insert(this, IsWorldObject());
+}
+
+void WorldObject::RemoveFromSpatialIndex()
+{
+    if (m_spatialIndex)
+        m_spatialIndex->Remove(this);
+}
+
+void WorldObject::RelocateInSpatialIndex()
+{
+    m_spatialIndex->Relocate(this);
+}
+
+void WorldObject::UpdateSpatialIndexObjectSize()
+{
+    if (m_spatialIndex)
+        m_spatialIndex->UpdateMaxObjectSize(this);
+}
+
 bool WorldObject::IsWorldObject() const
 {
     if (m_isWorldObject)
@@ -2083,14 +2158,16 @@ void WorldObject::SendPlaySound(uint32 Sound, bool OnlySelf)
         SendMessageToSet(&data, true); // ToSelf ignored in this case
 }
 
+void Object::AddToObjectUpdateIfNeeded()
+{
+    if (m_inWorld && !m_objectUpdated)
+        m_objectUpdated = AddToObjectUpdate();
+}
+
 void Object::ForceValuesUpdateAtIndex(uint32 i)
 {
     _changesMask.SetBit(i);
-    if (m_inWorld && !m_objectUpdated)
-    {
-        sObjectAccessor->AddUpdateObject(this);
-        m_objectUpdated = true;
-    }
+    AddToObjectUpdateIfNeeded();
 }
 
 namespace Trinity
@@ -2933,6 +3010,8 @@ void WorldObject::MovePositionToFirstCollision(Position &pos, float dist, float
 void WorldObject::SetPhaseMask(uint32 newPhaseMask, bool update)
 {
     m_phaseMask = newPhaseMask;
+    if (m_spatialIndex)
+        m_spatialIndex->UpdatePhaseMask(this);
 
     if (update && IsInWorld())
         UpdateObjectVisibility();
@@ -3025,6 +3104,7 @@ struct WorldObjectChangeAccumulator
     UpdateDataMapType& i_updateDatas;
     WorldObject& i_object;
     std::set<uint64> plr_list;
+    ValuesUpdateCache i_cache;
     WorldObjectChangeAccumulator(WorldObject &obj, UpdateDataMapType &d) : i_updateDatas(d), i_object(obj) {}
     void Visit(PlayerMapType &m)
     {
@@ -3082,7 +3162,7 @@ struct WorldObjectChangeAccumulator
         // Only send update once to a player
         if (plr_list.find(player->GetGUID()) == plr_list.end() && player->HaveAtClient(&i_object))
         {
-            i_object.BuildFieldsUpdate(player, i_updateDatas);
+            i_object.BuildFieldsUpdate(player, i_updateDatas, &i_cache);
             plr_list.insert(player->GetGUID());
         }
     }
@@ -3104,6 +3184,17 @@ void WorldObject::BuildUpdate(UpdateDataMapType& data_map)
     ClearUpdateMask(false);
 }
 
+bool WorldObject::AddToObjectUpdate()
+{
+    GetMap()->AddUpdateObject(this);
+    return true;
+}
+
+void WorldObject::RemoveFromObjectUpdate()
+{
+    GetMap()->RemoveUpdateObject(this);
+}
+
 uint64 WorldObject::GetTransGUID() const
 {
     if (GetTransport())
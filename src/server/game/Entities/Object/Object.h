@@ -116,10 +116,48 @@ class CreatureAI;
 class ZoneScript;
 class Unit;
 class Transport;
+class SpatialHashIndex;
 class WorldObject;
 
 typedef UNORDERED_MAP<Player*, UpdateData> UpdateDataMapType;
 
+//! Values update blocks of one object, serialized once per visibility class (the UF_FLAG_* an observer gets)
+//! and reused for every other observer of the same class during one update. The few fields whose value
+//! depends on the observer itself (aura state, tapping, quest activation...) are patched in per player.
+struct ValuesUpdateCache
+{
+    typedef std::vector<std::pair<uint16, size_t> > FieldPositions;   // field index, position in Data
+
+    struct Block
+    {
+        uint32 VisibleFlag;
+        ByteBuffer Data;
+        FieldPositions TargetFields;
+    };
+
+    ValuesUpdateCache() : Serialized(0), Reused(0) { }
+
+    Block* Find(uint32 visibleFlag)
+    {
+        // a handful of classes at most, a linear search is the fastest
+        for (std::list<Block>::iterator itr = Blocks.begin(); itr != Blocks.end(); ++itr)
+            if (itr->VisibleFlag == visibleFlag)
+                return &*itr;
+        return NULL;
+    }
+
+    Block* Add(uint32 visibleFlag)
+    {
+        Blocks.push_back(Block());
+        Blocks.back().VisibleFlag = visibleFlag;
+        return &Blocks.back();
+    }
+
+    std::list<Block> Blocks;
+    uint32 Serialized;
+    uint32 Reused;
+};
+
 //! Structure to ease conversions from single 64 bit integer guid into individual bytes, for packet sending purposes
 //! Nuke this out when porting ObjectGuid from MaNGOS, but preserve the per-byte storage
 struct ObjectGuid
@@ -204,6 +242,7 @@ class Object
         void SendUpdateToPlayer(Player* player);
 
         void BuildValuesUpdateBlockForPlayer(UpdateData* data, Player* target) const;
+        void BuildValuesUpdateBlockForPlayer(UpdateData* data, Player* target, ValuesUpdateCache& cache) const;
         void BuildOutOfRangeUpdateBlock(UpdateData* data) const;
 
         virtual void DestroyForPlayer(Player* target, bool onDeath = false) const;
@@ -349,13 +388,14 @@ class Object
         }
 
         void ClearUpdateMask(bool remove);
+        void AddToObjectUpdateIfNeeded();
 
         uint16 GetValuesCount() const { return m_valuesCount; }
 
         virtual bool hasQuest(uint32 /* quest_id */) const { return false; }
         virtual bool hasInvolvedQuest(uint32 /* quest_id */) const { return false; }
         virtual void BuildUpdate(UpdateDataMapType&) {}
-        void BuildFieldsUpdate(Player*, UpdateDataMapType &) const;
+        void BuildFieldsUpdate(Player*, UpdateDataMapType &, ValuesUpdateCache* cache = NULL) const;
 
         void SetFieldNotifyFlag(uint16 flag) { _fieldNotifyFlags |= flag; }
         void RemoveFieldNotifyFlag(uint16 flag) { _fieldNotifyFlags &= ~flag; }
@@ -391,10 +431,18 @@ class Object
 
         uint32 GetUpdateFieldData(Player const* target, uint32*& flags) const;
 
+        // Queues the object in the update list of the map that sends its values updates, false if there is none
+        virtual bool AddToObjectUpdate() = 0;
+        virtual void RemoveFromObjectUpdate() = 0;
+
         void _SetUpdateBits(UpdateMask* updateMask, Player* target) const;
         void _SetCreateBits(UpdateMask* updateMask, Player* target) const;
         void _BuildMovementUpdate(ByteBuffer * data, uint16 flags) const;
-        void _BuildValuesUpdate(uint8 updatetype, ByteBuffer *data, UpdateMask* updateMask, Player* target) const;
+        void _BuildValuesUpdate(uint8 updatetype, ByteBuffer *data, UpdateMask* updateMask, Player* target, ValuesUpdateCache::FieldPositions* targetFields = NULL) const;
+        void _AppendValues(ByteBuffer* data, UpdateMask* updateMask, uint32 valCount, Player* target, bool isActivateToQuest, ValuesUpdateCache::FieldPositions* targetFields) const;
+        bool _IsTargetDependentField(uint16 index) const;
+        uint32 _GetUnitFieldValueFor(uint16 index, Player* target) const;
+        uint32 _GetGameObjectFieldValueFor(uint16 index, Player* target, bool isActivateToQuest) const;
 
         uint16 m_objectType;
 
@@ -514,8 +562,8 @@ class GridObject
 {
     public:
         bool IsInGrid() const { return _gridRef.isValid(); }
-        void AddToGrid(GridRefManager<T>& m) { ASSERT(!IsInGrid()); _gridRef.link(&m, (T*)this); }
-        void RemoveFromGrid() { ASSERT(IsInGrid()); _gridRef.unlink(); }
+        void AddToGrid(GridRefManager<T>& m) { ASSERT(!IsInGrid()); _gridRef.link(&m, (T*)this); ((T*)this)->AddToSpatialIndex(); }
+        void RemoveFromGrid() { ASSERT(IsInGrid()); _gridRef.unlink(); ((T*)this)->RemoveFromSpatialIndex(); }
     private:
         GridReference<T> _gridRef;
 };
@@ -582,6 +630,13 @@ class WorldObject : public Object, public WorldLocation
         void GetRandomPoint(Position const &srcPos, float distance, float &rand_x, float &rand_y, float &rand_z) const;
         Position GetRandomPoint(Position const &srcPos, float distance) const;
 
+        // hide the Position setters, every move of a world object must refresh its spatial index bucket
+        void Relocate(float x, float y) { Position::Relocate(x, y); UpdateSpatialIndex(); }
+        void Relocate(float x, float y, float z) { Position::Relocate(x, y, z); UpdateSpatialIndex(); }
+        void Relocate(float x, float y, float z, float orientation) { Position::Relocate(x, y, z, orientation); UpdateSpatialIndex(); }
+        void Relocate(Position const &pos) { Position::Relocate(pos); UpdateSpatialIndex(); }
+        void Relocate(Position const* pos) { Position::Relocate(pos); UpdateSpatialIndex(); }
+
         uint32 GetInstanceId() const { return m_InstanceId; }
 
         virtual void SetPhaseMask(uint32 newPhaseMask, bool update);
@@ -755,6 +810,8 @@ class WorldObject : public Object, public WorldLocation
         void DestroyForNearbyPlayers();
         virtual void UpdateObjectVisibility(bool forced = true);
         void BuildUpdate(UpdateDataMapType&);
+        bool AddToObjectUpdate();
+        void RemoveFromObjectUpdate();
 
         //relocation and visibility system functions
         void AddToNotify(uint16 f) { m_notifyflags |= f;}
@@ -774,6 +831,12 @@ class WorldObject : public Object, public WorldLocation
         template<class NOTIFIER> void VisitNearbyGridObject(float const& radius, NOTIFIER& notifier) const { if (IsInWorld()) GetMap()->VisitGrid(GetPositionX(), GetPositionY(), radius, notifier); }
         template<class NOTIFIER> void VisitNearbyWorldObject(float const& radius, NOTIFIER& notifier) const { if (IsInWorld()) GetMap()->VisitWorld(GetPositionX(), GetPositionY(), radius, notifier); }
 
+        // kept in sync with the grid link, see GridObject
+        void AddToSpatialIndex();
+        void RemoveFromSpatialIndex();
+        void UpdateSpatialIndex() { if (m_spatialIndex) RelocateInSpatialIndex(); }
+        void UpdateSpatialIndexObjectSize();        // after the combat reach changed
+
 #ifdef MAP_BASED_RAND_GEN
         int32 irand(int32 min, int32 max) const     { return int32 (GetMap()->mtRand.randInt(max - min)) + min; }
         uint32 urand(uint32 min, uint32 max) const  { return GetMap()->mtRand.randInt(max - min) + min;}
@@ -818,8 +881,15 @@ class WorldObject : public Object, public WorldLocation
         //difference from IsAlwaysVisibleFor: 1. after distance check; 2. use owner or charmer as seer
         virtual bool IsAlwaysDetectableFor(WorldObject const* /*seer*/) const { return false; }
     private:
+        friend class SpatialHashIndex;
+
         Map* m_currMap;                                    //current object's Map location
 
+        SpatialHashIndex* m_spatialIndex;                   // index of m_currMap we are bucketed in, if any
+        uint32 m_spatialKey;
+        uint32 m_spatialSlot;
+        uint8 m_spatialContainer;
+
         //uint32 m_mapId;                                     // object at map with map_id
         uint32 m_InstanceId;                                // in map copy with instance id
         uint32 m_phaseMask;                                 // in area phase state
@@ -829,6 +899,8 @@ class WorldObject : public Object, public WorldLocation
 
         virtual bool _IsWithinDist(WorldObject const* obj, float dist2compare, bool is3D) const;
 
+        void RelocateInSpatialIndex();
+
         bool CanNeverSee(WorldObject const* obj) const { return GetMap() != obj->GetMap() || !InSamePhase(obj); }
         virtual bool CanAlwaysSee(WorldObject const* /*obj*/) const { return false; }
         bool CanDetect(WorldObject const* obj, bool ignoreStealth) const;
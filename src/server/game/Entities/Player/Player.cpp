@@ -5289,7 +5289,8 @@ void Player::DeleteFromDB(uint64 playerguid, uint32 accountId, bool updateRealmC
             stmt->setUInt32(0, guid);
             trans->Append(stmt);
 
-            CharacterDatabase.CommitTransaction(trans);
+            // same queue shard as the saves of the account, a pending save must not write the rows back
+            CharacterDatabase.CommitTransaction(trans, accountId);
             break;
         }
         // The character gets unlinked from the account, the name gets freed up and appears as deleted ingame
@@ -5299,7 +5300,7 @@ void Player::DeleteFromDB(uint64 playerguid, uint32 accountId, bool updateRealmC
 
             stmt->setUInt32(0, guid);
 
-            CharacterDatabase.Execute(stmt);
+            CharacterDatabase.Execute(stmt, SQL_PRIORITY_NORMAL, accountId);
             break;
         }
         default:
@@ -5877,6 +5878,12 @@ void Player::LeftChannel(Channel* c)
     m_channels.remove(c);
 }
 
+void Player::UpdateChannelIgnores()
+{
+    for (JoinedChannelsList::iterator i = m_channels.begin(); i != m_channels.end(); ++i)
+        (*i)->UpdateIgnores(this);
+}
+
 void Player::CleanupChannels()
 {
     while (!m_channels.empty())
@@ -6767,11 +6774,7 @@ void Player::SetSkill(uint16 id, uint16 step, uint16 newVal, uint16 maxVal)
                     for (int i = 0; i < 2; i++)
                     {
                         if (member->GetProfessionSkillId(i) == id)
-                        {
-                            member->SetProfessionSkillId(i, id);
-                            member->SetProfessionLevel(i, newVal);
-                            member->SetProfessionRank(i, step);
-                        }
+                            guild->UpdateMemberProfession(member, i, id, newVal, step);
                     }
                 }
             }
@@ -21052,7 +21055,7 @@ void Player::SaveToDB(bool create /*=false*/)
     if (m_session->isLogingOut() || !sWorld->getBoolConfig(CONFIG_STATS_SAVE_ONLY_ON_LOGOUT))
         _SaveStats(trans);
 
-    CharacterDatabase.CommitTransaction(trans);
+    CharacterDatabase.CommitTransaction(trans, GetSession()->GetAccountId());
 
     // save pet (hunter pet level and experience and all type pets health/mana).
     if (petHolder)
@@ -21895,7 +21898,7 @@ void Player::SetUInt32ValueInArray(Tokenizer& Tokenizer, uint16 index, uint32 va
     Tokenizer[index] = buf;
 }
 
-void Player::Customize(uint64 guid, uint8 gender, uint8 skin, uint8 face, uint8 hairStyle, uint8 hairColor, uint8 facialHair)
+void Player::Customize(uint64 guid, uint32 accountId, uint8 gender, uint8 skin, uint8 face, uint8 hairStyle, uint8 hairColor, uint8 facialHair)
 {
     PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_CHAR_PLAYERBYTES2);
     stmt->setUInt32(0, GUID_LOPART(guid));
@@ -21917,7 +21920,7 @@ void Player::Customize(uint64 guid, uint8 gender, uint8 skin, uint8 face, uint8
     stmt->setUInt32(2, playerBytes2);
     stmt->setUInt32(3, GUID_LOPART(guid));
 
-    CharacterDatabase.Execute(stmt);
+    CharacterDatabase.Execute(stmt, SQL_PRIORITY_NORMAL, accountId);
 }
 
 void Player::SendAttackSwingDeadTarget()
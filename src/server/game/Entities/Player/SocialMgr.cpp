@@ -191,6 +191,14 @@ bool PlayerSocial::HasFriend(uint32 friendGuid)
     return false;
 }
 
+void PlayerSocial::GetIgnoredGuids(std::vector<uint32>& ignored) const
+{
+    ignored.clear();
+    for (PlayerSocialMap::const_iterator itr = m_playerSocialMap.begin(); itr != m_playerSocialMap.end(); ++itr)
+        if (itr->second.Flags & SOCIAL_FLAG_IGNORED)
+            ignored.push_back(itr->first);
+}
+
 bool PlayerSocial::HasIgnore(uint32 ignore_guid)
 {
     PlayerSocialMap::const_iterator itr = m_playerSocialMap.find(ignore_guid);
@@ -101,6 +101,7 @@ void MapManager::LoadTransports()
         //If we someday decide to use the grid to track transports, here:
         t->SetMap(sMapMgr->CreateBaseMap(mapid));
         t->AddToWorld();
+        t->GetMap()->AddTransport(t);
 
         ++count;
     }
@@ -173,7 +174,8 @@ void MapManager::LoadTransportNPCs()
 }
 
 Transport::Transport(uint32 period, uint32 script) : GameObject(), m_pathTime(0), m_timer(0),
-currenttguid(0), m_period(period), ScriptId(script), m_nextNodeTime(0)
+currenttguid(0), m_period(period), ScriptId(script), m_teleportPending(false), m_lastUpdateTime(0), m_maxUpdateTime(0),
+m_nextNodeTime(0)
 {
     m_updateFlag = (UPDATEFLAG_TRANSPORT | UPDATEFLAG_STATIONARY_POSITION | UPDATEFLAG_ROTATION);
 }
@@ -497,12 +499,14 @@ void Transport::TeleportTransport(uint32 newMapid, float x, float y, float z)
     //we need to create and save new Map object with 'newMapid' because if not done -> lead to invalid Map object reference...
     //player far teleport would try to create same instance, but we need it NOW for transport...
 
+    GetMap()->RemoveTransport(this);
     RemoveFromWorld();
     ResetMap();
     Map* newMap = sMapMgr->CreateBaseMap(newMapid);
     SetMap(newMap);
     ASSERT(GetMap());
     AddToWorld();
+    newMap->AddTransport(this);
 
     if (oldMap != newMap)
     {
@@ -548,7 +552,7 @@ void Transport::Update(uint32 p_diff)
         return;
 
     m_timer = getMSTime() % m_period;
-    while (((m_timer - m_curr->first) % m_pathTime) > ((m_next->first - m_curr->first) % m_pathTime))
+    while (!m_teleportPending && ((m_timer - m_curr->first) % m_pathTime) > ((m_next->first - m_curr->first) % m_pathTime))
     {
         DoEventIfAny(*m_curr, true);
 
@@ -558,29 +562,41 @@ void Transport::Update(uint32 p_diff)
         DoEventIfAny(*m_curr, false);
 
         // first check help in case client-server transport coordinates de-synchronization
+        // Update() runs inside the update of the current map, passengers and other maps may not be touched here
         if (m_curr->second.mapid != GetMapId() || m_curr->second.teleport)
         {
-            TeleportTransport(m_curr->second.mapid, m_curr->second.x, m_curr->second.y, m_curr->second.z);
+            m_teleportPending = true;
+            break;
         }
-        else
-        {
-            Relocate(m_curr->second.x, m_curr->second.y, m_curr->second.z, GetAngle(m_next->second.x, m_next->second.y) + float(M_PI));
-            UpdateNPCPositions(); // COME BACK MARKER
-        }
-
-        sScriptMgr->OnRelocate(this, m_curr->first, m_curr->second.mapid, m_curr->second.x, m_curr->second.y, m_curr->second.z);
 
-        m_nextNodeTime = m_curr->first;
+        Relocate(m_curr->second.x, m_curr->second.y, m_curr->second.z, GetAngle(m_next->second.x, m_next->second.y) + float(M_PI));
+        UpdateNPCPositions(); // COME BACK MARKER
 
-        if (m_curr == m_WayPoints.begin())
-            sLog->outDebug(LOG_FILTER_TRANSPORTS, " ************ BEGIN ************** %s", m_name.c_str());
-
-        sLog->outDebug(LOG_FILTER_TRANSPORTS, "%s moved to %d %f %f %f %d", m_name.c_str(), m_curr->second.id, m_curr->second.x, m_curr->second.y, m_curr->second.z, m_curr->second.mapid);
+        WayPointReached();
     }
 
     sScriptMgr->OnTransportUpdate(this, p_diff);
 }
 
+void Transport::DoPendingTeleport()
+{
+    m_teleportPending = false;
+    TeleportTransport(m_curr->second.mapid, m_curr->second.x, m_curr->second.y, m_curr->second.z);
+    WayPointReached();
+}
+
+void Transport::WayPointReached()
+{
+    sScriptMgr->OnRelocate(this, m_curr->first, m_curr->second.mapid, m_curr->second.x, m_curr->second.y, m_curr->second.z);
+
+    m_nextNodeTime = m_curr->first;
+
+    if (m_curr == m_WayPoints.begin())
+        sLog->outDebug(LOG_FILTER_TRANSPORTS, " ************ BEGIN ************** %s", m_name.c_str());
+
+    sLog->outDebug(LOG_FILTER_TRANSPORTS, "%s moved to %d %f %f %f %d", m_name.c_str(), m_curr->second.id, m_curr->second.x, m_curr->second.y, m_curr->second.z, m_curr->second.mapid);
+}
+
 void Transport::UpdateForMap(Map const* targetMap)
 {
     Map::PlayerList const& player = targetMap->GetPlayers();
@@ -58,6 +58,15 @@ class Transport : public GameObject, public TransportBase
         void BuildStartMovePacket(Map const* targetMap);
         void BuildStopMovePacket(Map const* targetMap);
         uint32 GetScriptId() const { return ScriptId; }
+
+        /// Set by Update() when the next node is on another map, the move is done by DoPendingTeleport() once no map is updated
+        bool IsTeleportPending() const { return m_teleportPending; }
+        void DoPendingTeleport();
+
+        /// Duration of the updates in microseconds
+        void SetUpdateTime(uint32 time) { m_lastUpdateTime = time; m_maxUpdateTime = std::max(m_maxUpdateTime, time); }
+        uint32 GetLastUpdateTime() const { return m_lastUpdateTime; }
+        uint32 GetMaxUpdateTime() const { return m_maxUpdateTime; }
     private:
         struct WayPoint
         {
@@ -90,6 +99,10 @@ class Transport : public GameObject, public TransportBase
         uint32 currenttguid;
         uint32 m_period;
         uint32 ScriptId;
+
+        bool m_teleportPending;
+        uint32 m_lastUpdateTime;
+        uint32 m_maxUpdateTime;
     public:
         WayPointMap m_WayPoints;
         uint32 m_nextNodeTime;
@@ -98,6 +111,7 @@ class Transport : public GameObject, public TransportBase
         void TeleportTransport(uint32 newMapid, float x, float y, float z);
         void UpdateForMap(Map const* map);
         void DoEventIfAny(WayPointMap::value_type const& node, bool departure);
+        void WayPointReached();
         WayPointMap::const_iterator GetNextWayPoint();
 };
 #endif
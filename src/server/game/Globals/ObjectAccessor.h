@@ -41,43 +41,62 @@ class Vehicle;
 class Map;
 class WorldRunnable;
 
+//! Objects of one type by guid, spread over STRIPE_COUNT independently locked stripes chosen by guid.
+//! Lookups done at the same time by different map threads almost never wait on or dirty the same lock.
 template <class T>
 class HashMapHolder
 {
     public:
+        static uint32 const STRIPE_COUNT = 16;
 
         typedef UNORDERED_MAP<uint64, T*> MapType;
         typedef ACE_RW_Thread_Mutex LockType;
 
         static void Insert(T* o)
         {
-            TRINITY_WRITE_GUARD(LockType, i_lock);
-            m_objectMap[o->GetGUID()] = o;
+            Stripe& stripe = GetStripe(o->GetGUID());
+            TRINITY_WRITE_GUARD(LockType, stripe.Lock);
+            stripe.Objects[o->GetGUID()] = o;
         }
 
         static void Remove(T* o)
         {
-            TRINITY_WRITE_GUARD(LockType, i_lock);
-            m_objectMap.erase(o->GetGUID());
+            Stripe& stripe = GetStripe(o->GetGUID());
+            TRINITY_WRITE_GUARD(LockType, stripe.Lock);
+            stripe.Objects.erase(o->GetGUID());
         }
 
         static T* Find(uint64 guid)
         {
-            TRINITY_READ_GUARD(LockType, i_lock);
-            typename MapType::iterator itr = m_objectMap.find(guid);
-            return (itr != m_objectMap.end()) ? itr->second : NULL;
+            Stripe& stripe = GetStripe(guid);
+            TRINITY_READ_GUARD(LockType, stripe.Lock);
+            typename MapType::iterator itr = stripe.Objects.find(guid);
+            return (itr != stripe.Objects.end()) ? itr->second : NULL;
         }
 
-        static MapType& GetContainer() { return m_objectMap; }
+        // To visit every object, walk the stripes 0..STRIPE_COUNT-1 holding the lock of each in turn
+        static MapType& GetContainer(uint32 stripe) { return m_stripes[stripe].Objects; }
 
-        static LockType* GetLock() { return &i_lock; }
+        static LockType* GetLock(uint32 stripe) { return &m_stripes[stripe].Lock; }
 
     private:
+        struct Stripe
+        {
+            LockType Lock;
+            MapType Objects;
+            char Padding[64];                               // the locks of two stripes never share a cache line
+        };
+
+        static Stripe& GetStripe(uint64 guid)
+        {
+            // the low guid is a counter, the high part keeps the stripes of different object types apart
+            return m_stripes[(uint32(guid) ^ uint32(guid >> 32)) % STRIPE_COUNT];
+        }
+
         //Non instanceable only static
         HashMapHolder() {}
 
-        static LockType i_lock;
-        static MapType m_objectMap;
+        static Stripe m_stripes[STRIPE_COUNT];
 };
 
 class ObjectAccessor
@@ -187,22 +206,22 @@ class ObjectAccessor
         static Unit* FindUnit(uint64);
         static Player* FindPlayerByName(std::string const& name);
 
-        // when using this, you must use the hashmapholder's lock
-        static HashMapHolder<Player>::MapType const& GetPlayers()
+        // when using this, you must use the hashmapholder's lock of the same stripe
+        static HashMapHolder<Player>::MapType const& GetPlayers(uint32 stripe)
         {
-            return HashMapHolder<Player>::GetContainer();
+            return HashMapHolder<Player>::GetContainer(stripe);
         }
 
-        // when using this, you must use the hashmapholder's lock
-        static HashMapHolder<Creature>::MapType const& GetCreatures()
+        // when using this, you must use the hashmapholder's lock of the same stripe
+        static HashMapHolder<Creature>::MapType const& GetCreatures(uint32 stripe)
         {
-            return HashMapHolder<Creature>::GetContainer();
+            return HashMapHolder<Creature>::GetContainer(stripe);
         }
 
-        // when using this, you must use the hashmapholder's lock
-        static HashMapHolder<GameObject>::MapType const& GetGameObjects()
+        // when using this, you must use the hashmapholder's lock of the same stripe
+        static HashMapHolder<GameObject>::MapType const& GetGameObjects(uint32 stripe)
         {
-            return HashMapHolder<GameObject>::GetContainer();
+            return HashMapHolder<GameObject>::GetContainer(stripe);
         }
 
         template<class T> static void AddObject(T* object)
@@ -217,19 +236,6 @@ class ObjectAccessor
 
         static void SaveAllPlayers();
 
-        //non-static functions
-        void AddUpdateObject(Object* obj)
-        {
-            TRINITY_GUARD(ACE_Thread_Mutex, i_objectLock);
-            i_objects.insert(obj);
-        }
-
-        void RemoveUpdateObject(Object* obj)
-        {
-            TRINITY_GUARD(ACE_Thread_Mutex, i_objectLock);
-            i_objects.erase(obj);
-        }
-
         //Thread safe
         Corpse* GetCorpseForPlayerGUID(uint64 guid);
         void RemoveCorpse(Corpse* corpse);
@@ -238,22 +244,14 @@ class ObjectAccessor
         Corpse* ConvertCorpseForPlayer(uint64 player_guid, bool insignia = false);
 
         //Thread unsafe
-        void Update(uint32 diff);
         void RemoveOldCorpses();
         void UnloadAll();
 
     private:
-        static void _buildChangeObjectForPlayer(WorldObject*, UpdateDataMapType&);
-        static void _buildPacket(Player*, Object*, UpdateDataMapType&);
-        void _update();
-
         typedef UNORDERED_MAP<uint64, Corpse*> Player2CorpsesMapType;
-        typedef UNORDERED_MAP<Player*, UpdateData>::value_type UpdateDataValueType;
 
-        std::set<Object*> i_objects;
         Player2CorpsesMapType i_player2corpse;
 
-        ACE_Thread_Mutex i_objectLock;
         ACE_RW_Thread_Mutex i_corpseLock;
 };
 
@@ -1022,8 +1022,6 @@ class ObjectMgr
             return itr != _fishingBaseForAreaStore.end() ? itr->second : 0;
         }
 
-        void ReturnOrDeleteOldMails(bool serverUp);
-
         CreatureBaseStats const* GetCreatureBaseStats(uint8 level, uint8 unitClass);
 
         void SetHighestGuids();
@@ -1450,6 +1448,7 @@ class ObjectMgr
 
         typedef UNORDERED_MAP<uint32, AntiCheatConfig> AntiCheatConfigMap;
         AntiCheatConfigMap m_AntiCheatConfig;
+        std::vector<AntiCheatConfig const*> m_AntiCheatConfigByType;        // asked for every check of every packet
 };
 
 #define sObjectMgr ACE_Singleton<ObjectMgr, ACE_Null_Mutex>::instance()
@@ -0,0 +1,270 @@
+/*
+ * Copyright (C) 2008-2013 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PlayerDirectory.h"
+#include "AccountMgr.h"
+#include "DBCStores.h"
+#include "GuildMgr.h"
+#include "Player.h"
+#include "World.h"
+#include "WorldSession.h"
+
+bool PlayerDirectory::ToLower(std::string const& name, std::wstring& lower)
+{
+    if (!Utf8toWStr(name, lower))
+        return false;
+
+    wstrToLower(lower);
+    return true;
+}
+
+void PlayerDirectory::AddPlayer(Player* player)
+{
+    EntryMap::iterator itr = _entries.find(player->GetGUIDLow());
+    if (itr != _entries.end())
+        RemovePlayer(itr->second.Owner);
+
+    PlayerDirectoryEntry& entry = _entries[player->GetGUIDLow()];
+    entry.Owner = player;
+    entry.Name = player->GetName();
+    if (!ToLower(entry.Name, entry.LowerName))
+        entry.LowerName.clear();
+
+    Copy(entry);
+    LinkZone(entry);
+
+    if (!entry.LowerName.empty())
+        _names[entry.LowerName] = &entry;
+}
+
+void PlayerDirectory::RemovePlayer(Player* player)
+{
+    EntryMap::iterator itr = _entries.find(player->GetGUIDLow());
+    if (itr == _entries.end() || itr->second.Owner != player)
+        return;
+
+    PlayerDirectoryEntry& entry = itr->second;
+    NameMap::iterator name = _names.find(entry.LowerName);
+    if (name != _names.end() && name->second == &entry)
+        _names.erase(name);
+
+    UnlinkZone(entry);
+    _entries.erase(itr);
+}
+
+Player* PlayerDirectory::FindPlayerByName(std::string const& name) const
+{
+    std::wstring lower;
+    if (!ToLower(name, lower))
+        return NULL;
+
+    NameMap::const_iterator itr = _names.find(lower);
+    if (itr == _names.end() || !itr->second->Owner->IsInWorld())
+        return NULL;
+
+    return itr->second->Owner;
+}
+
+void PlayerDirectory::Copy(PlayerDirectoryEntry& entry)
+{
+    Player* player = entry.Owner;
+    entry.GuildId = player->GetGuildId();
+    entry.Team = player->GetTeam();
+    entry.Security = player->GetSession()->GetSecurity();
+    entry.Level = player->getLevel();
+    entry.Class = player->getClass();
+    entry.Race = player->getRace();
+    entry.Gender = player->getGender();
+    entry.ZoneId = player->GetZoneId();
+}
+
+void PlayerDirectory::LinkZone(PlayerDirectoryEntry& entry)
+{
+    std::vector<PlayerDirectoryEntry*>& zone = _zones[entry.ZoneId];
+    entry.ZoneSlot = zone.size();
+    zone.push_back(&entry);
+}
+
+void PlayerDirectory::UnlinkZone(PlayerDirectoryEntry& entry)
+{
+    ZoneMap::iterator itr = _zones.find(entry.ZoneId);
+    if (itr == _zones.end())
+        return;
+
+    std::vector<PlayerDirectoryEntry*>& zone = itr->second;
+    if (entry.ZoneSlot + 1 != zone.size())
+    {
+        zone[entry.ZoneSlot] = zone.back();
+        zone[entry.ZoneSlot]->ZoneSlot = entry.ZoneSlot;
+    }
+
+    zone.pop_back();
+    if (zone.empty())
+        _zones.erase(itr);
+}
+
+void PlayerDirectory::Refresh()
+{
+    for (EntryMap::iterator itr = _entries.begin(); itr != _entries.end(); ++itr)
+    {
+        PlayerDirectoryEntry& entry = itr->second;
+        uint32 oldZoneId = entry.ZoneId;
+        Copy(entry);
+        if (entry.ZoneId == oldZoneId)
+            continue;
+
+        // the zone bucket is found by the old zone
+        uint32 newZoneId = entry.ZoneId;
+        entry.ZoneId = oldZoneId;
+        UnlinkZone(entry);
+        entry.ZoneId = newZoneId;
+        LinkZone(entry);
+    }
+
+    // guilds may have been renamed or disbanded, their names are looked up again when needed
+    _guildNames.clear();
+    _lastRefresh = getMSTime();
+}
+
+PlayerDirectory::LowerName const& PlayerDirectory::GetLowerGuildName(uint32 guildId)
+{
+    UNORDERED_MAP<uint32, LowerName>::iterator itr = _guildNames.find(guildId);
+    if (itr != _guildNames.end())
+        return itr->second;
+
+    LowerName& name = _guildNames[guildId];
+    if (guildId)
+    {
+        name.Name = sGuildMgr->GetGuildNameById(guildId);
+        if (!ToLower(name.Name, name.Lower))
+            name.Lower.clear();
+    }
+
+    return name;
+}
+
+std::string const& PlayerDirectory::GetGuildName(uint32 guildId)
+{
+    return GetLowerGuildName(guildId).Name;
+}
+
+std::wstring const& PlayerDirectory::GetLowerAreaName(uint32 zoneId)
+{
+    UNORDERED_MAP<uint32, std::wstring>::iterator itr = _areaNames.find(zoneId);
+    if (itr != _areaNames.end())
+        return itr->second;
+
+    std::wstring& name = _areaNames[zoneId];
+    if (AreaTableEntry const* areaEntry = GetAreaEntryByAreaID(zoneId))
+        if (areaEntry->area_name && !ToLower(areaEntry->area_name, name))
+            name.clear();
+
+    return name;
+}
+
+bool PlayerDirectory::Matches(PlayerDirectoryEntry const& entry, WhoQuery const& query, Player* viewer, bool playerViewer,
+    bool allowTwoSide, uint32 gmLevelInWhoList)
+{
+    if (playerViewer)
+    {
+        // player can see member of other team only if CONFIG_ALLOW_TWO_SIDE_WHO_LIST
+        if (entry.Team != viewer->GetTeam() && !allowTwoSide)
+            return false;
+
+        // player can see MODERATOR, GAME MASTER, ADMINISTRATOR only if CONFIG_GM_IN_WHO_LIST
+        if (entry.Security > gmLevelInWhoList)
+            return false;
+    }
+
+    //do not process players which are not in world
+    if (!entry.Owner->IsInWorld() || entry.LowerName.empty())
+        return false;
+
+    // check if target is globally visible for player
+    if (!entry.Owner->IsVisibleGloballyFor(viewer))
+        return false;
+
+    if (entry.Level < query.LevelMin || entry.Level > query.LevelMax)
+        return false;
+
+    if (!(query.ClassMask & (1 << entry.Class)))
+        return false;
+
+    if (!(query.RaceMask & (1 << entry.Race)))
+        return false;
+
+    if (!query.PlayerName.empty() && entry.LowerName.find(query.PlayerName) == std::wstring::npos)
+        return false;
+
+    LowerName const& guildName = GetLowerGuildName(entry.GuildId);
+    if (!query.GuildName.empty() && guildName.Lower.find(query.GuildName) == std::wstring::npos)
+        return false;
+
+    // any of the strings in the player name, the guild name or the zone name
+    bool found = true;
+    for (uint32 i = 0; i < query.StringCount; ++i)
+    {
+        if (query.Strings[i].empty())
+            continue;
+
+        if (entry.LowerName.find(query.Strings[i]) != std::wstring::npos ||
+            guildName.Lower.find(query.Strings[i]) != std::wstring::npos ||
+            GetLowerAreaName(entry.ZoneId).find(query.Strings[i]) != std::wstring::npos)
+        {
+            found = true;
+            break;
+        }
+
+        found = false;
+    }
+
+    return found;
+}
+
+void PlayerDirectory::Search(WhoQuery const& query, Player* viewer, EntryList& results)
+{
+    if (GetMSTimeDiffToNow(_lastRefresh) >= PLAYER_DIRECTORY_REFRESH_INTERVAL)
+        Refresh();
+
+    bool playerViewer = AccountMgr::IsPlayerAccount(viewer->GetSession()->GetSecurity());
+    bool allowTwoSide = sWorld->getBoolConfig(CONFIG_ALLOW_TWO_SIDE_WHO_LIST);
+    uint32 gmLevelInWhoList = sWorld->getIntConfig(CONFIG_GM_LEVEL_IN_WHO_LIST);
+
+    if (!query.ZoneCount)
+    {
+        for (EntryMap::const_iterator itr = _entries.begin(); itr != _entries.end(); ++itr)
+            if (Matches(itr->second, query, viewer, playerViewer, allowTwoSide, gmLevelInWhoList))
+                results.push_back(&itr->second);
+
+        return;
+    }
+
+    for (uint32 i = 0; i < query.ZoneCount; ++i)
+    {
+        // the client may send a zone twice
+        if (std::find(query.Zones, query.Zones + i, query.Zones[i]) != query.Zones + i)
+            continue;
+
+        ZoneMap::const_iterator zone = _zones.find(query.Zones[i]);
+        if (zone == _zones.end())
+            continue;
+
+        for (std::vector<PlayerDirectoryEntry*>::const_iterator itr = zone->second.begin(); itr != zone->second.end(); ++itr)
+            if (Matches(**itr, query, viewer, playerViewer, allowTwoSide, gmLevelInWhoList))
+                results.push_back(*itr);
+    }
+}
@@ -0,0 +1,137 @@
+/*
+ * Copyright (C) 2008-2013 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_PLAYERDIRECTORY_H
+#define TRINITY_PLAYERDIRECTORY_H
+
+#include "Common.h"
+#include <ace/Null_Mutex.h>
+#include <ace/Singleton.h>
+
+class Player;
+
+#define PLAYER_DIRECTORY_REFRESH_INTERVAL   1000            // ms, levels, zones and guilds are copied from the players this often
+#define WHO_MAX_ZONES                       10              // client limit
+#define WHO_MAX_STRINGS                     4               // client limit
+
+// Filters of CMSG_WHO, the names and strings are lower case
+struct WhoQuery
+{
+    WhoQuery() : LevelMin(0), LevelMax(0), RaceMask(0), ClassMask(0), ZoneCount(0), StringCount(0) { }
+
+    uint32 LevelMin;
+    uint32 LevelMax;
+    uint32 RaceMask;
+    uint32 ClassMask;
+    uint32 ZoneCount;
+    uint32 Zones[WHO_MAX_ZONES];
+    std::wstring PlayerName;
+    std::wstring GuildName;
+    uint32 StringCount;
+    std::wstring Strings[WHO_MAX_STRINGS];
+};
+
+struct PlayerDirectoryEntry
+{
+    Player* Owner;
+    std::string Name;
+    std::wstring LowerName;
+    uint32 GuildId;
+    uint32 Team;
+    uint32 Security;
+    uint32 ZoneId;
+    uint8 Level;
+    uint8 Class;
+    uint8 Race;
+    uint8 Gender;
+    uint32 ZoneSlot;
+};
+
+/**
+ * Directory of the players logged in, answering /who and player name lookups without walking the
+ * object registry.
+ *
+ * Players are indexed by their lower case name and bucketed by zone. The lower case names of
+ * guilds and zones are cached, so a who query converts no strings. The fields players change
+ * while playing (level, zone, guild, ...) are copied from the players at most once every
+ * PLAYER_DIRECTORY_REFRESH_INTERVAL, by the first query after it passed.
+ *
+ * The directory has no lock: it is only changed by the world thread (logins, logouts and the
+ * refresh of the who handler), which never runs together with the map updates. The map threads
+ * may look names up, they never change it.
+ */
+class PlayerDirectory
+{
+    friend class ACE_Singleton<PlayerDirectory, ACE_Null_Mutex>;
+
+  public:
+    typedef std::vector<PlayerDirectoryEntry const*> EntryList;
+
+    void AddPlayer(Player* player);
+    void RemovePlayer(Player* player);
+
+    // the player in world with this name, in any case
+    Player* FindPlayerByName(std::string const& name) const;
+
+    // appends the players matching the query that the viewer may see
+    void Search(WhoQuery const& query, Player* viewer, EntryList& results);
+
+    std::string const& GetGuildName(uint32 guildId);
+
+    // copies the fields players change while playing
+    void Refresh();
+
+    uint32 GetSize() const { return _entries.size(); }
+
+  private:
+    PlayerDirectory() : _lastRefresh(0) { }
+    ~PlayerDirectory() { }
+
+    struct LowerName
+    {
+        std::string Name;
+        std::wstring Lower;
+    };
+
+    typedef UNORDERED_MAP<uint32, PlayerDirectoryEntry> EntryMap;               // by guid
+    typedef UNORDERED_MAP<std::wstring, PlayerDirectoryEntry*> NameMap;         // by lower case name
+    typedef UNORDERED_MAP<uint32, std::vector<PlayerDirectoryEntry*> > ZoneMap;
+
+    static bool ToLower(std::string const& name, std::wstring& lower);
+
+    void Copy(PlayerDirectoryEntry& entry);
+    void LinkZone(PlayerDirectoryEntry& entry);
+    void UnlinkZone(PlayerDirectoryEntry& entry);
+
+    LowerName const& GetLowerGuildName(uint32 guildId);
+    std::wstring const& GetLowerAreaName(uint32 zoneId);
+
+    bool Matches(PlayerDirectoryEntry const& entry, WhoQuery const& query, Player* viewer, bool playerViewer,
+        bool allowTwoSide, uint32 gmLevelInWhoList);
+
+    EntryMap _entries;
+    NameMap _names;
+    ZoneMap _zones;
+
+    UNORDERED_MAP<uint32, LowerName> _guildNames;                               // emptied by every refresh
+    UNORDERED_MAP<uint32, std::wstring> _areaNames;                             // by zone
+    uint32 _lastRefresh;
+};
+
+#define sPlayerDirectory ACE_Singleton<PlayerDirectory, ACE_Null_Mutex>::instance()
+
+#endif
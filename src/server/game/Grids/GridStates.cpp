@@ -21,28 +21,31 @@
 #include "Grid.h"
 #include "Log.h"
 
+void GridStateTimer::OnExpire()
+{
+    i_map->AddGridStateUpdate(i_x, i_y);
+}
+
 void InvalidState::Update(Map &, NGridType &, GridInfo &, const uint32) const
 {
 }
 
-void ActiveState::Update(Map &m, NGridType &grid, GridInfo & info, const uint32 t_diff) const
+// The states are only updated when the state timer of the grid expires, see Map::ResetGridExpiry
+void ActiveState::Update(Map &m, NGridType &grid, GridInfo &, const uint32) const
 {
     // Only check grid activity every (grid_expiry/10) ms, because it's really useless to do it every cycle
-    info.UpdateTimeTracker(t_diff);
-    if (info.getTimeTracker().Passed())
+    if (!grid.GetWorldObjectCountInNGrid<Player>() && !m.ActiveObjectsNearGrid(grid))
+    {
+        ObjectGridStoper worker;
+        TypeContainerVisitor<ObjectGridStoper, GridTypeMapContainer> visitor(worker);
+        grid.VisitAllGrids(visitor);
+        grid.SetGridState(GRID_STATE_IDLE);
+        m.ResetGridExpiry(grid, 0.0f);
+        sLog->outDebug(LOG_FILTER_MAPS, "Grid[%u, %u] on map %u moved to IDLE state", grid.getX(), grid.getY(), m.GetId());
+    }
+    else
     {
-        if (!grid.GetWorldObjectCountInNGrid<Player>() && !m.ActiveObjectsNearGrid(grid))
-        {
-            ObjectGridStoper worker;
-            TypeContainerVisitor<ObjectGridStoper, GridTypeMapContainer> visitor(worker);
-            grid.VisitAllGrids(visitor);
-            grid.SetGridState(GRID_STATE_IDLE);
-            sLog->outDebug(LOG_FILTER_MAPS, "Grid[%u, %u] on map %u moved to IDLE state", grid.getX(), grid.getY(), m.GetId());
-        }
-        else
-        {
-            m.ResetGridExpiry(grid, 0.1f);
-        }
+        m.ResetGridExpiry(grid, 0.1f);
     }
 }
 
@@ -53,19 +56,19 @@ void IdleState::Update(Map &m, NGridType &grid, GridInfo &, const uint32) const
     sLog->outDebug(LOG_FILTER_MAPS, "Grid[%u, %u] on map %u moved to REMOVAL state", grid.getX(), grid.getY(), m.GetId());
 }
 
-void RemovalState::Update(Map &m, NGridType &grid, GridInfo &info, const uint32 t_diff) const
+void RemovalState::Update(Map &m, NGridType &grid, GridInfo &info, const uint32) const
 {
-    if (!info.getUnloadLock())
+    // locked grids are checked again after a whole expiry
+    if (info.getUnloadLock())
+    {
+        m.ResetGridExpiry(grid);
+        return;
+    }
+
+    if (!m.UnloadGrid(grid, false))
     {
-        info.UpdateTimeTracker(t_diff);
-        if (info.getTimeTracker().Passed())
-        {
-            if (!m.UnloadGrid(grid, false))
-            {
-                sLog->outDebug(LOG_FILTER_MAPS, "Grid[%u, %u] for map %u differed unloading due to players or active objects nearby", grid.getX(), grid.getY(), m.GetId());
-                m.ResetGridExpiry(grid);
-            }
-        }
+        sLog->outDebug(LOG_FILTER_MAPS, "Grid[%u, %u] for map %u differed unloading due to players or active objects nearby", grid.getX(), grid.getY(), m.GetId());
+        m.ResetGridExpiry(grid);
     }
 }
 
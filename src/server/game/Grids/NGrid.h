@@ -25,32 +25,46 @@
 #include "Grid.h"
 #include "GridReference.h"
 #include "Timer.h"
+#include "TimerWheel.h"
 #include "Util.h"
 
 #define DEFAULT_VISIBILITY_NOTIFY_PERIOD      1000
 
+class Map;
+
+// Runs the grid state update of a grid when it expires, scheduled on the timers of the map by Map::ResetGridExpiry
+class GridStateTimer : public TimerWheelEntry
+{
+public:
+    GridStateTimer() : i_map(NULL), i_x(0), i_y(0) {}
+
+    void SetGrid(Map* map, uint32 x, uint32 y) { i_map = map; i_x = x; i_y = y; }
+    void OnExpire();
+private:
+    Map* i_map;
+    uint32 i_x;
+    uint32 i_y;
+};
+
 class GridInfo
 {
 public:
     GridInfo()
-        : i_timer(0), vis_Update(0, irand(0, DEFAULT_VISIBILITY_NOTIFY_PERIOD)),
+        : vis_Update(0, irand(0, DEFAULT_VISIBILITY_NOTIFY_PERIOD)),
           i_unloadActiveLockCount(0), i_unloadExplicitLock(false), i_unloadReferenceLock(false) {}
-    GridInfo(time_t expiry, bool unload = true )
-        : i_timer(expiry), vis_Update(0, irand(0, DEFAULT_VISIBILITY_NOTIFY_PERIOD)),
+    explicit GridInfo(bool unload)
+        : vis_Update(0, irand(0, DEFAULT_VISIBILITY_NOTIFY_PERIOD)),
           i_unloadActiveLockCount(0), i_unloadExplicitLock(!unload), i_unloadReferenceLock(false) {}
-    const TimeTracker& getTimeTracker() const { return i_timer; }
     bool getUnloadLock() const { return i_unloadActiveLockCount || i_unloadExplicitLock || i_unloadReferenceLock; }
     void setUnloadExplicitLock(bool on) { i_unloadExplicitLock = on; }
     void setUnloadReferenceLock(bool on) { i_unloadReferenceLock = on; }
     void incUnloadActiveLock() { ++i_unloadActiveLockCount; }
     void decUnloadActiveLock() { if (i_unloadActiveLockCount) --i_unloadActiveLockCount; }
 
-    void setTimer(const TimeTracker& pTimer) { i_timer = pTimer; }
-    void ResetTimeTracker(time_t interval) { i_timer.Reset(interval); }
-    void UpdateTimeTracker(time_t diff) { i_timer.Update(diff); }
+    GridStateTimer& getStateTimer() { return i_stateTimer; }
     PeriodicTimer& getRelocationTimer() { return vis_Update; }
 private:
-    TimeTracker i_timer;
+    GridStateTimer i_stateTimer;
     PeriodicTimer vis_Update;
 
     uint16 i_unloadActiveLockCount : 16;                    // lock from active object spawn points (prevent clone loading)
@@ -78,9 +92,9 @@ class NGrid
 {
     public:
         typedef Grid<ACTIVE_OBJECT, WORLD_OBJECT_TYPES, GRID_OBJECT_TYPES> GridType;
-        NGrid(uint32 id, int32 x, int32 y, time_t expiry, bool unload = true)
+        NGrid(uint32 id, int32 x, int32 y, bool unload = true)
             : i_gridId(id)
-            , i_GridInfo(GridInfo(expiry, unload))
+            , i_GridInfo(unload)
             , i_x(x)
             , i_y(y)
             , i_cellstate(GRID_STATE_INVALID)
@@ -115,14 +129,11 @@ class NGrid
         void setGridObjectDataLoaded(bool pLoaded) { i_GridObjectDataLoaded = pLoaded; }
 
         GridInfo* getGridInfoRef() { return &i_GridInfo; }
-        const TimeTracker& getTimeTracker() const { return i_GridInfo.getTimeTracker(); }
         bool getUnloadLock() const { return i_GridInfo.getUnloadLock(); }
         void setUnloadExplicitLock(bool on) { i_GridInfo.setUnloadExplicitLock(on); }
         void setUnloadReferenceLock(bool on) { i_GridInfo.setUnloadReferenceLock(on); }
         void incUnloadActiveLock() { i_GridInfo.incUnloadActiveLock(); }
         void decUnloadActiveLock() { i_GridInfo.decUnloadActiveLock(); }
-        void ResetTimeTracker(time_t interval) { i_GridInfo.ResetTimeTracker(interval); }
-        void UpdateTimeTracker(time_t diff) { i_GridInfo.UpdateTimeTracker(diff); }
 
         /*
         template<class SPECIFIC_OBJECT> void AddWorldObject(const uint32 x, const uint32 y, SPECIFIC_OBJECT *obj)
@@ -32,6 +32,7 @@
 #include "CreatureAI.h"
 #include "Spell.h"
 #include "WorldSession.h"
+#include "SpatialHashIndex.h"
 
 class Player;
 //class Map;
@@ -208,7 +209,7 @@ namespace Trinity
     };
 
     template<class Check>
-    struct WorldObjectListSearcher
+    struct WorldObjectListSearcher : public SpatialIndexNotifier
     {
         uint32 i_mapTypeMask;
         uint32 i_phaseMask;
@@ -223,8 +224,14 @@ namespace Trinity
         void Visit(CorpseMapType &m);
         void Visit(GameObjectMapType &m);
         void Visit(DynamicObjectMapType &m);
+        void VisitObject(Player* player);
+        void VisitObject(Creature* creature);
+        void VisitObject(Corpse* corpse);
+        void VisitObject(GameObject* go);
+        void VisitObject(DynamicObject* dynObj);
 
         template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED> &) {}
+        template<class NOT_INTERESTED> void VisitObject(NOT_INTERESTED*) {}
     };
 
     template<class Do>
@@ -287,49 +294,55 @@ namespace Trinity
     // Gameobject searchers
 
     template<class Check>
-    struct GameObjectSearcher
+    struct GameObjectSearcher : public SpatialIndexNotifier
     {
         uint32 i_phaseMask;
         GameObject* &i_object;
         Check &i_check;
 
         GameObjectSearcher(WorldObject const* searcher, GameObject* & result, Check& check)
-            : i_phaseMask(searcher->GetPhaseMask()), i_object(result), i_check(check) {}
+            : SpatialIndexNotifier(searcher->GetPhaseMask()), i_phaseMask(searcher->GetPhaseMask()), i_object(result), i_check(check) {}
 
         void Visit(GameObjectMapType &m);
+        void VisitObject(GameObject* go);
 
         template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED> &) {}
+        template<class NOT_INTERESTED> void VisitObject(NOT_INTERESTED*) {}
     };
 
     // Last accepted by Check GO if any (Check can change requirements at each call)
     template<class Check>
-    struct GameObjectLastSearcher
+    struct GameObjectLastSearcher : public SpatialIndexNotifier
     {
         uint32 i_phaseMask;
         GameObject* &i_object;
         Check& i_check;
 
         GameObjectLastSearcher(WorldObject const* searcher, GameObject* & result, Check& check)
-            : i_phaseMask(searcher->GetPhaseMask()), i_object(result), i_check(check) {}
+            : SpatialIndexNotifier(searcher->GetPhaseMask()), i_phaseMask(searcher->GetPhaseMask()), i_object(result), i_check(check) {}
 
         void Visit(GameObjectMapType &m);
+        void VisitObject(GameObject* go);
 
         template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED> &) {}
+        template<class NOT_INTERESTED> void VisitObject(NOT_INTERESTED*) {}
     };
 
     template<class Check>
-    struct GameObjectListSearcher
+    struct GameObjectListSearcher : public SpatialIndexNotifier
     {
         uint32 i_phaseMask;
         std::list<GameObject*> &i_objects;
         Check& i_check;
 
         GameObjectListSearcher(WorldObject const* searcher, std::list<GameObject*> &objects, Check & check)
-            : i_phaseMask(searcher->GetPhaseMask()), i_objects(objects), i_check(check) {}
+            : SpatialIndexNotifier(searcher->GetPhaseMask()), i_phaseMask(searcher->GetPhaseMask()), i_objects(objects), i_check(check) {}
 
         void Visit(GameObjectMapType &m);
+        void VisitObject(GameObject* go);
 
         template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED> &) {}
+        template<class NOT_INTERESTED> void VisitObject(NOT_INTERESTED*) {}
     };
 
     template<class Functor>
@@ -356,101 +369,116 @@ namespace Trinity
 
     // First accepted by Check Unit if any
     template<class Check>
-    struct UnitSearcher
+    struct UnitSearcher : public SpatialIndexNotifier
     {
         uint32 i_phaseMask;
         Unit* &i_object;
         Check & i_check;
 
         UnitSearcher(WorldObject const* searcher, Unit* & result, Check & check)
-            : i_phaseMask(searcher->GetPhaseMask()), i_object(result), i_check(check) {}
+            : SpatialIndexNotifier(searcher->GetPhaseMask()), i_phaseMask(searcher->GetPhaseMask()), i_object(result), i_check(check) {}
 
         void Visit(CreatureMapType &m);
         void Visit(PlayerMapType &m);
+        void VisitObject(Creature* creature);
+        void VisitObject(Player* player);
 
         template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED> &) {}
+        template<class NOT_INTERESTED> void VisitObject(NOT_INTERESTED*) {}
     };
 
     // Last accepted by Check Unit if any (Check can change requirements at each call)
     template<class Check>
-    struct UnitLastSearcher
+    struct UnitLastSearcher : public SpatialIndexNotifier
     {
         uint32 i_phaseMask;
         Unit* &i_object;
         Check & i_check;
 
         UnitLastSearcher(WorldObject const* searcher, Unit* & result, Check & check)
-            : i_phaseMask(searcher->GetPhaseMask()), i_object(result), i_check(check) {}
+            : SpatialIndexNotifier(searcher->GetPhaseMask()), i_phaseMask(searcher->GetPhaseMask()), i_object(result), i_check(check) {}
 
         void Visit(CreatureMapType &m);
         void Visit(PlayerMapType &m);
+        void VisitObject(Creature* creature);
+        void VisitObject(Player* player);
 
         template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED> &) {}
+        template<class NOT_INTERESTED> void VisitObject(NOT_INTERESTED*) {}
     };
 
     // All accepted by Check units if any
     template<class Check>
-    struct UnitListSearcher
+    struct UnitListSearcher : public SpatialIndexNotifier
     {
         uint32 i_phaseMask;
         std::list<Unit*> &i_objects;
         Check& i_check;
 
         UnitListSearcher(WorldObject const* searcher, std::list<Unit*> &objects, Check & check)
-            : i_phaseMask(searcher->GetPhaseMask()), i_objects(objects), i_check(check) {}
+            : SpatialIndexNotifier(searcher->GetPhaseMask()), i_phaseMask(searcher->GetPhaseMask()), i_objects(objects), i_check(check) {}
 
         void Visit(PlayerMapType &m);
         void Visit(CreatureMapType &m);
+        void VisitObject(Player* player);
+        void VisitObject(Creature* creature);
 
         template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED> &) {}
+        template<class NOT_INTERESTED> void VisitObject(NOT_INTERESTED*) {}
     };
 
     // Creature searchers
 
     template<class Check>
-    struct CreatureSearcher
+    struct CreatureSearcher : public SpatialIndexNotifier
     {
         uint32 i_phaseMask;
         Creature* &i_object;
         Check & i_check;
 
         CreatureSearcher(WorldObject const* searcher, Creature* & result, Check & check)
-            : i_phaseMask(searcher->GetPhaseMask()), i_object(result), i_check(check) {}
+            : SpatialIndexNotifier(searcher->GetPhaseMask()), i_phaseMask(searcher->GetPhaseMask()), i_object(result), i_check(check) {}
 
         void Visit(CreatureMapType &m);
+        void VisitObject(Creature* creature);
 
         template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED> &) {}
+        template<class NOT_INTERESTED> void VisitObject(NOT_INTERESTED*) {}
     };
 
     // Last accepted by Check Creature if any (Check can change requirements at each call)
     template<class Check>
-    struct CreatureLastSearcher
+    struct CreatureLastSearcher : public SpatialIndexNotifier
     {
         uint32 i_phaseMask;
         Creature* &i_object;
         Check & i_check;
 
         CreatureLastSearcher(WorldObject const* searcher, Creature* & result, Check & check)
-            : i_phaseMask(searcher->GetPhaseMask()), i_object(result), i_check(check) {}
+            : SpatialIndexNotifier(searcher->GetPhaseMask()), i_phaseMask(searcher->GetPhaseMask()), i_object(result), i_check(check) {}
 
         void Visit(CreatureMapType &m);
+        void VisitObject(Creature* creature);
 
         template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED> &) {}
+        template<class NOT_INTERESTED> void VisitObject(NOT_INTERESTED*) {}
     };
 
     template<class Check>
-    struct CreatureListSearcher
+    struct CreatureListSearcher : public SpatialIndexNotifier
     {
         uint32 i_phaseMask;
         std::list<Creature*> &i_objects;
         Check& i_check;
 
         CreatureListSearcher(WorldObject const* searcher, std::list<Creature*> &objects, Check & check)
-            : i_phaseMask(searcher->GetPhaseMask()), i_objects(objects), i_check(check) {}
+            : SpatialIndexNotifier(searcher->GetPhaseMask()), i_phaseMask(searcher->GetPhaseMask()), i_objects(objects), i_check(check) {}
 
         void Visit(CreatureMapType &m);
+        void VisitObject(Creature* creature);
 
         template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED> &) {}
+        template<class NOT_INTERESTED> void VisitObject(NOT_INTERESTED*) {}
     };
 
     template<class Do>
@@ -475,49 +503,55 @@ namespace Trinity
     // Player searchers
 
     template<class Check>
-    struct PlayerSearcher
+    struct PlayerSearcher : public SpatialIndexNotifier
     {
         uint32 i_phaseMask;
         Player* &i_object;
         Check & i_check;
 
         PlayerSearcher(WorldObject const* searcher, Player* & result, Check & check)
-            : i_phaseMask(searcher->GetPhaseMask()), i_object(result), i_check(check) {}
+            : SpatialIndexNotifier(searcher->GetPhaseMask()), i_phaseMask(searcher->GetPhaseMask()), i_object(result), i_check(check) {}
 
         void Visit(PlayerMapType &m);
+        void VisitObject(Player* player);
 
         template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED> &) {}
+        template<class NOT_INTERESTED> void VisitObject(NOT_INTERESTED*) {}
     };
 
     template<class Check>
-    struct PlayerListSearcher
+    struct PlayerListSearcher : public SpatialIndexNotifier
     {
         uint32 i_phaseMask;
         std::list<Player*> &i_objects;
         Check& i_check;
 
         PlayerListSearcher(WorldObject const* searcher, std::list<Player*> &objects, Check & check)
-            : i_phaseMask(searcher->GetPhaseMask()), i_objects(objects), i_check(check) {}
+            : SpatialIndexNotifier(searcher->GetPhaseMask()), i_phaseMask(searcher->GetPhaseMask()), i_objects(objects), i_check(check) {}
 
         void Visit(PlayerMapType &m);
+        void VisitObject(Player* player);
 
         template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED> &) {}
+        template<class NOT_INTERESTED> void VisitObject(NOT_INTERESTED*) {}
     };
 
     template<class Check>
-    struct PlayerLastSearcher
+    struct PlayerLastSearcher : public SpatialIndexNotifier
     {
         uint32 i_phaseMask;
         Player* &i_object;
         Check& i_check;
 
-        PlayerLastSearcher(WorldObject const* searcher, Player*& result, Check& check) : i_phaseMask(searcher->GetPhaseMask()), i_object(result), i_check(check)
+        PlayerLastSearcher(WorldObject const* searcher, Player*& result, Check& check) : SpatialIndexNotifier(searcher->GetPhaseMask()), i_phaseMask(searcher->GetPhaseMask()), i_object(result), i_check(check)
         {
         }
 
         void Visit(PlayerMapType& m);
+        void VisitObject(Player* player);
 
         template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED> &) {}
+        template<class NOT_INTERESTED> void VisitObject(NOT_INTERESTED*) {}
     };
 
     template<class Do>
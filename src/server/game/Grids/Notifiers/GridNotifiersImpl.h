@@ -27,6 +27,7 @@
 #include "CreatureAI.h"
 #include "SpellAuras.h"
 #include "Opcodes.h"
+#include "SpatialHashIndexImpl.h"
 
 template<class T>
 inline void Trinity::VisibleNotifier::Visit(GridRefManager<T> &m)
@@ -252,8 +253,14 @@ void Trinity::WorldObjectListSearcher<Check>::Visit(PlayerMapType &m)
         return;
 
     for (PlayerMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
-        if (i_check(itr->getSource()))
-            i_objects.push_back(itr->getSource());
+        VisitObject(itr->getSource());
+}
+
+template<class Check>
+void Trinity::WorldObjectListSearcher<Check>::VisitObject(Player* player)
+{
+    if ((i_mapTypeMask & GRID_MAP_TYPE_MASK_PLAYER) && i_check(player))
+        i_objects.push_back(player);
 }
 
 template<class Check>
@@ -263,8 +270,14 @@ void Trinity::WorldObjectListSearcher<Check>::Visit(CreatureMapType &m)
         return;
 
     for (CreatureMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
-        if (i_check(itr->getSource()))
-            i_objects.push_back(itr->getSource());
+        VisitObject(itr->getSource());
+}
+
+template<class Check>
+void Trinity::WorldObjectListSearcher<Check>::VisitObject(Creature* creature)
+{
+    if ((i_mapTypeMask & GRID_MAP_TYPE_MASK_CREATURE) && i_check(creature))
+        i_objects.push_back(creature);
 }
 
 template<class Check>
@@ -274,8 +287,14 @@ void Trinity::WorldObjectListSearcher<Check>::Visit(CorpseMapType &m)
         return;
 
     for (CorpseMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
-        if (i_check(itr->getSource()))
-            i_objects.push_back(itr->getSource());
+        VisitObject(itr->getSource());
+}
+
+template<class Check>
+void Trinity::WorldObjectListSearcher<Check>::VisitObject(Corpse* corpse)
+{
+    if ((i_mapTypeMask & GRID_MAP_TYPE_MASK_CORPSE) && i_check(corpse))
+        i_objects.push_back(corpse);
 }
 
 template<class Check>
@@ -285,8 +304,14 @@ void Trinity::WorldObjectListSearcher<Check>::Visit(GameObjectMapType &m)
         return;
 
     for (GameObjectMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
-        if (i_check(itr->getSource()))
-            i_objects.push_back(itr->getSource());
+        VisitObject(itr->getSource());
+}
+
+template<class Check>
+void Trinity::WorldObjectListSearcher<Check>::VisitObject(GameObject* go)
+{
+    if ((i_mapTypeMask & GRID_MAP_TYPE_MASK_GAMEOBJECT) && i_check(go))
+        i_objects.push_back(go);
 }
 
 template<class Check>
@@ -296,224 +321,250 @@ void Trinity::WorldObjectListSearcher<Check>::Visit(DynamicObjectMapType &m)
         return;
 
     for (DynamicObjectMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
-        if (i_check(itr->getSource()))
-            i_objects.push_back(itr->getSource());
+        VisitObject(itr->getSource());
+}
+
+template<class Check>
+void Trinity::WorldObjectListSearcher<Check>::VisitObject(DynamicObject* dynObj)
+{
+    if ((i_mapTypeMask & GRID_MAP_TYPE_MASK_DYNAMICOBJECT) && i_check(dynObj))
+        i_objects.push_back(dynObj);
 }
 
 // Gameobject searchers
 
 template<class Check>
 void Trinity::GameObjectSearcher<Check>::Visit(GameObjectMapType &m)
+{
+    for (GameObjectMapType::iterator itr=m.begin(); itr != m.end() && !i_object; ++itr)
+        VisitObject(itr->getSource());
+}
+
+template<class Check>
+void Trinity::GameObjectSearcher<Check>::VisitObject(GameObject* go)
 {
     // already found
     if (i_object)
         return;
 
-    for (GameObjectMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
-    {
-        if (!itr->getSource()->InSamePhase(i_phaseMask))
-            continue;
-
-        if (i_check(itr->getSource()))
-        {
-            i_object = itr->getSource();
-            return;
-        }
-    }
+    if (go->InSamePhase(i_phaseMask) && i_check(go))
+        i_object = go;
 }
 
 template<class Check>
 void Trinity::GameObjectLastSearcher<Check>::Visit(GameObjectMapType &m)
 {
     for (GameObjectMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
-    {
-        if (!itr->getSource()->InSamePhase(i_phaseMask))
-            continue;
+        VisitObject(itr->getSource());
+}
 
-        if (i_check(itr->getSource()))
-            i_object = itr->getSource();
-    }
+template<class Check>
+void Trinity::GameObjectLastSearcher<Check>::VisitObject(GameObject* go)
+{
+    if (go->InSamePhase(i_phaseMask) && i_check(go))
+        i_object = go;
 }
 
 template<class Check>
 void Trinity::GameObjectListSearcher<Check>::Visit(GameObjectMapType &m)
 {
     for (GameObjectMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
-        if (itr->getSource()->InSamePhase(i_phaseMask))
-            if (i_check(itr->getSource()))
-                i_objects.push_back(itr->getSource());
+        VisitObject(itr->getSource());
+}
+
+template<class Check>
+void Trinity::GameObjectListSearcher<Check>::VisitObject(GameObject* go)
+{
+    if (go->InSamePhase(i_phaseMask) && i_check(go))
+        i_objects.push_back(go);
 }
 
 // Unit searchers
 
 template<class Check>
 void Trinity::UnitSearcher<Check>::Visit(CreatureMapType &m)
+{
+    for (CreatureMapType::iterator itr=m.begin(); itr != m.end() && !i_object; ++itr)
+        VisitObject(itr->getSource());
+}
+
+template<class Check>
+void Trinity::UnitSearcher<Check>::VisitObject(Creature* creature)
 {
     // already found
     if (i_object)
         return;
 
-    for (CreatureMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
-    {
-        if (!itr->getSource()->InSamePhase(i_phaseMask))
-            continue;
-
-        if (i_check(itr->getSource()))
-        {
-            i_object = itr->getSource();
-            return;
-        }
-    }
+    if (creature->InSamePhase(i_phaseMask) && i_check(creature))
+        i_object = creature;
 }
 
 template<class Check>
 void Trinity::UnitSearcher<Check>::Visit(PlayerMapType &m)
+{
+    for (PlayerMapType::iterator itr=m.begin(); itr != m.end() && !i_object; ++itr)
+        VisitObject(itr->getSource());
+}
+
+template<class Check>
+void Trinity::UnitSearcher<Check>::VisitObject(Player* player)
 {
     // already found
     if (i_object)
         return;
 
-    for (PlayerMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
-    {
-        if (!itr->getSource()->InSamePhase(i_phaseMask))
-            continue;
-
-        if (i_check(itr->getSource()))
-        {
-            i_object = itr->getSource();
-            return;
-        }
-    }
+    if (player->InSamePhase(i_phaseMask) && i_check(player))
+        i_object = player;
 }
 
 template<class Check>
 void Trinity::UnitLastSearcher<Check>::Visit(CreatureMapType &m)
 {
     for (CreatureMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
-    {
-        if (!itr->getSource()->InSamePhase(i_phaseMask))
-            continue;
+        VisitObject(itr->getSource());
+}
 
-        if (i_check(itr->getSource()))
-            i_object = itr->getSource();
-    }
+template<class Check>
+void Trinity::UnitLastSearcher<Check>::VisitObject(Creature* creature)
+{
+    if (creature->InSamePhase(i_phaseMask) && i_check(creature))
+        i_object = creature;
 }
 
 template<class Check>
 void Trinity::UnitLastSearcher<Check>::Visit(PlayerMapType &m)
 {
     for (PlayerMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
-    {
-        if (!itr->getSource()->InSamePhase(i_phaseMask))
-            continue;
+        VisitObject(itr->getSource());
+}
 
-        if (i_check(itr->getSource()))
-            i_object = itr->getSource();
-    }
+template<class Check>
+void Trinity::UnitLastSearcher<Check>::VisitObject(Player* player)
+{
+    if (player->InSamePhase(i_phaseMask) && i_check(player))
+        i_object = player;
 }
 
 template<class Check>
 void Trinity::UnitListSearcher<Check>::Visit(PlayerMapType &m)
 {
     for (PlayerMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
-        if (itr->getSource()->InSamePhase(i_phaseMask))
-            if (i_check(itr->getSource()))
-                i_objects.push_back(itr->getSource());
+        VisitObject(itr->getSource());
+}
+
+template<class Check>
+void Trinity::UnitListSearcher<Check>::VisitObject(Player* player)
+{
+    if (player->InSamePhase(i_phaseMask) && i_check(player))
+        i_objects.push_back(player);
 }
 
 template<class Check>
 void Trinity::UnitListSearcher<Check>::Visit(CreatureMapType &m)
 {
     for (CreatureMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
-        if (itr->getSource()->InSamePhase(i_phaseMask))
-            if (i_check(itr->getSource()))
-                i_objects.push_back(itr->getSource());
+        VisitObject(itr->getSource());
+}
+
+template<class Check>
+void Trinity::UnitListSearcher<Check>::VisitObject(Creature* creature)
+{
+    if (creature->InSamePhase(i_phaseMask) && i_check(creature))
+        i_objects.push_back(creature);
 }
 
 // Creature searchers
 
 template<class Check>
 void Trinity::CreatureSearcher<Check>::Visit(CreatureMapType &m)
+{
+    for (CreatureMapType::iterator itr=m.begin(); itr != m.end() && !i_object; ++itr)
+        VisitObject(itr->getSource());
+}
+
+template<class Check>
+void Trinity::CreatureSearcher<Check>::VisitObject(Creature* creature)
 {
     // already found
     if (i_object)
         return;
 
-    for (CreatureMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
-    {
-        if (!itr->getSource()->InSamePhase(i_phaseMask))
-            continue;
-
-        if (i_check(itr->getSource()))
-        {
-            i_object = itr->getSource();
-            return;
-        }
-    }
+    if (creature->InSamePhase(i_phaseMask) && i_check(creature))
+        i_object = creature;
 }
 
 template<class Check>
 void Trinity::CreatureLastSearcher<Check>::Visit(CreatureMapType &m)
 {
     for (CreatureMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
-    {
-        if (!itr->getSource()->InSamePhase(i_phaseMask))
-            continue;
+        VisitObject(itr->getSource());
+}
 
-        if (i_check(itr->getSource()))
-            i_object = itr->getSource();
-    }
+template<class Check>
+void Trinity::CreatureLastSearcher<Check>::VisitObject(Creature* creature)
+{
+    if (creature->InSamePhase(i_phaseMask) && i_check(creature))
+        i_object = creature;
 }
 
 template<class Check>
 void Trinity::CreatureListSearcher<Check>::Visit(CreatureMapType &m)
 {
     for (CreatureMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
-        if (itr->getSource()->InSamePhase(i_phaseMask))
-            if (i_check(itr->getSource()))
-                i_objects.push_back(itr->getSource());
+        VisitObject(itr->getSource());
+}
+
+template<class Check>
+void Trinity::CreatureListSearcher<Check>::VisitObject(Creature* creature)
+{
+    if (creature->InSamePhase(i_phaseMask) && i_check(creature))
+        i_objects.push_back(creature);
 }
 
 template<class Check>
 void Trinity::PlayerListSearcher<Check>::Visit(PlayerMapType &m)
 {
     for (PlayerMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
-        if (itr->getSource()->InSamePhase(i_phaseMask))
-            if (i_check(itr->getSource()))
-                i_objects.push_back(itr->getSource());
+        VisitObject(itr->getSource());
+}
+
+template<class Check>
+void Trinity::PlayerListSearcher<Check>::VisitObject(Player* player)
+{
+    if (player->InSamePhase(i_phaseMask) && i_check(player))
+        i_objects.push_back(player);
 }
 
 template<class Check>
 void Trinity::PlayerSearcher<Check>::Visit(PlayerMapType &m)
+{
+    for (PlayerMapType::iterator itr=m.begin(); itr != m.end() && !i_object; ++itr)
+        VisitObject(itr->getSource());
+}
+
+template<class Check>
+void Trinity::PlayerSearcher<Check>::VisitObject(Player* player)
 {
     // already found
     if (i_object)
         return;
 
-    for (PlayerMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
-    {
-        if (!itr->getSource()->InSamePhase(i_phaseMask))
-            continue;
-
-        if (i_check(itr->getSource()))
-        {
-            i_object = itr->getSource();
-            return;
-        }
-    }
+    if (player->InSamePhase(i_phaseMask) && i_check(player))
+        i_object = player;
 }
 
 template<class Check>
-void Trinity::PlayerLastSearcher<Check>::Visit(PlayerMapType& m)
+void Trinity::PlayerLastSearcher<Check>::Visit(PlayerMapType &m)
 {
-    for (PlayerMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
-    {
-        if (!itr->getSource()->InSamePhase(i_phaseMask))
-            continue;
+    for (PlayerMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
+        VisitObject(itr->getSource());
+}
 
-        if (i_check(itr->getSource()))
-            i_object = itr->getSource();
-    }
+template<class Check>
+void Trinity::PlayerLastSearcher<Check>::VisitObject(Player* player)
+{
+    if (player->InSamePhase(i_phaseMask) && i_check(player))
+        i_object = player;
 }
 
 template<class Builder>
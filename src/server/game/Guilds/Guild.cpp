@@ -130,31 +130,41 @@ void Guild::SendSaveEmblemResult(WorldSession* session, GuildEmblemError errCode
 Guild::LogHolder::~LogHolder()
 {
     // Cleanup
-    for (GuildLog::iterator itr = m_log.begin(); itr != m_log.end(); ++itr)
-        delete (*itr);
+    for (uint32 i = 0; i < m_size; ++i)
+        delete GetEntry(i);
 }
 
-// Adds event loaded from database to collection
+// Adds event loaded from database to collection.
+// Events are loaded from the newest to the oldest one, each goes before the ones loaded already.
 inline void Guild::LogHolder::LoadEvent(LogEntry* entry)
 {
     if (m_nextGUID == uint32(GUILD_EVENT_LOG_GUID_UNDEFINED))
         m_nextGUID = entry->GetGUID();
-    m_log.push_front(entry);
+
+    if (m_log.empty())
+        m_log.resize(m_maxRecords, NULL);
+
+    m_head = (m_head + m_maxRecords - 1) % m_maxRecords;
+    m_log[m_head] = entry;
+    ++m_size;
 }
 
 // Adds new event happened in game.
-// If maximum number of events is reached, oldest event is removed from collection.
+// If maximum number of events is reached, it replaces the oldest event.
 inline void Guild::LogHolder::AddEvent(SQLTransaction& trans, LogEntry* entry)
 {
+    if (m_log.empty())
+        m_log.resize(m_maxRecords, NULL);
+
     // Check max records limit
-    if (m_log.size() >= m_maxRecords)
+    if (m_size >= m_maxRecords)
     {
-        LogEntry* oldEntry = m_log.front();
-        delete oldEntry;
-        m_log.pop_front();
+        delete m_log[m_head];
+        m_log[m_head] = entry;
+        m_head = (m_head + 1) % m_maxRecords;
     }
-    // Add event to list
-    m_log.push_back(entry);
+    else
+        m_log[(m_head + m_size++) % m_maxRecords] = entry;
     // Save to DB
     entry->SaveToDB(trans);
 }
@@ -163,14 +173,26 @@ inline void Guild::LogHolder::AddEvent(SQLTransaction& trans, LogEntry* entry)
 inline void Guild::LogHolder::WritePacket(WorldPacket& data) const
 {
     ByteBuffer buffer;
-    data.WriteBits(m_log.size(), 23);
-    for (GuildLog::const_iterator itr = m_log.begin(); itr != m_log.end(); ++itr)
-        (*itr)->WritePacket(data, buffer);
+    data.WriteBits(m_size, 23);
+    for (uint32 i = 0; i < m_size; ++i)
+        GetEntry(i)->WritePacket(data, buffer);
 
     data.FlushBits();
     data.append(buffer);
 }
 
+void Guild::LogHolder::Unload()
+{
+    for (uint32 i = 0; i < m_size; ++i)
+        delete GetEntry(i);
+
+    std::vector<LogEntry*>().swap(m_log);
+    m_head = 0;
+    m_size = 0;
+    m_nextGUID = uint32(GUILD_EVENT_LOG_GUID_UNDEFINED);
+    m_loaded = false;
+}
+
 inline uint32 Guild::LogHolder::GetNextGUID()
 {
     // Next guid was not initialized. It means there are no records for this holder in DB yet.
@@ -551,6 +573,19 @@ void Guild::BankTab::Delete(SQLTransaction& trans, bool removeItemsFromDB)
         }
 }
 
+void Guild::BankTab::UnloadItems()
+{
+    for (uint8 slotId = 0; slotId < GUILD_BANK_MAX_SLOTS; ++slotId)
+        if (Item* pItem = m_items[slotId])
+        {
+            pItem->RemoveFromWorld();
+            delete pItem;
+            m_items[slotId] = NULL;
+        }
+
+    m_itemsLoaded = false;
+}
+
 void Guild::BankTab::SetInfo(std::string const& name, std::string const& icon)
 {
     if (m_name == name && m_icon == icon)
@@ -694,6 +729,45 @@ void Guild::Member::ChangeRank(uint8 newRank)
     CharacterDatabase.Execute(stmt);
 }
 
+void Guild::Member::SaveChangesToDB(SQLTransaction& trans)
+{
+    PreparedStatement* stmt;
+    if (m_saveFlags & GUILD_MEMBER_SAVE_WEEK_REPUTATION)
+    {
+        stmt = CharacterDatabase.GetPreparedStatement(CHAR_UPD_GUILD_MEMBER_WEEK_REPUTATION);
+        stmt->setUInt32(0, m_weekReputation);
+        stmt->setUInt32(1, GUID_LOPART(m_guid));
+        trans->Append(stmt);
+    }
+
+    if (m_saveFlags & GUILD_MEMBER_SAVE_PROFESSIONS)
+    {
+        stmt = CharacterDatabase.GetPreparedStatement(CHAR_UPD_GUILD_MEMBER_PROFESSIONS);
+        for (uint8 i = 0; i < 2; ++i)
+        {
+            stmt->setUInt32(i * 3, m_professionSkillId[i]);
+            stmt->setUInt32(i * 3 + 1, m_professionLevel[i]);
+            stmt->setUInt32(i * 3 + 2, m_professionRank[i]);
+        }
+        stmt->setUInt32(6, GUID_LOPART(m_guid));
+        trans->Append(stmt);
+    }
+
+    m_saveFlags = 0;
+}
+
+bool Guild::Member::SetProfession(uint32 index, uint32 skillId, uint32 level, uint32 rank)
+{
+    if (m_professionSkillId[index] == skillId && m_professionLevel[index] == level && m_professionRank[index] == rank)
+        return false;
+
+    m_professionSkillId[index] = skillId;
+    m_professionLevel[index] = level;
+    m_professionRank[index] = rank;
+    m_saveFlags |= GUILD_MEMBER_SAVE_PROFESSIONS;
+    return true;
+}
+
 void Guild::Member::SaveToDB(SQLTransaction& trans) const
 {
     PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_INS_GUILD_MEMBER);
@@ -756,6 +830,7 @@ uint32 Guild::Member::CalculateReputationReward(uint32 const reputation)
     else
     {
         m_weekReputation += reputation;
+        m_saveFlags |= GUILD_MEMBER_SAVE_WEEK_REPUTATION;
         if (m_weekReputation > cap)
             return m_weekReputation - cap;
         else
@@ -798,16 +873,21 @@ void Guild::Member::UpdateBankWithdrawValue(SQLTransaction& trans, uint8 tabId,
     CharacterDatabase.ExecuteOrAppend(trans, stmt);
 }
 
-void Guild::Member::ResetValues(bool weekly /* = false*/)
+bool Guild::Member::ResetValues(bool weekly /* = false*/)
 {
     for (uint8 tabId = 0; tabId <= GUILD_BANK_MAX_TABS; ++tabId)
         m_bankWithdraw[tabId] = 0;
 
-    if (weekly)
-    {
-        m_weekActivity = 0;
-        m_weekReputation = 0;
-    }
+    if (!weekly)
+        return false;
+
+    m_weekActivity = 0;
+    if (!m_weekReputation)
+        return false;
+
+    m_weekReputation = 0;
+    m_saveFlags |= GUILD_MEMBER_SAVE_WEEK_REPUTATION;
+    return true;
 }
 
 // Get amount of money/slots left for today.
@@ -1472,7 +1552,10 @@ Guild::Guild():
     m_achievementMgr(this),
     _level(1),
     _experience(0),
-    _todayExperience(0)
+    _todayExperience(0),
+    m_saveFlags(0),
+    m_criteriaLoaded(false),
+    m_lastUsed(0)
 {
     memset(&m_bankEventLog, 0, (GUILD_BANK_MAX_TABS + 1) * sizeof(LogHolder*));
     m_challengesMgr = new ChallengesMgr(this);
@@ -1530,7 +1613,9 @@ bool Guild::Create(Player* pLeader, std::string const& name)
     _level = 1;
     _experience = 0;
     _todayExperience = 0;
-    _CreateLogHolders();
+    _CreateLogHolders(true);
+    m_criteriaLoaded = true;
+    m_lastUsed = m_createdDate;
 
     sLog->outDebug(LOG_FILTER_GUILD, "GUILD: creating guild [%s] for leader %s (%u)",
         name.c_str(), pLeader->GetName().c_str(), GUID_LOPART(m_leaderGuid));
@@ -1602,6 +1687,8 @@ void Guild::Disband()
     trans->Append(stmt);
 
     // Free bank tab used memory and delete items stored in them
+    for (uint8 tabId = 0; tabId < _GetPurchasedTabsSize(); ++tabId)
+        _LoadBankTabItems(tabId);
     _DeleteBankItems(trans, true);
 
     stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_GUILD_BANK_ITEMS);
@@ -1627,20 +1714,70 @@ void Guild::Disband()
     sGuildMgr->RemoveGuild(m_id);
 }
 
-void Guild::SaveToDB()
+// Writes what changed since the last save, everything else is written as it changes.
+// Returns false if nothing did.
+bool Guild::SaveToDB()
 {
     SQLTransaction trans = CharacterDatabase.BeginTransaction();
 
-    PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_UPD_GUILD_EXPERIENCE);
-    stmt->setUInt32(0, GetLevel());
-    stmt->setUInt64(1, GetExperience());
-    stmt->setUInt64(2, GetTodayExperience());
-    stmt->setUInt32(3, GetId());
-    trans->Append(stmt);
+    if (m_saveFlags & GUILD_SAVE_EXPERIENCE)
+    {
+        PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_UPD_GUILD_EXPERIENCE);
+        stmt->setUInt32(0, GetLevel());
+        stmt->setUInt64(1, GetExperience());
+        stmt->setUInt64(2, GetTodayExperience());
+        stmt->setUInt32(3, GetId());
+        trans->Append(stmt);
+    }
+
+    if (m_saveFlags & GUILD_SAVE_MEMBERS)
+        for (Members::iterator itr = m_members.begin(); itr != m_members.end(); ++itr)
+            itr->second->SaveChangesToDB(trans);
+
+    m_saveFlags = 0;
 
     m_achievementMgr.SaveToDB(trans);
 
+    if (!trans->GetSize())
+        return false;
+
     CharacterDatabase.CommitTransaction(trans);
+    return true;
+}
+
+bool Guild::UnloadIdleData(time_t now)
+{
+    bool loaded = m_criteriaLoaded || m_eventLog->IsLoaded();
+    for (uint8 tabId = 0; tabId <= GUILD_BANK_MAX_TABS && !loaded; ++tabId)
+        loaded = m_bankEventLog[tabId]->IsLoaded();
+    for (uint8 tabId = 0; tabId < _GetPurchasedTabsSize() && !loaded; ++tabId)
+        loaded = m_bankTabs[tabId]->AreItemsLoaded();
+
+    if (!loaded || now < m_lastUsed + time_t(sWorld->getIntConfig(CONFIG_GUILD_IDLE_UNLOAD_TIME) * MINUTE))
+        return false;
+
+    for (Members::const_iterator itr = m_members.begin(); itr != m_members.end(); ++itr)
+        if (itr->second->IsOnline())
+            return false;
+
+    // criteria progress changed since the last save would be lost
+    SaveToDB();
+    if (m_criteriaLoaded)
+    {
+        m_achievementMgr.UnloadCriteriaProgress();
+        m_criteriaLoaded = false;
+    }
+
+    if (m_eventLog->IsLoaded())
+        m_eventLog->Unload();
+    for (uint8 tabId = 0; tabId <= GUILD_BANK_MAX_TABS; ++tabId)
+        if (m_bankEventLog[tabId]->IsLoaded())
+            m_bankEventLog[tabId]->Unload();
+    for (uint8 tabId = 0; tabId < _GetPurchasedTabsSize(); ++tabId)
+        if (m_bankTabs[tabId]->AreItemsLoaded())
+            m_bankTabs[tabId]->UnloadItems();
+
+    return true;
 }
 
 void Guild::UpdateMemberData(Player* player, uint8 dataid, uint32 value)
@@ -1678,10 +1815,20 @@ void Guild::OnPlayerStatusChange(Player* player, uint32 flag, bool state)
 
 uint32 Guild::CalculateReputationRewardForMember(uint64 const& guid, uint32 const reputation)
 {
-    if (Member* member = GetMember(guid))
-        return member->CalculateReputationReward(reputation);
-    else
+    Member* member = GetMember(guid);
+    if (!member)
         return 0;
+
+    uint32 reward = member->CalculateReputationReward(reputation);
+    if (reward)
+        m_saveFlags |= GUILD_SAVE_MEMBERS;
+    return reward;
+}
+
+void Guild::UpdateMemberProfession(Member* member, uint32 index, uint32 skillId, uint32 level, uint32 rank)
+{
+    if (member->SetProfession(index, skillId, level, rank))
+        m_saveFlags |= GUILD_SAVE_MEMBERS;
 }
 
 void Guild::HandleRoster(WorldSession* session)
@@ -2422,6 +2569,7 @@ void Guild::HandleMemberLogout(WorldSession* session)
         member->ResetFlags();
     }
     _BroadcastEvent(GE_SIGNED_OFF, player->GetGUID(), player->GetName().c_str());
+    m_lastUsed = ::time(NULL);
 
     SaveToDB();
 }
@@ -2501,8 +2649,10 @@ void Guild::HandleGuildPartyRequest(WorldSession* session)
     sLog->outDebug(LOG_FILTER_GUILD, "SMSG_GUILD_PARTY_STATE_RESPONSE [%s]", session->GetPlayerInfo().c_str());
 }
 
-void Guild::SendEventLog(WorldSession* session) const
+void Guild::SendEventLog(WorldSession* session)
 {
+    _LoadEventLog();
+
     WorldPacket data(SMSG_GUILD_EVENT_LOG_QUERY_RESULT, 1 + m_eventLog->GetSize() * (1 + 8 + 4));
     m_eventLog->WritePacket(data);
     session->SendPacket(&data);
@@ -2512,18 +2662,14 @@ void Guild::SendEventLog(WorldSession* session) const
 void Guild::SendNewsUpdate(WorldSession* session)
 {
     uint32 size = m_newsLog->GetSize();
-    GuildLog* logs = m_newsLog->GetGuildLog();
-
-    if (!logs)
-        return;
 
     WorldPacket data(SMSG_GUILD_NEWS_UPDATE, (21 + size * (26 + 8)) / 8 + (8 + 6 * 4) * size);
     data.WriteBits(size, 21);
 
-    for (GuildLog::const_iterator itr = logs->begin(); itr != logs->end(); ++itr)
+    for (uint32 i = 0; i < size; ++i)
     {
         data.WriteBits(0, 26); // Not yet implemented used for guild achievements
-        ObjectGuid guid = ((NewsLogEntry*)(*itr))->GetPlayerGuid();
+        ObjectGuid guid = ((NewsLogEntry*)m_newsLog->GetEntry(i))->GetPlayerGuid();
 
         data.WriteBit(guid[7]);
         data.WriteBit(guid[0]);
@@ -2537,9 +2683,9 @@ void Guild::SendNewsUpdate(WorldSession* session)
 
     data.FlushBits();
 
-    for (GuildLog::const_iterator itr = logs->begin(); itr != logs->end(); ++itr)
+    for (uint32 i = 0; i < size; ++i)
     {
-        NewsLogEntry* news = (NewsLogEntry*)(*itr);
+        NewsLogEntry* news = (NewsLogEntry*)m_newsLog->GetEntry(i);
         ObjectGuid guid = news->GetPlayerGuid();
         data.WriteByteSeq(guid[5]);
 
@@ -2564,11 +2710,13 @@ void Guild::SendNewsUpdate(WorldSession* session)
     sLog->outDebug(LOG_FILTER_GUILD, "SMSG_GUILD_NEWS_UPDATE [%s]", session->GetPlayerInfo().c_str());
 }
 
-void Guild::SendBankLog(WorldSession* session, uint8 tabId) const
+void Guild::SendBankLog(WorldSession* session, uint8 tabId)
 {
     // GUILD_BANK_MAX_TABS send by client for money log
     if (tabId < _GetPurchasedTabsSize() || tabId == GUILD_BANK_MAX_TABS)
     {
+        _LoadBankEventLog(tabId);
+
         LogHolder const* log = m_bankEventLog[tabId];
         WorldPacket data(SMSG_GUILD_BANK_LOG_QUERY_RESULT, log->GetSize() * (4 * 4 + 1) + 1 + 1);
         data.WriteBit(GetLevel() >= 5 && tabId == GUILD_BANK_MAX_TABS);     // has Cash Flow perk
@@ -2630,6 +2778,9 @@ void Guild::SendLoginInfo(WorldSession* session)
     Member* member = GetMember(player->GetGUID());
     if (!member)
         return;
+
+    _LoadCriteriaProgress();
+    m_lastUsed = ::time(NULL);
     /*
         Login sequence:
           SMSG_GUILD_EVENT - GE_MOTD
@@ -2700,9 +2851,9 @@ bool Guild::LoadFromDB(Field* fields)
 
     m_bankTabs.resize(purchasedTabs);
     for (uint8 i = 0; i < purchasedTabs; ++i)
-        m_bankTabs[i] = new BankTab(m_id, i);
+        m_bankTabs[i] = new BankTab(m_id, i, false);
 
-    _CreateLogHolders();
+    _CreateLogHolders(false);
     return true;
 }
 
@@ -2818,18 +2969,6 @@ void Guild::LoadBankTabFromDB(Field* fields)
         m_bankTabs[tabId]->LoadFromDB(fields);
 }
 
-bool Guild::LoadBankItemFromDB(Field* fields)
-{
-    uint8 tabId = fields[12].GetUInt8();
-    if (tabId >= _GetPurchasedTabsSize())
-    {
-        sLog->outError(LOG_FILTER_GUILD, "Invalid tab for item (GUID: %u, id: #%u) in guild bank, skipped.",
-            fields[14].GetUInt32(), fields[15].GetUInt32());
-        return false;
-    }
-    return m_bankTabs[tabId]->LoadItemFromDB(fields);
-}
-
 // Validates guild data loaded from database. Returns false if guild should be deleted.
 bool Guild::Validate()
 {
@@ -3054,9 +3193,7 @@ bool Guild::AddMember(uint64 guid, uint8 rankId)
         {
             if (int32 skillId = player->GetUInt32Value(PLAYER_PROFESSION_SKILL_LINE_1 + i))
             {
-                member->SetProfessionSkillId(i, skillId);
-                member->SetProfessionLevel(i, player->GetSkillValue(skillId));
-                member->SetProfessionRank(i, player->GetSkillStep(skillId));
+                UpdateMemberProfession(member, i, skillId, player->GetSkillValue(skillId), player->GetSkillStep(skillId));
             }
         }
     }
@@ -3167,6 +3304,9 @@ void Guild::SwapItems(Player* player, uint8 tabId, uint8 slotId, uint8 destTabId
     if (tabId == destTabId && slotId == destSlotId)
         return;
 
+    _LoadBankTabItems(tabId);
+    _LoadBankTabItems(destTabId);
+
     BankMoveItemData from(this, player, tabId, slotId);
     BankMoveItemData to(this, player, destTabId, destSlotId);
     _MoveItems(&from, &to, splitedAmount);
@@ -3177,6 +3317,8 @@ void Guild::SwapItemsWithInventory(Player* player, bool toChar, uint8 tabId, uin
     if ((slotId >= GUILD_BANK_MAX_SLOTS && slotId != NULL_SLOT) || tabId >= _GetPurchasedTabsSize())
         return;
 
+    _LoadBankTabItems(tabId);
+
     BankMoveItemData bankData(this, player, tabId, slotId);
     PlayerMoveItemData charData(this, player, playerBag, playerSlotId);
     if (toChar)
@@ -3196,18 +3338,98 @@ void Guild::SetBankTabText(uint8 tabId, std::string const& text)
 }
 
 // Private methods
-void Guild::_CreateLogHolders()
+void Guild::_CreateLogHolders(bool loaded)
 {
     m_eventLog = new LogHolder(m_id, sWorld->getIntConfig(CONFIG_GUILD_EVENT_LOG_COUNT));
     m_newsLog = new LogHolder(m_id, sWorld->getIntConfig(CONFIG_GUILD_NEWS_LOG_COUNT));
+    m_newsLog->SetLoaded();
     for (uint8 tabId = 0; tabId <= GUILD_BANK_MAX_TABS; ++tabId)
         m_bankEventLog[tabId] = new LogHolder(m_id, sWorld->getIntConfig(CONFIG_GUILD_BANK_EVENT_LOG_COUNT));
+
+    if (loaded)
+    {
+        m_eventLog->SetLoaded();
+        for (uint8 tabId = 0; tabId <= GUILD_BANK_MAX_TABS; ++tabId)
+            m_bankEventLog[tabId]->SetLoaded();
+    }
+}
+
+void Guild::_LoadEventLog()
+{
+    m_lastUsed = ::time(NULL);
+    if (m_eventLog->IsLoaded())
+        return;
+
+    m_eventLog->SetLoaded();
+
+    PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_GUILD_EVENTLOGS);
+    stmt->setUInt32(0, m_id);
+    stmt->setUInt32(1, m_eventLog->GetMaxRecords());
+    if (PreparedQueryResult result = CharacterDatabase.Query(stmt))
+    {
+        do
+            LoadEventLogFromDB(result->Fetch());
+        while (result->NextRow());
+    }
+}
+
+void Guild::_LoadBankEventLog(uint8 tabId)
+{
+    m_lastUsed = ::time(NULL);
+    LogHolder* pLog = m_bankEventLog[tabId];
+    if (pLog->IsLoaded())
+        return;
+
+    pLog->SetLoaded();
+
+    PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_GUILD_BANK_EVENTLOGS);
+    stmt->setUInt32(0, m_id);
+    stmt->setUInt8 (1, tabId == GUILD_BANK_MAX_TABS ? uint8(GUILD_BANK_MONEY_LOGS_TAB) : tabId);
+    stmt->setUInt32(2, pLog->GetMaxRecords());
+    if (PreparedQueryResult result = CharacterDatabase.Query(stmt))
+    {
+        do
+            LoadBankEventLogFromDB(result->Fetch());
+        while (result->NextRow());
+    }
+}
+
+void Guild::_LoadBankTabItems(uint8 tabId)
+{
+    m_lastUsed = ::time(NULL);
+    BankTab* pTab = GetBankTab(tabId);
+    if (!pTab || pTab->AreItemsLoaded())
+        return;
+
+    pTab->SetItemsLoaded();
+
+    PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_GUILD_BANK_TAB_ITEMS);
+    stmt->setUInt32(0, m_id);
+    stmt->setUInt8 (1, tabId);
+    if (PreparedQueryResult result = CharacterDatabase.Query(stmt))
+    {
+        do
+            pTab->LoadItemFromDB(result->Fetch());
+        while (result->NextRow());
+    }
+}
+
+void Guild::_LoadCriteriaProgress()
+{
+    if (m_criteriaLoaded)
+        return;
+
+    m_criteriaLoaded = true;
+
+    PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_GUILD_ACHIEVEMENT_CRITERIA);
+    stmt->setUInt32(0, m_id);
+    m_achievementMgr.LoadFromDB(PreparedQueryResult(NULL), CharacterDatabase.Query(stmt));
 }
 
 void Guild::_CreateNewBankTab()
 {
     uint8 tabId = _GetPurchasedTabsSize();                      // Next free id
-    m_bankTabs.push_back(new BankTab(m_id, tabId));
+    m_bankTabs.push_back(new BankTab(m_id, tabId, true));
 
     SQLTransaction trans = CharacterDatabase.BeginTransaction();
 
@@ -3443,6 +3665,8 @@ inline bool Guild::_MemberHasTabRights(uint64 guid, uint8 tabId, uint32 rights)
 // Add new event log record
 inline void Guild::_LogEvent(GuildEventLogTypes eventType, uint32 playerGuid1, uint32 playerGuid2, uint8 newRank)
 {
+    _LoadEventLog();
+
     SQLTransaction trans = CharacterDatabase.BeginTransaction();
     m_eventLog->AddEvent(trans, new EventLogEntry(m_id, m_eventLog->GetNextGUID(), eventType, playerGuid1, playerGuid2, newRank));
     CharacterDatabase.CommitTransaction(trans);
@@ -3466,6 +3690,7 @@ void Guild::_LogBankEvent(SQLTransaction& trans, GuildBankEventLogTypes eventTyp
         tabId = GUILD_BANK_MAX_TABS;
         dbTabId = GUILD_BANK_MONEY_LOGS_TAB;
     }
+    _LoadBankEventLog(tabId);
     LogHolder* pLog = m_bankEventLog[tabId];
     pLog->AddEvent(trans, new BankEventLogEntry(m_id, pLog->GetNextGUID(), eventType, dbTabId, lowguid, itemOrMoney, itemStackCount, destTabId));
 
@@ -3712,12 +3937,15 @@ void Guild::_BroadcastEvent(GuildEvents guildEvent, uint64 guid, const char* par
         sLog->outDebug(LOG_FILTER_GUILD, "SMSG_GUILD_EVENT [Broadcast] Event: %s (%u)", _GetGuildEventString(guildEvent).c_str(), guildEvent);
 }
 
-void Guild::SendBankList(WorldSession* session, uint8 tabId, bool withContent, bool withTabInfo) const
+void Guild::SendBankList(WorldSession* session, uint8 tabId, bool withContent, bool withTabInfo)
 {
     Member const* member = GetMember(session->GetPlayer()->GetGUID());
     if (!member) // Shouldn't happen, just in case
         return;
 
+    if (withContent)
+        _LoadBankTabItems(tabId);
+
     ByteBuffer tabData;
     WorldPacket data(SMSG_GUILD_BANK_LIST, 500);
     data.WriteBit(0);
@@ -3881,6 +4109,8 @@ void Guild::GiveXP(uint32 xp, Player* source)
     if (!xp)
         return;
 
+    m_saveFlags |= GUILD_SAVE_EXPERIENCE;
+
     uint32 oldLevel = GetLevel();
 
     // Ding, mon!
@@ -3942,7 +4172,8 @@ void Guild::ResetTimes(bool weekly)
     _todayExperience = 0;
     for (Members::const_iterator itr = m_members.begin(); itr != m_members.end(); ++itr)
     {
-        itr->second->ResetValues(weekly);
+        if (itr->second->ResetValues(weekly))
+            m_saveFlags |= GUILD_SAVE_MEMBERS;
         if (Player* player = itr->second->FindPlayer())
         {
             //SendGuildXP(player->GetSession());
@@ -3976,24 +4207,27 @@ bool Guild::HasAchieved(uint32 achievementId) const
 
 void Guild::UpdateAchievementCriteria(AchievementCriteriaTypes type, uint64 miscValue1, uint64 miscValue2, uint64 miscValue3, Unit* unit, Player* player)
 {
+    // no member online, the progress would be saved over the one in DB
+    if (!m_criteriaLoaded)
+        return;
+
     m_achievementMgr.UpdateAchievementCriteria(type, miscValue1, miscValue2, miscValue3, unit, player);
 }
 
 void Guild::HandleNewsSetSticky(WorldSession* session, uint32 newsId, bool sticky)
 {
-    GuildLog* logs = m_newsLog->GetGuildLog();
-    GuildLog::iterator itr = logs->begin();
-    while (itr != logs->end() && (*itr)->GetGUID() != newsId)
-        ++itr;
+    NewsLogEntry* news = NULL;
+    for (uint32 i = 0; i < m_newsLog->GetSize() && !news; ++i)
+        if (m_newsLog->GetEntry(i)->GetGUID() == newsId)
+            news = (NewsLogEntry*)m_newsLog->GetEntry(i);
 
-    if (itr == logs->end())
+    if (!news)
     {
         sLog->outDebug(LOG_FILTER_GUILD, "HandleNewsSetSticky: [%s] requested unknown newsId %u - Sticky: %u",
             session->GetPlayerInfo().c_str(), newsId, sticky);
         return;
     }
 
-    NewsLogEntry* news = (NewsLogEntry*)(*itr);
     news->SetSticky(sticky);
 
     sLog->outDebug(LOG_FILTER_GUILD, "HandleNewsSetSticky: [%s] chenged newsId %u sticky to %u",
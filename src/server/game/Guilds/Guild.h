@@ -247,6 +247,19 @@ enum GuildMemberFlags
     GUILDMEMBER_STATUS_MOBILE           = 0x0008, // remote chat from mobile app
 };
 
+// What the periodic guild save has to write, everything else is written as it changes
+enum GuildSaveFlags
+{
+    GUILD_SAVE_EXPERIENCE               = 0x01,                 // level, experience and today's experience
+    GUILD_SAVE_MEMBERS                  = 0x02                  // some members have GuildMemberSaveFlags
+};
+
+enum GuildMemberSaveFlags
+{
+    GUILD_MEMBER_SAVE_WEEK_REPUTATION   = 0x01,
+    GUILD_MEMBER_SAVE_PROFESSIONS       = 0x02
+};
+
 enum GuildNews
 {
     GUILD_NEWS_GUILD_ACHIEVEMENT        = 0,
@@ -373,7 +386,8 @@ public:
             m_achievementPoints(0),
             m_totalActivity(0),
             m_weekActivity(0),
-            m_weekReputation(0)
+            m_weekReputation(0),
+            m_saveFlags(0)
         {
             memset(m_bankWithdraw, 0, (GUILD_BANK_MAX_TABS + 1) * sizeof(int32));
         }
@@ -396,6 +410,8 @@ public:
 
         bool LoadFromDB(Field* fields);
         void SaveToDB(SQLTransaction& trans) const;
+        // Writes the data changed since the last save
+        void SaveChangesToDB(SQLTransaction& trans);
 
         uint64 GetGUID() const { return m_guid; }
         std::string const& GetName() const { return m_name; }
@@ -425,7 +441,8 @@ public:
 
         void UpdateBankWithdrawValue(SQLTransaction& trans, uint8 tabId, uint32 amount);
         int32 GetBankWithdrawValue(uint8 tabId) const;
-        void ResetValues(bool weekly = false);
+        // returns true if something the guild save writes changed
+        bool ResetValues(bool weekly = false);
 
         inline Player* FindPlayer() const { return ObjectAccessor::FindPlayer(m_guid); }
 
@@ -433,9 +450,8 @@ public:
         uint32 GetProfessionSkillId(uint32 index) {return m_professionSkillId[index]; }
         uint32 GetProfessionLevel(uint32 index) {return m_professionLevel[index]; }
         uint32 GetProfessionRank(uint32 index) {return m_professionRank[index]; }
-        void SetProfessionSkillId(uint32 index, uint32 skillId) { m_professionSkillId[index] = skillId; CharacterDatabase.PExecute("UPDATE guild_member SET ProfessionSkillId%u = %u WHERE guid = %u", index, skillId, m_guid);}
-        void SetProfessionLevel(uint32 index, uint32 level) { m_professionLevel[index] = level; CharacterDatabase.PExecute("UPDATE guild_member SET ProfessionLevel%u = %u WHERE guid = %u", index, level, m_guid);}
-        void SetProfessionRank(uint32 index, uint32 rank) { m_professionRank[index] = rank; CharacterDatabase.PExecute("UPDATE guild_member SET ProfessionRank%u = %u WHERE guid = %u", index, rank, m_guid);}
+        // returns true if the profession changed, it is written by the next guild save
+        bool SetProfession(uint32 index, uint32 skillId, uint32 level, uint32 rank);
 
     private:
         uint32 m_guildId;
@@ -461,6 +477,8 @@ public:
         uint32 m_professionSkillId[2];
         uint32 m_professionLevel[2];
         uint32 m_professionRank[2];
+
+        uint8 m_saveFlags;                                  // GuildMemberSaveFlags
     };
 
     // Base class for event entries
@@ -579,18 +597,21 @@ public:
         uint32 m_value;
     };
 
-    // Class encapsulating work with events collection
-    typedef std::list<LogEntry*> GuildLog;
-
+    // Class encapsulating work with events collection.
+    // Events are kept in a ring of maxRecords entries, a new event replaces the oldest one once it is full.
     class LogHolder
     {
     public:
-        LogHolder(uint32 guildId, uint32 maxRecords) : m_guildId(guildId), m_maxRecords(maxRecords), m_nextGUID(uint32(GUILD_EVENT_LOG_GUID_UNDEFINED)) { }
+        LogHolder(uint32 guildId, uint32 maxRecords) : m_guildId(guildId), m_maxRecords(maxRecords), m_head(0), m_size(0),
+            m_nextGUID(uint32(GUILD_EVENT_LOG_GUID_UNDEFINED)), m_loaded(false) { }
         ~LogHolder();
 
-        uint8 GetSize() const { return uint8(m_log.size()); }
+        uint32 GetSize() const { return m_size; }
+        uint32 GetMaxRecords() const { return m_maxRecords; }
+        // Events from the oldest one (0) to the newest one (GetSize() - 1)
+        LogEntry* GetEntry(uint32 index) const { return m_log[(m_head + index) % m_maxRecords]; }
         // Checks if new log entry can be added to holder when loading from DB
-        inline bool CanInsert() const { return m_log.size() < m_maxRecords; }
+        inline bool CanInsert() const { return m_size < m_maxRecords; }
         // Adds event from DB to collection
         void LoadEvent(LogEntry* entry);
         // Adds new event to collection and saves it to DB
@@ -598,13 +619,21 @@ public:
         // Writes information about all events to packet
         void WritePacket(WorldPacket& data) const;
         uint32 GetNextGUID();
-        GuildLog* GetGuildLog() { return &m_log; } // Hack needed for news as WritePacket can't be used
+
+        // Events are read from DB the first time the log is used
+        bool IsLoaded() const { return m_loaded; }
+        void SetLoaded() { m_loaded = true; }
+        // Frees the events, they are read from DB again the next time the log is used
+        void Unload();
 
     private:
-        GuildLog m_log;
+        std::vector<LogEntry*> m_log;                       // allocated with the first event
         uint32 m_guildId;
         uint32 m_maxRecords;
+        uint32 m_head;                                      // oldest event
+        uint32 m_size;
         uint32 m_nextGUID;
+        bool m_loaded;
     };
 
     // Class encapsulating guild rank data
@@ -657,7 +686,7 @@ public:
     class BankTab
     {
     public:
-        BankTab(uint32 guildId, uint8 tabId) : m_guildId(guildId), m_tabId(tabId)
+        BankTab(uint32 guildId, uint8 tabId, bool itemsLoaded) : m_guildId(guildId), m_tabId(tabId), m_itemsLoaded(itemsLoaded)
         {
             memset(m_items, 0, GUILD_BANK_MAX_SLOTS * sizeof(Item*));
         }
@@ -685,9 +714,16 @@ public:
         inline Item* GetItem(uint8 slotId) const { return slotId < GUILD_BANK_MAX_SLOTS ?  m_items[slotId] : NULL; }
         bool SetItem(SQLTransaction& trans, uint8 slotId, Item* item);
 
+        // Items are read from DB the first time the tab is used
+        bool AreItemsLoaded() const { return m_itemsLoaded; }
+        void SetItemsLoaded() { m_itemsLoaded = true; }
+        // Frees the items, they are read from DB again the next time the tab is used
+        void UnloadItems();
+
     private:
         uint32 m_guildId;
         uint8 m_tabId;
+        bool m_itemsLoaded;
 
         Item* m_items[GUILD_BANK_MAX_SLOTS];
         std::string m_name;
@@ -833,7 +869,11 @@ public:
     bool Create(Player* pLeader, std::string const& name);
     void Disband();
 
-    void SaveToDB();
+    // false if there was nothing to save
+    bool SaveToDB();
+    // Frees the data loaded on first use once no member was online for Guild.IdleUnloadTime.
+    // Returns false if there was nothing to free.
+    bool UnloadIdleData(time_t now);
 
     // Getters
     uint32 GetId() const { return m_id; }
@@ -870,15 +910,16 @@ public:
     void HandleNewsSetSticky(WorldSession* session, uint32 newsId, bool sticky);
 
     void UpdateMemberData(Player* player, uint8 dataid, uint32 value);
+    void UpdateMemberProfession(Member* member, uint32 index, uint32 skillId, uint32 level, uint32 rank);
     void OnPlayerStatusChange(Player* player, uint32 flag, bool state);
     uint32 CalculateReputationRewardForMember(uint64 const& guid, uint32 const reputation);
 
     // Send info to client
     void SendChallengeComplete(uint32 index, uint32 goldreward, uint32 ccount, uint32 xp, uint32 tcount) const;
     void SendGuildRankInfo(WorldSession* session) const;
-    void SendEventLog(WorldSession* session) const;
-    void SendBankLog(WorldSession* session, uint8 tabId) const;
-    void SendBankList(WorldSession* session, uint8 tabId, bool withContent, bool withTabInfo) const;
+    void SendEventLog(WorldSession* session);
+    void SendBankLog(WorldSession* session, uint8 tabId);
+    void SendBankList(WorldSession* session, uint8 tabId, bool withContent, bool withTabInfo);
     void SendGuildXP(WorldSession* session = NULL) const;
     void SendBankTabText(WorldSession* session, uint8 tabId) const;
     void SendPermissions(WorldSession* session) const;
@@ -895,7 +936,6 @@ public:
     void LoadBankRightFromDB(Field* fields);
     void LoadBankTabFromDB(Field* fields);
     bool LoadBankEventLogFromDB(Field* fields);
-    bool LoadBankItemFromDB(Field* fields);
     bool Validate();
 
     // Broadcasts
@@ -990,6 +1030,10 @@ protected:
     uint64 _experience;
     uint64 _todayExperience;
 
+    uint8 m_saveFlags;                                      // GuildSaveFlags
+    bool m_criteriaLoaded;                                  // achievement criteria progress
+    time_t m_lastUsed;                                      // last member login or logout, or data loaded on first use
+
 private:
     inline uint8 _GetRanksSize() const { return uint8(m_ranks.size()); }
     inline const RankInfo* GetRankInfo(uint8 rankId) const { return rankId < _GetRanksSize() ? &m_ranks[rankId] : NULL; }
@@ -1025,7 +1069,14 @@ private:
     }
 
     // Creates log holders (either when loading or when creating guild)
-    void _CreateLogHolders();
+    void _CreateLogHolders(bool loaded);
+    // Read the logs and the bank tab items from DB the first time they are used, by the world thread.
+    // The news are loaded with the guild, they are sent at every login and written by the map threads.
+    void _LoadEventLog();
+    void _LoadBankEventLog(uint8 tabId);
+    void _LoadBankTabItems(uint8 tabId);
+    // Criteria progress is only needed while members are online, it is read at the first login
+    void _LoadCriteriaProgress();
     // Tries to create new bank tab
     void _CreateNewBankTab();
     // Creates default guild ranks with names in given locale
@@ -39,8 +39,30 @@ void GuildMgr::RemoveGuild(uint32 guildId)
 
 void GuildMgr::SaveGuilds()
 {
+    uint32 oldMSTime = getMSTime();
+    uint32 count = 0;
+
     for (GuildContainer::iterator itr = GuildStore.begin(); itr != GuildStore.end(); ++itr)
-        itr->second->SaveToDB();
+        if (itr->second->SaveToDB())
+            ++count;
+
+    sLog->outDebug(LOG_FILTER_GUILD, "Saved %u of %u guilds in %u ms", count, uint32(GuildStore.size()), GetMSTimeDiffToNow(oldMSTime));
+}
+
+void GuildMgr::UnloadIdleGuildData()
+{
+    if (!sWorld->getIntConfig(CONFIG_GUILD_IDLE_UNLOAD_TIME))
+        return;
+
+    uint32 oldMSTime = getMSTime();
+    uint32 count = 0;
+    time_t now = time(NULL);
+
+    for (GuildContainer::iterator itr = GuildStore.begin(); itr != GuildStore.end(); ++itr)
+        if (itr->second->UnloadIdleData(now))
+            ++count;
+
+    sLog->outDebug(LOG_FILTER_GUILD, "Unloaded idle data of %u guilds in %u ms", count, GetMSTimeDiffToNow(oldMSTime));
 }
 
 uint32 GuildMgr::GenerateGuildId()
@@ -263,71 +285,15 @@ void GuildMgr::LoadGuilds()
         }
     }
 
-    // 5. Load all event logs
-    sLog->outInfo(LOG_FILTER_SERVER_LOADING, "Loading guild event logs...");
+    // 5. Trim guild event logs, they are loaded when first shown or written to
     {
-        uint32 oldMSTime = getMSTime();
-
         CharacterDatabase.DirectPExecute("DELETE FROM guild_eventlog WHERE LogGuid > %u", sWorld->getIntConfig(CONFIG_GUILD_EVENT_LOG_COUNT));
-
-                                                     //          0        1        2          3            4            5        6
-        QueryResult result = CharacterDatabase.Query("SELECT guildid, LogGuid, EventType, PlayerGuid1, PlayerGuid2, NewRank, TimeStamp FROM guild_eventlog ORDER BY TimeStamp DESC, LogGuid DESC");
-
-        if (!result)
-        {
-            sLog->outInfo(LOG_FILTER_SERVER_LOADING, ">> Loaded 0 guild event logs. DB table `guild_eventlog` is empty.");
-        }
-        else
-        {
-            uint32 count = 0;
-            do
-            {
-                Field* fields = result->Fetch();
-                uint32 guildId = fields[0].GetUInt32();
-
-                if (Guild* guild = GetGuildById(guildId))
-                    guild->LoadEventLogFromDB(fields);
-
-                ++count;
-            }
-            while (result->NextRow());
-
-            sLog->outInfo(LOG_FILTER_SERVER_LOADING, ">> Loaded %u guild event logs in %u ms", count, GetMSTimeDiffToNow(oldMSTime));
-        }
     }
 
-    // 6. Load all bank event logs
-    sLog->outInfo(LOG_FILTER_SERVER_LOADING, "Loading guild bank event logs...");
+    // 6. Trim bank event logs, each tab's log is loaded when first shown or written to
     {
-        uint32 oldMSTime = getMSTime();
-
         // Remove log entries that exceed the number of allowed entries per guild
         CharacterDatabase.DirectPExecute("DELETE FROM guild_bank_eventlog WHERE LogGuid > %u", sWorld->getIntConfig(CONFIG_GUILD_BANK_EVENT_LOG_COUNT));
-
-                                                     //          0        1      2        3          4           5            6               7          8
-        QueryResult result = CharacterDatabase.Query("SELECT guildid, TabId, LogGuid, EventType, PlayerGuid, ItemOrMoney, ItemStackCount, DestTabId, TimeStamp FROM guild_bank_eventlog ORDER BY TimeStamp DESC, LogGuid DESC");
-
-        if (!result)
-        {
-            sLog->outInfo(LOG_FILTER_SERVER_LOADING, ">> Loaded 0 guild bank event logs. DB table `guild_bank_eventlog` is empty.");
-        }
-        else
-        {
-            uint32 count = 0;
-            do
-            {
-                Field* fields = result->Fetch();
-                uint32 guildId = fields[0].GetUInt32();
-
-                if (Guild* guild = GetGuildById(guildId))
-                    guild->LoadBankEventLogFromDB(fields);
-
-                ++count;
-            }
-            while (result->NextRow());
-
-            sLog->outInfo(LOG_FILTER_SERVER_LOADING, ">> Loaded %u guild bank event logs in %u ms", count, GetMSTimeDiffToNow(oldMSTime));
-        }
     }
 
     // 7. Load all news event logs
@@ -396,56 +362,18 @@ void GuildMgr::LoadGuilds()
         }
     }
 
-    // 9. Fill all guild bank tabs
-    sLog->outInfo(LOG_FILTER_GUILD, "Filling bank tabs with items...");
+    // 9. Delete orphan guild bank items, each tab is filled when first opened
     {
-        uint32 oldMSTime = getMSTime();
-
-        // Delete orphan guild bank items
         CharacterDatabase.DirectExecute("DELETE gbi FROM guild_bank_item gbi LEFT JOIN guild g ON gbi.guildId = g.guildId WHERE g.guildId IS NULL");
-
-                                                     //          0            1                2      3         4        5      6             7                 8           9           10
-        QueryResult result = CharacterDatabase.Query("SELECT creatorGuid, giftCreatorGuid, count, duration, charges, flags, enchantments, randomPropertyId, durability, playedTime, text, "
-                                                     //   11       12     13      14         15
-                                                     "guildid, TabId, SlotId, item_guid, itemEntry FROM guild_bank_item gbi INNER JOIN item_instance ii ON gbi.item_guid = ii.guid");
-
-        if (!result)
-        {
-            sLog->outInfo(LOG_FILTER_SERVER_LOADING, ">> Loaded 0 guild bank tab items. DB table `guild_bank_item` or `item_instance` is empty.");
-        }
-        else
-        {
-            uint32 count = 0;
-            do
-            {
-                Field* fields = result->Fetch();
-                uint32 guildId = fields[11].GetUInt32();
-
-                if (Guild* guild = GetGuildById(guildId))
-                    guild->LoadBankItemFromDB(fields);
-
-                ++count;
-            }
-            while (result->NextRow());
-
-            sLog->outInfo(LOG_FILTER_SERVER_LOADING, ">> Loaded %u guild bank tab items in %u ms", count, GetMSTimeDiffToNow(oldMSTime));
-        }
     }
 
-    // 10. Load guild achievements
+    // 10. Load guild achievements, the criteria progress is loaded at the first member login
     {
-        PreparedQueryResult achievementResult;
-        PreparedQueryResult criteriaResult;
         for (GuildContainer::const_iterator itr = GuildStore.begin(); itr != GuildStore.end(); ++itr)
         {
             PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_GUILD_ACHIEVEMENT);
             stmt->setUInt32(0, itr->first);
-            achievementResult = CharacterDatabase.Query(stmt);
-            stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_GUILD_ACHIEVEMENT_CRITERIA);
-            stmt->setUInt32(0, itr->first);
-            criteriaResult = CharacterDatabase.Query(stmt);
-
-            itr->second->GetAchievementMgr().LoadFromDB(achievementResult, criteriaResult);
+            itr->second->GetAchievementMgr().LoadFromDB(CharacterDatabase.Query(stmt), PreparedQueryResult(NULL));
         }
     }
 
@@ -44,6 +44,8 @@ public:
     void RemoveGuild(uint32 guildId);
 
     void SaveGuilds();
+    // Frees the logs, bank items and criteria progress of the guilds without members online for a while
+    void UnloadIdleGuildData();
 
     void ResetReputationCaps();
 
@@ -39,6 +39,7 @@
 #include "Pet.h"
 #include "PlayerDump.h"
 #include "Player.h"
+#include "PlayerDirectory.h"
 #include "ReputationMgr.h"
 #include "ScriptMgr.h"
 #include "SharedDefines.h"
@@ -50,19 +51,6 @@
 #include "WorldPacket.h"
 #include "WorldSession.h"
 
-class LoginQueryHolder : public SQLQueryHolder
-{
-    private:
-        uint32 m_accountId;
-        uint64 m_guid;
-    public:
-        LoginQueryHolder(uint32 accountId, uint64 guid)
-            : m_accountId(accountId), m_guid(guid) { }
-        uint64 GetGuid() const { return m_guid; }
-        uint32 GetAccountId() const { return m_accountId; }
-        bool Initialize();
-};
-
 bool LoginQueryHolder::Initialize()
 {
     SetSize(MAX_PLAYER_LOGIN_QUERY);
@@ -291,7 +279,7 @@ void WorldSession::HandleCharEnumOpcode(WorldPacket & /*recvData*/)
     stmt->setUInt8(0, 0);
     stmt->setUInt32(1, GetAccountId());
 
-    _charEnumCallback = CharacterDatabase.AsyncQuery(stmt);
+    _charEnumCallback.SetFutureResult(CharacterDatabase.AsyncQuery(stmt));
 }
 
 void WorldSession::HandleCharCreateOpcode(WorldPacket& recvData)
@@ -832,7 +820,9 @@ void WorldSession::HandlePlayerLoginOpcode(WorldPacket& recvData)
     SendAccountDataTimes(GLOBAL_CACHE_MASK);
     SendTutorialsData();
 
-    _charLoginCallback = CharacterDatabase.DelayQueryHolder((SQLQueryHolder*)holder);
+    // Routed by account so the load is ordered after the last save of the same account
+    _charLoginCallback.SetFutureResult(CharacterDatabase.DelayQueryHolder((SQLQueryHolder*)holder, GetAccountId(),
+        uint8(sWorld->getIntConfig(CONFIG_LOGIN_QUERY_PARALLELISM))));
 }
 
 void WorldSession::HandleLoadScreenOpcode(WorldPacket& recvPacket)
@@ -1009,6 +999,7 @@ void WorldSession::HandlePlayerLogin(LoginQueryHolder* holder)
     }
 
     sObjectAccessor->AddObject(pCurrChar);
+    sPlayerDirectory->AddPlayer(pCurrChar);
     //sLog->outDebug("Player %s added to Map.", pCurrChar->GetName().c_str());
 
     pCurrChar->SendInitialPacketsAfterAddToMap();
@@ -1288,14 +1279,14 @@ void WorldSession::HandleChangePlayerNameOpcodeCallBack(PreparedQueryResult resu
     stmt->setUInt16(1, AT_LOGIN_RENAME);
     stmt->setUInt32(2, guidLow);
 
-    CharacterDatabase.Execute(stmt);
+    CharacterDatabase.Execute(stmt, SQL_PRIORITY_NORMAL, GetAccountId());
 
     // Removed declined name from db
     stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_DECLINED_NAME);
 
     stmt->setUInt32(0, guidLow);
 
-    CharacterDatabase.Execute(stmt);
+    CharacterDatabase.Execute(stmt, SQL_PRIORITY_NORMAL, GetAccountId());
 
     sLog->outInfo(LOG_FILTER_CHARACTER, "Account: %d (IP: %s) Character:[%s] (guid:%u) Changed name to: %s", GetAccountId(), GetRemoteAddress().c_str(), oldName.c_str(), guidLow, newName.c_str());
 
@@ -1391,7 +1382,7 @@ void WorldSession::HandleSetPlayerDeclinedNames(WorldPacket& recvData)
 
     trans->Append(stmt);
 
-    CharacterDatabase.CommitTransaction(trans);
+    CharacterDatabase.CommitTransaction(trans, GetAccountId());
 
     WorldPacket data(SMSG_SET_PLAYER_DECLINED_NAMES_RESULT, 4+8);
     data << uint32(0);                                      // OK
@@ -1585,7 +1576,7 @@ void WorldSession::HandleCharCustomize(WorldPacket& recvData)
         sLog->outInfo(LOG_FILTER_CHARACTER, "Account: %d (IP: %s), Character[%s] (guid:%u) Customized to: %s", GetAccountId(), GetRemoteAddress().c_str(), oldname.c_str(), GUID_LOPART(guid), newName.c_str());
     }
 
-    Player::Customize(guid, gender, skin, face, hairStyle, hairColor, facialHair);
+    Player::Customize(guid, GetAccountId(), gender, skin, face, hairStyle, hairColor, facialHair);
 
     stmt = CharacterDatabase.GetPreparedStatement(CHAR_UPD_CHAR_NAME_AT_LOGIN);
 
@@ -1593,13 +1584,13 @@ void WorldSession::HandleCharCustomize(WorldPacket& recvData)
     stmt->setUInt16(1, uint16(AT_LOGIN_CUSTOMIZE));
     stmt->setUInt32(2, GUID_LOPART(guid));
 
-    CharacterDatabase.Execute(stmt);
+    CharacterDatabase.Execute(stmt, SQL_PRIORITY_NORMAL, GetAccountId());
 
     stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_DECLINED_NAME);
 
     stmt->setUInt32(0, GUID_LOPART(guid));
 
-    CharacterDatabase.Execute(stmt);
+    CharacterDatabase.Execute(stmt, SQL_PRIORITY_NORMAL, GetAccountId());
 
     sWorld->UpdateCharacterNameData(GUID_LOPART(guid), newName, gender);
 
@@ -1864,7 +1855,7 @@ void WorldSession::HandleCharFactionOrRaceChange(WorldPacket& recvData)
     }
 
     CharacterDatabase.EscapeString(newname);
-    Player::Customize(guid, gender, skin, face, hairStyle, hairColor, facialHair);
+    Player::Customize(guid, GetAccountId(), gender, skin, face, hairStyle, hairColor, facialHair);
     SQLTransaction trans = CharacterDatabase.BeginTransaction();
 
     stmt = CharacterDatabase.GetPreparedStatement(CHAR_UPD_FACTION_OR_RACE);
@@ -2279,7 +2270,7 @@ void WorldSession::HandleCharFactionOrRaceChange(WorldPacket& recvData)
         }
     }
 
-    CharacterDatabase.CommitTransaction(trans);
+    CharacterDatabase.CommitTransaction(trans, GetAccountId());
 
     std::string IP_str = GetRemoteAddress();
     sLog->outDebug(LOG_FILTER_PLAYER, "%s (IP: %s) changed race from %u to %u", GetPlayerInfo().c_str(), IP_str.c_str(), oldRace, race);
@@ -35,6 +35,7 @@
 #include "Chat.h"
 #include "zlib.h"
 #include "ObjectAccessor.h"
+#include "PlayerDirectory.h"
 #include "Object.h"
 #include "Battleground.h"
 #include "OutdoorPvP.h"
@@ -183,181 +184,81 @@ void WorldSession::HandleWhoOpcode(WorldPacket& recvData)
 
     uint32 matchcount = 0;
 
-    uint32 level_min, level_max, racemask, classmask, zones_count, str_count;
-    uint32 zoneids[10];                                     // 10 is client limit
+    WhoQuery query;
     std::string player_name, guild_name;
 
-    recvData >> level_min;                                 // maximal player level, default 0
-    recvData >> level_max;                                 // minimal player level, default 100 (MAX_LEVEL)
+    recvData >> query.LevelMin;                            // maximal player level, default 0
+    recvData >> query.LevelMax;                            // minimal player level, default 100 (MAX_LEVEL)
     recvData >> player_name;                               // player name, case sensitive...
 
     recvData >> guild_name;                                // guild name, case sensitive...
 
-    recvData >> racemask;                                  // race mask
-    recvData >> classmask;                                 // class mask
-    recvData >> zones_count;                               // zones count, client limit = 10 (2.0.10)
+    recvData >> query.RaceMask;                            // race mask
+    recvData >> query.ClassMask;                           // class mask
+    recvData >> query.ZoneCount;                           // zones count, client limit = 10 (2.0.10)
 
-    if (zones_count > 10)
+    if (query.ZoneCount > WHO_MAX_ZONES)
         return;                                             // can't be received from real client or broken packet
 
-    for (uint32 i = 0; i < zones_count; ++i)
+    for (uint32 i = 0; i < query.ZoneCount; ++i)
     {
         uint32 temp;
         recvData >> temp;                                  // zone id, 0 if zone is unknown...
-        zoneids[i] = temp;
-        sLog->outDebug(LOG_FILTER_NETWORKIO, "Zone %u: %u", i, zoneids[i]);
+        query.Zones[i] = temp;
+        sLog->outDebug(LOG_FILTER_NETWORKIO, "Zone %u: %u", i, query.Zones[i]);
     }
 
-    recvData >> str_count;                                 // user entered strings count, client limit=4 (checked on 2.0.10)
+    recvData >> query.StringCount;                         // user entered strings count, client limit=4 (checked on 2.0.10)
 
-    if (str_count > 4)
+    if (query.StringCount > WHO_MAX_STRINGS)
         return;                                             // can't be received from real client or broken packet
 
-    sLog->outDebug(LOG_FILTER_NETWORKIO, "Minlvl %u, maxlvl %u, name %s, guild %s, racemask %u, classmask %u, zones %u, strings %u", level_min, level_max, player_name.c_str(), guild_name.c_str(), racemask, classmask, zones_count, str_count);
+    sLog->outDebug(LOG_FILTER_NETWORKIO, "Minlvl %u, maxlvl %u, name %s, guild %s, racemask %u, classmask %u, zones %u, strings %u", query.LevelMin, query.LevelMax, player_name.c_str(), guild_name.c_str(), query.RaceMask, query.ClassMask, query.ZoneCount, query.StringCount);
 
-    std::wstring str[4];                                    // 4 is client limit
-    for (uint32 i = 0; i < str_count; ++i)
+    for (uint32 i = 0; i < query.StringCount; ++i)
     {
         std::string temp;
         recvData >> temp;                                  // user entered string, it used as universal search pattern(guild+player name)?
 
-        if (!Utf8toWStr(temp, str[i]))
+        if (!Utf8toWStr(temp, query.Strings[i]))
             continue;
 
-        wstrToLower(str[i]);
+        wstrToLower(query.Strings[i]);
 
         sLog->outDebug(LOG_FILTER_NETWORKIO, "String %u: %s", i, temp.c_str());
     }
 
-    std::wstring wplayer_name;
-    std::wstring wguild_name;
-    if (!(Utf8toWStr(player_name, wplayer_name) && Utf8toWStr(guild_name, wguild_name)))
+    if (!(Utf8toWStr(player_name, query.PlayerName) && Utf8toWStr(guild_name, query.GuildName)))
         return;
-    wstrToLower(wplayer_name);
-    wstrToLower(wguild_name);
+    wstrToLower(query.PlayerName);
+    wstrToLower(query.GuildName);
 
     // client send in case not set max level value 100 but Trinity supports 255 max level,
     // update it to show GMs with characters after 100 level
-    if (level_max >= MAX_LEVEL)
-        level_max = STRONG_MAX_LEVEL;
+    if (query.LevelMax >= MAX_LEVEL)
+        query.LevelMax = STRONG_MAX_LEVEL;
 
-    uint32 team = _player->GetTeam();
-    uint32 security = GetSecurity();
-    bool allowTwoSideWhoList = sWorld->getBoolConfig(CONFIG_ALLOW_TWO_SIDE_WHO_LIST);
-    uint32 gmLevelInWhoList  = sWorld->getIntConfig(CONFIG_GM_LEVEL_IN_WHO_LIST);
     uint32 displaycount = 0;
 
     WorldPacket data(SMSG_WHO, 50);                       // guess size
     data << uint32(matchcount);                           // placeholder, count of players matching criteria
     data << uint32(displaycount);                         // placeholder, count of players displayed
 
-    TRINITY_READ_GUARD(HashMapHolder<Player>::LockType, *HashMapHolder<Player>::GetLock());
-    HashMapHolder<Player>::MapType const& m = sObjectAccessor->GetPlayers();
-    for (HashMapHolder<Player>::MapType::const_iterator itr = m.begin(); itr != m.end(); ++itr)
-    {
-        if (AccountMgr::IsPlayerAccount(security))
-        {
-            // player can see member of other team only if CONFIG_ALLOW_TWO_SIDE_WHO_LIST
-            if (itr->second->GetTeam() != team && !allowTwoSideWhoList)
-                continue;
-
-            // player can see MODERATOR, GAME MASTER, ADMINISTRATOR only if CONFIG_GM_IN_WHO_LIST
-            if ((itr->second->GetSession()->GetSecurity() > AccountTypes(gmLevelInWhoList)))
-                continue;
-        }
-
-        //do not process players which are not in world
-        if (!(itr->second->IsInWorld()))
-            continue;
-
-        // check if target is globally visible for player
-        if (!(itr->second->IsVisibleGloballyFor(_player)))
-            continue;
+    PlayerDirectory::EntryList players;
+    sPlayerDirectory->Search(query, _player, players);
 
-        // check if target's level is in level range
-        uint8 lvl = itr->second->getLevel();
-        if (lvl < level_min || lvl > level_max)
-            continue;
-
-        // check if class matches classmask
-        uint32 class_ = itr->second->getClass();
-        if (!(classmask & (1 << class_)))
-            continue;
-
-        // check if race matches racemask
-        uint32 race = itr->second->getRace();
-        if (!(racemask & (1 << race)))
-            continue;
-
-        uint32 pzoneid = itr->second->GetZoneId();
-        uint8 gender = itr->second->getGender();
-
-        bool z_show = true;
-        for (uint32 i = 0; i < zones_count; ++i)
-        {
-            if (zoneids[i] == pzoneid)
-            {
-                z_show = true;
-                break;
-            }
-
-            z_show = false;
-        }
-        if (!z_show)
-            continue;
-
-        std::string pname = itr->second->GetName();
-        std::wstring wpname;
-        if (!Utf8toWStr(pname, wpname))
-            continue;
-        wstrToLower(wpname);
-
-        if (!(wplayer_name.empty() || wpname.find(wplayer_name) != std::wstring::npos))
-            continue;
-
-        std::string gname = sGuildMgr->GetGuildNameById(itr->second->GetGuildId());
-        std::wstring wgname;
-        if (!Utf8toWStr(gname, wgname))
-            continue;
-        wstrToLower(wgname);
-
-        if (!(wguild_name.empty() || wgname.find(wguild_name) != std::wstring::npos))
-            continue;
-
-        std::string aname;
-        if (AreaTableEntry const* areaEntry = GetAreaEntryByAreaID(itr->second->GetZoneId()))
-            aname = areaEntry->area_name[GetSessionDbcLocale()];
-
-        bool s_show = true;
-        for (uint32 i = 0; i < str_count; ++i)
-        {
-            if (!str[i].empty())
-            {
-                if (wgname.find(str[i]) != std::wstring::npos ||
-                    wpname.find(str[i]) != std::wstring::npos ||
-                    Utf8FitTo(aname, str[i]))
-                {
-                    s_show = true;
-                    break;
-                }
-                s_show = false;
-            }
-        }
-        if (!s_show)
-            continue;
-
-        // 49 is maximum player count sent to client - can be overridden
-        // through config, but is unstable
-        if ((matchcount++) >= sWorld->getIntConfig(CONFIG_MAX_WHO))
-            continue;
-
-        data << pname;                                    // player name
-        data << gname;                                    // guild name
-        data << uint32(lvl);                              // player level
-        data << uint32(class_);                           // player class
-        data << uint32(race);                             // player race
-        data << uint8(gender);                            // player gender
-        data << uint32(pzoneid);                          // player zone id
+    // 49 is maximum player count sent to client - can be overridden
+    // through config, but is unstable
+    matchcount = players.size();
+    for (PlayerDirectory::EntryList::const_iterator itr = players.begin(); itr != players.end() && displaycount < sWorld->getIntConfig(CONFIG_MAX_WHO); ++itr)
+    {
+        data << (*itr)->Name;                                       // player name
+        data << sPlayerDirectory->GetGuildName((*itr)->GuildId);    // guild name
+        data << uint32((*itr)->Level);                              // player level
+        data << uint32((*itr)->Class);                              // player class
+        data << uint32((*itr)->Race);                               // player race
+        data << uint8((*itr)->Gender);                              // player gender
+        data << uint32((*itr)->ZoneId);                             // player zone id
 
         ++displaycount;
     }
@@ -639,7 +540,7 @@ void WorldSession::HandleAddIgnoreOpcode(WorldPacket& recvData)
 
     stmt->setString(0, ignoreName);
 
-    _addIgnoreCallback = CharacterDatabase.AsyncQuery(stmt);
+    _addIgnoreCallback.SetFutureResult(CharacterDatabase.AsyncQuery(stmt));
 }
 
 void WorldSession::HandleAddIgnoreOpcodeCallBack(PreparedQueryResult result)
@@ -670,6 +571,8 @@ void WorldSession::HandleAddIgnoreOpcodeCallBack(PreparedQueryResult result)
                 // ignore list full
                 if (!GetPlayer()->GetSocial()->AddToSocialList(GUID_LOPART(IgnoreGuid), true))
                     ignoreResult = FRIEND_IGNORE_FULL;
+                else
+                    GetPlayer()->UpdateChannelIgnores();
             }
         }
     }
@@ -688,6 +591,7 @@ void WorldSession::HandleDelIgnoreOpcode(WorldPacket& recvData)
     recvData >> IgnoreGUID;
 
     _player->GetSocial()->RemoveFromSocialList(GUID_LOPART(IgnoreGUID), true);
+    _player->UpdateChannelIgnores();
 
     sSocialMgr->SendFriendStatus(GetPlayer(), FRIEND_IGNORE_REMOVED, GUID_LOPART(IgnoreGUID), false);
 
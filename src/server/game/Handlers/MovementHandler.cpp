@@ -395,8 +395,8 @@ void WorldSession::HandleMovementOpcodes(WorldPacket& recvPacket)
     if (opcode == MSG_MOVE_FALL_LAND && plrMover && !plrMover->isInFlight())
         plrMover->HandleFall(movementInfo);
 
-    // Anticheat Check
-    GetPlayer()->GetAntiCheat().DoAntiCheatCheck(CHECK_MOVEMENT, movementInfo, Opcodes(opcode));
+    // Anticheat Check, run with the other players of the map after the packets were handled
+    GetPlayer()->GetAntiCheat().AddMovementSample(movementInfo, Opcodes(opcode));
 
     if (GetPlayer()->GetUInt32Value(UNIT_NPC_EMOTESTATE))
     {
@@ -0,0 +1,352 @@
+/*
+ * Copyright (C) 2008-2013 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MailExpiry.h"
+#include "Log.h"
+#include "ObjectAccessor.h"
+#include "Player.h"
+#include "Timer.h"
+#include "World.h"
+
+void MailExpiry::ExpireAll()
+{
+    if (IsSweeping())
+        return;
+
+    uint32 oldMSTime = getMSTime();
+
+    _baseTime = uint32(time(NULL));
+    _cursorTime = 0;
+    _cursorId = 0;
+    _batchSize = sWorld->getIntConfig(CONFIG_MAIL_EXPIRY_BATCH_SIZE);
+    _serverUp = false;
+    _sweep = MailExpiryStats();
+
+    // Delete all old mails without item and without body immediately, if starting server
+    PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_EMPTY_EXPIRED_MAIL);
+    stmt->setUInt32(0, _baseTime);
+    CharacterDatabase.Execute(stmt);
+
+    _state = MAIL_EXPIRY_PROCESS;
+    while (_state != MAIL_EXPIRY_IDLE)
+    {
+        LoadMails(CharacterDatabase.Query(GetMailQuery()));
+        if (_state == MAIL_EXPIRY_IDLE)
+            break;
+
+        if (NeedsItems())
+            LoadItems(CharacterDatabase.Query(GetItemQuery()));
+
+        ProcessMails(0);
+        FinishBatch();
+    }
+
+    if (!_sweep.Processed)
+        sLog->outInfo(LOG_FILTER_SERVER_LOADING, ">> No expired mails found.");
+    else
+        sLog->outInfo(LOG_FILTER_SERVER_LOADING, ">> Processed %u expired mails: %u deleted and %u returned in %u batches in %u ms",
+            _sweep.Processed, _sweep.Deleted, _sweep.Returned, _sweep.Batches, GetMSTimeDiffToNow(oldMSTime));
+}
+
+void MailExpiry::StartSweep()
+{
+    if (IsSweeping())
+    {
+        sLog->outWarn(LOG_FILTER_GENERAL, "MailExpiry: the sweep started at %u did not finish yet, not starting another one.", _baseTime);
+        return;
+    }
+
+    _baseTime = uint32(time(NULL));
+    _cursorTime = 0;
+    _cursorId = 0;
+    _batchSize = sWorld->getIntConfig(CONFIG_MAIL_EXPIRY_BATCH_SIZE);
+    _serverUp = true;
+    _sweep = MailExpiryStats();
+    _sweepStart = getMSTime();
+
+    _query = CharacterDatabase.AsyncQuery(GetMailQuery());
+    _state = MAIL_EXPIRY_QUERY_MAILS;
+}
+
+void MailExpiry::Update()
+{
+    switch (_state)
+    {
+        case MAIL_EXPIRY_QUERY_MAILS:
+        {
+            if (!_query.ready())
+                return;
+
+            PreparedQueryResult result;
+            _query.get(result);
+            _query.cancel();
+            LoadMails(result);
+            if (_state == MAIL_EXPIRY_IDLE)
+                return;
+
+            if (NeedsItems())
+            {
+                _query = CharacterDatabase.AsyncQuery(GetItemQuery());
+                _state = MAIL_EXPIRY_QUERY_ITEMS;
+                return;
+            }
+
+            _state = MAIL_EXPIRY_PROCESS;
+            break;
+        }
+        case MAIL_EXPIRY_QUERY_ITEMS:
+        {
+            if (!_query.ready())
+                return;
+
+            PreparedQueryResult result;
+            _query.get(result);
+            _query.cancel();
+            LoadItems(result);
+            _state = MAIL_EXPIRY_PROCESS;
+            break;
+        }
+        case MAIL_EXPIRY_PROCESS:
+            break;
+        default:
+            return;
+    }
+
+    if (!ProcessMails(MAIL_EXPIRY_TIME_BUDGET))
+        return;
+
+    FinishBatch();
+    if (_state != MAIL_EXPIRY_IDLE)
+    {
+        _query = CharacterDatabase.AsyncQuery(GetMailQuery());
+        _state = MAIL_EXPIRY_QUERY_MAILS;
+    }
+}
+
+PreparedStatement* MailExpiry::GetMailQuery()
+{
+    PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_EXPIRED_MAIL);
+    stmt->setUInt32(0, _baseTime);
+    stmt->setUInt32(1, _cursorTime);
+    stmt->setUInt32(2, _cursorTime);
+    stmt->setUInt32(3, _cursorId);
+    stmt->setUInt32(4, _batchSize);
+    return stmt;
+}
+
+PreparedStatement* MailExpiry::GetItemQuery()
+{
+    ExpiredMail const& last = _mails.back();
+
+    PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_EXPIRED_MAIL_ITEMS);
+    stmt->setUInt32(0, _baseTime);
+    stmt->setUInt32(1, _cursorTime);
+    stmt->setUInt32(2, _cursorTime);
+    stmt->setUInt32(3, _cursorId);
+    stmt->setUInt32(4, last.ExpireTime);
+    stmt->setUInt32(5, last.ExpireTime);
+    stmt->setUInt32(6, last.Id);
+    return stmt;
+}
+
+void MailExpiry::LoadMails(PreparedQueryResult result)
+{
+    _mails.clear();
+    _next = 0;
+
+    if (!result)
+    {
+        FinishSweep();
+        return;
+    }
+
+    _mails.reserve(result->GetRowCount());
+    do
+    {
+        Field* fields = result->Fetch();
+
+        ExpiredMail mail;
+        mail.Id          = fields[0].GetUInt32();
+        mail.MessageType = fields[1].GetUInt8();
+        mail.Sender      = fields[2].GetUInt32();
+        mail.Receiver    = fields[3].GetUInt32();
+        mail.HasItems    = fields[4].GetBool();
+        mail.ExpireTime  = fields[5].GetUInt32();
+        mail.Checked     = fields[7].GetUInt8();
+        _mails.push_back(mail);
+    }
+    while (result->NextRow());
+}
+
+void MailExpiry::LoadItems(PreparedQueryResult result)
+{
+    if (!result)
+        return;
+
+    UNORDERED_MAP<uint32, uint32> indexes;
+    for (uint32 i = 0; i < _mails.size(); ++i)
+        indexes[_mails[i].Id] = i;
+
+    do
+    {
+        Field* fields = result->Fetch();
+
+        MailItemInfo item;
+        item.item_guid = fields[0].GetUInt32();
+        item.item_template = fields[1].GetUInt32();
+
+        UNORDERED_MAP<uint32, uint32>::const_iterator itr = indexes.find(fields[2].GetUInt32());
+        if (itr != indexes.end())
+            _mails[itr->second].Items.push_back(item);
+    }
+    while (result->NextRow());
+}
+
+bool MailExpiry::NeedsItems() const
+{
+    for (std::vector<ExpiredMail>::const_iterator itr = _mails.begin(); itr != _mails.end(); ++itr)
+        if (itr->HasItems)
+            return true;
+
+    return false;
+}
+
+bool MailExpiry::ProcessMails(uint32 timeBudget)
+{
+    uint32 startTime = getMSTime();
+    SQLTransaction trans = CharacterDatabase.BeginTransaction();
+
+    for (; _next < _mails.size(); ++_next)
+    {
+        if (timeBudget && GetMSTimeDiffToNow(startTime) >= timeBudget)
+            break;
+
+        ProcessMail(_mails[_next], trans);
+    }
+
+    // normal priority: low priority work may be dropped, and a return must be written before a later login reads the mail
+    if (trans->GetSize())
+        CharacterDatabase.CommitTransaction(trans);
+    return _next == _mails.size();
+}
+
+void MailExpiry::ProcessMail(ExpiredMail& mail, SQLTransaction& trans)
+{
+    if (_serverUp)
+    {
+        // the receiver listed his mails since the batch was read, they are his to handle now
+        Player* player = ObjectAccessor::FindPlayer(uint64(mail.Receiver));
+        if (player && player->m_mailsLoaded)
+        {
+            ++_sweep.Skipped;
+            ++_stats.Skipped;
+            return;
+        }
+    }
+
+    ++_sweep.Processed;
+    ++_stats.Processed;
+
+    PreparedStatement* stmt;
+    if (mail.HasItems)
+    {
+        // if it is mail from non-player, or if it's already return mail, it shouldn't be returned, but deleted
+        if (mail.MessageType != MAIL_NORMAL || (mail.Checked & (MAIL_CHECK_MASK_COD_PAYMENT | MAIL_CHECK_MASK_RETURNED)))
+        {
+            // mail open and then not returned
+            for (MailItemInfoVec::const_iterator itr = mail.Items.begin(); itr != mail.Items.end(); ++itr)
+            {
+                stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_ITEM_INSTANCE);
+                stmt->setUInt32(0, itr->item_guid);
+                trans->Append(stmt);
+            }
+        }
+        else
+        {
+            // Mail will be returned
+            stmt = CharacterDatabase.GetPreparedStatement(CHAR_UPD_MAIL_RETURNED);
+            stmt->setUInt32(0, mail.Receiver);
+            stmt->setUInt32(1, mail.Sender);
+            stmt->setUInt32(2, _baseTime + 30 * DAY);
+            stmt->setUInt32(3, _baseTime);
+            stmt->setUInt8 (4, uint8(MAIL_CHECK_MASK_RETURNED));
+            stmt->setUInt32(5, mail.Id);
+            trans->Append(stmt);
+
+            for (MailItemInfoVec::const_iterator itr = mail.Items.begin(); itr != mail.Items.end(); ++itr)
+            {
+                // Update receiver in mail items for its proper delivery, and in instance_item for avoid lost item at sender delete
+                stmt = CharacterDatabase.GetPreparedStatement(CHAR_UPD_MAIL_ITEM_RECEIVER);
+                stmt->setUInt32(0, mail.Sender);
+                stmt->setUInt32(1, itr->item_guid);
+                trans->Append(stmt);
+
+                stmt = CharacterDatabase.GetPreparedStatement(CHAR_UPD_ITEM_OWNER);
+                stmt->setUInt32(0, mail.Sender);
+                stmt->setUInt32(1, itr->item_guid);
+                trans->Append(stmt);
+            }
+
+            ++_sweep.Returned;
+            ++_stats.Returned;
+            return;
+        }
+    }
+
+    stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_MAIL_BY_ID);
+    stmt->setUInt32(0, mail.Id);
+    trans->Append(stmt);
+
+    ++_sweep.Deleted;
+    ++_stats.Deleted;
+}
+
+void MailExpiry::FinishBatch()
+{
+    uint32 count = _mails.size();
+
+    _sweep.LastBatch = count;
+    _stats.LastBatch = count;
+    ++_sweep.Batches;
+    ++_stats.Batches;
+    if (count > _sweep.MaxBatch)
+        _sweep.MaxBatch = count;
+    if (count > _stats.MaxBatch)
+        _stats.MaxBatch = count;
+
+    // the next batch continues after this one, whatever became of its mails
+    if (count)
+    {
+        _cursorTime = _mails.back().ExpireTime;
+        _cursorId = _mails.back().Id;
+    }
+
+    _mails.clear();
+    _next = 0;
+
+    if (count < _batchSize)
+        FinishSweep();
+}
+
+void MailExpiry::FinishSweep()
+{
+    _state = MAIL_EXPIRY_IDLE;
+
+    if (_serverUp)
+        sLog->outInfo(LOG_FILTER_GENERAL, "MailExpiry: processed %u expired mails in %u batches: %u deleted, %u returned and %u skipped in %u ms",
+            _sweep.Processed, _sweep.Batches, _sweep.Deleted, _sweep.Returned, _sweep.Skipped, GetMSTimeDiffToNow(_sweepStart));
+}
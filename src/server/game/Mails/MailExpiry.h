@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2008-2013 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_MAILEXPIRY_H
+#define TRINITY_MAILEXPIRY_H
+
+#include "Common.h"
+#include "DatabaseEnv.h"
+#include "Mail.h"
+#include <ace/Null_Mutex.h>
+#include <ace/Singleton.h>
+
+#define MAIL_EXPIRY_TIME_BUDGET     5                       // ms of a world update spent on expired mails at most
+
+enum MailExpiryState
+{
+    MAIL_EXPIRY_IDLE,
+    MAIL_EXPIRY_QUERY_MAILS,                                // waiting for the next batch of expired mails
+    MAIL_EXPIRY_QUERY_ITEMS,                                // waiting for the items of the batch
+    MAIL_EXPIRY_PROCESS
+};
+
+struct MailExpiryStats
+{
+    MailExpiryStats() : Batches(0), LastBatch(0), MaxBatch(0), Processed(0), Deleted(0), Returned(0), Skipped(0) { }
+
+    uint32 Batches;
+    uint32 LastBatch;                                       // mails processed by the last batch
+    uint32 MaxBatch;
+    uint32 Processed;
+    uint32 Deleted;
+    uint32 Returned;
+    uint32 Skipped;                                         // receivers with their mails loaded
+};
+
+/**
+ * Returns or deletes the expired mails in batches of Mail.ExpiryBatchSize.
+ *
+ * A sweep walks the expired mails in (expire_time, id) order, each batch continuing after the last mail of the
+ * one before, so the index on expire_time reads every expired mail once however many there are. During the
+ * game the queries are asynchronous and Update, called every world update, only handles the results: it
+ * spends MAIL_EXPIRY_TIME_BUDGET ms at most on a batch, the rest waits for the next update. At startup
+ * ExpireAll runs the batches one after another.
+ */
+class MailExpiry
+{
+    friend class ACE_Singleton<MailExpiry, ACE_Null_Mutex>;
+
+  public:
+    // at startup, also deletes the expired mails without items and body
+    void ExpireAll();
+
+    // starts a sweep over the mails expired by now, unless one runs
+    void StartSweep();
+    void Update();
+
+    bool IsSweeping() const { return _state != MAIL_EXPIRY_IDLE; }
+    MailExpiryStats const& GetStats() const { return _stats; }
+    MailExpiryStats const& GetSweepStats() const { return _sweep; }
+
+  private:
+    MailExpiry() : _state(MAIL_EXPIRY_IDLE), _serverUp(false), _baseTime(0), _cursorTime(0), _cursorId(0), _batchSize(0),
+        _next(0), _sweepStart(0) { }
+    ~MailExpiry() { }
+
+    struct ExpiredMail
+    {
+        uint32 Id;
+        uint8 MessageType;
+        uint32 Sender;
+        uint32 Receiver;
+        bool HasItems;
+        uint32 ExpireTime;
+        uint8 Checked;
+        MailItemInfoVec Items;
+    };
+
+    PreparedStatement* GetMailQuery();
+    PreparedStatement* GetItemQuery();
+    void LoadMails(PreparedQueryResult result);
+    void LoadItems(PreparedQueryResult result);
+    bool NeedsItems() const;
+
+    // false if the time budget ran out first
+    bool ProcessMails(uint32 timeBudget);
+    void ProcessMail(ExpiredMail& mail, SQLTransaction& trans);
+    void FinishBatch();
+    void FinishSweep();
+
+    MailExpiryState _state;
+    bool _serverUp;                                         // mails of players online may not be touched
+    uint32 _baseTime;                                       // mails expired before it are processed
+    uint32 _cursorTime;                                     // last mail of the batch before
+    uint32 _cursorId;
+    uint32 _batchSize;
+    PreparedQueryResultFuture _query;
+
+    std::vector<ExpiredMail> _mails;                        // the batch
+    uint32 _next;
+    uint32 _sweepStart;
+
+    MailExpiryStats _stats;                                 // since the start
+    MailExpiryStats _sweep;                                 // of the running or last sweep
+};
+
+#define sMailExpiry ACE_Singleton<MailExpiry, ACE_Null_Mutex>::instance()
+
+#endif
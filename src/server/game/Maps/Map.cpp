@@ -31,6 +31,7 @@
 #include "ObjectAccessor.h"
 #include "ObjectMgr.h"
 #include "Pet.h"
+#include "PlayerDirectory.h"
 #include "ScriptMgr.h"
 #include "Transport.h"
 #include "Vehicle.h"
@@ -66,6 +67,8 @@ Map::~Map()
     if (!m_scriptSchedule.empty())
         sScriptMgr->DecreaseScheduledScriptCount(m_scriptSchedule.size());
 
+    delete _spatialIndex;
+
     MMAP::MMapFactory::createOrGetMMapManager()->unloadMapInstance(GetId(), i_InstanceId);
 }
 
@@ -221,8 +224,12 @@ _creatureToMoveLock(false), i_mapEntry (sMapStore.LookupEntry(id)), i_spawnMode(
 m_unloadTimer(0), m_VisibleDistance(DEFAULT_VISIBILITY_DISTANCE),
 m_VisibilityNotifyPeriod(DEFAULT_VISIBILITY_NOTIFY_PERIOD),
 m_activeNonPlayersIter(m_activeNonPlayers.end()), i_gridExpiry(expiry),
-i_scriptLock(false), _defaultLight(GetDefaultMapLight(id))
+i_scriptLock(false), _spatialIndex(NULL), _expiredTimers(0), _antiCheatSamples(0), _antiCheatUpdateTime(0),
+_antiCheatMaxUpdateTime(0), _defaultLight(GetDefaultMapLight(id))
 {
+    if (sWorld->getBoolConfig(CONFIG_MAP_SPATIAL_INDEX))
+        _spatialIndex = new SpatialHashIndex();
+
     m_parentMap = (_parent ? _parent : this);
     for (unsigned int idx=0; idx < MAX_NUMBER_OF_GRIDS; ++idx)
     {
@@ -301,6 +308,7 @@ void Map::SwitchGridContainers(Creature* obj, bool on)
     GridType &grid = ngrid->GetGridType(cell.CellX(), cell.CellY());
 
     obj->RemoveFromGrid(); //This step is not really necessary but we want to do ASSERT in remove/add
+    obj->m_isTempWorldObject = on;                      // before re-adding, the spatial index stores the container
     if (on)
     {
         grid.AddWorldObject(obj);
@@ -311,7 +319,6 @@ void Map::SwitchGridContainers(Creature* obj, bool on)
         grid.AddGridObject(obj);
         RemoveWorldObject(obj);
     }
-    obj->m_isTempWorldObject = on;
 }
 
 template<class T>
@@ -325,7 +332,8 @@ template<>
 void Map::DeleteFromWorld(Player* player)
 {
     sObjectAccessor->RemoveObject(player);
-    sObjectAccessor->RemoveUpdateObject(player); //TODO: I do not know why we need this, it should be removed in ~Object anyway
+    sPlayerDirectory->RemovePlayer(player);
+    RemoveUpdateObject(player); //TODO: I do not know why we need this, it should be removed in ~Object anyway
     delete player;
 }
 
@@ -343,13 +351,17 @@ void Map::EnsureGridCreated_i(const GridCoord &p)
     {
         sLog->outDebug(LOG_FILTER_MAPS, "Creating grid[%u, %u] for map %u instance %u", p.x_coord, p.y_coord, GetId(), i_InstanceId);
 
-        setNGrid(new NGridType(p.x_coord*MAX_NUMBER_OF_GRIDS + p.y_coord, p.x_coord, p.y_coord, i_gridExpiry, sWorld->getBoolConfig(CONFIG_GRID_UNLOAD)),
+        setNGrid(new NGridType(p.x_coord*MAX_NUMBER_OF_GRIDS + p.y_coord, p.x_coord, p.y_coord, sWorld->getBoolConfig(CONFIG_GRID_UNLOAD)),
             p.x_coord, p.y_coord);
 
+        NGridType* grid = getNGrid(p.x_coord, p.y_coord);
+
         // build a linkage between this map and NGridType
-        buildNGridLinkage(getNGrid(p.x_coord, p.y_coord));
+        buildNGridLinkage(grid);
 
-        getNGrid(p.x_coord, p.y_coord)->SetGridState(GRID_STATE_IDLE);
+        grid->getGridInfoRef()->getStateTimer().SetGrid(this, p.x_coord, p.y_coord);
+        grid->SetGridState(GRID_STATE_IDLE);
+        _createdGrids.push_back(p);
 
         //z coord
         int gx = (MAX_NUMBER_OF_GRIDS - 1) - p.x_coord;
@@ -527,6 +539,18 @@ void Map::VisitNearbyCellsOf(WorldObject* obj, TypeContainerVisitor<Trinity::Obj
 
 void Map::Update(const uint32 t_diff)
 {
+    {
+        TRINITY_GUARD(ACE_Thread_Mutex, GridLock);
+        for (std::vector<GridCoord>::const_iterator itr = _createdGrids.begin(); itr != _createdGrids.end(); ++itr)
+            if (NGridType* grid = getNGrid(itr->x_coord, itr->y_coord))
+                if (!grid->getGridInfoRef()->getStateTimer().IsScheduled())
+                    ResetGridExpiry(*grid, 0.0f);
+
+        _createdGrids.clear();
+    }
+
+    _expiredTimers = _timers.Update(t_diff);
+
     _dynamicTree.update(t_diff);
     /// update worldsessions for existing players
     for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
@@ -540,6 +564,10 @@ void Map::Update(const uint32 t_diff)
             session->Update(t_diff, updater);
         }
     }
+
+    /// check the movement packets the sessions just handled
+    UpdateAntiCheat();
+
     /// update active cells around players and active objects
     resetMarkedCells();
 
@@ -591,6 +619,8 @@ void Map::Update(const uint32 t_diff)
         VisitNearbyCellsOf(obj, grid_object_update, world_object_update);
     }
 
+    UpdateTransports(t_diff);
+
     ///- Process necessary scripts
     if (!m_scriptSchedule.empty())
     {
@@ -607,6 +637,68 @@ void Map::Update(const uint32 t_diff)
     sScriptMgr->OnMapUpdate(this, t_diff);
 }
 
+void Map::UpdateTransports(uint32 diff)
+{
+    for (std::set<Transport*>::const_iterator itr = _transports.begin(); itr != _transports.end(); ++itr)
+    {
+        Transport* transport = *itr;
+        ACE_Time_Value startTime = ACE_OS::gettimeofday();
+
+        // a transport reaching a node on another map only flags itself here, it changes map
+        // after all maps are updated, see MapManager::Update
+        transport->Update(diff);
+
+        ACE_Time_Value elapsed = ACE_OS::gettimeofday() - startTime;
+        transport->SetUpdateTime(uint32(elapsed.sec() * 1000000 + elapsed.usec()));
+    }
+}
+
+void Map::UpdateAntiCheat()
+{
+    ACE_Time_Value startTime = ACE_OS::gettimeofday();
+
+    _antiCheatSamples = 0;
+    for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
+    {
+        Player* player = m_mapRefIter->getSource();
+        if (player && player->IsInWorld())
+            _antiCheatSamples += player->GetAntiCheat().ProcessMovementSamples();
+    }
+
+    ACE_Time_Value elapsed = ACE_OS::gettimeofday() - startTime;
+    _antiCheatUpdateTime = uint32(elapsed.sec() * 1000000 + elapsed.usec());
+    _antiCheatMaxUpdateTime = std::max(_antiCheatMaxUpdateTime, _antiCheatUpdateTime);
+}
+
+void Map::SendObjectUpdates()
+{
+    UpdateDataMapType update_players;
+
+    while (true)
+    {
+        Object* obj;
+        {
+            TRINITY_GUARD(ACE_Thread_Mutex, _updateObjectsLock);
+            if (_updateObjects.empty())
+                break;
+
+            obj = *_updateObjects.begin();
+            _updateObjects.erase(_updateObjects.begin());
+        }
+
+        ASSERT(obj && obj->IsInWorld());
+        obj->BuildUpdate(update_players);
+    }
+
+    WorldPacket packet;                                     // here we allocate a std::vector with a size of 0x10000
+    for (UpdateDataMapType::iterator iter = update_players.begin(); iter != update_players.end(); ++iter)
+    {
+        iter->second.BuildPacket(&packet);
+        iter->first->GetSession()->SendPacket(&packet);
+        packet.clear();                                     // clean the string
+    }
+}
+
 struct ResetNotifier
 {
     template<class T>inline void resetNotify(GridRefManager<T> &m)
@@ -2123,15 +2215,21 @@ void Map::DelayedUpdate(const uint32 t_diff)
     // This isn't really bother us, since as soon as we have instanced BG-s, the whole map unloads as the BG gets ended
     if (!IsBattlegroundOrArena())
     {
-        for (GridRefManager<NGridType>::iterator i = GridRefManager<NGridType>::begin(); i != GridRefManager<NGridType>::end();)
+        // only the grids whose state timer expired, the updates schedule the next one
+        std::vector<GridCoord> updates;
+        updates.swap(_gridStateUpdates);
+        for (std::vector<GridCoord>::const_iterator itr = updates.begin(); itr != updates.end(); ++itr)
         {
-            NGridType *grid = i->getSource();
-            GridInfo* info = i->getSource()->getGridInfoRef();
-            ++i;                                                // The update might delete the map and we need the next map before the iterator gets invalid
+            NGridType* grid = getNGrid(itr->x_coord, itr->y_coord);
+            if (!grid)                                          // unloaded meanwhile
+                continue;
+
             ASSERT(grid->GetGridState() >= 0 && grid->GetGridState() < MAX_GRID_STATE);
-            si_GridStates[grid->GetGridState()]->Update(*this, *grid, *info, t_diff);
+            si_GridStates[grid->GetGridState()]->Update(*this, *grid, *grid->getGridInfoRef(), t_diff);
         }
     }
+    else
+        _gridStateUpdates.clear();
 }
 
 void Map::AddObjectToRemoveList(WorldObject* obj)
@@ -27,10 +27,12 @@
 #include "GridDefines.h"
 #include "Cell.h"
 #include "Timer.h"
+#include "TimerWheel.h"
 #include "SharedDefines.h"
 #include "GridRefManager.h"
 #include "MapRefManager.h"
 #include "DynamicTree.h"
+#include "SpatialHashIndex.h"
 #include "GameObjectModel.h"
 
 #include <bitset>
@@ -52,6 +54,7 @@ struct Position;
 class Battleground;
 class MapInstanced;
 class InstanceMap;
+class Transport;
 namespace Trinity { struct ObjectUpdater; }
 
 struct ScriptAction
@@ -312,10 +315,12 @@ class Map : public GridRefManager<NGridType>
         bool UnloadGrid(NGridType& ngrid, bool pForce);
         virtual void UnloadAll();
 
-        void ResetGridExpiry(NGridType &grid, float factor = 1) const
+        // (re)schedules the next state update of the grid
+        void ResetGridExpiry(NGridType &grid, float factor = 1)
         {
-            grid.ResetTimeTracker(time_t(float(i_gridExpiry)*factor));
+            _timers.Schedule(&grid.getGridInfoRef()->getStateTimer(), uint64(float(i_gridExpiry)*factor));
         }
+        void AddGridStateUpdate(uint32 x, uint32 y) { _gridStateUpdates.push_back(GridCoord(x, y)); }
 
         time_t GetGridExpiry(void) const { return i_gridExpiry; }
         uint32 GetId(void) const { return i_mapEntry->MapID; }
@@ -403,6 +408,8 @@ class Map : public GridRefManager<NGridType>
         void AddObjectToRemoveList(WorldObject* obj);
         void AddObjectToSwitchList(WorldObject* obj, bool on);
         virtual void DelayedUpdate(const uint32 diff);
+        // builds the values updates of the changed objects, only called once no map is being updated
+        virtual void SendObjectUpdates();
 
         void UpdateObjectVisibility(WorldObject* obj, Cell cell, CellCoord cellpair);
         void UpdateObjectsVisibilityFor(Player* player, Cell cell, CellCoord cellpair);
@@ -418,6 +425,35 @@ class Map : public GridRefManager<NGridType>
         void AddWorldObject(WorldObject* obj) { i_worldObjects.insert(obj); }
         void RemoveWorldObject(WorldObject* obj) { i_worldObjects.erase(obj); }
 
+        // Transports currently on this map, they are moved by Update(). Only changed from the world thread.
+        void AddTransport(Transport* transport) { _transports.insert(transport); }
+        void RemoveTransport(Transport* transport) { _transports.erase(transport); }
+
+        // Finer grained index of the grid objects, NULL unless Map.SpatialIndex is enabled
+        SpatialHashIndex* GetSpatialIndex() const { return _spatialIndex; }
+
+        // Respawn, corpse removal, grid state and summon despawn timers of this map, advanced at the start of Update()
+        TimerWheel& GetTimers() { return _timers; }
+        uint32 GetExpiredTimerCount() const { return _expiredTimers; }     // during the last Update()
+
+        // Movement checks of the anticheat, run for all players of the map once per Update(), times in microseconds
+        uint32 GetAntiCheatSampleCount() const { return _antiCheatSamples; }
+        uint32 GetAntiCheatUpdateTime() const { return _antiCheatUpdateTime; }
+        uint32 GetAntiCheatMaxUpdateTime() const { return _antiCheatMaxUpdateTime; }
+
+        // Objects with changed update fields, their values updates are sent at the end of Update()
+        void AddUpdateObject(Object* obj)
+        {
+            TRINITY_GUARD(ACE_Thread_Mutex, _updateObjectsLock);
+            _updateObjects.insert(obj);
+        }
+
+        void RemoveUpdateObject(Object* obj)
+        {
+            TRINITY_GUARD(ACE_Thread_Mutex, _updateObjectsLock);
+            _updateObjects.erase(obj);
+        }
+
         void SendToPlayers(WorldPacket const* data) const;
 
         typedef MapRefManager PlayerList;
@@ -444,6 +480,8 @@ class Map : public GridRefManager<NGridType>
         template<class NOTIFIER> void VisitFirstFound(const float &x, const float &y, float radius, NOTIFIER &notifier);
         template<class NOTIFIER> void VisitWorld(const float &x, const float &y, float radius, NOTIFIER &notifier);
         template<class NOTIFIER> void VisitGrid(const float &x, const float &y, float radius, NOTIFIER &notifier);
+        template<class NOTIFIER> bool VisitSpatialIndex(float x, float y, float radius, NOTIFIER& notifier, Trinity::SpatialIndexNotifier const* /*tag*/, bool worldObjects, bool gridObjects);
+        template<class NOTIFIER> bool VisitSpatialIndex(float /*x*/, float /*y*/, float /*radius*/, NOTIFIER& /*notifier*/, void const* /*tag*/, bool /*worldObjects*/, bool /*gridObjects*/) { return false; }
         CreatureGroupHolderType CreatureGroupHolder;
 
         void UpdateIteratorBack(Player* player);
@@ -599,10 +637,30 @@ class Map : public GridRefManager<NGridType>
         //visibility calculations. Highly optimized for massive calculations
         void ProcessRelocationNotifies(const uint32 diff);
 
+        void UpdateTransports(uint32 diff);
+        void UpdateAntiCheat();
+
         bool i_scriptLock;
         std::set<WorldObject*> i_objectsToRemove;
         std::map<WorldObject*, bool> i_objectsToSwitch;
         std::set<WorldObject*> i_worldObjects;
+        std::set<Transport*> _transports;
+        SpatialHashIndex* _spatialIndex;
+
+        TimerWheel _timers;
+        uint32 _expiredTimers;
+        // grids created since the last update, their state timer is scheduled by it. Instances create the grids
+        // of their parent map from their own update thread, under GridLock, and must not touch its timers.
+        std::vector<GridCoord> _createdGrids;
+        uint32 _antiCheatSamples;
+        uint32 _antiCheatUpdateTime;
+        uint32 _antiCheatMaxUpdateTime;
+        std::vector<GridCoord> _gridStateUpdates;           // grids whose state timer expired, updated in DelayedUpdate()
+
+        // Filled by the map threads, locked because objects of this map may still be changed from the world
+        // thread or, rarely, another map. Drained by SendObjectUpdates() after all maps are updated.
+        std::set<Object*> _updateObjects;
+        ACE_Thread_Mutex _updateObjectsLock;
 
         typedef std::multimap<time_t, ScriptAction> ScriptScheduleMap;
         ScriptScheduleMap m_scriptSchedule;
@@ -718,9 +776,19 @@ inline void Map::Visit(Cell const& cell, TypeContainerVisitor<T, CONTAINER>& vis
     }
 }
 
+// notifiers deriving from Trinity::SpatialIndexNotifier are served from the spatial index if possible
+template<class NOTIFIER>
+inline bool Map::VisitSpatialIndex(float x, float y, float radius, NOTIFIER& notifier, Trinity::SpatialIndexNotifier const* /*tag*/, bool worldObjects, bool gridObjects)
+{
+    return _spatialIndex && _spatialIndex->Visit(x, y, radius, notifier, worldObjects, gridObjects);
+}
+
 template<class NOTIFIER>
 inline void Map::VisitAll(float const& x, float const& y, float radius, NOTIFIER& notifier)
 {
+    if (VisitSpatialIndex(x, y, radius, notifier, &notifier, true, true))
+        return;
+
     CellCoord p(Trinity::ComputeCellCoord(x, y));
     Cell cell(p);
     cell.SetNoCreate();
@@ -735,6 +803,9 @@ inline void Map::VisitAll(float const& x, float const& y, float radius, NOTIFIER
 template<class NOTIFIER>
 inline void Map::VisitFirstFound(const float &x, const float &y, float radius, NOTIFIER &notifier)
 {
+    if (VisitSpatialIndex(x, y, radius, notifier, &notifier, true, true))
+        return;
+
     CellCoord p(Trinity::ComputeCellCoord(x, y));
     Cell cell(p);
     cell.SetNoCreate();
@@ -751,6 +822,9 @@ inline void Map::VisitFirstFound(const float &x, const float &y, float radius, N
 template<class NOTIFIER>
 inline void Map::VisitWorld(const float &x, const float &y, float radius, NOTIFIER &notifier)
 {
+    if (VisitSpatialIndex(x, y, radius, notifier, &notifier, true, false))
+        return;
+
     CellCoord p(Trinity::ComputeCellCoord(x, y));
     Cell cell(p);
     cell.SetNoCreate();
@@ -762,6 +836,9 @@ inline void Map::VisitWorld(const float &x, const float &y, float radius, NOTIFI
 template<class NOTIFIER>
 inline void Map::VisitGrid(const float &x, const float &y, float radius, NOTIFIER &notifier)
 {
+    if (VisitSpatialIndex(x, y, radius, notifier, &notifier, false, true))
+        return;
+
     CellCoord p(Trinity::ComputeCellCoord(x, y));
     Cell cell(p);
     cell.SetNoCreate();
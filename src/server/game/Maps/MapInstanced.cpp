@@ -83,6 +83,14 @@ void MapInstanced::DelayedUpdate(const uint32 diff)
     Map::DelayedUpdate(diff); // this may be removed
 }
 
+void MapInstanced::SendObjectUpdates()
+{
+    for (InstancedMaps::iterator i = m_InstancedMaps.begin(); i != m_InstancedMaps.end(); ++i)
+        i->second->SendObjectUpdates();
+
+    Map::SendObjectUpdates();
+}
+
 /*
 void MapInstanced::RelocationNotify()
 {
@@ -306,9 +306,15 @@ void MapManager::Update(uint32 diff)
     for (iter = i_maps.begin(); iter != i_maps.end(); ++iter)
         iter->second->DelayedUpdate(uint32(i_timer.GetCurrent()));
 
-    sObjectAccessor->Update(uint32(i_timer.GetCurrent()));
+    // BuildUpdate visits the cells around each changed object and reads its values, no map may run meanwhile
+    for (iter = i_maps.begin(); iter != i_maps.end(); ++iter)
+        iter->second->SendObjectUpdates();
+
+    // Transports are moved by the update of their map, the ones that reached another map change map here,
+    // when no map is being updated
     for (TransportSet::iterator itr = m_Transports.begin(); itr != m_Transports.end(); ++itr)
-        (*itr)->Update(uint32(i_timer.GetCurrent()));
+        if ((*itr)->IsTeleportPending())
+            (*itr)->DoPendingTeleport();
 
     i_timer.SetCurrent(0);
 }
@@ -343,6 +349,7 @@ void MapManager::UnloadAll()
 {
     for (TransportSet::iterator i = m_Transports.begin(); i != m_Transports.end(); ++i)
     {
+        (*i)->GetMap()->RemoveTransport(*i);
         (*i)->RemoveFromWorld();
         delete *i;
     }
@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2008-2013 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SpatialHashIndex.h"
+#include "Object.h"
+
+SpatialHashIndex::~SpatialHashIndex()
+{
+    // objects outliving the map must not unlink from a deleted index
+    for (BucketMap::iterator itr = _buckets.begin(); itr != _buckets.end(); ++itr)
+        for (uint8 i = 0; i < MAX_CONTAINERS; ++i)
+            for (std::vector<WorldObject*>::iterator obj = itr->second.Containers[i].Objects.begin(); obj != itr->second.Containers[i].Objects.end(); ++obj)
+                (*obj)->m_spatialIndex = NULL;
+}
+
+SpatialHashIndex::Entries& SpatialHashIndex::GetEntries(WorldObject const* obj)
+{
+    BucketMap::iterator itr = _buckets.find(obj->m_spatialKey);
+    ASSERT(itr != _buckets.end());
+    return itr->second.Containers[obj->m_spatialContainer];
+}
+
+void SpatialHashIndex::UpdateMaxObjectSize(WorldObject const* obj)
+{
+    if (obj->GetObjectSize() > _maxObjectSize)
+        _maxObjectSize = obj->GetObjectSize();
+}
+
+void SpatialHashIndex::Insert(WorldObject* obj, bool inWorldContainer)
+{
+    ASSERT(!obj->m_spatialIndex);
+
+    float x = obj->GetPositionX();
+    float y = obj->GetPositionY();
+    uint32 key = MakeKey(ComputeBucketCoord(x), ComputeBucketCoord(y));
+    uint8 container = inWorldContainer ? CONTAINER_WORLD : CONTAINER_GRID;
+    Entries& entries = _buckets[key].Containers[container];
+
+    obj->m_spatialIndex = this;
+    obj->m_spatialKey = key;
+    obj->m_spatialSlot = entries.Size();
+    obj->m_spatialContainer = container;
+
+    entries.X.push_back(x);
+    entries.Y.push_back(y);
+    entries.PhaseMask.push_back(obj->GetPhaseMask());
+    entries.Objects.push_back(obj);
+    ++_size;
+
+    UpdateMaxObjectSize(obj);
+}
+
+void SpatialHashIndex::Remove(WorldObject* obj)
+{
+    ASSERT(obj->m_spatialIndex == this);
+
+    BucketMap::iterator itr = _buckets.find(obj->m_spatialKey);
+    ASSERT(itr != _buckets.end());
+
+    Entries& entries = itr->second.Containers[obj->m_spatialContainer];
+    uint32 slot = obj->m_spatialSlot;
+    uint32 last = entries.Size() - 1;
+    ASSERT(slot <= last && entries.Objects[slot] == obj);
+
+    if (slot != last)
+    {
+        entries.X[slot] = entries.X[last];
+        entries.Y[slot] = entries.Y[last];
+        entries.PhaseMask[slot] = entries.PhaseMask[last];
+        entries.Objects[slot] = entries.Objects[last];
+        entries.Objects[slot]->m_spatialSlot = slot;
+    }
+
+    entries.X.pop_back();
+    entries.Y.pop_back();
+    entries.PhaseMask.pop_back();
+    entries.Objects.pop_back();
+
+    if (itr->second.IsEmpty())
+        _buckets.erase(itr);
+
+    obj->m_spatialIndex = NULL;
+    --_size;
+}
+
+void SpatialHashIndex::Relocate(WorldObject* obj)
+{
+    if (obj->m_spatialIndex != this)
+        return;
+
+    float x = obj->GetPositionX();
+    float y = obj->GetPositionY();
+    if (MakeKey(ComputeBucketCoord(x), ComputeBucketCoord(y)) == obj->m_spatialKey)
+    {
+        Entries& entries = GetEntries(obj);
+        entries.X[obj->m_spatialSlot] = x;
+        entries.Y[obj->m_spatialSlot] = y;
+
+        UpdateMaxObjectSize(obj);
+        return;
+    }
+
+    bool inWorldContainer = obj->m_spatialContainer == CONTAINER_WORLD;
+    Remove(obj);
+    Insert(obj, inWorldContainer);
+}
+
+void SpatialHashIndex::UpdatePhaseMask(WorldObject* obj)
+{
+    if (obj->m_spatialIndex != this)
+        return;
+
+    GetEntries(obj).PhaseMask[obj->m_spatialSlot] = obj->GetPhaseMask();
+}
@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2008-2013 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_SPATIALHASHINDEX_H
+#define TRINITY_SPATIALHASHINDEX_H
+
+#include "Define.h"
+#include "GridDefines.h"
+#include "UnorderedMap.h"
+#include <vector>
+
+class WorldObject;
+
+#define SPATIAL_HASH_BUCKET_SIZE        8.0f
+#define SPATIAL_HASH_BUCKETS_PER_AXIS   uint32(MAP_SIZE / SPATIAL_HASH_BUCKET_SIZE + 1)
+// searches reaching further than this are cheaper through whole grid cells
+#define SPATIAL_HASH_MAX_SEARCH_RANGE   32.0f
+
+namespace Trinity
+{
+    // Notifiers deriving from this provide VisitObject() overloads for single objects
+    // and may be served by Map::VisitAll/VisitWorld/VisitGrid from the map spatial hash.
+    // Objects sharing no phase with i_spatialPhaseMask are skipped before they are
+    // dereferenced, 0 visits all phases.
+    struct SpatialIndexNotifier
+    {
+        explicit SpatialIndexNotifier(uint32 phaseMask = 0) : i_spatialPhaseMask(phaseMask) { }
+
+        uint32 i_spatialPhaseMask;
+    };
+}
+
+/**
+ * Optional per map index of all grid linked objects in SPATIAL_HASH_BUCKET_SIZE buckets.
+ *
+ * Objects are added and removed together with their grid link (see GridObject) and their
+ * indexed position is refreshed by WorldObject::Relocate. Every bucket keeps the
+ * positions and phase masks of its objects in packed arrays, searches filter them by
+ * distance and phase four at a time (SSE2) and only dereference the objects that pass.
+ * Every object remembers its bucket and slot so removal is a swap with the last object.
+ */
+class SpatialHashIndex
+{
+    public:
+        enum Container
+        {
+            CONTAINER_GRID  = 0,
+            CONTAINER_WORLD = 1,
+            MAX_CONTAINERS  = 2
+        };
+
+        // structure of arrays, the same slot in every array describes one object
+        struct Entries
+        {
+            std::vector<float> X;
+            std::vector<float> Y;
+            std::vector<uint32> PhaseMask;
+            std::vector<WorldObject*> Objects;
+
+            uint32 Size() const { return uint32(Objects.size()); }
+        };
+
+        struct Bucket
+        {
+            Entries Containers[MAX_CONTAINERS];
+
+            bool IsEmpty() const { return Containers[CONTAINER_GRID].Objects.empty() && Containers[CONTAINER_WORLD].Objects.empty(); }
+        };
+
+        typedef UNORDERED_MAP<uint32, Bucket> BucketMap;
+
+        SpatialHashIndex() : _size(0), _maxObjectSize(0.0f) { }
+        ~SpatialHashIndex();
+
+        void Insert(WorldObject* obj, bool inWorldContainer);
+        void Remove(WorldObject* obj);
+        void Relocate(WorldObject* obj);
+        void UpdatePhaseMask(WorldObject* obj);
+        void UpdateMaxObjectSize(WorldObject const* obj);
+
+        // returns false if the search must fall back to the grid cells
+        // vectorized is only cleared to benchmark the scalar filter
+        template<class NOTIFIER> bool Visit(float x, float y, float radius, NOTIFIER& notifier, bool worldObjects, bool gridObjects, bool vectorized = true) const;
+
+        uint32 GetSize() const { return _size; }
+        uint32 GetBucketCount() const { return uint32(_buckets.size()); }
+        float GetMaxObjectSize() const { return _maxObjectSize; }
+
+        static uint32 ComputeBucketCoord(float c)
+        {
+            c += MAP_HALFSIZE;
+            if (!(c > 0.0f))
+                return 0;
+
+            uint32 coord = uint32(c / SPATIAL_HASH_BUCKET_SIZE);
+            return coord < SPATIAL_HASH_BUCKETS_PER_AXIS ? coord : SPATIAL_HASH_BUCKETS_PER_AXIS - 1;
+        }
+
+        static uint32 MakeKey(uint32 x, uint32 y) { return x * SPATIAL_HASH_BUCKETS_PER_AXIS + y; }
+
+    private:
+        template<class NOTIFIER> static void VisitEntries(Entries const& entries, float x, float y, float rangeSq, uint32 phaseMask, NOTIFIER& notifier, bool vectorized);
+        template<class NOTIFIER> static void VisitObject(WorldObject* obj, NOTIFIER& notifier);
+
+        Entries& GetEntries(WorldObject const* obj);
+
+        BucketMap _buckets;
+        uint32 _size;
+        // objects are indexed by their center but checks measure from the object bounds,
+        // searches are widened by the largest object size seen so far, including resizes
+        float _maxObjectSize;
+};
+
+#endif
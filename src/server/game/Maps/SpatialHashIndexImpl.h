@@ -0,0 +1,137 @@
+/*
+ * Copyright (C) 2008-2013 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_SPATIALHASHINDEXIMPL_H
+#define TRINITY_SPATIALHASHINDEXIMPL_H
+
+#include "SpatialHashIndex.h"
+#include "Corpse.h"
+#include "Creature.h"
+#include "DynamicObject.h"
+#include "GameObject.h"
+#include "Player.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  define SPATIAL_HASH_SSE2
+#  include <emmintrin.h>
+#endif
+
+template<class NOTIFIER>
+void SpatialHashIndex::VisitObject(WorldObject* obj, NOTIFIER& notifier)
+{
+    switch (obj->GetTypeId())
+    {
+        case TYPEID_PLAYER:
+            notifier.VisitObject(static_cast<Player*>(obj));
+            break;
+        case TYPEID_UNIT:
+            notifier.VisitObject(static_cast<Creature*>(obj));
+            break;
+        case TYPEID_GAMEOBJECT:
+            notifier.VisitObject(static_cast<GameObject*>(obj));
+            break;
+        case TYPEID_DYNAMICOBJECT:
+            notifier.VisitObject(static_cast<DynamicObject*>(obj));
+            break;
+        case TYPEID_CORPSE:
+            notifier.VisitObject(static_cast<Corpse*>(obj));
+            break;
+        default:
+            break;
+    }
+}
+
+// Only the 2d distance is filtered, some checks ignore the height
+template<class NOTIFIER>
+void SpatialHashIndex::VisitEntries(Entries const& entries, float x, float y, float rangeSq, uint32 phaseMask, NOTIFIER& notifier, bool vectorized)
+{
+    uint32 count = entries.Size();
+    uint32 i = 0;
+
+#ifdef SPATIAL_HASH_SSE2
+    if (vectorized)
+    {
+        __m128 const centerX = _mm_set1_ps(x);
+        __m128 const centerY = _mm_set1_ps(y);
+        __m128 const range = _mm_set1_ps(rangeSq);
+        __m128i const phase = _mm_set1_epi32(int32(phaseMask));
+        __m128i const zero = _mm_setzero_si128();
+        __m128i const anyPhase = _mm_cmpeq_epi32(phase, zero);
+
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128 dx = _mm_sub_ps(_mm_loadu_ps(&entries.X[i]), centerX);
+            __m128 dy = _mm_sub_ps(_mm_loadu_ps(&entries.Y[i]), centerY);
+            __m128 inRange = _mm_cmple_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), range);
+
+            __m128i shared = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<__m128i const*>(&entries.PhaseMask[i])), phase);
+            __m128i outOfPhase = _mm_andnot_si128(anyPhase, _mm_cmpeq_epi32(shared, zero));
+
+            int pass = _mm_movemask_ps(_mm_andnot_ps(_mm_castsi128_ps(outOfPhase), inRange));
+            for (uint32 lane = 0; pass; ++lane, pass >>= 1)
+                if (pass & 1)
+                    VisitObject(entries.Objects[i + lane], notifier);
+        }
+    }
+#endif
+
+    for (; i < count; ++i)
+    {
+        float dx = entries.X[i] - x;
+        float dy = entries.Y[i] - y;
+        if (dx * dx + dy * dy > rangeSq)
+            continue;
+
+        if (phaseMask && !(entries.PhaseMask[i] & phaseMask))
+            continue;
+
+        VisitObject(entries.Objects[i], notifier);
+    }
+}
+
+template<class NOTIFIER>
+bool SpatialHashIndex::Visit(float x, float y, float radius, NOTIFIER& notifier, bool worldObjects, bool gridObjects, bool vectorized) const
+{
+    // searcher and target sizes are both added to the range by the checks
+    float range = radius + 2.0f * _maxObjectSize;
+    if (range > SPATIAL_HASH_MAX_SEARCH_RANGE)
+        return false;
+
+    uint32 lowX = ComputeBucketCoord(x - range);
+    uint32 highX = ComputeBucketCoord(x + range);
+    uint32 lowY = ComputeBucketCoord(y - range);
+    uint32 highY = ComputeBucketCoord(y + range);
+
+    for (uint32 bucketX = lowX; bucketX <= highX; ++bucketX)
+    {
+        for (uint32 bucketY = lowY; bucketY <= highY; ++bucketY)
+        {
+            BucketMap::const_iterator itr = _buckets.find(MakeKey(bucketX, bucketY));
+            if (itr == _buckets.end())
+                continue;
+
+            if (worldObjects)
+                VisitEntries(itr->second.Containers[CONTAINER_WORLD], x, y, range * range, notifier.i_spatialPhaseMask, notifier, vectorized);
+            if (gridObjects)
+                VisitEntries(itr->second.Containers[CONTAINER_GRID], x, y, range * range, notifier.i_spatialPhaseMask, notifier, vectorized);
+        }
+    }
+
+    return true;
+}
+
+#endif
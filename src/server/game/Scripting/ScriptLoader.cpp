@@ -50,6 +50,9 @@ void AddSC_account_commandscript();
 void AddSC_achievement_commandscript();
 void AddSC_ban_commandscript();
 void AddSC_bf_commandscript();
+#ifdef WITH_BENCHMARKS
+void AddSC_bench_commandscript();
+#endif
 void AddSC_anticheat_commandscript();
 void AddSC_cast_commandscript();
 void AddSC_character_commandscript();
@@ -802,6 +805,9 @@ void AddCommandScripts()
     AddSC_achievement_commandscript();
     AddSC_ban_commandscript();
     AddSC_bf_commandscript();
+#ifdef WITH_BENCHMARKS
+    AddSC_bench_commandscript();
+#endif
     AddSC_anticheat_commandscript();
     AddSC_cast_commandscript();
     AddSC_character_commandscript();
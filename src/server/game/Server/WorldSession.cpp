@@ -1036,60 +1036,87 @@ void WorldSession::InitializeQueryCallbackParameters()
     // Callback parameters that have pointers in them should be properly
     // initialized to NULL here.
     _charCreateCallback.SetParam(NULL);
+
+    _charEnumCallback.SetCompletionQueue(&_queryCompletions, QUERY_CALLBACK_CHAR_ENUM);
+    _addIgnoreCallback.SetCompletionQueue(&_queryCompletions, QUERY_CALLBACK_ADD_IGNORE);
+    _charRenameCallback.SetCompletionQueue(&_queryCompletions, QUERY_CALLBACK_CHAR_RENAME);
+    _addFriendCallback.SetCompletionQueue(&_queryCompletions, QUERY_CALLBACK_ADD_FRIEND);
+    _charCreateCallback.SetCompletionQueue(&_queryCompletions, QUERY_CALLBACK_CHAR_CREATE);
+    _charLoginCallback.SetCompletionQueue(&_queryCompletions, QUERY_CALLBACK_CHAR_LOGIN);
 }
 
 void WorldSession::ProcessQueryCallbacks()
 {
-    PreparedQueryResult result;
-
-    //! HandleCharEnumOpcode
-    if (_charEnumCallback.ready())
-    {
-        _charEnumCallback.get(result);
-        HandleCharEnum(result);
-        _charEnumCallback.cancel();
-    }
-
-    if (_charCreateCallback.IsReady())
-    {
-        _charCreateCallback.GetResult(result);
-        HandleCharCreateCallback(result, _charCreateCallback.GetParam());
-        // Don't call FreeResult() here, the callback handler will do that depending on the events in the callback chain
-    }
-
-    //! HandlePlayerLoginOpcode
-    if (_charLoginCallback.ready())
-    {
-        SQLQueryHolder* param;
-        _charLoginCallback.get(param);
-        HandlePlayerLogin((LoginQueryHolder*)param);
-        _charLoginCallback.cancel();
-    }
-
-    //! HandleAddFriendOpcode
-    if (_addFriendCallback.IsReady())
-    {
-        std::string param = _addFriendCallback.GetParam();
-        _addFriendCallback.GetResult(result);
-        HandleAddFriendOpcodeCallBack(result, param);
-        _addFriendCallback.FreeResult();
-    }
-
-    //- HandleCharRenameOpcode
-    if (_charRenameCallback.IsReady())
-    {
-        std::string param = _charRenameCallback.GetParam();
-        _charRenameCallback.GetResult(result);
-        HandleChangePlayerNameOpcodeCallBack(result, param);
-        _charRenameCallback.FreeResult();
-    }
+    // Only callbacks whose result was set by a worker thread are reported here. A reported callback may
+    // have been replaced by a newer, still pending query since, so readiness is checked again.
+    if (_queryCompletions.IsEmpty())
+        return;
 
-    //- HandleCharAddIgnoreOpcode
-    if (_addIgnoreCallback.ready())
+    PreparedQueryResult result;
+    uint32 callbackId;
+    while (_queryCompletions.Next(callbackId))
     {
-        _addIgnoreCallback.get(result);
-        HandleAddIgnoreOpcodeCallBack(result);
-        _addIgnoreCallback.cancel();
+        switch (callbackId)
+        {
+            //! HandleCharEnumOpcode
+            case QUERY_CALLBACK_CHAR_ENUM:
+                if (_charEnumCallback.IsReady())
+                {
+                    _charEnumCallback.GetResult(result);
+                    HandleCharEnum(result);
+                    _charEnumCallback.FreeResult();
+                }
+                break;
+            case QUERY_CALLBACK_CHAR_CREATE:
+                if (_charCreateCallback.IsReady())
+                {
+                    _charCreateCallback.GetResult(result);
+                    HandleCharCreateCallback(result, _charCreateCallback.GetParam());
+                    // Don't call FreeResult() here, the callback handler will do that depending on the events in the callback chain
+                }
+                break;
+            //! HandlePlayerLoginOpcode
+            case QUERY_CALLBACK_CHAR_LOGIN:
+                if (_charLoginCallback.IsReady())
+                {
+                    SQLQueryHolder* param;
+                    _charLoginCallback.GetResult(param);
+                    HandlePlayerLogin((LoginQueryHolder*)param);
+                    _charLoginCallback.FreeResult();
+                }
+                break;
+            //! HandleAddFriendOpcode
+            case QUERY_CALLBACK_ADD_FRIEND:
+                if (_addFriendCallback.IsReady())
+                {
+                    std::string param = _addFriendCallback.GetParam();
+                    _addFriendCallback.GetResult(result);
+                    HandleAddFriendOpcodeCallBack(result, param);
+                    _addFriendCallback.FreeResult();
+                }
+                break;
+            //- HandleCharRenameOpcode
+            case QUERY_CALLBACK_CHAR_RENAME:
+                if (_charRenameCallback.IsReady())
+                {
+                    std::string param = _charRenameCallback.GetParam();
+                    _charRenameCallback.GetResult(result);
+                    HandleChangePlayerNameOpcodeCallBack(result, param);
+                    _charRenameCallback.FreeResult();
+                }
+                break;
+            //- HandleCharAddIgnoreOpcode
+            case QUERY_CALLBACK_ADD_IGNORE:
+                if (_addIgnoreCallback.IsReady())
+                {
+                    _addIgnoreCallback.GetResult(result);
+                    HandleAddIgnoreOpcodeCallBack(result);
+                    _addIgnoreCallback.FreeResult();
+                }
+                break;
+            default:
+                break;
+        }
     }
 }
 
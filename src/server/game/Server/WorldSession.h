@@ -37,7 +37,6 @@ class Creature;
 class GameObject;
 class InstanceSave;
 class Item;
-class LoginQueryHolder;
 class Object;
 class Player;
 class Quest;
@@ -85,6 +84,19 @@ enum AccountDataType
 
 typedef std::list<WorldPacket*> packetBlock;  
 
+class LoginQueryHolder : public SQLQueryHolder
+{
+    private:
+        uint32 m_accountId;
+        uint64 m_guid;
+    public:
+        LoginQueryHolder(uint32 accountId, uint64 guid)
+            : m_accountId(accountId), m_guid(guid) { }
+        uint64 GetGuid() const { return m_guid; }
+        uint32 GetAccountId() const { return m_accountId; }
+        bool Initialize();
+};
+
 struct AccountData
 {
     AccountData() : Time(0), Data("") {}
@@ -1005,8 +1017,21 @@ class WorldSession
         void InitializeQueryCallbackParameters();
         void ProcessQueryCallbacks();
 
-        PreparedQueryResultFuture _charEnumCallback;
-        PreparedQueryResultFuture _addIgnoreCallback;
+        enum QueryCallbackId
+        {
+            QUERY_CALLBACK_CHAR_ENUM,
+            QUERY_CALLBACK_ADD_IGNORE,
+            QUERY_CALLBACK_CHAR_RENAME,
+            QUERY_CALLBACK_ADD_FRIEND,
+            QUERY_CALLBACK_CHAR_CREATE,
+            QUERY_CALLBACK_CHAR_LOGIN
+        };
+
+        // Must be declared before the callbacks reporting to it
+        QueryCompletionQueue _queryCompletions;
+
+        QueryCallback<PreparedQueryResult, bool> _charEnumCallback;
+        QueryCallback<PreparedQueryResult, bool> _addIgnoreCallback;
         PreparedQueryResultFuture _stablePetCallback;
         QueryCallback<PreparedQueryResult, std::string> _charRenameCallback;
         QueryCallback<PreparedQueryResult, std::string> _addFriendCallback;
@@ -1014,7 +1039,7 @@ class WorldSession
         QueryCallback<PreparedQueryResult, uint32> _stableSwapCallback;
         QueryCallback<PreparedQueryResult, uint64> _sendStabledPetCallback;
         QueryCallback<PreparedQueryResult, CharacterCreateInfo*, true> _charCreateCallback;
-        QueryResultHolderFuture _charLoginCallback;
+        QueryCallback<SQLQueryHolder*, bool> _charLoginCallback;
 
     private:
         // private trade methods
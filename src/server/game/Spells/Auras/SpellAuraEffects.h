@@ -36,6 +36,9 @@ class AuraEffect
         ~AuraEffect();
         explicit AuraEffect(Aura* base, uint8 effIndex, int32 *baseAmount, Unit* caster);
     public:
+        static void* operator new(size_t size) { return ObjectPool<AuraEffect>::Allocate(size); }
+        static void operator delete(void* ptr, size_t size) { ObjectPool<AuraEffect>::Deallocate(ptr, size); }
+
         Unit* GetCaster() const { return GetBase()->GetCaster(); }
         uint64 GetCasterGUID() const { return GetBase()->GetCasterGUID(); }
         Aura* GetBase() const { return m_base; }
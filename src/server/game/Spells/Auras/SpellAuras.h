@@ -22,6 +22,7 @@
 #include "SpellAuraDefines.h"
 #include "SpellInfo.h"
 #include "Unit.h"
+#include "ObjectPool.h"
 
 class Unit;
 class SpellInfo;
@@ -61,6 +62,8 @@ class AuraApplication
         void _InitFlags(Unit* caster, uint8 effMask);
         void _HandleEffect(uint8 effIndex, bool apply);
     public:
+        static void* operator new(size_t size) { return ObjectPool<AuraApplication>::Allocate(size); }
+        static void operator delete(void* ptr, size_t size) { ObjectPool<AuraApplication>::Deallocate(ptr, size); }
 
         Unit* GetTarget() const { return _target; }
         Aura* GetBase() const { return _base; }
@@ -263,6 +266,9 @@ class UnitAura : public Aura
     protected:
         explicit UnitAura(SpellInfo const* spellproto, uint8 effMask, WorldObject* owner, Unit* caster, int32 *baseAmount, Item* castItem, uint64 casterGUID);
     public:
+        static void* operator new(size_t size) { return ObjectPool<UnitAura>::Allocate(size); }
+        static void operator delete(void* ptr, size_t size) { ObjectPool<UnitAura>::Deallocate(ptr, size); }
+
         void _ApplyForTarget(Unit* target, Unit* caster, AuraApplication * aurApp);
         void _UnapplyForTarget(Unit* target, Unit* caster, AuraApplication * aurApp);
 
@@ -24,6 +24,7 @@
 #include "ObjectMgr.h"
 #include "SpellInfo.h"
 #include "PathGenerator.h"
+#include "ObjectPool.h"
 
 class Unit;
 class Player;
@@ -351,6 +352,9 @@ class Spell
         Spell(Unit* caster, SpellInfo const* info, TriggerCastFlags triggerFlags, uint64 originalCasterGUID = 0, bool skipCheck = false);
         ~Spell();
 
+        static void* operator new(size_t size) { return ObjectPool<Spell>::Allocate(size); }
+        static void operator delete(void* ptr, size_t size) { ObjectPool<Spell>::Deallocate(ptr, size); }
+
         void InitExplicitTargets(SpellCastTargets const& targets);
         void SelectExplicitTargets();
 
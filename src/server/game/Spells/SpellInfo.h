@@ -305,10 +305,10 @@ private:
 class SpellInfo
 {
 public:
+    // Hot data: read by the cast, target selection and damage paths (Spell::prepare, Spell::CheckCast,
+    // Unit::SpellDamageBonus...). Kept together at the start of the object so a cast touches as few
+    // cache lines as possible, add rarely used fields to the cold part below.
     uint32 Id;
-    uint32 Category;
-    uint32 Dispel;
-    uint32 Mechanic;
     uint32 Attributes;
     uint32 AttributesEx;
     uint32 AttributesEx2;
@@ -321,12 +321,20 @@ public:
     uint32 AttributesEx9;
     uint32 AttributesEx10;
     uint32 AttributesCu;
-    uint32 Stances;
-    uint32 StancesNot;
+    uint32 SchoolMask;
+    uint32 DmgClass;
+    uint32 PreventionType;
+    uint32 SpellFamilyName;
+    flag96 SpellFamilyFlags;
+    uint32 Category;
+    uint32 Dispel;
+    uint32 Mechanic;
+    uint32 ExplicitTargetMask;
     uint32 Targets;
     uint32 TargetCreatureType;
-    uint32 RequiresSpellFocus;
     uint32 FacingCasterFlags;
+    uint32 Stances;
+    uint32 StancesNot;
     uint32 CasterAuraState;
     uint32 TargetAuraState;
     uint32 CasterAuraStateNot;
@@ -336,6 +344,9 @@ public:
     uint32 ExcludeCasterAuraSpell;
     uint32 ExcludeTargetAuraSpell;
     SpellCastTimesEntry const* CastTimeEntry;
+    SpellDurationEntry const* DurationEntry;
+    SpellRangeEntry const* RangeEntry;
+    float  Speed;
     uint32 RecoveryTime;
     uint32 CategoryRecoveryTime;
     uint32 StartRecoveryCategory;
@@ -343,42 +354,38 @@ public:
     uint32 InterruptFlags;
     uint32 AuraInterruptFlags;
     uint32 ChannelInterruptFlags;
-    uint32 ProcFlags;
-    uint32 ProcChance;
-    uint32 ProcCharges;
-    uint32 MaxLevel;
-    uint32 BaseLevel;
-    uint32 SpellLevel;
-    SpellDurationEntry const* DurationEntry;
     uint32 PowerType;
     uint32 ManaCost;
     uint32 ManaCostPerlevel;
     uint32 ManaPerSecond;
     uint32 ManaCostPercentage;
     uint32 RuneCostID;
-    SpellRangeEntry const* RangeEntry;
-    float  Speed;
+    uint32 MaxLevel;
+    uint32 BaseLevel;
+    uint32 SpellLevel;
+    uint32 MaxTargetLevel;
+    uint32 MaxAffectedTargets;
     uint32 StackAmount;
-    uint32 Totem[2];
-    int32  Reagent[MAX_SPELL_REAGENTS];
-    uint32 ReagentCount[MAX_SPELL_REAGENTS];
+    uint32 RequiresSpellFocus;
+    int32  AreaGroupId;
     int32  EquippedItemClass;
     int32  EquippedItemSubClassMask;
     int32  EquippedItemInventoryTypeMask;
+    SpellChainNode const* ChainEntry;
+
+    // Cold data: loading, client display, procs and reagents
+    uint32 ProcFlags;
+    uint32 ProcChance;
+    uint32 ProcCharges;
+    uint32 Totem[2];
+    int32  Reagent[MAX_SPELL_REAGENTS];
+    uint32 ReagentCount[MAX_SPELL_REAGENTS];
     uint32 TotemCategory[2];
     uint32 SpellVisual[2];
     uint32 SpellIconID;
     uint32 ActiveIconID;
     char* SpellName;
     char* Rank;
-    uint32 MaxTargetLevel;
-    uint32 MaxAffectedTargets;
-    uint32 SpellFamilyName;
-    flag96 SpellFamilyFlags;
-    uint32 DmgClass;
-    uint32 PreventionType;
-    int32  AreaGroupId;
-    uint32 SchoolMask;
     uint32 SpellDifficultyId;
     uint32 SpellScalingId;
     uint32 SpellAuraOptionsId;
@@ -403,9 +410,9 @@ public:
     int32  ScalingClass;
     float  CoefBase;
     int32  CoefLevelBase;
+
+    // Effects are read through Effects[i] on the damage paths, they are too large to share the hot lines
     SpellEffectInfo Effects[MAX_SPELL_EFFECTS];
-    uint32 ExplicitTargetMask;
-    SpellChainNode const* ChainEntry;
 
     // Info Entrys
     SpellImplicitTargetInfo TargetA;
@@ -368,7 +368,7 @@ bool IsDiminishingReturnsGroupDurationLimited(DiminishingGroup group)
     }
 }
 
-SpellMgr::SpellMgr()
+SpellMgr::SpellMgr() : mSpellInfoStorage(NULL), mSpellInfoStorageSize(0)
 {
 }
 
@@ -2642,20 +2642,29 @@ void SpellMgr::LoadSpellInfoStore()
         effectsBySpell[effect->EffectSpellId].effects[effect->EffectIndex] = effect;
     }
 
+    uint32 spellCount = 0;
+    for (uint32 i = 0; i < sSpellStore.GetNumRows(); ++i)
+        if (sSpellStore.LookupEntry(i))
+            ++spellCount;
+
+    // All SpellInfo objects are placed in one block ordered by id instead of one allocation per spell,
+    // neighbouring spells (ranks, triggered spells) share pages and there is no allocator overhead per object
+    mSpellInfoStorage = static_cast<SpellInfo*>(::operator new(spellCount * sizeof(SpellInfo)));
     for (uint32 i = 0; i < sSpellStore.GetNumRows(); ++i)
         if (SpellEntry const* spellEntry = sSpellStore.LookupEntry(i))
-            mSpellInfoMap[i] = new SpellInfo(spellEntry, effectsBySpell[i].effects);
+            mSpellInfoMap[i] = new (&mSpellInfoStorage[mSpellInfoStorageSize++]) SpellInfo(spellEntry, effectsBySpell[i].effects);
 
     sLog->outInfo(LOG_FILTER_SERVER_LOADING, ">> Loaded spell info store in %u ms", GetMSTimeDiffToNow(oldMSTime));
 }
 
 void SpellMgr::UnloadSpellInfoStore()
 {
-    for (uint32 i = 0; i < mSpellInfoMap.size(); ++i)
-    {
-        if (mSpellInfoMap[i])
-            delete mSpellInfoMap[i];
-    }
+    for (uint32 i = 0; i < mSpellInfoStorageSize; ++i)
+        mSpellInfoStorage[i].~SpellInfo();
+
+    ::operator delete(mSpellInfoStorage);
+    mSpellInfoStorage = NULL;
+    mSpellInfoStorageSize = 0;
     mSpellInfoMap.clear();
 }
 
@@ -753,7 +753,9 @@ class SpellMgr
         SkillLineAbilityMap        mSkillLineAbilityMap;
         PetLevelupSpellMap         mPetLevelupSpellMap;
         PetDefaultSpellsMap        mPetDefaultSpellsMap;           // only spells not listed in related mPetLevelupSpellMap entry
-        SpellInfoMap               mSpellInfoMap;
+        SpellInfoMap               mSpellInfoMap;                  // indexed by spell id, points into mSpellInfoStorage
+        SpellInfo*                 mSpellInfoStorage;
+        uint32                     mSpellInfoStorageSize;
 };
 
 #define sSpellMgr ACE_Singleton<SpellMgr, ACE_Null_Mutex>::instance()
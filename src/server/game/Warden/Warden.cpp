@@ -28,14 +28,18 @@
 #include "Player.h"
 #include "Util.h"
 #include "Warden.h"
+#include "WardenScheduler.h"
 #include "AccountMgr.h"
+#include "AnticheatSink.h"
 
-Warden::Warden() : _inputCrypto(16), _outputCrypto(16), _checkTimer(10000/*10 sec*/), _clientResponseTimer(0), _dataSent(false), _initialized(false)
+Warden::Warden() : _inputCrypto(16), _outputCrypto(16), _checkTimer(WARDEN_FIRST_REQUEST_DELAY), _clientResponseTimer(0), _dataSent(false), _initialized(false)
 {
+    sWardenScheduler->AddWarden();
 }
 
 Warden::~Warden()
 {
+    sWardenScheduler->RemoveWarden();
     delete[] _module->CompressedData;
     delete _module;
     _module = NULL;
@@ -179,7 +183,7 @@ uint32 Warden::BuildChecksum(const uint8* data, uint32 length)
     return checkSum;
 }
 
-std::string Warden::Penalty(WardenCheck* check /*= NULL*/)
+std::string Warden::Penalty(AntiCheatCheck checkType, WardenCheck* check /*= NULL*/)
 {
     WardenActions action;
 
@@ -188,35 +192,40 @@ std::string Warden::Penalty(WardenCheck* check /*= NULL*/)
     else
         action = WardenActions(sWorld->getIntConfig(CONFIG_WARDEN_CLIENT_FAIL_ACTION));
 
+    // counted and banned by the world thread
+    AntiCheatViolation violation;
+    violation.AccountId = _session->GetAccountId();
+    violation.Guid = _session->GetPlayer() ? _session->GetPlayer()->GetGUIDLow() : 0;
+    violation.CheckType = checkType;
+    violation.Time = uint32(time(NULL));
+    violation.IntValue = check ? check->CheckId : 0;
+    violation.FloatValue = 0.0f;
+    violation.Actions = 0;
+    violation.BanDuration = 0;
+    strncpy(violation.Name, _session->GetPlayer() ? _session->GetPlayer()->GetName().c_str() : "", ANTICHEAT_VIOLATION_NAME_SIZE - 1);
+    violation.Name[ANTICHEAT_VIOLATION_NAME_SIZE - 1] = '\0';
+
+    std::string result = "Undefined";
     switch (action)
     {
     case WARDEN_ACTION_LOG:
-        return "None";
+        result = "None";
         break;
     case WARDEN_ACTION_KICK:
         _session->KickPlayer();
-        return "Kick";
+        result = "Kick";
         break;
     case WARDEN_ACTION_BAN:
-        {
-            std::stringstream duration;
-            duration << sWorld->getIntConfig(CONFIG_WARDEN_CLIENT_BAN_DURATION) << "s";
-            std::string accountName;
-            AccountMgr::GetName(_session->GetAccountId(), accountName);
-            std::stringstream banReason;
-            banReason << "Warden Anticheat Violation";
-            // Check can be NULL, for example if the client sent a wrong signature in the warden packet (CHECKSUM FAIL)
-            if (check)
-                banReason << ": " << check->Comment << " (CheckId: " << check->CheckId << ")";
-
-            sWorld->BanAccount(BAN_ACCOUNT, accountName, duration.str(), banReason.str(),"Server");
-
-            return "Ban";
-        }
+        violation.Actions = ANTICHEAT_VIOLATION_BAN_ACCOUNT;
+        violation.BanDuration = sWorld->getIntConfig(CONFIG_WARDEN_CLIENT_BAN_DURATION);
+        result = "Ban";
+        break;
     default:
         break;
     }
-    return "Undefined";
+
+    sAntiCheatSink->AddViolation(violation);
+    return result;
 }
 
 void WorldSession::HandleWardenDataOpcode(WorldPacket& recvData)
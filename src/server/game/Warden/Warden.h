@@ -23,6 +23,7 @@
 #include "Cryptography/ARC4.h"
 #include "Cryptography/BigNumber.h"
 #include "ByteBuffer.h"
+#include "AnticheatConfig.h"
 #include "WardenCheckMgr.h"
 
 enum WardenOpcodes
@@ -126,8 +127,9 @@ class Warden
         static bool IsValidCheckSum(uint32 checksum, const uint8 *data, const uint16 length);
         static uint32 BuildChecksum(const uint8 *data, uint32 length);
 
-        // If no check is passed, the default action from config is executed
-        std::string Penalty(WardenCheck* check = NULL);
+        // If no check is passed, the default action from config is executed. checkType is what failed
+        // (CHECK_WARDEN_*, CHECK_WARDEN for a failed check), bans are left to the world thread
+        std::string Penalty(AntiCheatCheck checkType, WardenCheck* check = NULL);
 
     private:
         WorldSession* _session;
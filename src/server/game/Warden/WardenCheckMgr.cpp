@@ -17,6 +17,7 @@
  */
 
 #include "Common.h"
+#include "Cryptography/HMACSHA1.h"
 #include "WorldPacket.h"
 #include "WorldSession.h"
 #include "Log.h"
@@ -34,8 +35,29 @@ WardenCheckMgr::~WardenCheckMgr()
     for (uint16 i = 0; i < CheckStore.size(); ++i)
         delete CheckStore[i];
 
-    for (CheckResultContainer::iterator itr = CheckResultStore.begin(); itr != CheckResultStore.end(); ++itr)
-        delete itr->second;
+    for (uint16 i = 0; i < CheckResultStore.size(); ++i)
+        delete CheckResultStore[i];
+}
+
+// bytes of a hex string as the checks send and compare them
+void WardenCheckMgr::GetBytes(std::string const& hex, std::vector<uint8>& bytes)
+{
+    BigNumber number;
+    number.SetHexStr(hex.c_str());
+    int len = hex.size() / 2;
+
+    if (number.GetNumBytes() < len)
+    {
+        uint8* temp = new uint8[len];
+        memset(temp, 0, len);
+        memcpy(temp, number.AsByteArray(), number.GetNumBytes());
+        std::reverse(temp, temp + len);
+        number.SetBinary((uint8*)temp, len);
+        delete [] temp;
+    }
+
+    uint8 const* array = number.AsByteArray(0, false);
+    bytes.assign(array, array + number.GetNumBytes());
 }
 
 void WardenCheckMgr::LoadWardenChecks()
@@ -60,6 +82,7 @@ void WardenCheckMgr::LoadWardenChecks()
     uint16 maxCheckId = fields[0].GetUInt16();
 
     CheckStore.resize(maxCheckId + 1);
+    CheckResultStore.resize(maxCheckId + 1);
 
     //                                    0    1     2     3        4       5      6      7
     result = WorldDatabase.Query("SELECT id, type, data, result, address, length, str, comment FROM warden_checks ORDER BY id ASC");
@@ -86,19 +109,7 @@ void WardenCheckMgr::LoadWardenChecks()
         wardenCheck->Action = WardenActions(sWorld->getIntConfig(CONFIG_WARDEN_CLIENT_FAIL_ACTION));
 
         if (checkType == PAGE_CHECK_A || checkType == PAGE_CHECK_B || checkType == DRIVER_CHECK)
-        {
-            wardenCheck->Data.SetHexStr(data.c_str());
-            int len = data.size() / 2;
-
-            if (wardenCheck->Data.GetNumBytes() < len)
-            {
-                uint8 temp[24];
-                memset(temp, 0, len);
-                memcpy(temp, wardenCheck->Data.AsByteArray(), wardenCheck->Data.GetNumBytes());
-                std::reverse(temp, temp + len);
-                wardenCheck->Data.SetBinary((uint8*)temp, len);
-            }
-        }
+            GetBytes(data, wardenCheck->Data);
 
         if (checkType == MEM_CHECK || checkType == MODULE_CHECK)
             MemChecksIdPool.push_back(id);
@@ -115,22 +126,33 @@ void WardenCheckMgr::LoadWardenChecks()
         if (checkType == MEM_CHECK || checkType == MPQ_CHECK || checkType == LUA_STR_CHECK || checkType == DRIVER_CHECK || checkType == MODULE_CHECK)
             wardenCheck->Str = str;
 
+        // the requests pick one of these instead of hashing the module name each time
+        if (checkType == MODULE_CHECK)
+        {
+            wardenCheck->Seeds.resize(WARDEN_MODULE_CHECK_SEEDS);
+            for (uint32 i = 0; i < WARDEN_MODULE_CHECK_SEEDS; ++i)
+            {
+                WardenModuleSeed& seed = wardenCheck->Seeds[i];
+                seed.Seed = static_cast<uint32>(rand32());
+                HmacHash hmac(4, (uint8*)&seed.Seed);
+                hmac.UpdateData(str);
+                hmac.Finalize();
+                memcpy(seed.Digest, hmac.GetDigest(), sizeof(seed.Digest));
+            }
+        }
+
         CheckStore[id] = wardenCheck;
 
         if (checkType == MPQ_CHECK || checkType == MEM_CHECK)
         {
             WardenCheckResult* wr = new WardenCheckResult();
-            wr->Result.SetHexStr(checkResult.c_str());
-            int len = checkResult.size() / 2;
-            if (wr->Result.GetNumBytes() < len)
-            {
-                uint8 *temp = new uint8[len];
-                memset(temp, 0, len);
-                memcpy(temp, wr->Result.AsByteArray(), wr->Result.GetNumBytes());
-                std::reverse(temp, temp + len);
-                wr->Result.SetBinary((uint8*)temp, len);
-                delete [] temp;
-            }
+            GetBytes(checkResult, wr->Result);
+
+            // the answers are compared over their full length
+            uint32 resultLength = checkType == MEM_CHECK ? wardenCheck->Length : 20;
+            if (wr->Result.size() < resultLength)
+                wr->Result.resize(resultLength, 0);
+
             CheckResultStore[id] = wr;
         }
 
@@ -202,8 +224,8 @@ WardenCheck* WardenCheckMgr::GetWardenDataById(uint16 Id)
 
 WardenCheckResult* WardenCheckMgr::GetWardenResultById(uint16 Id)
 {
-    CheckResultContainer::const_iterator itr = CheckResultStore.find(Id);
-    if (itr != CheckResultStore.end())
-        return itr->second;
+    if (Id < CheckResultStore.size())
+        return CheckResultStore[Id];
+
     return NULL;
 }
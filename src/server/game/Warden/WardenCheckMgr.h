@@ -22,6 +22,8 @@
 #include <map>
 #include "Cryptography/BigNumber.h"
 
+#define WARDEN_MODULE_CHECK_SEEDS   32                      // precomputed seeds of every MODULE_CHECK
+
 enum WardenActions
 {
     WARDEN_ACTION_LOG,
@@ -29,21 +31,30 @@ enum WardenActions
     WARDEN_ACTION_BAN
 };
 
+// Seed of a MODULE_CHECK and the HMAC of the module name it gives
+struct WardenModuleSeed
+{
+    uint32 Seed;
+    uint8 Digest[20];
+};
+
 struct WardenCheck
 {
     uint8 Type;
-    BigNumber Data;
+    std::vector<uint8> Data;                                // PAGE_CHECK, DRIVER_CHECK, as sent
     uint32 Address;                                         // PROC_CHECK, MEM_CHECK, PAGE_CHECK
     uint8 Length;                                           // PROC_CHECK, MEM_CHECK, PAGE_CHECK
     std::string Str;                                        // LUA, MPQ, DRIVER
     std::string Comment;
     uint16 CheckId;
     enum WardenActions Action;
+    std::vector<WardenModuleSeed> Seeds;                    // MODULE_CHECK
 };
 
+// Expected answer of a check, as the client sends it
 struct WardenCheckResult
 {
-    BigNumber Result;                                       // MEM_CHECK
+    std::vector<uint8> Result;                              // MEM_CHECK: Length bytes, MPQ_CHECK: SHA1
 };
 
 class WardenCheckMgr
@@ -55,7 +66,7 @@ class WardenCheckMgr
     public:
         // We have a linear key without any gaps, so we use vector for fast access
         typedef std::vector<WardenCheck*> CheckContainer;
-        typedef std::map<uint32, WardenCheckResult*> CheckResultContainer;
+        typedef std::vector<WardenCheckResult*> CheckResultContainer;   // by check id, NULL for checks without result
 
         WardenCheck* GetWardenDataById(uint16 Id);
         WardenCheckResult* GetWardenResultById(uint16 Id);
@@ -69,6 +80,8 @@ class WardenCheckMgr
         ACE_RW_Mutex _checkStoreLock;
 
     private:
+        static void GetBytes(std::string const& hex, std::vector<uint8>& bytes);
+
         CheckContainer CheckStore;
         CheckResultContainer CheckResultStore;
 };
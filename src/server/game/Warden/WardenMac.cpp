@@ -29,6 +29,7 @@
 #include "Util.h"
 #include "WardenMac.h"
 #include "WardenModuleMac.h"
+#include "WardenScheduler.h"
 
 WardenMac::WardenMac() : Warden()
 {
@@ -168,7 +169,7 @@ void WardenMac::HandleHashResult(ByteBuffer &buff)
     // Verify key
     if (memcmp(buff.contents() + 1, sha1.GetDigest(), 20) != 0)
     {
-        sLog->outWarn(LOG_FILTER_WARDEN, "%s failed hash reply. Action: %s", _session->GetPlayerInfo().c_str(), Penalty().c_str());
+        sLog->outWarn(LOG_FILTER_WARDEN, "%s failed hash reply. Action: %s", _session->GetPlayerInfo().c_str(), Penalty(CHECK_WARDEN_KEY).c_str());
         return;
     }
 
@@ -190,6 +191,7 @@ void WardenMac::HandleHashResult(ByteBuffer &buff)
     _initialized = true;
 
     _previousTimestamp = getMSTime();
+    _checkTimer = sWardenScheduler->ScheduleRequest(WARDEN_FIRST_REQUEST_DELAY);
 }
 
 void WardenMac::RequestData()
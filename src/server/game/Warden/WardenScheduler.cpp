@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2008-2013 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "WardenScheduler.h"
+#include "Timer.h"
+
+WardenScheduler::WardenScheduler() : _wardens(0), _lastSlot(0), _slotSet(false), _interval(0), _requests(0),
+    _windowStart(getMSTime()), _windowRequests(0), _windowChecks(0), _requestRate(0), _checkRate(0)
+{
+}
+
+void WardenScheduler::AddWarden()
+{
+    TRINITY_GUARD(ACE_Thread_Mutex, _lock);
+    ++_wardens;
+}
+
+void WardenScheduler::RemoveWarden()
+{
+    TRINITY_GUARD(ACE_Thread_Mutex, _lock);
+    if (_wardens)
+        --_wardens;
+}
+
+uint32 WardenScheduler::ScheduleRequest(uint32 minDelay)
+{
+    TRINITY_GUARD(ACE_Thread_Mutex, _lock);
+
+    uint32 now = getMSTime();
+    uint32 earliest = now + minDelay;
+    _interval = minDelay / (_wardens ? _wardens : 1);
+
+    // the slot after the last one handed out, unless it passed already
+    uint32 slot = _lastSlot + _interval;
+    if (!_slotSet || int32(slot - earliest) < 0)
+        slot = earliest;
+    // fewer sessions than when the slots were handed out
+    else if (int32(slot - earliest) > int32(minDelay))
+        slot = earliest + minDelay;
+
+    _lastSlot = slot;
+    _slotSet = true;
+    return slot - now;
+}
+
+void WardenScheduler::UpdateRates(uint32 now)
+{
+    uint32 elapsed = getMSTimeDiff(_windowStart, now);
+    if (elapsed < WARDEN_RATE_WINDOW)
+        return;
+
+    _requestRate = uint32(uint64(_windowRequests) * IN_MILLISECONDS / elapsed);
+    _checkRate = uint32(uint64(_windowChecks) * IN_MILLISECONDS / elapsed);
+    _windowStart = now;
+    _windowRequests = 0;
+    _windowChecks = 0;
+}
+
+void WardenScheduler::RecordRequest(uint32 checks)
+{
+    TRINITY_GUARD(ACE_Thread_Mutex, _lock);
+
+    UpdateRates(getMSTime());
+    ++_requests;
+    ++_windowRequests;
+    _windowChecks += checks;
+}
+
+WardenStats WardenScheduler::GetStats()
+{
+    TRINITY_GUARD(ACE_Thread_Mutex, _lock);
+
+    UpdateRates(getMSTime());
+
+    WardenStats stats;
+    stats.Wardens = _wardens;
+    stats.Interval = _interval;
+    stats.RequestsPerSec = _requestRate;
+    stats.ChecksPerSec = _checkRate;
+    stats.Requests = _requests;
+    return stats;
+}
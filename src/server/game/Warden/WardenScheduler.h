@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2008-2013 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _WARDENSCHEDULER_H
+#define _WARDENSCHEDULER_H
+
+#include "Common.h"
+#include <ace/Null_Mutex.h>
+#include <ace/Singleton.h>
+#include <ace/Thread_Mutex.h>
+
+#define WARDEN_FIRST_REQUEST_DELAY  10000                   // ms after the module was initialized
+#define WARDEN_RATE_WINDOW          10000                   // ms over which the rates are measured
+
+struct WardenStats
+{
+    uint32 Wardens;
+    uint32 Interval;                                        // ms between two requests of the server
+    uint32 RequestsPerSec;
+    uint32 ChecksPerSec;
+    uint64 Requests;
+};
+
+/**
+ * Spaces the check requests of all the warden sessions evenly.
+ *
+ * Every session asks for its next request once it got the answer to the last one, the scheduler hands out
+ * times at least the hold off of Warden.ClientCheckHoldOff apart for one session and hold off / sessions
+ * apart for the server, so the requests do not come in bursts when many players logged in together.
+ */
+class WardenScheduler
+{
+    friend class ACE_Singleton<WardenScheduler, ACE_Null_Mutex>;
+
+  public:
+    void AddWarden();
+    void RemoveWarden();
+
+    // ms until the session may send its next request, minDelay at least and twice it at most
+    uint32 ScheduleRequest(uint32 minDelay);
+
+    void RecordRequest(uint32 checks);
+
+    WardenStats GetStats();
+
+  private:
+    WardenScheduler();
+    ~WardenScheduler() { }
+
+    void UpdateRates(uint32 now);
+
+    ACE_Thread_Mutex _lock;
+    uint32 _wardens;
+    uint32 _lastSlot;
+    bool _slotSet;
+    uint32 _interval;
+
+    uint64 _requests;
+
+    uint32 _windowStart;
+    uint32 _windowRequests;
+    uint32 _windowChecks;
+    uint32 _requestRate;
+    uint32 _checkRate;
+};
+
+#define sWardenScheduler ACE_Singleton<WardenScheduler, ACE_Null_Mutex>::instance()
+
+#endif
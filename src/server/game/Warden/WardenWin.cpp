@@ -16,7 +16,6 @@
  * with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 
-#include "Cryptography/HMACSHA1.h"
 #include "Cryptography/WardenKeyGeneration.h"
 #include "Common.h"
 #include "WorldPacket.h"
@@ -32,9 +31,10 @@
 #include "WardenWin.h"
 #include "WardenModuleWin.h"
 #include "WardenCheckMgr.h"
+#include "WardenScheduler.h"
 #include "AccountMgr.h"
 
-WardenWin::WardenWin() : Warden()
+WardenWin::WardenWin() : Warden(), _memCheckCursor(urand(0, 0xFFFF)), _otherCheckCursor(urand(0, 0xFFFF))
 {
 }
 
@@ -158,7 +158,7 @@ void WardenWin::HandleHashResult(ByteBuffer &buff)
     // Verify key
     if (memcmp(buff.contents() + 1, Module.ClientKeySeedHash, 20) != 0)
     {
-        sLog->outWarn(LOG_FILTER_WARDEN, "%s failed hash reply. Action: %s", _session->GetPlayerInfo().c_str(), Penalty().c_str());
+        sLog->outWarn(LOG_FILTER_WARDEN, "%s failed hash reply. Action: %s", _session->GetPlayerInfo().c_str(), Penalty(CHECK_WARDEN_KEY).c_str());
         return;
     }
 
@@ -174,19 +174,13 @@ void WardenWin::HandleHashResult(ByteBuffer &buff)
     _initialized = true;
 
     _previousTimestamp = getMSTime();
+    _checkTimer = sWardenScheduler->ScheduleRequest(WARDEN_FIRST_REQUEST_DELAY);
 }
 
 void WardenWin::RequestData()
 {
     sLog->outDebug(LOG_FILTER_WARDEN, "Request data");
 
-    // If all checks were done, fill the todo list again
-    if (_memChecksTodo.empty())
-        _memChecksTodo.assign(sWardenCheckMgr->MemChecksIdPool.begin(), sWardenCheckMgr->MemChecksIdPool.end());
-
-    if (_otherChecksTodo.empty())
-        _otherChecksTodo.assign(sWardenCheckMgr->OtherChecksIdPool.begin(), sWardenCheckMgr->OtherChecksIdPool.end());
-
     _serverTicks = getMSTime();
 
     uint16 id;
@@ -194,35 +188,22 @@ void WardenWin::RequestData()
     WardenCheck* wd;
     _currentChecks.clear();
 
-    // Build check request
-    for (uint32 i = 0; i < sWorld->getIntConfig(CONFIG_WARDEN_NUM_MEM_CHECKS); ++i)
-    {
-        // If todo list is done break loop (will be filled on next Update() run)
-        if (_memChecksTodo.empty())
-            break;
-
-        // Get check id from the end and remove it from todo
-        id = _memChecksTodo.back();
-        _memChecksTodo.pop_back();
-
-        // Add the id to the list sent in this cycle
-        _currentChecks.push_back(id);
-    }
+    // Build check request, every session goes round the pools from its own place
+    std::vector<uint16> const& memChecks = sWardenCheckMgr->MemChecksIdPool;
+    uint32 memCheckCount = std::min<uint32>(sWorld->getIntConfig(CONFIG_WARDEN_NUM_MEM_CHECKS), memChecks.size());
+    for (uint32 i = 0; i < memCheckCount; ++i)
+        _currentChecks.push_back(memChecks[_memCheckCursor++ % memChecks.size()]);
 
     ByteBuffer buff;
     buff << uint8(WARDEN_SMSG_CHEAT_CHECKS_REQUEST);
 
     ACE_READ_GUARD(ACE_RW_Mutex, g, sWardenCheckMgr->_checkStoreLock);
 
-    for (uint32 i = 0; i < sWorld->getIntConfig(CONFIG_WARDEN_NUM_OTHER_CHECKS); ++i)
+    std::vector<uint16> const& otherChecks = sWardenCheckMgr->OtherChecksIdPool;
+    uint32 otherCheckCount = std::min<uint32>(sWorld->getIntConfig(CONFIG_WARDEN_NUM_OTHER_CHECKS), otherChecks.size());
+    for (uint32 i = 0; i < otherCheckCount; ++i)
     {
-        // If todo list is done break loop (will be filled on next Update() run)
-        if (_otherChecksTodo.empty())
-            break;
-
-        // Get check id from the end and remove it from todo
-        id = _otherChecksTodo.back();
-        _otherChecksTodo.pop_back();
+        id = otherChecks[_otherCheckCursor++ % otherChecks.size()];
 
         // Add the id to the list sent in this cycle
         _currentChecks.push_back(id);
@@ -250,7 +231,7 @@ void WardenWin::RequestData()
 
     uint8 index = 1;
 
-    for (std::list<uint16>::iterator itr = _currentChecks.begin(); itr != _currentChecks.end(); ++itr)
+    for (std::vector<uint16>::const_iterator itr = _currentChecks.begin(); itr != _currentChecks.end(); ++itr)
     {
         wd = sWardenCheckMgr->GetWardenDataById(*itr);
 
@@ -268,7 +249,8 @@ void WardenWin::RequestData()
             case PAGE_CHECK_A:
             case PAGE_CHECK_B:
             {
-                buff.append(wd->Data.AsByteArray(0, false), wd->Data.GetNumBytes());
+                if (!wd->Data.empty())
+                    buff.append(&wd->Data[0], wd->Data.size());
                 buff << uint32(wd->Address);
                 buff << uint8(wd->Length);
                 break;
@@ -281,18 +263,16 @@ void WardenWin::RequestData()
             }
             case DRIVER_CHECK:
             {
-                buff.append(wd->Data.AsByteArray(0, false), wd->Data.GetNumBytes());
+                if (!wd->Data.empty())
+                    buff.append(&wd->Data[0], wd->Data.size());
                 buff << uint8(index++);
                 break;
             }
             case MODULE_CHECK:
             {
-                uint32 seed = static_cast<uint32>(rand32());
-                buff << uint32(seed);
-                HmacHash hmac(4, (uint8*)&seed);
-                hmac.UpdateData(wd->Str);
-                hmac.Finalize();
-                buff.append(hmac.GetDigest(), hmac.GetLength());
+                WardenModuleSeed const& seed = wd->Seeds[urand(0, wd->Seeds.size() - 1)];
+                buff << uint32(seed.Seed);
+                buff.append(seed.Digest, sizeof(seed.Digest));
                 break;
             }
             /*case PROC_CHECK:
@@ -320,10 +300,11 @@ void WardenWin::RequestData()
     _session->SendPacket(&pkt);
 
     _dataSent = true;
+    sWardenScheduler->RecordRequest(_currentChecks.size());
 
     std::stringstream stream;
     stream << "Sent check id's: ";
-    for (std::list<uint16>::iterator itr = _currentChecks.begin(); itr != _currentChecks.end(); ++itr)
+    for (std::vector<uint16>::const_iterator itr = _currentChecks.begin(); itr != _currentChecks.end(); ++itr)
         stream << *itr << " ";
 
     sLog->outDebug(LOG_FILTER_WARDEN, "%s", stream.str().c_str());
@@ -344,7 +325,7 @@ void WardenWin::HandleData(ByteBuffer &buff)
     if (!IsValidCheckSum(Checksum, buff.contents() + buff.rpos(), Length))
     {
         buff.rpos(buff.wpos());
-        sLog->outWarn(LOG_FILTER_WARDEN, "%s failed checksum. Action: %s", _session->GetPlayerInfo().c_str(), Penalty().c_str());
+        sLog->outWarn(LOG_FILTER_WARDEN, "%s failed checksum. Action: %s", _session->GetPlayerInfo().c_str(), Penalty(CHECK_WARDEN_CHECKSUM).c_str());
         return;
     }
 
@@ -355,7 +336,7 @@ void WardenWin::HandleData(ByteBuffer &buff)
         // TODO: test it.
         if (result == 0x00)
         {
-            sLog->outWarn(LOG_FILTER_WARDEN, "%s failed timing check. Action: %s", _session->GetPlayerInfo().c_str(), Penalty().c_str());
+            sLog->outWarn(LOG_FILTER_WARDEN, "%s failed timing check. Action: %s", _session->GetPlayerInfo().c_str(), Penalty(CHECK_WARDEN_TIMEOUT).c_str());
             return;
         }
 
@@ -378,7 +359,7 @@ void WardenWin::HandleData(ByteBuffer &buff)
 
     ACE_READ_GUARD(ACE_RW_Mutex, g, sWardenCheckMgr->_checkStoreLock);
 
-    for (std::list<uint16>::iterator itr = _currentChecks.begin(); itr != _currentChecks.end(); ++itr)
+    for (std::vector<uint16>::const_iterator itr = _currentChecks.begin(); itr != _currentChecks.end(); ++itr)
     {
         rd = sWardenCheckMgr->GetWardenDataById(*itr);
         rs = sWardenCheckMgr->GetWardenResultById(*itr);
@@ -398,7 +379,7 @@ void WardenWin::HandleData(ByteBuffer &buff)
                     continue;
                 }
 
-                if (memcmp(buff.contents() + buff.rpos(), rs->Result.AsByteArray(0, false), rd->Length) != 0)
+                if (memcmp(buff.contents() + buff.rpos(), &rs->Result[0], rd->Length) != 0)
                 {
                     sLog->outDebug(LOG_FILTER_WARDEN, "RESULT MEM_CHECK fail CheckId %u account Id %u", *itr, _session->GetAccountId());
                     checkFailed = *itr;
@@ -477,7 +458,7 @@ void WardenWin::HandleData(ByteBuffer &buff)
                     continue;
                 }
 
-                if (memcmp(buff.contents() + buff.rpos(), rs->Result.AsByteArray(0, false), 20) != 0) // SHA1
+                if (memcmp(buff.contents() + buff.rpos(), &rs->Result[0], 20) != 0) // SHA1
                 {
                     sLog->outDebug(LOG_FILTER_WARDEN, "RESULT MPQ_CHECK fail, CheckId %u account Id %u", *itr, _session->GetAccountId());
                     checkFailed = *itr;
@@ -497,10 +478,10 @@ void WardenWin::HandleData(ByteBuffer &buff)
     if (checkFailed > 0)
     {
         WardenCheck* check = sWardenCheckMgr->GetWardenDataById(checkFailed);
-        sLog->outWarn(LOG_FILTER_WARDEN, "%s failed Warden check %u. Action: %s", _session->GetPlayerInfo().c_str(), checkFailed, Penalty(check).c_str());
+        sLog->outWarn(LOG_FILTER_WARDEN, "%s failed Warden check %u. Action: %s", _session->GetPlayerInfo().c_str(), checkFailed, Penalty(CHECK_WARDEN, check).c_str());
     }
 
-    // Set hold off timer, minimum timer should at least be 1 second
+    // Set hold off timer, minimum timer should at least be 1 second, the requests of all sessions are spread over it
     uint32 holdOff = sWorld->getIntConfig(CONFIG_WARDEN_CLIENT_CHECK_HOLDOFF);
-    _checkTimer = (holdOff < 1 ? 1 : holdOff) * IN_MILLISECONDS;
+    _checkTimer = sWardenScheduler->ScheduleRequest((holdOff < 1 ? 1 : holdOff) * IN_MILLISECONDS);
 }
@@ -86,9 +86,9 @@ class WardenWin : public Warden
 
     private:
         uint32 _serverTicks;
-        std::list<uint16> _otherChecksTodo;
-        std::list<uint16> _memChecksTodo;
-        std::list<uint16> _currentChecks;
+        uint32 _memCheckCursor;                             // next check of the pools to send
+        uint32 _otherCheckCursor;
+        std::vector<uint16> _currentChecks;
 };
 
 #endif
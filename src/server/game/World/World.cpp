@@ -35,6 +35,7 @@
 #include "SkillDiscovery.h"
 #include "World.h"
 #include "AccountMgr.h"
+#include "AnticheatSink.h"
 #include "AchievementMgr.h"
 #include "AuctionHouseMgr.h"
 #include "ObjectMgr.h"
@@ -48,6 +49,7 @@
 #include "DBCStores.h"
 #include "DB2Stores.h"
 #include "LootMgr.h"
+#include "MailExpiry.h"
 #include "ItemEnchantmentMgr.h"
 #include "MapManager.h"
 #include "CreatureAIRegistry.h"
@@ -588,11 +590,24 @@ void World::LoadConfigSettings(bool reload)
     m_int_configs[CONFIG_TRADE_LEVEL_REQ] = ConfigMgr::GetIntDefault("LevelReq.Trade", 1);
     m_int_configs[CONFIG_TICKET_LEVEL_REQ] = ConfigMgr::GetIntDefault("LevelReq.Ticket", 1);
     m_int_configs[CONFIG_AUCTION_LEVEL_REQ] = ConfigMgr::GetIntDefault("LevelReq.Auction", 1);
+    m_int_configs[CONFIG_AUCTION_EXPIRY_BATCH_SIZE] = ConfigMgr::GetIntDefault("AuctionHouse.ExpiryBatchSize", 100);
+    if (!m_int_configs[CONFIG_AUCTION_EXPIRY_BATCH_SIZE])
+    {
+        sLog->outError(LOG_FILTER_SERVER_LOADING, "AuctionHouse.ExpiryBatchSize (0) must be > 0, set to default 100.");
+        m_int_configs[CONFIG_AUCTION_EXPIRY_BATCH_SIZE] = 100;
+    }
     m_int_configs[CONFIG_MAIL_LEVEL_REQ] = ConfigMgr::GetIntDefault("LevelReq.Mail", 1);
+    m_int_configs[CONFIG_MAIL_EXPIRY_BATCH_SIZE] = ConfigMgr::GetIntDefault("Mail.ExpiryBatchSize", 100);
+    if (!m_int_configs[CONFIG_MAIL_EXPIRY_BATCH_SIZE])
+    {
+        sLog->outError(LOG_FILTER_SERVER_LOADING, "Mail.ExpiryBatchSize (0) must be > 0, set to default 100.");
+        m_int_configs[CONFIG_MAIL_EXPIRY_BATCH_SIZE] = 100;
+    }
     m_bool_configs[CONFIG_ALLOW_PLAYER_COMMANDS] = ConfigMgr::GetBoolDefault("AllowPlayerCommands", 1);
     m_bool_configs[CONFIG_PRESERVE_CUSTOM_CHANNELS] = ConfigMgr::GetBoolDefault("PreserveCustomChannels", false);
     m_int_configs[CONFIG_PRESERVE_CUSTOM_CHANNEL_DURATION] = ConfigMgr::GetIntDefault("PreserveCustomChannelDuration", 14);
     m_bool_configs[CONFIG_GRID_UNLOAD] = ConfigMgr::GetBoolDefault("GridUnload", true);
+    m_bool_configs[CONFIG_MAP_SPATIAL_INDEX] = ConfigMgr::GetBoolDefault("Map.SpatialIndex", false);
     m_int_configs[CONFIG_INTERVAL_SAVE] = ConfigMgr::GetIntDefault("PlayerSaveInterval", 15 * MINUTE * IN_MILLISECONDS);
     m_int_configs[CONFIG_INTERVAL_DISCONNECT_TOLERANCE] = ConfigMgr::GetIntDefault("DisconnectToleranceInterval", 0);
     m_bool_configs[CONFIG_STATS_SAVE_ONLY_ON_LOGOUT] = ConfigMgr::GetBoolDefault("PlayerSave.Stats.SaveOnlyOnLogout", true);
@@ -1249,6 +1264,7 @@ void World::LoadConfigSettings(bool reload)
     // Guild save interval
     m_bool_configs[CONFIG_GUILD_LEVELING_ENABLED] = ConfigMgr::GetBoolDefault("Guild.LevelingEnabled", true);
     m_int_configs[CONFIG_GUILD_SAVE_INTERVAL] = ConfigMgr::GetIntDefault("Guild.SaveInterval", 15);
+    m_int_configs[CONFIG_GUILD_IDLE_UNLOAD_TIME] = ConfigMgr::GetIntDefault("Guild.IdleUnloadTime", 60);
     m_int_configs[CONFIG_GUILD_MAX_LEVEL] = ConfigMgr::GetIntDefault("Guild.MaxLevel", 25);
     m_int_configs[CONFIG_GUILD_UNDELETABLE_LEVEL] = ConfigMgr::GetIntDefault("Guild.UndeletableLevel", 4);
     rate_values[RATE_XP_GUILD_MODIFIER] = ConfigMgr::GetFloatDefault("Guild.XPModifier", 0.25f);
@@ -1285,11 +1301,20 @@ void World::LoadConfigSettings(bool reload)
     m_int_configs[CONFIG_ANTICHEAT_ACTION_DELAY] = ConfigMgr::GetIntDefault("Anticheat.DelayAfterAction", 30);
     m_int_configs[CONFIG_ANTICHEAT_GMLEVEL] = ConfigMgr::GetIntDefault("Anticheat.GmLevel", SEC_VIP);
     m_int_configs[CONFIG_ANTICHEAT_DELETE_LOGS] = ConfigMgr::GetIntDefault("Anticheat.DeleteOldLogsInDays", 7);
+    m_int_configs[CONFIG_ANTICHEAT_VIOLATION_REPEAT_WINDOW] = ConfigMgr::GetIntDefault("Anticheat.ViolationRepeatWindow", 60);
+    m_int_configs[CONFIG_ANTICHEAT_VIOLATIONS_PER_ACCOUNT] = ConfigMgr::GetIntDefault("Anticheat.ViolationsPerAccount", 10);
 
     // Guild Reputation Bonus
     m_int_configs[CONFIG_GUILD_REP_NORMAL_DUNGEON_BONUS] = ConfigMgr::GetIntDefault("AdditionalGuildReputationNormal", 50);
     m_int_configs[CONFIG_GUILD_REP_HEROIC_DUNGEON_BONUS] = ConfigMgr::GetIntDefault("AdditionalGuildReputationHeroic", 80);
 
+    m_int_configs[CONFIG_LOGIN_QUERY_PARALLELISM] = ConfigMgr::GetIntDefault("PlayerLogin.QueryParallelism", 1);
+    if (m_int_configs[CONFIG_LOGIN_QUERY_PARALLELISM] < 1 || m_int_configs[CONFIG_LOGIN_QUERY_PARALLELISM] > 32)
+    {
+        sLog->outError(LOG_FILTER_SERVER_LOADING, "PlayerLogin.QueryParallelism (%u) must be in range 1..32. Set to 1.", m_int_configs[CONFIG_LOGIN_QUERY_PARALLELISM]);
+        m_int_configs[CONFIG_LOGIN_QUERY_PARALLELISM] = 1;
+    }
+
     // call ScriptMgr if we're reloading the configuration
     if (reload)
         sScriptMgr->OnConfigLoad(reload);
@@ -1740,7 +1765,7 @@ void World::SetInitialWorldSettings()
 
     ///- Handle outdated emails (delete/return)
     sLog->outInfo(LOG_FILTER_SERVER_LOADING, "Returning old mails...");
-    sObjectMgr->ReturnOrDeleteOldMails(false);
+    sMailExpiry->ExpireAll();
 
     sLog->outInfo(LOG_FILTER_SERVER_LOADING, "Loading Autobroadcasts...");
     LoadAutobroadcasts();
@@ -1784,7 +1809,7 @@ void World::SetInitialWorldSettings()
                             realmID, uint32(m_startTime), _FULLVERSION);       // One-time query
 
     m_timers[WUPDATE_WEATHERS].SetInterval(1*IN_MILLISECONDS);
-    m_timers[WUPDATE_AUCTIONS].SetInterval(MINUTE*IN_MILLISECONDS);
+    m_timers[WUPDATE_AUCTIONS].SetInterval(1*IN_MILLISECONDS);  // ended auctions are settled in slices every second
     m_timers[WUPDATE_UPTIME].SetInterval(m_int_configs[CONFIG_UPTIME_UPDATE]*MINUTE*IN_MILLISECONDS);
                                                             //Update "uptime" table based on configuration entry in minutes.
     m_timers[WUPDATE_CORPSES].SetInterval(20 * MINUTE * IN_MILLISECONDS);
@@ -1803,9 +1828,10 @@ void World::SetInitialWorldSettings()
     //one second is 1000 -(tested on win system)
     //TODO: Get rid of magic numbers
     mail_timer = ((((localtime(&m_gameTime)->tm_hour + 20) % 24)* HOUR * IN_MILLISECONDS) / m_timers[WUPDATE_AUCTIONS].GetInterval());
-                                                            //1440
+                                                            //86400
     mail_timer_expires = ((DAY * IN_MILLISECONDS) / (m_timers[WUPDATE_AUCTIONS].GetInterval()));
-    sLog->outInfo(LOG_FILTER_SERVER_LOADING, "Mail timer set to: " UI64FMTD ", mail return is called every " UI64FMTD " minutes", uint64(mail_timer), uint64(mail_timer_expires));
+    sLog->outInfo(LOG_FILTER_SERVER_LOADING, "Mail timer set to: " UI64FMTD ", mail return is called every " UI64FMTD " minutes", uint64(mail_timer),
+        uint64(mail_timer_expires * m_timers[WUPDATE_AUCTIONS].GetInterval() / (MINUTE * IN_MILLISECONDS)));
 
     ///- Initilize static helper structures
     AIRegistry::Initialize();
@@ -2066,7 +2092,7 @@ void World::Update(uint32 diff)
         if (++mail_timer > mail_timer_expires)
         {
             mail_timer = 0;
-            sObjectMgr->ReturnOrDeleteOldMails(true);
+            sMailExpiry->StartSweep();
         }
 
         ///- Handle expired auctions
@@ -2100,7 +2126,7 @@ void World::Update(uint32 diff)
         stmt->setUInt32(2, realmID);
         stmt->setUInt32(3, uint32(m_startTime));
 
-        LoginDatabase.Execute(stmt);
+        LoginDatabase.Execute(stmt, SQL_PRIORITY_LOW);
     }
 
     /// <li> Clean logs table
@@ -2125,6 +2151,14 @@ void World::Update(uint32 diff)
     sMapMgr->Update(diff);
     RecordTimeDiff("UpdateMapMgr");
 
+    ///- Act on the anticheat and warden violations the sessions and maps found
+    sAntiCheatSink->Update();
+    RecordTimeDiff("UpdateAntiCheatSink");
+
+    ///- Return or delete the next expired mails of a running sweep
+    sMailExpiry->Update();
+    RecordTimeDiff("UpdateMailExpiry");
+
     if (sWorld->getBoolConfig(CONFIG_AUTOBROADCAST))
     {
         if (m_timers[WUPDATE_AUTOBROADCAST].Passed())
@@ -2187,6 +2221,7 @@ void World::Update(uint32 diff)
     {
         m_timers[WUPDATE_GUILDSAVE].Reset();
         sGuildMgr->SaveGuilds();
+        sGuildMgr->UnloadIdleGuildData();
     }
 
     // update the instance reset times
@@ -179,6 +179,7 @@ enum WorldBoolConfigs
     CONFIG_UI_QUESTMETHOD_IN_DIALOGS,
     CONFIG_EVENT_ANNOUNCE,
     CONFIG_ANTICHEAT_ENABLED,
+    CONFIG_MAP_SPATIAL_INDEX,
     BOOL_CONFIG_VALUE_COUNT
 };
 
@@ -283,7 +284,9 @@ enum WorldIntConfigs
     CONFIG_TRADE_LEVEL_REQ,
     CONFIG_TICKET_LEVEL_REQ,
     CONFIG_AUCTION_LEVEL_REQ,
+    CONFIG_AUCTION_EXPIRY_BATCH_SIZE,
     CONFIG_MAIL_LEVEL_REQ,
+    CONFIG_MAIL_EXPIRY_BATCH_SIZE,
     CONFIG_CORPSE_DECAY_NORMAL,
     CONFIG_CORPSE_DECAY_RARE,
     CONFIG_CORPSE_DECAY_ELITE,
@@ -352,6 +355,7 @@ enum WorldIntConfigs
     CONFIG_TOLBARAD_NOBATTLETIME,
     CONFIG_TOLBARAD_RESTART_AFTER_CRASH,
     CONFIG_GUILD_SAVE_INTERVAL,
+    CONFIG_GUILD_IDLE_UNLOAD_TIME,
     CONFIG_GUILD_MAX_LEVEL,
     CONFIG_GUILD_UNDELETABLE_LEVEL,
     CONFIG_GUILD_DAILY_XP_CAP,
@@ -359,8 +363,11 @@ enum WorldIntConfigs
     CONFIG_ANTICHEAT_ACTION_DELAY,
     CONFIG_ANTICHEAT_GMLEVEL,
     CONFIG_ANTICHEAT_DELETE_LOGS,
+    CONFIG_ANTICHEAT_VIOLATION_REPEAT_WINDOW,
+    CONFIG_ANTICHEAT_VIOLATIONS_PER_ACCOUNT,
     CONFIG_GUILD_REP_NORMAL_DUNGEON_BONUS,
     CONFIG_GUILD_REP_HEROIC_DUNGEON_BONUS,
+    CONFIG_LOGIN_QUERY_PARALLELISM,
     INT_CONFIG_VALUE_COUNT
 };
 
@@ -0,0 +1,1185 @@
+/*
+ * Copyright (C) 2008-2013 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/* ScriptData
+Name: bench_commandscript
+%Complete: 100
+Comment: Benchmarks of the core, only built with WITH_BENCHMARKS
+Category: commandscripts
+EndScriptData */
+
+#include "ScriptMgr.h"
+#include "ObjectMgr.h"
+#include "AccountMgr.h"
+#include "AuctionHouseMgr.h"
+#include "Chat.h"
+#include "Cell.h"
+#include "CellImpl.h"
+#include "Channel.h"
+#include "GridNotifiers.h"
+#include "GridNotifiersImpl.h"
+#include "GuildMgr.h"
+#include "Language.h"
+#include "PlayerDirectory.h"
+#include "SFMT.h"
+#include "SocialMgr.h"
+#include "Spell.h"
+#include "SpellAuras.h"
+#include "SpellAuraEffects.h"
+#include "World.h"
+#include "WorldSession.h"
+
+#include <fstream>
+#include <ace/Task.h>
+
+// Upper bounds of the arguments, every benchmark blocks the world thread until it is done
+#define BENCH_MAX_LOGINS                10000
+#define BENCH_MAX_SPELL_ITERATIONS      1000
+#define BENCH_MAX_OBSERVERS             1000
+#define BENCH_MAX_VALUES_ITERATIONS     10000
+#define BENCH_MAX_THREADS               64
+#define BENCH_MAX_ACCESSOR_ITERATIONS   100000
+#define BENCH_MAX_ATTACKERS             1000
+#define BENCH_MAX_THREAT_ITERATIONS     1000
+#define BENCH_MAX_SPATIAL_ITERATIONS    100000
+#define BENCH_MAX_SOAK_HOURS            168
+#define BENCH_MAX_CASTS                 1000000
+#define BENCH_MAX_AUCTIONS              1000000
+#define BENCH_MAX_SEARCHES              100000
+#define BENCH_MAX_WHO_QUERIES           100000
+#define BENCH_MAX_MEMBERS               100000
+#define BENCH_MAX_MESSAGES              100000
+
+// Worker of .bench accessor: every thread looks up the same list of guids, either through the
+// striped player registry or through a single map behind one lock, the way the registry used to be
+class AccessorBenchRunnable : public ACE_Task_Base
+{
+    public:
+        typedef UNORDERED_MAP<uint64, Player*> SingleLockMap;
+
+        AccessorBenchRunnable(std::vector<uint64> const& guids, uint32 iterations, SingleLockMap* singleLockMap, ACE_RW_Thread_Mutex* singleLock) :
+            _guids(guids), _iterations(iterations), _singleLockMap(singleLockMap), _singleLock(singleLock), _found(0) { }
+
+        int svc()
+        {
+            uint32 found = 0;
+            for (uint32 i = 0; i < _iterations; ++i)
+            {
+                for (std::vector<uint64>::const_iterator itr = _guids.begin(); itr != _guids.end(); ++itr)
+                {
+                    if (!_singleLockMap)
+                    {
+                        if (HashMapHolder<Player>::Find(*itr))
+                            ++found;
+                        continue;
+                    }
+
+                    TRINITY_READ_GUARD(ACE_RW_Thread_Mutex, *_singleLock);
+                    if (_singleLockMap->find(*itr) != _singleLockMap->end())
+                        ++found;
+                }
+            }
+
+            _found += found;
+            return 0;
+        }
+
+        uint32 GetFound() const { return _found.value(); }
+
+    private:
+        std::vector<uint64> const& _guids;
+        uint32 _iterations;
+        SingleLockMap* _singleLockMap;
+        ACE_RW_Thread_Mutex* _singleLock;
+        ACE_Atomic_Op<ACE_Thread_Mutex, uint32> _found;
+};
+
+#define EVENT_BENCH_TARGETS             25
+#define EVENT_BENCH_CASTS_PER_UPDATE    20
+#define EVENT_BENCH_UPDATE_DIFF         50
+
+#define POOL_SOAK_SEED                  24      // .bench poolsoak replays the same churn in both of its modes
+
+// Spell hit of .bench event, only counts its executions
+class EventBenchHit : public BasicEvent
+{
+    public:
+        explicit EventBenchHit(uint32& executed) : _executed(executed) { }
+
+        bool Execute(uint64 /*e_time*/, uint32 /*p_time*/)
+        {
+            ++_executed;
+            return true;
+        }
+
+    private:
+        uint32& _executed;
+};
+
+// Matches of a /who query the way the who handler used to find them, walking the player registry and
+// converting the names of every player, used by .bench who
+static uint32 CountWhoMatchesByScan(WhoQuery const& query, Player* viewer)
+{
+    uint32 team = viewer->GetTeam();
+    bool playerViewer = AccountMgr::IsPlayerAccount(viewer->GetSession()->GetSecurity());
+    bool allowTwoSideWhoList = sWorld->getBoolConfig(CONFIG_ALLOW_TWO_SIDE_WHO_LIST);
+    uint32 gmLevelInWhoList = sWorld->getIntConfig(CONFIG_GM_LEVEL_IN_WHO_LIST);
+    uint32 matches = 0;
+
+    for (uint32 stripe = 0; stripe < HashMapHolder<Player>::STRIPE_COUNT; ++stripe)
+    {
+        TRINITY_READ_GUARD(HashMapHolder<Player>::LockType, *HashMapHolder<Player>::GetLock(stripe));
+        HashMapHolder<Player>::MapType const& m = sObjectAccessor->GetPlayers(stripe);
+        for (HashMapHolder<Player>::MapType::const_iterator itr = m.begin(); itr != m.end(); ++itr)
+        {
+            Player* player = itr->second;
+            if (playerViewer && ((player->GetTeam() != team && !allowTwoSideWhoList) ||
+                player->GetSession()->GetSecurity() > AccountTypes(gmLevelInWhoList)))
+                continue;
+
+            if (!player->IsInWorld() || !player->IsVisibleGloballyFor(viewer))
+                continue;
+
+            if (player->getLevel() < query.LevelMin || player->getLevel() > query.LevelMax ||
+                !(query.ClassMask & (1 << player->getClass())) || !(query.RaceMask & (1 << player->getRace())))
+                continue;
+
+            if (query.ZoneCount && std::find(query.Zones, query.Zones + query.ZoneCount, player->GetZoneId()) == query.Zones + query.ZoneCount)
+                continue;
+
+            std::wstring wpname;
+            if (!Utf8toWStr(player->GetName(), wpname))
+                continue;
+            wstrToLower(wpname);
+
+            if (!query.PlayerName.empty() && wpname.find(query.PlayerName) == std::wstring::npos)
+                continue;
+
+            std::wstring wgname;
+            if (!Utf8toWStr(sGuildMgr->GetGuildNameById(player->GetGuildId()), wgname))
+                continue;
+            wstrToLower(wgname);
+
+            if (!query.GuildName.empty() && wgname.find(query.GuildName) == std::wstring::npos)
+                continue;
+
+            std::string aname;
+            if (AreaTableEntry const* areaEntry = GetAreaEntryByAreaID(player->GetZoneId()))
+                if (areaEntry->area_name)
+                    aname = areaEntry->area_name;
+
+            bool show = true;
+            for (uint32 i = 0; i < query.StringCount; ++i)
+            {
+                if (query.Strings[i].empty())
+                    continue;
+
+                show = wgname.find(query.Strings[i]) != std::wstring::npos || wpname.find(query.Strings[i]) != std::wstring::npos ||
+                    Utf8FitTo(aname, query.Strings[i]);
+                if (show)
+                    break;
+            }
+
+            if (show)
+                ++matches;
+        }
+    }
+
+    return matches;
+}
+
+class bench_commandscript : public CommandScript
+{
+public:
+    bench_commandscript() : CommandScript("bench_commandscript") { }
+
+    ChatCommand* GetCommands() const
+    {
+        static ChatCommand benchCommandTable[] =
+        {
+            { "login",          SEC_CONSOLE,        true,  &HandleBenchLoginCommand,           "", NULL },
+            { "spell",          SEC_ADMINISTRATOR,  false, &HandleBenchSpellCommand,           "", NULL },
+            { "values",         SEC_ADMINISTRATOR,  false, &HandleBenchValuesCommand,          "", NULL },
+            { "accessor",       SEC_CONSOLE,        true,  &HandleBenchAccessorCommand,        "", NULL },
+            { "threat",         SEC_ADMINISTRATOR,  false, &HandleBenchThreatCommand,          "", NULL },
+            { "spatial",        SEC_ADMINISTRATOR,  false, &HandleBenchSpatialCommand,         "", NULL },
+            { "poolsoak",       SEC_CONSOLE,        true,  &HandleBenchPoolSoakCommand,        "", NULL },
+            { "event",          SEC_ADMINISTRATOR,  true,  &HandleBenchEventCommand,           "", NULL },
+            { "auction",        SEC_CONSOLE,        true,  &HandleBenchAuctionCommand,         "", NULL },
+            { "who",            SEC_ADMINISTRATOR,  false, &HandleBenchWhoCommand,             "", NULL },
+            { "channel",        SEC_ADMINISTRATOR,  false, &HandleBenchChannelCommand,         "", NULL },
+            { NULL,             SEC_PLAYER,         false, NULL,                               "", NULL }
+        };
+        static ChatCommand commandTable[] =
+        {
+            { "bench",          SEC_ADMINISTRATOR,  true,  NULL,                  "", benchCommandTable },
+            { NULL,             SEC_PLAYER,         false, NULL,                  "",              NULL }
+        };
+        return commandTable;
+    }
+
+    // Reads a count argument, a missing one takes the default. Counts out of 1..maxValue are refused.
+    static bool ExtractBenchCount(ChatHandler* handler, char const* str, char const* name, uint32 defaultValue, uint32 maxValue, uint32& value)
+    {
+        value = str && *str ? uint32(atoi(str)) : defaultValue;
+        if (value && value <= maxValue)
+            return true;
+
+        handler->PSendSysMessage("%s must be in range 1..%u.", name, maxValue);
+        handler->SetSentErrorMessage(true);
+        return false;
+    }
+
+    // USAGE: .bench login #count [#parallelism] [name]
+    // Loads a character #count times through the login query holder and reports the achieved logins per second.
+    // Uses the configured character database and blocks the world thread until every holder finished.
+    static bool HandleBenchLoginCommand(ChatHandler* handler, char const* args)
+    {
+        if (!*args)
+            return false;
+
+        char* countStr = strtok((char*)args, " ");
+        char* parallelismStr = strtok(NULL, " ");
+        char* nameStr = strtok(NULL, " ");
+
+        uint32 count;
+        if (!ExtractBenchCount(handler, countStr, "Count", 0, BENCH_MAX_LOGINS, count))
+            return false;
+
+        int32 parallelism = parallelismStr ? atoi(parallelismStr) : int32(sWorld->getIntConfig(CONFIG_LOGIN_QUERY_PARALLELISM));
+        if (parallelism < 1 || parallelism > 32)
+        {
+            handler->SendSysMessage("Parallelism must be in range 1..32.");
+            handler->SetSentErrorMessage(true);
+            return false;
+        }
+
+        uint64 targetGuid;
+        if (!handler->extractPlayerTarget(nameStr, NULL, &targetGuid))
+            return false;
+
+        uint32 accountId = sObjectMgr->GetPlayerAccountIdByGUID(targetGuid);
+
+        std::vector<QueryResultHolderFuture> futures;
+        futures.reserve(count);
+
+        uint32 startTime = getMSTime();
+        for (uint32 i = 0; i < count; ++i)
+        {
+            LoginQueryHolder* holder = new LoginQueryHolder(accountId, targetGuid);
+            if (!holder->Initialize())
+            {
+                delete holder;
+                break;
+            }
+
+            // Every login of a real storm comes from another account, spread them the same way over the connections
+            futures.push_back(CharacterDatabase.DelayQueryHolder(holder, accountId + i, uint8(parallelism)));
+        }
+
+        for (size_t i = 0; i < futures.size(); ++i)
+        {
+            SQLQueryHolder* holder;
+            futures[i].get(holder);
+
+            // Results are owned by the caller once fetched, let the reference counting free them
+            for (size_t j = 0; j < holder->GetSize(); ++j)
+                holder->GetPreparedResult(j);
+
+            delete holder;
+        }
+
+        uint32 elapsed = GetMSTimeDiffToNow(startTime);
+        handler->PSendSysMessage("Loaded %u characters in %u ms with parallelism %i: %.1f logins/s",
+            uint32(futures.size()), elapsed, parallelism, elapsed ? futures.size() * 1000.0f / elapsed : 0.0f);
+        return true;
+    }
+
+    // USAGE: .bench spell [#iterations]
+    // Replays the spell book of the player against the selected unit: SpellInfo lookups with the
+    // checks done on every cast (IsPositive, ranges, cast time) and then a full Spell::CheckCast
+    static bool HandleBenchSpellCommand(ChatHandler* handler, char const* args)
+    {
+        uint32 iterations;
+        if (!ExtractBenchCount(handler, args, "Iterations", 100, BENCH_MAX_SPELL_ITERATIONS, iterations))
+            return false;
+
+        Player* player = handler->GetSession()->GetPlayer();
+        Unit* target = handler->getSelectedUnit();
+        if (!target)
+            target = player;
+
+        std::vector<uint32> spells;
+        PlayerSpellMap const& spellMap = player->GetSpellMap();
+        for (PlayerSpellMap::const_iterator itr = spellMap.begin(); itr != spellMap.end(); ++itr)
+            if (itr->second->state != PLAYERSPELL_REMOVED && itr->second->active && !itr->second->disabled)
+                if (SpellInfo const* spellInfo = sSpellMgr->GetSpellInfo(itr->first))
+                    if (!spellInfo->IsPassive())
+                        spells.push_back(itr->first);
+
+        if (spells.empty())
+        {
+            handler->SendSysMessage("No castable spells in the spell book.");
+            handler->SetSentErrorMessage(true);
+            return false;
+        }
+
+        // Keeps the compiler from dropping the lookups
+        uint32 checksum = 0;
+
+        uint32 startTime = getMSTime();
+        for (uint32 i = 0; i < iterations; ++i)
+        {
+            for (std::vector<uint32>::const_iterator itr = spells.begin(); itr != spells.end(); ++itr)
+            {
+                SpellInfo const* spellInfo = sSpellMgr->GetSpellInfo(*itr);
+                bool positive = spellInfo->IsPositive();
+                checksum += uint32(spellInfo->GetMaxRange(positive, player)) + uint32(spellInfo->GetMinRange(positive));
+                checksum += spellInfo->CalcCastTime(player->getLevel()) + spellInfo->GetSchoolMask() + spellInfo->PowerType;
+            }
+        }
+        uint32 lookupTime = GetMSTimeDiffToNow(startTime);
+
+        SpellCastTargets targets;
+        targets.SetUnitTarget(target);
+
+        startTime = getMSTime();
+        for (uint32 i = 0; i < iterations; ++i)
+        {
+            for (std::vector<uint32>::const_iterator itr = spells.begin(); itr != spells.end(); ++itr)
+            {
+                Spell* spell = new Spell(player, sSpellMgr->GetSpellInfo(*itr), TRIGGERED_NONE);
+                spell->InitExplicitTargets(targets);
+                checksum += spell->CheckCast(true);
+                delete spell;
+            }
+        }
+        uint32 checkCastTime = GetMSTimeDiffToNow(startTime);
+
+        uint32 total = iterations * spells.size();
+        handler->PSendSysMessage("%u spells x %u iterations (checksum %u)", uint32(spells.size()), iterations, checksum);
+        handler->PSendSysMessage("SpellInfo lookups: %u ms, %.2f us per spell", lookupTime, lookupTime * 1000.0f / total);
+        handler->PSendSysMessage("Spell::CheckCast: %u ms, %.2f us per cast", checkCastTime, checkCastTime * 1000.0f / total);
+        return true;
+    }
+
+    // USAGE: .bench values [#observers] [#iterations]
+    // Builds the values update of the selected unit for #observers players, once serialized per
+    // observer and once through the per visibility class cache. The observers are all played by
+    // the command user, i.e. one visibility class, like the spectators of a raid boss.
+    static bool HandleBenchValuesCommand(ChatHandler* handler, char const* args)
+    {
+        char* observersStr = strtok((char*)args, " ");
+        char* iterationsStr = strtok(NULL, " ");
+
+        uint32 observers, iterations;
+        if (!ExtractBenchCount(handler, observersStr, "Observers", 125, BENCH_MAX_OBSERVERS, observers) ||
+            !ExtractBenchCount(handler, iterationsStr, "Iterations", 100, BENCH_MAX_VALUES_ITERATIONS, iterations))
+            return false;
+
+        Unit* unit = handler->getSelectedUnit();
+        if (!unit)
+        {
+            handler->SendSysMessage(LANG_SELECT_CHAR_OR_CREATURE);
+            handler->SetSentErrorMessage(true);
+            return false;
+        }
+
+        Player* observer = handler->GetSession()->GetPlayer();
+
+        // The health field stays marked as changed until the next update of the map sends it
+        unit->ForceValuesUpdateAtIndex(UNIT_FIELD_HEALTH);
+
+        uint32 startTime = getMSTime();
+        for (uint32 i = 0; i < iterations; ++i)
+        {
+            for (uint32 j = 0; j < observers; ++j)
+            {
+                UpdateData data(unit->GetMapId());
+                unit->BuildValuesUpdateBlockForPlayer(&data, observer);
+            }
+        }
+        uint32 perObserverTime = GetMSTimeDiffToNow(startTime);
+
+        ValuesUpdateCache cache;
+        startTime = getMSTime();
+        for (uint32 i = 0; i < iterations; ++i)
+        {
+            cache = ValuesUpdateCache();
+            for (uint32 j = 0; j < observers; ++j)
+            {
+                UpdateData data(unit->GetMapId());
+                unit->BuildValuesUpdateBlockForPlayer(&data, observer, cache);
+            }
+        }
+        uint32 cachedTime = GetMSTimeDiffToNow(startTime);
+
+        handler->PSendSysMessage("%u observers x %u updates of %s", observers, iterations, unit->GetName().c_str());
+        handler->PSendSysMessage("Serialized per observer: %u ms", perObserverTime);
+        handler->PSendSysMessage("Serialized per visibility class: %u ms (%u blocks built, %u reused in the last update)",
+            cachedTime, cache.Serialized, cache.Reused);
+        return true;
+    }
+
+    // USAGE: .bench accessor [#threads] [#iterations]
+    // Looks up every online player and as many unknown guids from several threads at once, first in the
+    // striped ObjectAccessor registry and then in a copy of it kept behind a single lock
+    static bool HandleBenchAccessorCommand(ChatHandler* handler, char const* args)
+    {
+        char* threadsStr = strtok((char*)args, " ");
+        char* iterationsStr = strtok(NULL, " ");
+
+        uint32 threads, iterations;
+        if (!ExtractBenchCount(handler, threadsStr, "Threads", 8, BENCH_MAX_THREADS, threads) ||
+            !ExtractBenchCount(handler, iterationsStr, "Iterations", 10000, BENCH_MAX_ACCESSOR_ITERATIONS, iterations))
+            return false;
+
+        std::vector<uint64> guids;
+        AccessorBenchRunnable::SingleLockMap singleLockMap;
+        for (uint32 stripe = 0; stripe < HashMapHolder<Player>::STRIPE_COUNT; ++stripe)
+        {
+            TRINITY_READ_GUARD(HashMapHolder<Player>::LockType, *HashMapHolder<Player>::GetLock(stripe));
+            HashMapHolder<Player>::MapType const& m = sObjectAccessor->GetPlayers(stripe);
+            for (HashMapHolder<Player>::MapType::const_iterator itr = m.begin(); itr != m.end(); ++itr)
+            {
+                guids.push_back(itr->first);
+                singleLockMap[itr->first] = itr->second;
+            }
+        }
+
+        // as many lookups of guids nobody uses, at least a few hundred when the server is empty
+        uint32 misses = std::max<uint32>(guids.size(), 256);
+        for (uint32 i = 0; i < misses; ++i)
+            guids.push_back(MAKE_NEW_GUID(0xFFFFFFFF - i, 0, HIGHGUID_PLAYER));
+
+        ACE_RW_Thread_Mutex singleLock;
+        uint32 elapsed[2];
+        uint32 found[2];
+        for (uint32 pass = 0; pass < 2; ++pass)
+        {
+            AccessorBenchRunnable runnable(guids, iterations, pass ? &singleLockMap : NULL, &singleLock);
+            uint32 startTime = getMSTime();
+            if (runnable.activate(THR_NEW_LWP | THR_JOINABLE, int(threads)) == -1)
+            {
+                handler->PSendSysMessage("Could not start %u threads", threads);
+                handler->SetSentErrorMessage(true);
+                return false;
+            }
+            runnable.wait();
+            elapsed[pass] = GetMSTimeDiffToNow(startTime);
+            found[pass] = runnable.GetFound();
+        }
+
+        uint64 lookups = uint64(guids.size()) * iterations * threads;
+        handler->PSendSysMessage("%u threads x %u lookups (%u online players)", threads, uint32(lookups / threads), uint32(singleLockMap.size()));
+        handler->PSendSysMessage("Striped registry (%u stripes): %u ms, %u found", uint32(HashMapHolder<Player>::STRIPE_COUNT), elapsed[0], found[0]);
+        handler->PSendSysMessage("Single lock: %u ms, %u found", elapsed[1], found[1]);
+        return true;
+    }
+
+    // Threat of one attacker in the list side of .bench threat
+    struct ThreatBenchEntry
+    {
+        ThreatBenchEntry(Unit* target, float threat) : Guid(target->GetGUID()), Target(target), Threat(threat) { }
+
+        // list::sort is stable, equal threats keep their order like the insertion order of the heap
+        static bool IsHigherThreat(ThreatBenchEntry const& a, ThreatBenchEntry const& b) { return a.Threat > b.Threat; }
+
+        uint64 Guid;
+        Unit* Target;
+        float Threat;
+    };
+
+    static ThreatBenchEntry& FindThreatBenchEntry(std::list<ThreatBenchEntry>& list, uint64 guid)
+    {
+        std::list<ThreatBenchEntry>::iterator itr = list.begin();
+        while (itr->Guid != guid)
+            ++itr;
+        return *itr;
+    }
+
+    // USAGE: .bench threat [#attackers] [#iterations]
+    // Fills the threat list of the selected creature (out of combat) with summoned attackers, then every iteration
+    // adds threat from all of them, changes the threat of some by a percentage and selects a victim. The same
+    // threat updates are replayed on a list sorted by threat and searched linearly, as the threat list used
+    // to be, both should end with the same top threat.
+    static bool HandleBenchThreatCommand(ChatHandler* handler, char const* args)
+    {
+        char* attackersStr = strtok((char*)args, " ");
+        char* iterationsStr = strtok(NULL, " ");
+
+        uint32 attackers, iterations;
+        if (!ExtractBenchCount(handler, attackersStr, "Attackers", 200, BENCH_MAX_ATTACKERS, attackers) ||
+            !ExtractBenchCount(handler, iterationsStr, "Iterations", 100, BENCH_MAX_THREAT_ITERATIONS, iterations))
+            return false;
+
+        Creature* creature = handler->getSelectedCreature();
+        if (!creature || creature->isInCombat() || !creature->CanHaveThreatList())
+        {
+            handler->SendSysMessage(LANG_SELECT_CREATURE);
+            handler->SetSentErrorMessage(true);
+            return false;
+        }
+
+        std::vector<TempSummon*> summons;
+        for (uint32 i = 0; i < attackers; ++i)
+            if (TempSummon* summon = creature->SummonCreature(VISUAL_WAYPOINT, *creature, TEMPSUMMON_MANUAL_DESPAWN))
+                summons.push_back(summon);
+
+        if (summons.empty())
+        {
+            handler->SendSysMessage("Could not summon attackers");
+            handler->SetSentErrorMessage(true);
+            return false;
+        }
+
+        ThreatManager& threatManager = creature->getThreatManager();
+        for (std::vector<TempSummon*>::const_iterator itr = summons.begin(); itr != summons.end(); ++itr)
+            threatManager.doAddThreat(*itr, 1.0f);
+
+        uint32 startTime = getMSTime();
+        uint32 selected = 0;
+        for (uint32 i = 0; i < iterations; ++i)
+        {
+            for (uint32 j = 0; j < summons.size(); ++j)
+                threatManager.doAddThreat(summons[j], float((i * 7 + j * 13) % 100));
+
+            for (uint32 j = i % 10; j < summons.size(); j += 10)
+                threatManager.modifyThreatPercent(summons[j], -50);
+
+            if (threatManager.getOnlineContainer().selectNextVictim(creature, NULL))
+                ++selected;
+        }
+        uint32 heapTime = GetMSTimeDiffToNow(startTime);
+
+        HostileReference* mostHated = threatManager.getOnlineContainer().getMostHated();
+        float heapTopThreat = mostHated ? mostHated->getThreat() : 0.0f;
+
+        // the same threat updates replayed on a list: linear search by guid for every change, sort before every selection
+        std::list<ThreatBenchEntry> list;
+        for (std::vector<TempSummon*>::const_iterator itr = summons.begin(); itr != summons.end(); ++itr)
+            list.push_back(ThreatBenchEntry(*itr, 1.0f));
+
+        startTime = getMSTime();
+        uint32 listSelected = 0;
+        for (uint32 i = 0; i < iterations; ++i)
+        {
+            for (uint32 j = 0; j < summons.size(); ++j)
+                FindThreatBenchEntry(list, summons[j]->GetGUID()).Threat += float((i * 7 + j * 13) % 100);
+
+            for (uint32 j = i % 10; j < summons.size(); j += 10)
+            {
+                // as HostileReference::addThreatPercent, which adds the difference
+                float& threat = FindThreatBenchEntry(list, summons[j]->GetGUID()).Threat;
+                float newThreat = threat;
+                AddPct(newThreat, -50);
+                threat += newThreat - threat;
+            }
+
+            list.sort(ThreatBenchEntry::IsHigherThreat);
+            for (std::list<ThreatBenchEntry>::const_iterator itr = list.begin(); itr != list.end(); ++itr)
+            {
+                if (creature->canCreatureAttack(itr->Target))
+                {
+                    ++listSelected;
+                    break;
+                }
+            }
+        }
+        uint32 listTime = GetMSTimeDiffToNow(startTime);
+
+        creature->DeleteThreatList();
+        for (std::vector<TempSummon*>::const_iterator itr = summons.begin(); itr != summons.end(); ++itr)
+            (*itr)->UnSummon();
+
+        handler->PSendSysMessage("%u attackers x %u iterations on %s", uint32(summons.size()), iterations, creature->GetName().c_str());
+        handler->PSendSysMessage("Threat heap: %u ms (%u victims selected, top threat %.1f)", heapTime, selected, heapTopThreat);
+        handler->PSendSysMessage("Sorted list: %u ms (%u victims selected, top threat %.1f)", listTime, listSelected, list.front().Threat);
+        return true;
+    }
+
+    // USAGE: .bench spatial [#iterations]
+    // Runs unit searches of the usual radii around the player through the grid cells and through the
+    // spatial index of the map (Map.SpatialIndex), filtering the packed positions with and without SSE2.
+    // All must find the same units.
+    static bool HandleBenchSpatialCommand(ChatHandler* handler, char const* args)
+    {
+        char* iterationsStr = strtok((char*)args, " ");
+        uint32 iterations;
+        if (!ExtractBenchCount(handler, iterationsStr, "Iterations", 1000, BENCH_MAX_SPATIAL_ITERATIONS, iterations))
+            return false;
+
+        Player* player = handler->GetSession()->GetPlayer();
+        Map* map = player->GetMap();
+        SpatialHashIndex* index = map->GetSpatialIndex();
+        if (!index)
+        {
+            handler->PSendSysMessage("Map %u has no spatial index, enable Map.SpatialIndex", map->GetId());
+            return true;
+        }
+
+        handler->PSendSysMessage("Spatial index: %u objects in %u buckets, largest object size %.1f", index->GetSize(), index->GetBucketCount(), index->GetMaxObjectSize());
+
+        static float const radii[] = { 5.0f, 10.0f, 20.0f, 30.0f };
+        for (uint32 r = 0; r < sizeof(radii) / sizeof(radii[0]); ++r)
+        {
+            float x = player->GetPositionX();
+            float y = player->GetPositionY();
+            Trinity::AnyUnitInObjectRangeCheck check(player, radii[r]);
+
+            uint32 cellFound = 0;
+            uint32 startTime = getMSTime();
+            for (uint32 i = 0; i < iterations; ++i)
+            {
+                std::list<Unit*> targets;
+                Trinity::UnitListSearcher<Trinity::AnyUnitInObjectRangeCheck> searcher(player, targets, check);
+
+                CellCoord p(Trinity::ComputeCellCoord(x, y));
+                Cell cell(p);
+                cell.SetNoCreate();
+
+                TypeContainerVisitor<Trinity::UnitListSearcher<Trinity::AnyUnitInObjectRangeCheck>, WorldTypeMapContainer> world_object_notifier(searcher);
+                cell.Visit(p, world_object_notifier, *map, radii[r], x, y);
+                TypeContainerVisitor<Trinity::UnitListSearcher<Trinity::AnyUnitInObjectRangeCheck>, GridTypeMapContainer> grid_object_notifier(searcher);
+                cell.Visit(p, grid_object_notifier, *map, radii[r], x, y);
+                cellFound = uint32(targets.size());
+            }
+            uint32 cellTime = GetMSTimeDiffToNow(startTime);
+
+            uint32 indexFound[2] = { 0, 0 };
+            uint32 indexTime[2] = { 0, 0 };
+            bool indexed = true;
+            for (uint8 vectorized = 0; vectorized < 2; ++vectorized)
+            {
+                startTime = getMSTime();
+                for (uint32 i = 0; i < iterations; ++i)
+                {
+                    std::list<Unit*> targets;
+                    Trinity::UnitListSearcher<Trinity::AnyUnitInObjectRangeCheck> searcher(player, targets, check);
+                    indexed = index->Visit(x, y, radii[r], searcher, true, true, vectorized != 0);
+                    indexFound[vectorized] = uint32(targets.size());
+                }
+                indexTime[vectorized] = GetMSTimeDiffToNow(startTime);
+            }
+
+            if (!indexed)
+            {
+                handler->PSendSysMessage("Radius %.0f, %u searches: cells %u ms (%u units), too large for the index", radii[r], iterations, cellTime, cellFound);
+                continue;
+            }
+
+            handler->PSendSysMessage("Radius %.0f, %u searches: cells %u ms (%u units), index scalar %u ms (%u units), index SSE2 %u ms (%u units)",
+                radii[r], iterations, cellTime, cellFound, indexTime[0], indexFound[0], indexTime[1], indexFound[1]);
+        }
+
+        return true;
+    }
+
+    // Blocks of a private pool, the pools behind operator new and their slabs are left alone
+    template<class T>
+    struct PoolSoakAllocator
+    {
+        void* Allocate() { return Pool.AllocateBlock(); }
+        void Deallocate(void* ptr) { Pool.DeallocateBlock(ptr); }
+
+        ObjectPool<T> Pool;
+    };
+
+    // Baseline of the soak, what the class would get without its pooled operator new
+    template<class T>
+    struct HeapSoakAllocator
+    {
+        void* Allocate() { return ::operator new(sizeof(T)); }
+        void Deallocate(void* ptr) { ::operator delete(ptr); }
+    };
+
+    template<class ALLOCATOR>
+    struct SoakPopulation
+    {
+        ~SoakPopulation()
+        {
+            for (std::vector<void*>::const_iterator itr = Blocks.begin(); itr != Blocks.end(); ++itr)
+                Allocator.Deallocate(*itr);
+        }
+
+        // Frees a random part of the blocks and allocates until target blocks are live
+        void Churn(uint32 target, SFMTRand& rand)
+        {
+            uint32 freed = uint32(Blocks.size()) / 10;
+            for (uint32 i = 0; i < freed; ++i)
+            {
+                uint32 index = rand.URandom(0, uint32(Blocks.size()) - 1);
+                Allocator.Deallocate(Blocks[index]);
+                Blocks[index] = Blocks.back();
+                Blocks.pop_back();
+            }
+
+            while (Blocks.size() > target)
+            {
+                Allocator.Deallocate(Blocks.back());
+                Blocks.pop_back();
+            }
+
+            while (Blocks.size() < target)
+                Blocks.push_back(Allocator.Allocate());
+        }
+
+        ALLOCATOR Allocator;
+        std::vector<void*> Blocks;
+    };
+
+    static std::string GetResidentSetSize()
+    {
+#if PLATFORM == PLATFORM_UNIX
+        std::ifstream statm("/proc/self/statm");
+        unsigned long size = 0, resident = 0;
+        if (statm >> size >> resident)
+        {
+            std::ostringstream ss;
+            ss << (resident * uint64(sysconf(_SC_PAGESIZE)) / 1024) << " KB";
+            return ss.str();
+        }
+#endif
+        return "n/a";
+    }
+
+    // Replays the same seeded day of churn on private pools or on the general heap
+    template<template<class> class ALLOCATOR>
+    static void RunPoolSoak(ChatHandler* handler, uint32 hours)
+    {
+        SFMTRand rand;
+        rand.RandomInit(POOL_SOAK_SEED);
+
+        std::string startSize = GetResidentSetSize();
+        uint32 startTime = getMSTime();
+        {
+            SoakPopulation<ALLOCATOR<Creature> > creatures;
+            SoakPopulation<ALLOCATOR<Spell> > spells;
+            SoakPopulation<ALLOCATOR<UnitAura> > auras;
+            SoakPopulation<ALLOCATOR<AuraEffect> > effects;
+            SoakPopulation<ALLOCATOR<AuraApplication> > applications;
+
+            for (uint32 hour = 0; hour < hours; ++hour)
+            {
+                for (uint32 minute = 0; minute < MINUTE; ++minute)
+                {
+                    float load = 1.5f + std::sin(2.0f * M_PI * (hour * MINUTE + minute) / (24 * MINUTE));
+                    uint32 population = uint32(load * 10000.0f);
+                    creatures.Churn(population, rand);
+                    spells.Churn(population / 5, rand);
+                    auras.Churn(population * 2, rand);
+                    effects.Churn(population * 3, rand);
+                    applications.Churn(population * 2, rand);
+                }
+
+                handler->PSendSysMessage("Hour %u: %u creatures, %u aura effects, resident set %s", hour + 1,
+                    uint32(creatures.Blocks.size()), uint32(effects.Blocks.size()), GetResidentSetSize().c_str());
+            }
+        }
+
+        handler->PSendSysMessage("Soaked %u simulated hours in %u ms, resident set %s before, %s after release",
+            hours, GetMSTimeDiffToNow(startTime), startSize.c_str(), GetResidentSetSize().c_str());
+    }
+
+    // USAGE: .bench poolsoak [#hours] [heap]
+    // Replays the creature, spell and aura churn of a server over the given simulated hours (24 by
+    // default): one step per simulated minute, a population following a day/night curve and a tenth
+    // of it replaced every step. The blocks come from private pools that are released afterwards, or
+    // with "heap" from plain new/delete replaying the same sequence. Reports the resident set every
+    // hour; compare both in freshly started servers, it should stop growing once the first peak has
+    // been reached. Blocks the world thread while it runs.
+    static bool HandleBenchPoolSoakCommand(ChatHandler* handler, char const* args)
+    {
+        char* hoursStr = strtok((char*)args, " ");
+        char* modeStr = strtok(NULL, " ");
+        uint32 hours;
+        if (!ExtractBenchCount(handler, hoursStr, "Hours", 24, BENCH_MAX_SOAK_HOURS, hours))
+            return false;
+
+        if (modeStr && strcmp(modeStr, "heap") != 0)
+        {
+            handler->SendSysMessage(LANG_BAD_VALUE);
+            handler->SetSentErrorMessage(true);
+            return false;
+        }
+
+        if (modeStr)
+            RunPoolSoak<HeapSoakAllocator>(handler, hours);
+        else
+            RunPoolSoak<PoolSoakAllocator>(handler, hours);
+        return true;
+    }
+
+    // USAGE: .bench event [#casts]
+    // Replays the hits of area spells: every cast schedules one event per target with a travel time of 0.1 to 1.5
+    // seconds, EVENT_BENCH_CASTS_PER_UPDATE casts per update. Runs them through the timing wheel of EventProcessor
+    // and through the multimap it used to keep, both with the same pooled events.
+    static bool HandleBenchEventCommand(ChatHandler* handler, char const* args)
+    {
+        char* castsStr = strtok((char*)args, " ");
+        uint32 casts;
+        if (!ExtractBenchCount(handler, castsStr, "Casts", 10000, BENCH_MAX_CASTS, casts))
+            return false;
+
+        std::vector<uint32> delays(casts);
+        for (uint32 i = 0; i < casts; ++i)
+            delays[i] = urand(100, 1500);
+
+        uint32 wheelExecuted = 0;
+        uint32 startTime = getMSTime();
+        {
+            EventProcessor events;
+            uint32 cast = 0;
+            while (cast < casts || events.GetEventCount())
+            {
+                for (uint32 i = 0; i < EVENT_BENCH_CASTS_PER_UPDATE && cast < casts; ++i, ++cast)
+                    for (uint32 target = 0; target < EVENT_BENCH_TARGETS; ++target)
+                        events.AddEvent(new EventBenchHit(wheelExecuted), events.CalculateTime(delays[cast]));
+
+                events.Update(EVENT_BENCH_UPDATE_DIFF);
+            }
+        }
+        uint32 wheelTime = GetMSTimeDiffToNow(startTime);
+
+        uint32 multimapExecuted = 0;
+        startTime = getMSTime();
+        {
+            typedef std::multimap<uint64, BasicEvent*> EventList;
+            EventList events;
+            uint64 now = 0;
+            uint32 cast = 0;
+            while (cast < casts || !events.empty())
+            {
+                for (uint32 i = 0; i < EVENT_BENCH_CASTS_PER_UPDATE && cast < casts; ++i, ++cast)
+                    for (uint32 target = 0; target < EVENT_BENCH_TARGETS; ++target)
+                        events.insert(std::pair<uint64, BasicEvent*>(now + delays[cast], new EventBenchHit(multimapExecuted)));
+
+                now += EVENT_BENCH_UPDATE_DIFF;
+                EventList::iterator itr;
+                while ((itr = events.begin()) != events.end() && itr->first <= now)
+                {
+                    BasicEvent* event = itr->second;
+                    events.erase(itr);
+                    if (event->Execute(now, EVENT_BENCH_UPDATE_DIFF))
+                        delete event;
+                }
+            }
+        }
+        uint32 multimapTime = GetMSTimeDiffToNow(startTime);
+
+        handler->PSendSysMessage("%u casts x %u targets: timing wheel %u ms (%u events), multimap %u ms (%u events)",
+            casts, EVENT_BENCH_TARGETS, wheelTime, wheelExecuted, multimapTime, multimapExecuted);
+        return true;
+    }
+
+    // USAGE: .bench auction [#auctions] [#searches]
+    // Fills a detached auction search index with auctions of random items and runs a mix of browse and name
+    // searches through it and through the former scan of all auctions, checking that both find the same auctions.
+    // The items are registered with the auction manager under the highest item guids for the time of the run.
+    static bool HandleBenchAuctionCommand(ChatHandler* handler, char const* args)
+    {
+        char* auctionsStr = strtok((char*)args, " ");
+        char* searchesStr = strtok(NULL, " ");
+        uint32 auctionCount, searchCount;
+        if (!ExtractBenchCount(handler, auctionsStr, "Auctions", 100000, BENCH_MAX_AUCTIONS, auctionCount) ||
+            !ExtractBenchCount(handler, searchesStr, "Searches", 1000, BENCH_MAX_SEARCHES, searchCount))
+            return false;
+
+        std::vector<ItemTemplate const*> protos;
+        ItemTemplateContainer const* store = sObjectMgr->GetItemTemplateStore();
+        for (ItemTemplateContainer::const_iterator itr = store->begin(); itr != store->end(); ++itr)
+            if (!itr->second.Name1.empty())
+                protos.push_back(&itr->second);
+
+        if (protos.empty())
+        {
+            handler->SendSysMessage(LANG_BAD_VALUE);
+            handler->SetSentErrorMessage(true);
+            return false;
+        }
+
+        LocaleConstant locale = LocaleConstant(handler->GetSessionDbLocaleIndex());
+        time_t curTime = sWorld->GetGameTime();
+
+        AuctionSearchIndex index;
+        std::vector<AuctionEntry*> auctions;
+        auctions.reserve(auctionCount);
+
+        uint32 startTime = getMSTime();
+        for (uint32 guid = 0xFFFFFFFF; auctions.size() < auctionCount && guid; --guid)
+        {
+            if (sAuctionMgr->GetAItem(guid))
+                continue;
+
+            Item* item = new Item();
+            if (!item->Create(guid, protos[urand(0, protos.size() - 1)]->ItemId, NULL))
+            {
+                delete item;
+                continue;
+            }
+
+            AuctionEntry* auction = new AuctionEntry();
+            auction->Id = auctions.size() + 1;
+            auction->itemGUIDLow = guid;
+            auction->itemEntry = item->GetEntry();
+            auction->itemCount = 1;
+            auction->expire_time = curTime + 12 * HOUR;
+            auctions.push_back(auction);
+
+            sAuctionMgr->AddAItem(item);
+            index.Insert(auction, item);
+        }
+        uint32 insertTime = GetMSTimeDiffToNow(startTime);
+
+        // a mix of name searches (3 to 6 characters of item names), category browsing and filtered browsing
+        std::vector<AuctionSearchQuery> queries(searchCount);
+        for (uint32 i = 0; i < searchCount; ++i)
+        {
+            ItemTemplate const* proto = protos[urand(0, protos.size() - 1)];
+            AuctionSearchQuery& query = queries[i];
+            switch (urand(0, 3))
+            {
+                case 0:
+                {
+                    std::wstring name;
+                    if (Utf8toWStr(proto->Name1, name) && name.size() >= 3)
+                    {
+                        wstrToLower(name);
+                        uint32 length = std::min<uint32>(urand(3, 6), name.size());
+                        query.Name = name.substr(urand(0, name.size() - length), length);
+                    }
+                    break;
+                }
+                case 1:
+                    query.ItemClass = proto->Class;
+                    break;
+                case 2:
+                    query.ItemClass = proto->Class;
+                    query.ItemSubClass = proto->SubClass;
+                    break;
+                default:
+                    query.ItemClass = proto->Class;
+                    query.Quality = proto->Quality;
+                    query.LevelMin = 1;
+                    query.LevelMax = uint8(urand(10, 80));
+                    break;
+            }
+        }
+
+        uint64 indexFound = 0;
+        uint32 mismatches = 0;
+        std::vector<uint32> found(searchCount);
+        std::vector<AuctionEntry*> results;
+        startTime = getMSTime();
+        for (uint32 i = 0; i < searchCount; ++i)
+        {
+            results.clear();
+            index.Search(queries[i], locale, NULL, curTime, results);
+            found[i] = results.size();
+            indexFound += results.size();
+        }
+        uint32 indexTime = GetMSTimeDiffToNow(startTime);
+
+        uint64 scanFound = 0;
+        startTime = getMSTime();
+        for (uint32 i = 0; i < searchCount; ++i)
+        {
+            uint32 matches = 0;
+            for (std::vector<AuctionEntry*>::const_iterator itr = auctions.begin(); itr != auctions.end(); ++itr)
+                if (AuctionSearchIndex::MatchesByScan(*itr, queries[i], locale, NULL, curTime))
+                    ++matches;
+
+            if (matches != found[i])
+                ++mismatches;
+            scanFound += matches;
+        }
+        uint32 scanTime = GetMSTimeDiffToNow(startTime);
+
+        uint32 names = index.GetNameCount();
+
+        startTime = getMSTime();
+        for (std::vector<AuctionEntry*>::const_iterator itr = auctions.begin(); itr != auctions.end(); ++itr)
+        {
+            index.Remove(*itr);
+            delete sAuctionMgr->GetAItem((*itr)->itemGUIDLow);
+            sAuctionMgr->RemoveAItem((*itr)->itemGUIDLow);
+            delete *itr;
+        }
+        uint32 removeTime = GetMSTimeDiffToNow(startTime);
+
+        handler->PSendSysMessage("%u auctions of %u distinct names, indexed in %u ms, removed in %u ms",
+            uint32(auctions.size()), names, insertTime, removeTime);
+        handler->PSendSysMessage("%u searches: index %u ms (" UI64FMTD " auctions found), scan %u ms (" UI64FMTD " auctions found), %u mismatches",
+            searchCount, indexTime, indexFound, scanTime, scanFound, mismatches);
+        return true;
+    }
+
+    // USAGE: .bench who [#queries]
+    // Runs random /who queries (levels, zones, names and free strings taken from the players online) for the
+    // own character through the player directory and through the former walk of the player registry
+    static bool HandleBenchWhoCommand(ChatHandler* handler, char const* args)
+    {
+        char* queriesStr = strtok((char*)args, " ");
+        uint32 queryCount;
+        if (!ExtractBenchCount(handler, queriesStr, "Queries", 1000, BENCH_MAX_WHO_QUERIES, queryCount))
+            return false;
+
+        Player* viewer = handler->GetSession()->GetPlayer();
+
+        std::vector<std::pair<std::wstring, uint32> > online;
+        for (uint32 stripe = 0; stripe < HashMapHolder<Player>::STRIPE_COUNT; ++stripe)
+        {
+            TRINITY_READ_GUARD(HashMapHolder<Player>::LockType, *HashMapHolder<Player>::GetLock(stripe));
+            HashMapHolder<Player>::MapType const& m = sObjectAccessor->GetPlayers(stripe);
+            for (HashMapHolder<Player>::MapType::const_iterator itr = m.begin(); itr != m.end(); ++itr)
+            {
+                std::wstring name;
+                if (Utf8toWStr(itr->second->GetName(), name))
+                {
+                    wstrToLower(name);
+                    online.push_back(std::make_pair(name, itr->second->GetZoneId()));
+                }
+            }
+        }
+
+        std::vector<WhoQuery> queries(queryCount);
+        for (uint32 i = 0; i < queryCount; ++i)
+        {
+            WhoQuery& query = queries[i];
+            query.LevelMax = STRONG_MAX_LEVEL;
+            query.RaceMask = 0xFFFFFFFF;
+            query.ClassMask = 0xFFFFFFFF;
+
+            std::pair<std::wstring, uint32> const& sample = online[urand(0, online.size() - 1)];
+            switch (urand(0, 3))
+            {
+                case 0:
+                    query.LevelMin = urand(1, 70);
+                    query.LevelMax = query.LevelMin + 10;
+                    break;
+                case 1:
+                    query.ZoneCount = 1;
+                    query.Zones[0] = sample.second;
+                    break;
+                case 2:
+                    query.PlayerName = sample.first.substr(0, std::min<size_t>(sample.first.size(), 3));
+                    break;
+                default:
+                    query.StringCount = 1;
+                    query.Strings[0] = sample.first.substr(0, std::min<size_t>(sample.first.size(), 4));
+                    break;
+            }
+        }
+
+        sPlayerDirectory->Refresh();
+
+        uint64 directoryMatches = 0;
+        PlayerDirectory::EntryList results;
+        uint32 startTime = getMSTime();
+        for (uint32 i = 0; i < queryCount; ++i)
+        {
+            results.clear();
+            sPlayerDirectory->Search(queries[i], viewer, results);
+            directoryMatches += results.size();
+        }
+        uint32 directoryTime = GetMSTimeDiffToNow(startTime);
+
+        uint64 scanMatches = 0;
+        startTime = getMSTime();
+        for (uint32 i = 0; i < queryCount; ++i)
+            scanMatches += CountWhoMatchesByScan(queries[i], viewer);
+        uint32 scanTime = GetMSTimeDiffToNow(startTime);
+
+        handler->PSendSysMessage("%u who queries over %u players: directory %u ms (" UI64FMTD " matches), registry walk %u ms (" UI64FMTD " matches)",
+            queryCount, sPlayerDirectory->GetSize(), directoryTime, directoryMatches, scanTime, scanMatches);
+        return true;
+    }
+
+    // USAGE: .bench channel [#members] [#messages]
+    // Fans chat messages out to a channel of fake members, once the way channels used to (registry lookup and
+    // ignore list check per member) and once over the member slots with the ignores masked out. Only the choice
+    // of recipients is timed, the packets are not sent.
+    static bool HandleBenchChannelCommand(ChatHandler* handler, char const* args)
+    {
+        char* membersStr = strtok((char*)args, " ");
+        char* messagesStr = strtok(NULL, " ");
+        uint32 memberCount, messageCount;
+        if (!ExtractBenchCount(handler, membersStr, "Members", 5000, BENCH_MAX_MEMBERS, memberCount) ||
+            !ExtractBenchCount(handler, messagesStr, "Messages", 1000, BENCH_MAX_MESSAGES, messageCount))
+            return false;
+
+        Player* viewer = handler->GetSession()->GetPlayer();
+        uint64 sender = viewer->GetGUID();
+
+        // every member stands for the own character, one in a hundred ignores the sender
+        std::map<uint64, uint8> store;
+        std::vector<Player*> members(memberCount, viewer);
+        std::vector<uint32> ignoring;
+        std::vector<bool> ignores(memberCount, false);
+        std::vector<uint32> skipMask((memberCount + 31) / 32, 0);
+        for (uint32 i = 0; i < memberCount; ++i)
+        {
+            store[MAKE_NEW_GUID(0xFFFFFFFF - i, 0, HIGHGUID_PLAYER)] = MEMBER_FLAG_NONE;
+            if (!urand(0, 99))
+            {
+                ignoring.push_back(i);
+                ignores[i] = true;
+            }
+        }
+
+        uint64 lookupRecipients = 0;
+        uint32 startTime = getMSTime();
+        for (uint32 m = 0; m < messageCount; ++m)
+        {
+            uint32 i = 0;
+            for (std::map<uint64, uint8>::const_iterator itr = store.begin(); itr != store.end(); ++itr, ++i)
+            {
+                ObjectAccessor::FindPlayer(itr->first);
+                if (!viewer->GetSocial()->HasIgnore(GUID_LOPART(sender)) && !ignores[memberCount - 1 - i])
+                    ++lookupRecipients;
+            }
+        }
+        uint32 lookupTime = GetMSTimeDiffToNow(startTime);
+
+        uint64 slotRecipients = 0;
+        startTime = getMSTime();
+        for (uint32 m = 0; m < messageCount; ++m)
+        {
+            for (std::vector<uint32>::const_iterator itr = ignoring.begin(); itr != ignoring.end(); ++itr)
+                skipMask[*itr >> 5] |= 1u << (*itr & 31);
+
+            for (uint32 slot = 0; slot < members.size(); ++slot)
+                if (Player* player = members[slot])
+                    if (player->IsInWorld() && !(skipMask[slot >> 5] & (1u << (slot & 31))))
+                        ++slotRecipients;
+
+            for (std::vector<uint32>::const_iterator itr = ignoring.begin(); itr != ignoring.end(); ++itr)
+                skipMask[*itr >> 5] &= ~(1u << (*itr & 31));
+        }
+        uint32 slotTime = GetMSTimeDiffToNow(startTime);
+
+        handler->PSendSysMessage("%u messages to %u members: registry lookups %u ms (%u msg/s, " UI64FMTD " recipients), member slots %u ms (%u msg/s, " UI64FMTD " recipients)",
+            messageCount, memberCount, lookupTime, uint32(uint64(messageCount) * IN_MILLISECONDS / std::max<uint32>(lookupTime, 1)), lookupRecipients,
+            slotTime, uint32(uint64(messageCount) * IN_MILLISECONDS / std::max<uint32>(slotTime, 1)), slotRecipients);
+        return true;
+    }
+};
+
+void AddSC_bench_commandscript()
+{
+    new bench_commandscript();
+}
@@ -24,6 +24,7 @@ EndScriptData */
 
 #include "ScriptMgr.h"
 #include "ObjectMgr.h"
+#include "AnticheatSink.h"
 #include "BattlegroundMgr.h"
 #include "Chat.h"
 #include "Cell.h"
@@ -32,6 +33,13 @@ EndScriptData */
 #include "GridNotifiersImpl.h"
 #include "GossipDef.h"
 #include "Language.h"
+#include "MailExpiry.h"
+#include "MapManager.h"
+#include "Spell.h"
+#include "SpellAuras.h"
+#include "SpellAuraEffects.h"
+#include "Transport.h"
+#include "WardenScheduler.h"
 
 #include <fstream>
 
@@ -92,6 +100,12 @@ public:
             { "los",            SEC_MODERATOR,      false, &HandleDebugLoSCommand,             "", NULL },
             { "moveflags",      SEC_ADMINISTRATOR,  false, &HandleDebugMoveflagsCommand,       "", NULL },
             { "phase",          SEC_MODERATOR,      false, &HandleDebugPhaseCommand,           "", NULL },
+            { "transports",     SEC_ADMINISTRATOR,  true,  &HandleDebugTransportsCommand,      "", NULL },
+            { "pools",          SEC_ADMINISTRATOR,  true,  &HandleDebugPoolsCommand,           "", NULL },
+            { "maptimers",      SEC_ADMINISTRATOR,  false, &HandleDebugMapTimersCommand,       "", NULL },
+            { "anticheat",      SEC_ADMINISTRATOR,  false, &HandleDebugAntiCheatCommand,       "", NULL },
+            { "warden",         SEC_ADMINISTRATOR,  true,  &HandleDebugWardenCommand,          "", NULL },
+            { "mailexpiry",     SEC_ADMINISTRATOR,  true,  &HandleDebugMailExpiryCommand,      "", NULL },
             { NULL,             SEC_PLAYER,         false, NULL,                               "", NULL }
         };
         static ChatCommand commandTable[] =
@@ -1051,6 +1065,88 @@ public:
         return true;
     }
 
+    template<class T>
+    static void SendPoolStats(ChatHandler* handler, char const* name)
+    {
+        ObjectPool<T>* pool = ObjectPool<T>::instance();
+        handler->PSendSysMessage("%s (%u bytes): %u live, " UI64FMTD " allocations, " UI64FMTD " from recycled blocks, %u slabs, %u shared free blocks",
+            name, uint32(ObjectPool<T>::BlockSize), pool->GetLiveCount(), pool->GetAllocationCount(), pool->GetPoolHitCount(), pool->GetSlabCount(), pool->GetSharedFreeCount());
+    }
+
+    // Shows the object pools behind the operator new of the frequently created classes
+    static bool HandleDebugPoolsCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        SendPoolStats<Creature>(handler, "Creature");
+        SendPoolStats<GameObject>(handler, "GameObject");
+        SendPoolStats<Spell>(handler, "Spell");
+        SendPoolStats<UnitAura>(handler, "UnitAura");
+        SendPoolStats<AuraEffect>(handler, "AuraEffect");
+        SendPoolStats<AuraApplication>(handler, "AuraApplication");
+        return true;
+    }
+
+    // Shows the respawn, corpse, grid state and summon timers of the current map
+    static bool HandleDebugMapTimersCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        Map* map = handler->GetSession()->GetPlayer()->GetMap();
+        TimerWheel& timers = map->GetTimers();
+        handler->PSendSysMessage("Map %u instance %u: %u timers scheduled, %u expired in the last update, " UI64FMTD " expired in total",
+            map->GetId(), map->GetInstanceId(), timers.GetSize(), map->GetExpiredTimerCount(), timers.GetExpiredCount());
+        return true;
+    }
+
+    // Shows how long the movement checks of the anticheat took in the last update of the current map
+    static bool HandleDebugAntiCheatCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        Map* map = handler->GetSession()->GetPlayer()->GetMap();
+        handler->PSendSysMessage("Map %u instance %u: %u movement packets checked in %u us in the last update, at most %u us",
+            map->GetId(), map->GetInstanceId(), map->GetAntiCheatSampleCount(), map->GetAntiCheatUpdateTime(), map->GetAntiCheatMaxUpdateTime());
+
+        handler->PSendSysMessage("Violations: %u waiting, %u lost, %u processed, at most %u per world update",
+            sAntiCheatSink->GetQueuedCount(), sAntiCheatSink->GetDroppedCount(), sAntiCheatSink->GetProcessedCount(), sAntiCheatSink->GetMaxBatchSize());
+
+        AntiCheatSink::CounterMap const& counters = sAntiCheatSink->GetCounters();
+        for (AntiCheatSink::CounterMap::const_iterator itr = counters.begin(); itr != counters.end(); ++itr)
+            handler->PSendSysMessage("Check %u: %u violations, %u not reported, %u stored, %u bans",
+                itr->first, itr->second.Reported, itr->second.Suppressed, itr->second.Stored, itr->second.Bans);
+        return true;
+    }
+
+    static bool HandleDebugWardenCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        WardenStats stats = sWardenScheduler->GetStats();
+        handler->PSendSysMessage("Warden: %u sessions, one request every %u ms, %u requests/s, %u checks/s",
+            stats.Wardens, stats.Interval, stats.RequestsPerSec, stats.ChecksPerSec);
+        handler->PSendSysMessage(UI64FMTD " requests sent", stats.Requests);
+        return true;
+    }
+
+    static bool HandleDebugMailExpiryCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        MailExpiryStats const& sweep = sMailExpiry->GetSweepStats();
+        MailExpiryStats const& stats = sMailExpiry->GetStats();
+        handler->PSendSysMessage("Mail expiry: %s, last sweep %u batches, %u mails: %u deleted, %u returned, %u skipped",
+            sMailExpiry->IsSweeping() ? "sweeping" : "idle", sweep.Batches, sweep.Processed, sweep.Deleted, sweep.Returned, sweep.Skipped);
+        handler->PSendSysMessage("Since start: %u batches, %u mails per batch on average, %u at most, last %u",
+            stats.Batches, stats.Batches ? (stats.Processed + stats.Skipped) / stats.Batches : 0, stats.MaxBatch, stats.LastBatch);
+        handler->PSendSysMessage("%u mails: %u deleted, %u returned, %u skipped", stats.Processed, stats.Deleted, stats.Returned, stats.Skipped);
+        return true;
+    }
+
+    // Lists the transports with their current map and how long their updates take
+    static bool HandleDebugTransportsCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        for (MapManager::TransportSet::const_iterator itr = sMapMgr->m_Transports.begin(); itr != sMapMgr->m_Transports.end(); ++itr)
+        {
+            Transport* transport = *itr;
+            handler->PSendSysMessage("%s (entry %u) map %u, %u passengers: last update %u us, max %u us%s", transport->GetName().c_str(),
+                transport->GetEntry(), transport->GetMapId(), uint32(transport->GetPassengers().size()),
+                transport->GetLastUpdateTime(), transport->GetMaxUpdateTime(), transport->IsTeleportPending() ? ", changing map" : "");
+        }
+
+        return true;
+    }
+
     //show animation
     static bool HandleDebugAnimCommand(ChatHandler* handler, char const* args)
     {
@@ -118,32 +118,35 @@ public:
         bool first = true;
         bool footer = false;
 
-        TRINITY_READ_GUARD(HashMapHolder<Player>::LockType, *HashMapHolder<Player>::GetLock());
-        HashMapHolder<Player>::MapType const& m = sObjectAccessor->GetPlayers();
-        for (HashMapHolder<Player>::MapType::const_iterator itr = m.begin(); itr != m.end(); ++itr)
+        for (uint32 stripe = 0; stripe < HashMapHolder<Player>::STRIPE_COUNT; ++stripe)
         {
-            AccountTypes itrSec = itr->second->GetSession()->GetSecurity();
-            if ((itr->second->isGameMaster() || (!AccountMgr::IsPlayerAccount(itrSec) && itrSec <= AccountTypes(sWorld->getIntConfig(CONFIG_GM_LEVEL_IN_GM_LIST)))) &&
-                (!handler->GetSession() || itr->second->IsVisibleGloballyFor(handler->GetSession()->GetPlayer())))
+            TRINITY_READ_GUARD(HashMapHolder<Player>::LockType, *HashMapHolder<Player>::GetLock(stripe));
+            HashMapHolder<Player>::MapType const& m = sObjectAccessor->GetPlayers(stripe);
+            for (HashMapHolder<Player>::MapType::const_iterator itr = m.begin(); itr != m.end(); ++itr)
             {
-                if (first)
+                AccountTypes itrSec = itr->second->GetSession()->GetSecurity();
+                if ((itr->second->isGameMaster() || (!AccountMgr::IsPlayerAccount(itrSec) && itrSec <= AccountTypes(sWorld->getIntConfig(CONFIG_GM_LEVEL_IN_GM_LIST)))) &&
+                    (!handler->GetSession() || itr->second->IsVisibleGloballyFor(handler->GetSession()->GetPlayer())))
                 {
-                    first = false;
-                    footer = true;
-                    handler->SendSysMessage(LANG_GMS_ON_SRV);
-                    handler->SendSysMessage("========================");
+                    if (first)
+                    {
+                        first = false;
+                        footer = true;
+                        handler->SendSysMessage(LANG_GMS_ON_SRV);
+                        handler->SendSysMessage("========================");
+                    }
+                    std::string const& name = itr->second->GetName();
+                    uint8 size = name.size();
+                    uint8 security = itrSec;
+                    uint8 max = ((16 - size) / 2);
+                    uint8 max2 = max;
+                    if ((max + max2 + size) == 16)
+                        max2 = max - 1;
+                    if (handler->GetSession())
+                        handler->PSendSysMessage("|    %s GMLevel %u", name.c_str(), security);
+                    else
+                        handler->PSendSysMessage("|%*s%s%*s|   %u  |", max, " ", name.c_str(), max2, " ", security);
                 }
-                std::string const& name = itr->second->GetName();
-                uint8 size = name.size();
-                uint8 security = itrSec;
-                uint8 max = ((16 - size) / 2);
-                uint8 max2 = max;
-                if ((max + max2 + size) == 16)
-                    max2 = max - 1;
-                if (handler->GetSession())
-                    handler->PSendSysMessage("|    %s GMLevel %u", name.c_str(), security);
-                else
-                    handler->PSendSysMessage("|%*s%s%*s|   %u  |", max, " ", name.c_str(), max2, " ", security);
             }
         }
         if (footer)
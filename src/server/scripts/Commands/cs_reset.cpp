@@ -294,10 +294,13 @@ public:
         stmt->setUInt16(0, uint16(atLogin));
         CharacterDatabase.Execute(stmt);
 
-        TRINITY_READ_GUARD(HashMapHolder<Player>::LockType, *HashMapHolder<Player>::GetLock());
-        HashMapHolder<Player>::MapType const& plist = sObjectAccessor->GetPlayers();
-        for (HashMapHolder<Player>::MapType::const_iterator itr = plist.begin(); itr != plist.end(); ++itr)
-            itr->second->SetAtLoginFlag(atLogin);
+        for (uint32 stripe = 0; stripe < HashMapHolder<Player>::STRIPE_COUNT; ++stripe)
+        {
+            TRINITY_READ_GUARD(HashMapHolder<Player>::LockType, *HashMapHolder<Player>::GetLock(stripe));
+            HashMapHolder<Player>::MapType const& plist = sObjectAccessor->GetPlayers(stripe);
+            for (HashMapHolder<Player>::MapType::const_iterator itr = plist.begin(); itr != plist.end(); ++itr)
+                itr->second->SetAtLoginFlag(atLogin);
+        }
 
         return true;
     }
@@ -24,6 +24,7 @@ EndScriptData */
 
 #include "Chat.h"
 #include "Config.h"
+#include "DatabaseEnv.h"
 #include "Language.h"
 #include "ObjectAccessor.h"
 #include "Player.h"
@@ -77,6 +78,7 @@ public:
         static ChatCommand serverCommandTable[] =
         {
             { "corpses",        SEC_GAMEMASTER,     true,  &HandleServerCorpsesCommand,             "", NULL },
+            { "dbqueue",        SEC_ADMINISTRATOR,  true,  &HandleServerDBQueueCommand,             "", NULL },
             { "exit",           SEC_CONSOLE,        true,  &HandleServerExitCommand,                "", NULL },
             { "idlerestart",    SEC_ADMINISTRATOR,  true,  NULL,                                    "", serverIdleRestartCommandTable },
             { "idleshutdown",   SEC_ADMINISTRATOR,  true,  NULL,                                    "", serverIdleShutdownCommandTable },
@@ -436,6 +438,28 @@ public:
         return true;
     }
 
+    template <class T>
+    static void SendDatabaseQueueInfo(ChatHandler* handler, DatabaseWorkerPool<T>& database)
+    {
+        for (uint8 i = 0; i < database.GetQueueShardCount(); ++i)
+        {
+            SQLQueueSnapshot snapshot;
+            database.GetQueueSnapshot(i, snapshot);
+            handler->PSendSysMessage("%s[%u]: depth %u (max %u), enqueued %u, executed %u, dropped %u, overflows %u, wait avg %u ms (max %u ms)",
+                database.GetDatabaseName(), i, snapshot.Depth, snapshot.MaxDepth, snapshot.Enqueued, snapshot.Executed,
+                snapshot.Dropped, snapshot.Overflows, snapshot.AvgWaitTime, snapshot.MaxWaitTime);
+        }
+    }
+
+    // Display depth and latency of the asynchronous database queues
+    static bool HandleServerDBQueueCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        SendDatabaseQueueInfo(handler, LoginDatabase);
+        SendDatabaseQueueInfo(handler, WorldDatabase);
+        SendDatabaseQueueInfo(handler, CharacterDatabase);
+        return true;
+    }
+
     static bool HandleServerUptimeCommand(ChatHandler* handler, const char* /*args*/)
     {
         std::string uptime = secsToTimeString(sWorld->GetUptime());
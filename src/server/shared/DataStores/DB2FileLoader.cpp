@@ -20,135 +20,108 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+
+#include <ace/Mem_Map.h>
+
 #include "DB2FileLoader.h"
 
+#define DB2_HEADER_SIZE         32
+#define DB2_EXTENDED_HEADER_SIZE 48
+
 DB2FileLoader::DB2FileLoader()
 {
+    mapping = NULL;
     data = NULL;
     fieldsOffset = NULL;
 }
 
 bool DB2FileLoader::Load(const char *filename, const char *fmt)
 {
-    if (data)
+    if (mapping)
     {
-        delete [] data;
+        delete mapping;
+        mapping = NULL;
         data = NULL;
     }
 
-    FILE* f = fopen(filename, "rb");
-    if (!f)
-        return false;
-
-    uint32 header;
-    if (fread(&header, 4, 1, f) != 1)                        // Signature
+    // Private mapping, see DBCFileLoader::Load
+    mapping = new ACE_Mem_Map();
+    if (mapping->map(filename, static_cast<size_t>(-1), O_RDONLY, ACE_DEFAULT_FILE_PERMS, PROT_RDWR, ACE_MAP_PRIVATE) == -1)
     {
-        fclose(f);
+        delete mapping;
+        mapping = NULL;
         return false;
     }
 
-    EndianConvert(header);
-
-    if (header != 0x32424457)
-    {
-        fclose(f);
-        return false;                                       //'WDB2'
-    }
+    mapping->close_handle();
 
-    if (fread(&recordCount, 4, 1, f) != 1)                 // Number of records
-    {
-        fclose(f);
+    size_t fileSize = mapping->size();
+    if (fileSize < DB2_HEADER_SIZE)
         return false;
-    }
 
-    EndianConvert(recordCount);
+    uint32 const* header = reinterpret_cast<uint32 const*>(mapping->addr());
 
-    if (fread(&fieldCount, 4, 1, f) != 1)                 // Number of fields
-    {
-        fclose(f);
-        return false;
-    }
+    uint32 signature = header[0];
+    EndianConvert(signature);
 
-    EndianConvert(fieldCount);
+    if (signature != 0x32424457)
+        return false;                                       //'WDB2'
 
-    if (fread(&recordSize, 4, 1, f) != 1)                 // Size of a record
-    {
-        fclose(f);
-        return false;
-    }
+    recordCount = header[1];                                // Number of records
+    EndianConvert(recordCount);
 
-    EndianConvert(recordSize);
+    fieldCount = header[2];                                 // Number of fields
+    EndianConvert(fieldCount);
 
-    if (fread(&stringSize, 4, 1, f) != 1)                 // String size
-    {
-        fclose(f);
-        return false;
-    }
+    recordSize = header[3];                                 // Size of a record
+    EndianConvert(recordSize);
 
+    stringSize = header[4];                                 // String size
     EndianConvert(stringSize);
 
     /* NEW WDB2 FIELDS*/
-    if (fread(&tableHash, 4, 1, f) != 1)                  // Table hash
-    {
-        fclose(f);
-        return false;
-    }
-
+    tableHash = header[5];                                  // Table hash
     EndianConvert(tableHash);
 
-    if (fread(&build, 4, 1, f) != 1)                     // Build
-    {
-        fclose(f);
-        return false;
-    }
-
+    build = header[6];                                      // Build
     EndianConvert(build);
 
-    if (fread(&unk1, 4, 1, f) != 1)                     // Unknown WDB2
-    {
-        fclose(f);
-        return false;
-    }
-
+    unk1 = header[7];                                       // Unknown WDB2
     EndianConvert(unk1);
 
+    size_t headerSize = DB2_HEADER_SIZE;
+    minIndex = 0;
+    maxIndex = 0;
+
     if (build > 12880)
     {
-        if (fread(&minIndex, 4, 1, f) != 1)                           // MinIndex WDB2
-        {
-            fclose(f);
+        if (fileSize < DB2_EXTENDED_HEADER_SIZE)
             return false;
-        }
+
+        minIndex = header[8];                               // MinIndex WDB2
         EndianConvert(minIndex);
 
-        if (fread(&maxIndex, 4, 1, f) != 1)                           // MaxIndex WDB2
-        {
-            fclose(f);
-            return false;
-        }
+        maxIndex = header[9];                               // MaxIndex WDB2
         EndianConvert(maxIndex);
 
-        if (fread(&locale, 4, 1, f) != 1)                             // Locales
-        {
-            fclose(f);
-            return false;
-        }
+        locale = header[10];                                // Locales
         EndianConvert(locale);
 
-        if (fread(&unk5, 4, 1, f) != 1)                               // Unknown WDB2
-        {
-            fclose(f);
-            return false;
-        }
+        unk5 = header[11];                                  // Unknown WDB2
         EndianConvert(unk5);
+
+        headerSize = DB2_EXTENDED_HEADER_SIZE;
     }
 
     if (maxIndex != 0)
     {
         int32 diff = maxIndex - minIndex + 1;
-        fseek(f, diff * 4 + diff * 2, SEEK_CUR);    // diff * 4: an index for rows, diff * 2: a memory allocation bank
+        headerSize += diff * 4 + diff * 2;                  // diff * 4: an index for rows, diff * 2: a memory allocation bank
     }
 
+    if (fileSize < headerSize + size_t(recordSize) * recordCount + stringSize)
+        return false;
+
     fieldsOffset = new uint32[fieldCount];
     fieldsOffset[0] = 0;
     for (uint32 i = 1; i < fieldCount; i++)
@@ -160,27 +133,27 @@ bool DB2FileLoader::Load(const char *filename, const char *fmt)
             fieldsOffset[i] += 4;
     }
 
-    data = new unsigned char[recordSize*recordCount+stringSize];
+    data = reinterpret_cast<unsigned char*>(mapping->addr()) + headerSize;
     stringTable = data + recordSize*recordCount;
 
-    if (fread(data, recordSize * recordCount + stringSize, 1, f) != 1)
-    {
-        fclose(f);
-        return false;
-    }
-
-    fclose(f);
     return true;
 }
 
 DB2FileLoader::~DB2FileLoader()
 {
-    if (data)
-        delete [] data;
+    if (mapping)
+        delete mapping;
     if (fieldsOffset)
         delete [] fieldsOffset;
 }
 
+ACE_Mem_Map* DB2FileLoader::ReleaseMapping()
+{
+    ACE_Mem_Map* released = mapping;
+    mapping = NULL;
+    return released;
+}
+
 DB2FileLoader::Record DB2FileLoader::getRecord(size_t id)
 {
     assert(data);
@@ -370,8 +343,7 @@ char* DB2FileLoader::AutoProduceStrings(const char* format, char* dataTable, uin
     if (strlen(format) != fieldCount)
         return NULL;
 
-    char* stringPool= new char[stringSize];
-    memcpy(stringPool, stringTable, stringSize);
+    char* stringPool = reinterpret_cast<char*>(stringTable);
 
     uint32 offset = 0;
 
@@ -393,10 +365,7 @@ char* DB2FileLoader::AutoProduceStrings(const char* format, char* dataTable, uin
                 // fill only not filled entries
                 LocalizedString* db2str = *(LocalizedString**)(&dataTable[offset]);
                 if (db2str->Str[locale] == nullStr)
-                {
-                    const char * st = getRecord(y).getString(x);
-                    db2str->Str[locale] = stringPool + (st - (const char*)stringTable);
-                }
+                    db2str->Str[locale] = const_cast<char*>(getRecord(y).getString(x));
 
                 offset += sizeof(char*);
                 break;
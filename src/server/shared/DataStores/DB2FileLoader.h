@@ -22,6 +22,9 @@
 #include "Utilities/ByteConverter.h"
 #include <cassert>
 
+class ACE_Mem_Map;
+
+/*! Reads a .db2 file through a private, copy-on-write mapping of the file, like DBCFileLoader. */
 class DB2FileLoader
 {
     public:
@@ -80,11 +83,16 @@ class DB2FileLoader
     bool IsLoaded() const { return (data != NULL); }
     char* AutoProduceData(const char* fmt, uint32& count, char**& indexTable);
     char* AutoProduceStringsArrayHolders(const char* fmt, char* dataTable);
+    // Points the localized string holders into the mapped string table and returns its start.
+    // The mapping must be kept alive with ReleaseMapping() for as long as the strings are used.
     char* AutoProduceStrings(const char* fmt, char* dataTable, uint32 locale);
+    // Hands over the ownership of the file mapping, it is not unmapped anymore when the loader is destroyed
+    ACE_Mem_Map* ReleaseMapping();
     static uint32 GetFormatRecordSize(const char * format, int32 * index_pos = NULL);
     static uint32 GetFormatStringsFields(const char * format);
 private:
 
+    ACE_Mem_Map* mapping;
     uint32 recordSize;
     uint32 recordCount;
     uint32 fieldCount;
@@ -23,6 +23,8 @@
 #include "ByteBuffer.h"
 #include <vector>
 
+#include <ace/Mem_Map.h>
+
 /// Interface class for common access
 class DB2StorageBase
 {
@@ -101,6 +103,7 @@ template<class T>
 class DB2Storage : public DB2StorageBase
 {
     typedef std::list<char*> StringPoolList;
+    typedef std::list<ACE_Mem_Map*> MappingList;
     typedef std::vector<T*> DataTableEx;
     typedef bool(*EntryChecker)(DB2Storage<T> const&, uint32);
     typedef void(*PacketWriter)(DB2Storage<T> const&, uint32, uint32, ByteBuffer&);
@@ -165,8 +168,9 @@ public:
         // create string holders for loaded string fields
         m_stringPoolList.push_back(db2.AutoProduceStringsArrayHolders(fmt, (char*)m_dataTable));
 
-        // load strings from dbc data
-        m_stringPoolList.push_back(db2.AutoProduceStrings(fmt, (char*)m_dataTable, locale));
+        // load strings from dbc data, they point into the mapped file
+        db2.AutoProduceStrings(fmt, (char*)m_dataTable, locale);
+        m_mappingList.push_back(db2.ReleaseMapping());
 
         // error in dbc file at loading if NULL
         return indexTable.asT != NULL;
@@ -184,7 +188,8 @@ public:
             return false;
 
         // load strings from another locale dbc data
-        m_stringPoolList.push_back(db2.AutoProduceStrings(fmt, (char*)m_dataTable, locale));
+        db2.AutoProduceStrings(fmt, (char*)m_dataTable, locale);
+        m_mappingList.push_back(db2.ReleaseMapping());
 
         return true;
     }
@@ -210,6 +215,12 @@ public:
             m_stringPoolList.pop_front();
         }
 
+        while (!m_mappingList.empty())
+        {
+            delete m_mappingList.front();
+            m_mappingList.pop_front();
+        }
+
         nCount = 0;
     }
 
@@ -228,6 +239,7 @@ private:
     T* m_dataTable;
     DataTableEx m_dataTableEx;
     StringPoolList m_stringPoolList;
+    MappingList m_mappingList;
 };
 
 #endif
@@ -20,73 +20,65 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include <ace/Mem_Map.h>
+
 #include "DBCFileLoader.h"
 #include "Errors.h"
 
-DBCFileLoader::DBCFileLoader() : fieldsOffset(NULL), data(NULL), stringTable(NULL)
+#define DBC_HEADER_SIZE 20
+
+DBCFileLoader::DBCFileLoader() : mapping(NULL), fieldsOffset(NULL), data(NULL), stringTable(NULL)
 {
 }
 
 bool DBCFileLoader::Load(const char* filename, const char* fmt)
 {
-    uint32 header;
-    if (data)
+    if (mapping)
     {
-        delete [] data;
+        delete mapping;
+        mapping = NULL;
         data = NULL;
     }
 
-    FILE* f = fopen(filename, "rb");
-    if (!f)
-        return false;
-
-    if (fread(&header, 4, 1, f) != 1)                        // Number of records
+    // Private mapping: writes (core side corrections of dbc data) only copy the touched page
+    mapping = new ACE_Mem_Map();
+    if (mapping->map(filename, static_cast<size_t>(-1), O_RDONLY, ACE_DEFAULT_FILE_PERMS, PROT_RDWR, ACE_MAP_PRIVATE) == -1)
     {
-        fclose(f);
+        delete mapping;
+        mapping = NULL;
         return false;
     }
 
+    // The mapping stays valid without the file handle
+    mapping->close_handle();
 
-    EndianConvert(header);
-
-    if (header != 0x43424457)                                //'WDBC'
-    {
-        fclose(f);
+    size_t fileSize = mapping->size();
+    if (fileSize < DBC_HEADER_SIZE)
         return false;
-    }
 
-    if (fread(&recordCount, 4, 1, f) != 1)                   // Number of records
-    {
-        fclose(f);
-        return false;
-    }
+    uint32 const* header = reinterpret_cast<uint32 const*>(mapping->addr());
 
-    EndianConvert(recordCount);
+    uint32 signature = header[0];
+    EndianConvert(signature);
 
-    if (fread(&fieldCount, 4, 1, f) != 1)                    // Number of fields
-    {
-        fclose(f);
+    if (signature != 0x43424457)                             //'WDBC'
         return false;
-    }
 
-    EndianConvert(fieldCount);
+    recordCount = header[1];                                 // Number of records
+    EndianConvert(recordCount);
 
-    if (fread(&recordSize, 4, 1, f) != 1)                    // Size of a record
-    {
-        fclose(f);
-        return false;
-    }
+    fieldCount = header[2];                                  // Number of fields
+    EndianConvert(fieldCount);
 
+    recordSize = header[3];                                  // Size of a record
     EndianConvert(recordSize);
 
-    if (fread(&stringSize, 4, 1, f) != 1)                    // String size
-    {
-        fclose(f);
-        return false;
-    }
-
+    stringSize = header[4];                                  // String size
     EndianConvert(stringSize);
 
+    if (fileSize < DBC_HEADER_SIZE + size_t(recordSize) * recordCount + stringSize)
+        return false;
+
     fieldsOffset = new uint32[fieldCount];
     fieldsOffset[0] = 0;
     for (uint32 i = 1; i < fieldCount; ++i)
@@ -100,29 +92,28 @@ bool DBCFileLoader::Load(const char* filename, const char* fmt)
             fieldsOffset[i] += sizeof(uint32);
     }
 
-    data = new unsigned char[recordSize * recordCount + stringSize];
+    data = reinterpret_cast<unsigned char*>(mapping->addr()) + DBC_HEADER_SIZE;
     stringTable = data + recordSize*recordCount;
 
-    if (fread(data, recordSize * recordCount + stringSize, 1, f) != 1)
-    {
-        fclose(f);
-        return false;
-    }
-
-    fclose(f);
-
     return true;
 }
 
 DBCFileLoader::~DBCFileLoader()
 {
-    if (data)
-        delete [] data;
+    if (mapping)
+        delete mapping;
 
     if (fieldsOffset)
         delete [] fieldsOffset;
 }
 
+ACE_Mem_Map* DBCFileLoader::ReleaseMapping()
+{
+    ACE_Mem_Map* released = mapping;
+    mapping = NULL;
+    return released;
+}
+
 DBCFileLoader::Record DBCFileLoader::getRecord(size_t id)
 {
     assert(data);
@@ -273,13 +264,72 @@ char* DBCFileLoader::AutoProduceData(const char* format, uint32& records, char**
     return dataTable;
 }
 
+bool DBCFileLoader::CanUseRecordsInPlace(const char* format) const
+{
+#if TRINITY_ENDIAN == TRINITY_BIGENDIAN
+    return false;
+#else
+    if (strlen(format) != fieldCount || recordSize != fieldCount * sizeof(uint32))
+        return false;
+
+    // Only 4 byte fields that are all present in the structure: no padding, no pointers, no skipped columns
+    for (uint32 x = 0; x < fieldCount; ++x)
+        if (format[x] != FT_INT && format[x] != FT_IND && format[x] != FT_FLOAT)
+            return false;
+
+    return true;
+#endif
+}
+
+char* DBCFileLoader::AutoProduceIndex(const char* format, uint32& records, char**& indexTable)
+{
+    typedef char* ptr;
+    if (!CanUseRecordsInPlace(format))
+        return NULL;
+
+    int32 i;
+    GetFormatRecordSize(format, &i);
+
+    if (i >= 0)
+    {
+        uint32 maxi = 0;
+        //find max index
+        for (uint32 y = 0; y < recordCount; ++y)
+        {
+            uint32 ind = getRecord(y).getUInt(i);
+            if (ind > maxi)
+                maxi = ind;
+        }
+
+        ++maxi;
+        records = maxi;
+        indexTable = new ptr[maxi];
+        memset(indexTable, 0, maxi * sizeof(ptr));
+    }
+    else
+    {
+        records = recordCount;
+        indexTable = new ptr[recordCount];
+    }
+
+    char* dataTable = reinterpret_cast<char*>(data);
+    for (uint32 y = 0; y < recordCount; ++y)
+    {
+        if (i >= 0)
+            indexTable[getRecord(y).getUInt(i)] = &dataTable[y * recordSize];
+        else
+            indexTable[y] = &dataTable[y * recordSize];
+    }
+
+    return dataTable;
+}
+
 char* DBCFileLoader::AutoProduceStrings(const char* format, char* dataTable)
 {
     if (strlen(format) != fieldCount)
         return NULL;
 
-    char* stringPool = new char[stringSize];
-    memcpy(stringPool, stringTable, stringSize);
+    char* stringPool = reinterpret_cast<char*>(stringTable);
 
     uint32 offset = 0;
 
@@ -307,10 +357,7 @@ char* DBCFileLoader::AutoProduceStrings(const char* format, char* dataTable)
                     // fill only not filled entries
                     char** slot = (char**)(&dataTable[offset]);
                     if (!*slot || !**slot)
-                    {
-                        const char * st = getRecord(y).getString(x);
-                        *slot=stringPool+(st-(const char*)stringTable);
-                    }
+                        *slot = const_cast<char*>(getRecord(y).getString(x));
                     offset += sizeof(char*);
                     break;
                  }
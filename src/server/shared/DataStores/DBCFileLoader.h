@@ -22,6 +22,11 @@
 #include "Utilities/ByteConverter.h"
 #include <cassert>
 
+class ACE_Mem_Map;
+
+/*! Reads a .dbc file through a private, copy-on-write mapping of the file. Pages that are never written
+    are shared with every other process mapping the same file, e.g. several worldservers on one host.
+*/
 class DBCFileLoader
 {
     public:
@@ -85,10 +90,20 @@ class DBCFileLoader
         uint32 GetOffset(size_t id) const { return (fieldsOffset != NULL && id < fieldCount) ? fieldsOffset[id] : 0; }
         bool IsLoaded() const { return data != NULL; }
         char* AutoProduceData(const char* fmt, uint32& count, char**& indexTable, uint32 sqlRecordCount, uint32 sqlHighestIndex, char *& sqlDataTable);
+        // Points the string fields of dataTable into the mapped string table and returns its start (an empty string).
+        // The mapping must be kept alive with ReleaseMapping() for as long as the strings are used.
         char* AutoProduceStrings(const char* fmt, char* dataTable);
+        // True if the records of the file have exactly the layout of the structure described by fmt,
+        // so they can be used in place without being copied
+        bool CanUseRecordsInPlace(const char* fmt) const;
+        // Builds the index table over the mapped records, only valid if CanUseRecordsInPlace()
+        char* AutoProduceIndex(const char* fmt, uint32& count, char**& indexTable);
+        // Hands over the ownership of the file mapping, it is not unmapped anymore when the loader is destroyed
+        ACE_Mem_Map* ReleaseMapping();
         static uint32 GetFormatRecordSize(const char * format, int32 * index_pos = NULL);
     private:
 
+        ACE_Mem_Map* mapping;
         uint32 recordSize;
         uint32 recordCount;
         uint32 fieldCount;
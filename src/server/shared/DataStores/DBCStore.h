@@ -26,6 +26,8 @@
 #include "Implementation/WorldDatabase.h"
 #include "DatabaseEnv.h"
 
+#include <ace/Mem_Map.h>
+
 struct SqlDbc
 {
     std::string const* formatString;
@@ -68,10 +70,10 @@ struct SqlDbc
 template<class T>
 class DBCStorage
 {
-    typedef std::list<char*> StringPoolList;
+    typedef std::list<ACE_Mem_Map*> MappingList;
     public:
         explicit DBCStorage(char const* f)
-            : fmt(f), nCount(0), fieldCount(0), dataTable(NULL)
+            : fmt(f), nCount(0), fieldCount(0), dataTable(NULL), ownsDataTable(false)
         {
             indexTable.asT = NULL;
         }
@@ -129,10 +131,22 @@ class DBCStorage
             char* sqlDataTable = NULL;
             fieldCount = dbc.GetCols();
 
+            // Stores without sql data and without strings are used directly from the mapped file
+            if (!sql && dbc.CanUseRecordsInPlace(fmt))
+            {
+                dataTable = reinterpret_cast<T*>(dbc.AutoProduceIndex(fmt, nCount, indexTable.asChar));
+                ownsDataTable = false;
+                mappingList.push_back(dbc.ReleaseMapping());
+                return indexTable.asT != NULL;
+            }
+
             dataTable = reinterpret_cast<T*>(dbc.AutoProduceData(fmt, nCount, indexTable.asChar,
                 sqlRecordCount, sqlHighestIndex, sqlDataTable));
+            ownsDataTable = true;
 
-            stringPoolList.push_back(dbc.AutoProduceStrings(fmt, reinterpret_cast<char*>(dataTable)));
+            // Strings are not copied, they point into the mapped file
+            char* stringTable = dbc.AutoProduceStrings(fmt, reinterpret_cast<char*>(dataTable));
+            mappingList.push_back(dbc.ReleaseMapping());
 
             // Insert sql data into arrays
             if (result)
@@ -188,7 +202,7 @@ class DBCStorage
                                         break;
                                     case FT_STRING:
                                         // Beginning of the pool - empty string
-                                        *reinterpret_cast<char**>(&sqlDataTable[offset]) = stringPoolList.back();
+                                        *reinterpret_cast<char**>(&sqlDataTable[offset]) = stringTable;
                                         offset += sizeof(char*);
                                         break;
                                 }
@@ -261,7 +275,8 @@ class DBCStorage
             if (!dbc.Load(fn, fmt))
                 return false;
 
-            stringPoolList.push_back(dbc.AutoProduceStrings(fmt, reinterpret_cast<char*>(dataTable)));
+            dbc.AutoProduceStrings(fmt, reinterpret_cast<char*>(dataTable));
+            mappingList.push_back(dbc.ReleaseMapping());
 
             return true;
         }
@@ -273,13 +288,15 @@ class DBCStorage
 
             delete[] reinterpret_cast<char*>(indexTable.asT);
             indexTable.asT = NULL;
-            delete[] reinterpret_cast<char*>(dataTable);
+            if (ownsDataTable)
+                delete[] reinterpret_cast<char*>(dataTable);
             dataTable = NULL;
+            ownsDataTable = false;
 
-            while (!stringPoolList.empty())
+            while (!mappingList.empty())
             {
-                delete[] stringPoolList.front();
-                stringPoolList.pop_front();
+                delete mappingList.front();
+                mappingList.pop_front();
             }
 
             nCount = 0;
@@ -298,7 +315,8 @@ class DBCStorage
         indexTable;
 
         T* dataTable;
-        StringPoolList stringPoolList;
+        bool ownsDataTable;                                 // false if dataTable points into a mapped file
+        MappingList mappingList;
 };
 
 #endif
@@ -34,6 +34,10 @@
 #define MIN_MYSQL_SERVER_VERSION 50100u
 #define MIN_MYSQL_CLIENT_VERSION 50100u
 
+//! Normal priority operations queued on a shard per placeholder of its low priority work queued among them,
+//! so low priority work keeps a minimum share of the connection under sustained normal load
+#define SQL_LOW_PRIORITY_SHARE   8
+
 class PingOperation : public SQLOperation
 {
     //! Operation for idle delaythreads
@@ -44,13 +48,49 @@ class PingOperation : public SQLOperation
     }
 };
 
+//! Placeholder of low priority work, executes the oldest low priority operation of its shard still waiting
+class LowPriorityOperation : public SQLOperation
+{
+    public:
+        explicit LowPriorityOperation(SQLLowPriorityQueue* queue) : m_queue(queue) {}
+
+        bool Execute()
+        {
+            //! Several placeholders may exist per operation, see DatabaseWorkerPool::EnqueueOrdered
+            SQLOperation* op = m_queue->Pop();
+            if (!op)
+                return true;
+
+            op->SetConnection(m_conn);
+            op->call();
+            delete op;
+            return true;
+        }
+
+    private:
+        SQLLowPriorityQueue* m_queue;
+};
+
+//! Point-in-time copy of the counters of one asynchronous queue shard
+struct SQLQueueSnapshot
+{
+    uint32 Depth;
+    uint32 MaxDepth;
+    uint32 Enqueued;
+    uint32 Executed;
+    uint32 Dropped;
+    uint32 Overflows;
+    uint32 AvgWaitTime;
+    uint32 MaxWaitTime;
+};
+
 template <class T>
 class DatabaseWorkerPool
 {
     public:
         /* Activity state */
         DatabaseWorkerPool() :
-        _queue(new ACE_Activation_Queue())
+        _queueLimit(0)
         {
             memset(_connectionCount, 0, sizeof(_connectionCount));
             _connections.resize(IDX_SIZE);
@@ -63,19 +103,31 @@ class DatabaseWorkerPool
         {
         }
 
-        bool Open(const std::string& infoString, uint8 async_threads, uint8 synch_threads)
+        bool Open(const std::string& infoString, uint8 async_threads, uint8 synch_threads, uint32 queue_limit = 0)
         {
             bool res = true;
             _connectionInfo = MySQLConnectionInfo(infoString);
+            _queueLimit = queue_limit;
 
             sLog->outInfo(LOG_FILTER_SQL_DRIVER, "Opening DatabasePool '%s'. Asynchronous connections: %u, synchronous connections: %u.",
                 GetDatabaseName(), async_threads, synch_threads);
 
+            //! Every asynchronous connection has a queue shard of its own, so a shard executes its operations
+            //! in order and SQLOperationFence only has to order the shards against each other
+            _shards.resize(async_threads);
+            for (uint8 i = 0; i < async_threads; ++i)
+            {
+                _shards[i].Queue = new ACE_Activation_Queue();
+                _shards[i].LowPriority = new SQLLowPriorityQueue();
+                _shards[i].NormalSinceLow = 0;
+                _shards[i].Saturated = 0;
+            }
+
             //! Open asynchronous connections (delayed operations)
             _connections[IDX_ASYNC].resize(async_threads);
             for (uint8 i = 0; i < async_threads; ++i)
             {
-                T* t = new T(_queue, _connectionInfo);
+                T* t = new T(_shards[i].Queue, _connectionInfo);
                 res &= t->Open();
                 if (res) // only check mysql version if connection is valid
                     WPFatal(mysql_get_server_version(t->GetHandle()) >= MIN_MYSQL_SERVER_VERSION, "TrinityCore does not support MySQL versions below 5.1");
@@ -109,7 +161,10 @@ class DatabaseWorkerPool
             //! Shuts down delaythreads for this connection pool by underlying deactivate().
             //! The next dequeue attempt in the worker thread tasks will result in an error,
             //! ultimately ending the worker thread task.
-            _queue->queue()->close();
+            //! Operations waiting for earlier ones that are discarded with their queue must not block the shutdown.
+            _fence.Cancel();
+            for (size_t i = 0; i < _shards.size(); ++i)
+                _shards[i].Queue->queue()->close();
 
             for (uint8 i = 0; i < _connectionCount[IDX_ASYNC]; ++i)
             {
@@ -130,8 +185,13 @@ class DatabaseWorkerPool
             for (uint8 i = 0; i < _connectionCount[IDX_SYNCH]; ++i)
                 _connections[IDX_SYNCH][i]->Close();
 
-            //! Deletes the ACE_Activation_Queue object and its underlying ACE_Message_Queue
-            delete _queue;
+            //! Deletes the ACE_Activation_Queue objects and their underlying ACE_Message_Queue
+            for (size_t i = 0; i < _shards.size(); ++i)
+            {
+                delete _shards[i].Queue;
+                delete _shards[i].LowPriority;
+            }
+            _shards.clear();
 
             sLog->outInfo(LOG_FILTER_SQL_DRIVER, "All connections on DatabasePool '%s' closed.", GetDatabaseName());
         }
@@ -169,10 +229,14 @@ class DatabaseWorkerPool
 
         //! Enqueues a one-way SQL operation in prepared statement format that will be executed asynchronously.
         //! Statement must be prepared with CONNECTION_ASYNC flag.
-        void Execute(PreparedStatement* stmt)
+        //! Statements enqueued with SQL_PRIORITY_LOW are executed after most pending normal work, in no order
+        //! with it, and are dropped when the queue is above its configured limit.
+        //! A non-zero shardKey (the account id) routes the statement to the queue shard owning that key. Keyed
+        //! statements may overtake earlier ones of other accounts, everything else keeps the enqueue order.
+        void Execute(PreparedStatement* stmt, SQLOperationPriority priority = SQL_PRIORITY_NORMAL, uint32 shardKey = 0)
         {
             PreparedStatementTask* task = new PreparedStatementTask(stmt);
-            Enqueue(task);
+            Enqueue(task, priority, shardKey);
         }
 
         /**
@@ -334,12 +398,29 @@ class DatabaseWorkerPool
         //! return object as soon as the query is executed.
         //! The return value is then processed in ProcessQueryCallback methods.
         //! Any prepared statements added to this holder need to be prepared with the CONNECTION_ASYNC flag.
-        QueryResultHolderFuture DelayQueryHolder(SQLQueryHolder* holder)
+        //! A non-zero shardKey (the account id) routes the holder to the queue shard owning that key.
+        //! With parallelism > 1 the queries of the holder are split into that many parts, which are queued on
+        //! consecutive shards and run concurrently. Capped at the asynchronous connections. All parts still wait
+        //! for the earlier operations of the key, e.g. a pending save of the account.
+        QueryResultHolderFuture DelayQueryHolder(SQLQueryHolder* holder, uint32 shardKey = 0, uint8 parallelism = 1)
         {
             QueryResultHolderFuture res;
-            SQLQueryHolderTask* task = new SQLQueryHolderTask(holder, res);
-            Enqueue(task);
-            return res;     //! Fool compiler, has no use yet
+
+            uint32 parts = std::min<uint32>(parallelism, uint32(_shards.size()));
+            parts = std::min<uint32>(parts, uint32(holder->GetSize()));
+            if (parts <= 1)
+            {
+                Enqueue(new SQLQueryHolderTask(holder, res), SQL_PRIORITY_NORMAL, shardKey);
+                return res;     //! Fool compiler, has no use yet
+            }
+
+            SQLQueryHolderParts* pendingParts = new SQLQueryHolderParts(long(parts));
+            std::vector<SQLOperation*> tasks(parts);
+            for (uint32 i = 0; i < parts; ++i)
+                tasks[i] = new SQLQueryHolderTask(holder, res, i, parts, pendingParts);
+
+            EnqueueOrdered(&tasks[0], parts, shardKey);
+            return res;
         }
 
         /**
@@ -354,7 +435,9 @@ class DatabaseWorkerPool
 
         //! Enqueues a collection of one-way SQL operations (can be both adhoc and prepared). The order in which these operations
         //! were appended to the transaction will be respected during execution.
-        void CommitTransaction(SQLTransaction transaction)
+        //! A non-zero shardKey (the account id) routes the transaction to the queue shard owning that key.
+        //! Transactions committed with SQL_PRIORITY_LOW are dropped like low priority statements.
+        void CommitTransaction(SQLTransaction transaction, uint32 shardKey = 0, SQLOperationPriority priority = SQL_PRIORITY_NORMAL)
         {
             #ifdef TRINITY_DEBUG
             //! Only analyze transaction weaknesses in Debug mode.
@@ -373,7 +456,7 @@ class DatabaseWorkerPool
             }
             #endif // TRINITY_DEBUG
 
-            Enqueue(new TransactionTask(transaction));
+            Enqueue(new TransactionTask(transaction), priority, shardKey);
         }
 
         //! Directly executes a collection of one-way SQL operations (can be both adhoc and prepared). The order in which these operations
@@ -463,14 +546,44 @@ class DatabaseWorkerPool
                 }
             }
 
-            //! Assuming all worker threads are free, every worker thread will receive 1 ping operation request
-            //! If one or more worker threads are busy, the ping operations will not be split evenly, but this doesn't matter
-            //! as the sole purpose is to prevent connections from idling.
-            for (size_t i = 0; i < _connections[IDX_ASYNC].size(); ++i)
-                Enqueue(new PingOperation);
+            //! Every asynchronous connection has a queue shard of its own and receives 1 ping operation request.
+            //! Pings touch no data, they are not ordered with the other operations.
+            for (size_t i = 0; i < _shards.size(); ++i)
+                Push(_shards[i], new PingOperation, SQL_PRIORITY_NORMAL);
+        }
+
+        //! Number of asynchronous queue shards of this pool
+        uint8 GetQueueShardCount() const
+        {
+            return uint8(_shards.size());
+        }
+
+        //! Copies the current counters of the given queue shard
+        void GetQueueSnapshot(uint8 shard, SQLQueueSnapshot& snapshot) const
+        {
+            memset(&snapshot, 0, sizeof(snapshot));
+            if (shard >= _shards.size())
+                return;
+
+            QueueShard const& queue = _shards[shard];
+            snapshot.Depth = uint32(queue.Queue->queue()->message_count());
+            snapshot.MaxDepth = queue.Stats.MaxDepth.value();
+            snapshot.Enqueued = queue.Stats.Enqueued.value();
+            snapshot.Executed = queue.Stats.Executed.value();
+            snapshot.Dropped = queue.Stats.Dropped.value();
+            snapshot.Overflows = queue.Stats.Overflows.value();
+            snapshot.AvgWaitTime = snapshot.Executed ? uint32(queue.Stats.TotalWaitTime.value() / snapshot.Executed) : 0;
+            snapshot.MaxWaitTime = queue.Stats.MaxWaitTime.value();
+        }
+
+        char const* GetDatabaseName() const
+        {
+            return _connectionInfo.database.c_str();
         }
 
     private:
+        struct QueueShard;
+
         unsigned long EscapeString(char *to, const char *from, unsigned long length)
         {
             if (!to || !from || !length)
@@ -479,9 +592,93 @@ class DatabaseWorkerPool
             return mysql_real_escape_string(_connections[IDX_SYNCH][0]->GetHandle(), to, from, length);
         }
 
-        void Enqueue(SQLOperation* op)
+        //! Operations without a shard key always go to the first shard, keyed ones to the shard owning the key.
+        void Enqueue(SQLOperation* op, SQLOperationPriority priority = SQL_PRIORITY_NORMAL, uint32 shardKey = 0)
+        {
+            if (priority != SQL_PRIORITY_LOW)
+            {
+                EnqueueOrdered(&op, 1, shardKey);
+                return;
+            }
+
+            QueueShard& shard = _shards[shardKey % _shards.size()];
+            if (!CheckQueueLimit(shard, priority))
+            {
+                delete op;
+                return;
+            }
+
+            ++shard.Stats.Enqueued;
+            op->SetQueueStatistics(&shard.Stats);
+            shard.LowPriority->Push(op);
+            Push(shard, new LowPriorityOperation(shard.LowPriority), SQL_PRIORITY_LOW);
+        }
+
+        //! Queues normal priority operations sharing one place in the order of the pool, the i-th one on the shard
+        //! following the shard of the key i times. See SQLOperationFence.
+        void EnqueueOrdered(SQLOperation* const* ops, uint32 count, uint32 shardKey)
+        {
+            //! The queues of the shards must receive their operations in ticket order
+            TRINITY_GUARD(ACE_Thread_Mutex, _enqueueLock);
+
+            //! A single connection executes everything in enqueue order anyway
+            uint64 ticket = _shards.size() > 1 ? _fence.Register(shardKey, count) : 0;
+            for (uint32 i = 0; i < count; ++i)
+            {
+                QueueShard& shard = _shards[(shardKey + i) % _shards.size()];
+                CheckQueueLimit(shard, SQL_PRIORITY_NORMAL);
+
+                ++shard.Stats.Enqueued;
+                ops[i]->SetQueueStatistics(&shard.Stats);
+                if (ticket)
+                    ops[i]->SetFence(&_fence, ticket, shardKey);
+                Push(shard, ops[i], SQL_PRIORITY_NORMAL);
+
+                if (++shard.NormalSinceLow >= SQL_LOW_PRIORITY_SHARE)
+                {
+                    shard.NormalSinceLow = 0;
+                    if (!shard.LowPriority->Empty())
+                        Push(shard, new LowPriorityOperation(shard.LowPriority), SQL_PRIORITY_NORMAL);
+                }
+            }
+        }
+
+        //! Returns false if the operation must be dropped
+        bool CheckQueueLimit(QueueShard& shard, SQLOperationPriority priority)
+        {
+            uint32 depth = uint32(shard.Queue->queue()->message_count());
+
+            if (_queueLimit && depth >= _queueLimit)
+            {
+                //! Only the thread that saturated the shard reports it
+                if (!shard.Saturated.value() && ++shard.Saturated == 1)
+                {
+                    sLog->outWarn(LOG_FILTER_SQL_DRIVER, "DatabasePool '%s': asynchronous queue shard %u reached its limit of %u pending operations.",
+                        GetDatabaseName(), uint32(&shard - &_shards[0]), _queueLimit);
+                }
+
+                //! Low priority work is expendable, everything else is accepted and accounted for
+                if (priority == SQL_PRIORITY_LOW)
+                {
+                    ++shard.Stats.Dropped;
+                    return false;
+                }
+
+                ++shard.Stats.Overflows;
+            }
+            else if (shard.Saturated.value() && depth < _queueLimit / 2)
+                shard.Saturated = 0;
+
+            if (depth + 1 > shard.Stats.MaxDepth.value())
+                shard.Stats.MaxDepth = depth + 1;
+
+            return true;
+        }
+
+        static void Push(QueueShard& shard, SQLOperation* op, SQLOperationPriority priority)
         {
-            _queue->enqueue(op);
+            op->priority(priority);
+            shard.Queue->enqueue(op);
         }
 
         //! Gets a free connection in the synchronous connection pool.
@@ -503,11 +700,6 @@ class DatabaseWorkerPool
             return t;
         }
 
-        char const* GetDatabaseName() const
-        {
-            return _connectionInfo.database.c_str();
-        }
-
     private:
         enum _internalIndex
         {
@@ -516,7 +708,20 @@ class DatabaseWorkerPool
             IDX_SIZE
         };
 
-        ACE_Activation_Queue*           _queue;             //! Queue shared by async worker threads.
+        struct QueueShard
+        {
+            ACE_Activation_Queue*       Queue;              //! Queue of the async connection of this shard.
+            SQLLowPriorityQueue*        LowPriority;        //! Low priority operations, run by placeholders in Queue.
+            uint32                      NormalSinceLow;     //! Normal operations queued since the last placeholder, under _enqueueLock.
+            SQLQueueStatistics          Stats;
+            //! Non-zero above the queue limit, cleared once drained to half of it. Set by the world and map threads alike.
+            ACE_Atomic_Op<ACE_Thread_Mutex, uint32> Saturated;
+        };
+
+        std::vector<QueueShard>         _shards;
+        uint32                          _queueLimit;        //! Pending operations per shard before backpressure applies, 0 = unbounded.
+        SQLOperationFence               _fence;
+        ACE_Thread_Mutex                _enqueueLock;
         std::vector< std::vector<T*> >  _connections;
         uint32                          _connectionCount[2];       //! Counter of MySQL connections;
         MySQLConnectionInfo             _connectionInfo;
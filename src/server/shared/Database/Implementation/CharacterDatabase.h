@@ -123,7 +123,6 @@ enum CharacterDatabaseStatements
     CHAR_SEL_AUCTION_ITEMS,
     CHAR_INS_AUCTION,
     CHAR_DEL_AUCTION,
-    CHAR_SEL_AUCTION_BY_TIME,
     CHAR_UPD_AUCTION_BID,
     CHAR_SEL_AUCTIONS,
     CHAR_INS_MAIL,
@@ -177,18 +176,23 @@ enum CharacterDatabaseStatements
     CHAR_INS_GUILD_BANK_ITEM,
     CHAR_DEL_GUILD_BANK_ITEM,
     CHAR_DEL_GUILD_BANK_ITEMS,
+    CHAR_SEL_GUILD_BANK_TAB_ITEMS,
     CHAR_INS_GUILD_BANK_RIGHT,
     CHAR_DEL_GUILD_BANK_RIGHTS,
     CHAR_DEL_GUILD_BANK_RIGHTS_FOR_RANK,
     CHAR_INS_GUILD_BANK_EVENTLOG,
     CHAR_DEL_GUILD_BANK_EVENTLOG,
     CHAR_DEL_GUILD_BANK_EVENTLOGS,
+    CHAR_SEL_GUILD_BANK_EVENTLOGS,
     CHAR_INS_GUILD_EVENTLOG,
     CHAR_DEL_GUILD_EVENTLOG,
     CHAR_DEL_GUILD_EVENTLOGS,
+    CHAR_SEL_GUILD_EVENTLOGS,
     CHAR_UPD_GUILD_MEMBER_PNOTE,
     CHAR_UPD_GUILD_MEMBER_OFFNOTE,
     CHAR_UPD_GUILD_MEMBER_RANK,
+    CHAR_UPD_GUILD_MEMBER_WEEK_REPUTATION,
+    CHAR_UPD_GUILD_MEMBER_PROFESSIONS,
     CHAR_UPD_GUILD_MOTD,
     CHAR_UPD_GUILD_INFO,
     CHAR_UPD_GUILD_LEADER,
@@ -175,7 +175,8 @@ bool SQLQueryHolderTask::Execute()
     /// we can do this, we are friends
     std::vector<SQLQueryHolder::SQLResultPair> &queries = m_holder->m_queries;
 
-    for (size_t i = 0; i < queries.size(); i++)
+    /// every part only touches its own elements of the (already sized) vector, so no locking is needed
+    for (size_t i = m_offset; i < queries.size(); i += m_stride)
     {
         /// execute all queries in the holder and pass the results
         if (SQLElementData* data = &queries[i].first)
@@ -200,6 +201,15 @@ bool SQLQueryHolderTask::Execute()
         }
     }
 
+    if (m_pendingParts)
+    {
+        /// other parts of the holder are still running on other connections
+        if (--(*m_pendingParts) > 0)
+            return true;
+
+        delete m_pendingParts;
+    }
+
     m_result.set(m_holder);
     return true;
 }
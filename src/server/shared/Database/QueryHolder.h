@@ -19,6 +19,7 @@
 #define _QUERYHOLDER_H
 
 #include <ace/Future.h>
+#include <ace/Atomic_Op.h>
 
 class SQLQueryHolder
 {
@@ -33,6 +34,7 @@ class SQLQueryHolder
         bool SetPQuery(size_t index, const char *format, ...) ATTR_PRINTF(3, 4);
         bool SetPreparedQuery(size_t index, PreparedStatement* stmt);
         void SetSize(size_t size);
+        size_t GetSize() const { return m_queries.size(); }
         QueryResult GetResult(size_t index);
         PreparedQueryResult GetPreparedResult(size_t index);
         void SetResult(size_t index, ResultSet* result);
@@ -41,15 +43,26 @@ class SQLQueryHolder
 
 typedef ACE_Future<SQLQueryHolder*> QueryResultHolderFuture;
 
+//- Amount of unfinished parts of a holder that is executed by several connections at once
+typedef ACE_Atomic_Op<ACE_Thread_Mutex, long> SQLQueryHolderParts;
+
 class SQLQueryHolderTask : public SQLOperation
 {
     private:
         SQLQueryHolder * m_holder;
         QueryResultHolderFuture m_result;
+        size_t m_offset;                        //- First query executed by this task
+        size_t m_stride;                        //- Distance between the queries executed by this task
+        SQLQueryHolderParts* m_pendingParts;    //- Shared by all parts of the holder, NULL if not split
 
     public:
         SQLQueryHolderTask(SQLQueryHolder *holder, QueryResultHolderFuture res)
-            : m_holder(holder), m_result(res){};
+            : m_holder(holder), m_result(res), m_offset(0), m_stride(1), m_pendingParts(NULL) {};
+
+        //- Executes every stride-th query of the holder, starting at offset. The part finishing
+        //- last sets the result of the future.
+        SQLQueryHolderTask(SQLQueryHolder *holder, QueryResultHolderFuture res, size_t offset, size_t stride, SQLQueryHolderParts* pendingParts)
+            : m_holder(holder), m_result(res), m_offset(offset), m_stride(stride), m_pendingParts(pendingParts) {};
         bool Execute();
 
 };
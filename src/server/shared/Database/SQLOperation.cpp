@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2008-2013 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "DatabaseEnv.h"
+#include "SQLOperation.h"
+
+uint64 SQLOperationFence::Register(uint32 key, uint32 operations)
+{
+    TRINITY_GUARD(ACE_Thread_Mutex, _lock);
+
+    uint64 ticket = _nextTicket++;
+    _pending[ticket] = operations;
+    if (key)
+        _keyed[key][ticket] = operations;
+    else
+        _unkeyed[ticket] = operations;
+
+    return ticket;
+}
+
+void SQLOperationFence::Wait(uint64 ticket, uint32 key)
+{
+    TRINITY_GUARD(ACE_Thread_Mutex, _lock);
+
+    while (!_cancelled)
+    {
+        //! The earliest tickets of the queues of the connections are never waiting themselves,
+        //! so the oldest unfinished ticket can always run
+        if (!key)
+        {
+            if (_pending.begin()->first == ticket)
+                return;
+        }
+        else if ((_unkeyed.empty() || _unkeyed.begin()->first > ticket) && _keyed[key].begin()->first == ticket)
+            return;
+
+        _condition.wait();
+    }
+}
+
+void SQLOperationFence::Release(uint64 ticket, uint32 key)
+{
+    TRINITY_GUARD(ACE_Thread_Mutex, _lock);
+
+    Remove(_pending, ticket);
+    if (!key)
+        Remove(_unkeyed, ticket);
+    else
+    {
+        UNORDERED_MAP<uint32, TicketMap>::iterator itr = _keyed.find(key);
+        Remove(itr->second, ticket);
+        if (itr->second.empty())
+            _keyed.erase(itr);
+    }
+
+    _condition.broadcast();
+}
+
+void SQLOperationFence::Cancel()
+{
+    TRINITY_GUARD(ACE_Thread_Mutex, _lock);
+
+    _cancelled = true;
+    _condition.broadcast();
+}
+
+void SQLOperationFence::Remove(TicketMap& tickets, uint64 ticket)
+{
+    TicketMap::iterator itr = tickets.find(ticket);
+    if (!--itr->second)
+        tickets.erase(itr);
+}
+
+void SQLLowPriorityQueue::Push(SQLOperation* op)
+{
+    TRINITY_GUARD(ACE_Thread_Mutex, _lock);
+    _operations.push_back(op);
+}
+
+SQLOperation* SQLLowPriorityQueue::Pop()
+{
+    TRINITY_GUARD(ACE_Thread_Mutex, _lock);
+    if (_operations.empty())
+        return NULL;
+
+    SQLOperation* op = _operations.front();
+    _operations.pop_front();
+    return op;
+}
+
+bool SQLLowPriorityQueue::Empty()
+{
+    TRINITY_GUARD(ACE_Thread_Mutex, _lock);
+    return _operations.empty();
+}
+
+void SQLLowPriorityQueue::Clear()
+{
+    TRINITY_GUARD(ACE_Thread_Mutex, _lock);
+    for (std::deque<SQLOperation*>::const_iterator itr = _operations.begin(); itr != _operations.end(); ++itr)
+        delete *itr;
+    _operations.clear();
+}
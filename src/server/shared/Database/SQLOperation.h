@@ -20,8 +20,16 @@
 
 #include <ace/Method_Request.h>
 #include <ace/Activation_Queue.h>
+#include <ace/Atomic_Op.h>
+#include <ace/Condition_Thread_Mutex.h>
+#include <ace/Thread_Mutex.h>
+#include <deque>
+#include <map>
+
+#include "UnorderedMap.h"
 
 #include "QueryResult.h"
+#include "Timer.h"
 
 //- Forward declare (don't include header to prevent circular includes)
 class PreparedStatement;
@@ -54,21 +62,132 @@ union SQLResultSetUnion
     ResultSet* qresult;
 };
 
+//- Queue priority of an asynchronous operation. Operations of a higher priority
+//- are dequeued first, operations of equal priority keep their enqueue order.
+enum SQLOperationPriority
+{
+    SQL_PRIORITY_LOW    = 0,    // Logs and statistics, may be dropped when the queue is saturated
+    SQL_PRIORITY_NORMAL = 1,
+    MAX_SQL_PRIORITY
+};
+
+//- Counters of one asynchronous queue shard, shared between the enqueueing threads and the worker threads
+struct SQLQueueStatistics
+{
+    SQLQueueStatistics() : Enqueued(0), Executed(0), Dropped(0), Overflows(0), MaxDepth(0), TotalWaitTime(0), MaxWaitTime(0) {}
+
+    ACE_Atomic_Op<ACE_Thread_Mutex, uint32> Enqueued;       // Operations accepted by the queue
+    ACE_Atomic_Op<ACE_Thread_Mutex, uint32> Executed;       // Operations picked up by a worker
+    ACE_Atomic_Op<ACE_Thread_Mutex, uint32> Dropped;        // Low priority operations rejected because of the queue limit
+    ACE_Atomic_Op<ACE_Thread_Mutex, uint32> Overflows;      // Operations accepted while the queue was above its limit
+    ACE_Atomic_Op<ACE_Thread_Mutex, uint32> MaxDepth;
+    ACE_Atomic_Op<ACE_Thread_Mutex, uint64> TotalWaitTime;  // Milliseconds spent in the queue, summed over all executed operations
+    ACE_Atomic_Op<ACE_Thread_Mutex, uint32> MaxWaitTime;
+};
+
+//- Keeps the asynchronous operations of a pool in enqueue order where they may touch the same rows,
+//- although they are served by different connections. Every ordered operation takes a ticket when it is
+//- enqueued and is only executed once the earlier operations it conflicts with have finished: operations
+//- with a key (the account id) conflict with earlier ones of the same key and with every unkeyed one,
+//- unkeyed operations with everything. Operations sharing a ticket (parts of one query holder) run together.
+class SQLOperationFence
+{
+    public:
+        SQLOperationFence() : _condition(_lock), _nextTicket(1), _cancelled(false) {}
+
+        //- Tickets must be taken in the order the operations are put into the queues of the connections
+        uint64 Register(uint32 key, uint32 operations = 1);
+        void Wait(uint64 ticket, uint32 key);
+        void Release(uint64 ticket, uint32 key);
+
+        //- Lets waiting operations run unordered, queued operations are discarded when the pool closes
+        void Cancel();
+
+    private:
+        typedef std::map<uint64, uint32> TicketMap;         // ticket -> unfinished operations holding it
+
+        static void Remove(TicketMap& tickets, uint64 ticket);
+
+        ACE_Thread_Mutex _lock;
+        ACE_Condition_Thread_Mutex _condition;
+        uint64 _nextTicket;
+        bool _cancelled;
+        TicketMap _pending;
+        TicketMap _unkeyed;
+        UNORDERED_MAP<uint32, TicketMap> _keyed;
+};
+
+class SQLOperation;
+
+//- Low priority operations of a queue shard in enqueue order. They are not put into the activation queue
+//- themselves: a placeholder is, and whichever placeholder runs first executes the oldest operation.
+class SQLLowPriorityQueue
+{
+    public:
+        ~SQLLowPriorityQueue() { Clear(); }
+
+        void Push(SQLOperation* op);
+        SQLOperation* Pop();
+        bool Empty();
+        void Clear();
+
+    private:
+        ACE_Thread_Mutex _lock;
+        std::deque<SQLOperation*> _operations;
+};
+
 class MySQLConnection;
 
 class SQLOperation : public ACE_Method_Request
 {
     public:
-        SQLOperation(): m_conn(NULL) {}
+        SQLOperation(): m_conn(NULL), m_queueStats(NULL), m_enqueueTime(0), m_fence(NULL), m_ticket(0), m_fenceKey(0) {}
         virtual int call()
         {
+            if (m_queueStats)
+            {
+                uint32 waitTime = getMSTimeDiff(m_enqueueTime, getMSTime());
+                ++m_queueStats->Executed;
+                m_queueStats->TotalWaitTime += waitTime;
+                if (waitTime > m_queueStats->MaxWaitTime.value())
+                    m_queueStats->MaxWaitTime = waitTime;
+            }
+
+            if (m_fence)
+                m_fence->Wait(m_ticket, m_fenceKey);
+
             Execute();
+
+            if (m_fence)
+                m_fence->Release(m_ticket, m_fenceKey);
             return 0;
         }
         virtual bool Execute() = 0;
         virtual void SetConnection(MySQLConnection* con) { m_conn = con; }
 
+        //! Called by the pool right before the operation is put into a queue
+        void SetQueueStatistics(SQLQueueStatistics* stats)
+        {
+            m_queueStats = stats;
+            m_enqueueTime = getMSTime();
+        }
+
+        //! Called by the pool of several connections, see SQLOperationFence
+        void SetFence(SQLOperationFence* fence, uint64 ticket, uint32 key)
+        {
+            m_fence = fence;
+            m_ticket = ticket;
+            m_fenceKey = key;
+        }
+
         MySQLConnection* m_conn;
+
+    private:
+        SQLQueueStatistics* m_queueStats;
+        uint32 m_enqueueTime;
+        SQLOperationFence* m_fence;
+        uint64 m_ticket;
+        uint32 m_fenceKey;
 };
 
 #endif
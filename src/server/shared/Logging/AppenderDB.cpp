@@ -45,7 +45,7 @@ void AppenderDB::_write(LogMessage const& message)
             stmt->setUInt8(2, uint8(message.type));
             stmt->setUInt8(3, uint8(message.level));
             stmt->setString(4, message.text);
-            LoginDatabase.Execute(stmt);
+            LoginDatabase.Execute(stmt, SQL_PRIORITY_LOW);
             break;
     }
 }
@@ -20,27 +20,89 @@
 
 #include <ace/Future.h>
 #include <ace/Future_Set.h>
+#include <ace/Atomic_Op.h>
 #include "QueryResult.h"
+#include "LockedQueue.h"
 
 typedef ACE_Future<QueryResult> QueryResultFuture;
 typedef ACE_Future<PreparedQueryResult> PreparedQueryResultFuture;
 
+/*! Queue of callback ids whose futures were set by a database worker thread.
+    The worker thread pushes the id of a callback as soon as its result is available, so the owner
+    only has to handle the callbacks that actually completed instead of polling every pending future.
+*/
+class QueryCompletionQueue
+{
+    public:
+        QueryCompletionQueue() : _size(0) {}
+
+        //! Called from the worker thread that set the future
+        void Push(uint32 callbackId)
+        {
+            _queue.add(callbackId);
+            ++_size;
+        }
+
+        //! Lockless check for the owner thread, the common case is that nothing completed
+        bool IsEmpty() const
+        {
+            return _size.value() == 0;
+        }
+
+        bool Next(uint32& callbackId)
+        {
+            if (!_queue.next(callbackId))
+                return false;
+
+            --_size;
+            return true;
+        }
+
+    private:
+        ACE_Based::LockedQueue<uint32, ACE_Thread_Mutex> _queue;
+        ACE_Atomic_Op<ACE_Thread_Mutex, long> _size;
+};
+
 /*! A simple template using ACE_Future to manage callbacks from the thread and object that
     issued the request. <ParamType> is variable type of parameter that is used as parameter
     for the callback function.
+    When bound to a QueryCompletionQueue the callback observes its future and reports its id to the
+    queue once the result is set. The queue must outlive the callback.
 */
 #define CALLBACK_STAGE_INVALID uint8(-1)
 
 template <typename Result, typename ParamType, bool chain = false>
-class QueryCallback
+class QueryCallback : public ACE_Future_Observer<Result>
 {
     public:
-        QueryCallback() : _stage(chain ? 0 : CALLBACK_STAGE_INVALID)  {}
+        QueryCallback() : _stage(chain ? 0 : CALLBACK_STAGE_INVALID), _completions(NULL), _completionId(0) {}
+
+        ~QueryCallback()
+        {
+            //! The worker thread must not report to us anymore once we are gone
+            _result.detach(this);
+        }
+
+        //! Reports the given id to the queue each time a future of this callback gets its result
+        void SetCompletionQueue(QueryCompletionQueue* queue, uint32 callbackId)
+        {
+            _completions = queue;
+            _completionId = callbackId;
+        }
 
         //! The parameter of this function should be a resultset returned from either .AsyncQuery or .AsyncPQuery
         void SetFutureResult(ACE_Future<Result> value)
         {
+            _result.detach(this);
             _result = value;
+            if (_completions)
+                _result.attach(this);
+        }
+
+        //! Inherited from ACE_Future_Observer, called by the thread that set the result
+        void update(ACE_Future<Result> const& /*future*/)
+        {
+            _completions->Push(_completionId);
         }
 
         ACE_Future<Result> GetFutureResult()
@@ -60,6 +122,7 @@ class QueryCallback
 
         void FreeResult()
         {
+            _result.detach(this);
             _result.cancel();
         }
 
@@ -109,18 +172,42 @@ class QueryCallback
         ACE_Future<Result> _result;
         ParamType _param;
         uint8 _stage;
+        QueryCompletionQueue* _completions;
+        uint32 _completionId;
 };
 
 template <typename Result, typename ParamType1, typename ParamType2, bool chain = false>
-class QueryCallback_2
+class QueryCallback_2 : public ACE_Future_Observer<Result>
 {
     public:
-        QueryCallback_2() : _stage(chain ? 0 : CALLBACK_STAGE_INVALID) {}
+        QueryCallback_2() : _stage(chain ? 0 : CALLBACK_STAGE_INVALID), _completions(NULL), _completionId(0) {}
+
+        ~QueryCallback_2()
+        {
+            //! The worker thread must not report to us anymore once we are gone
+            _result.detach(this);
+        }
+
+        //! Reports the given id to the queue each time a future of this callback gets its result
+        void SetCompletionQueue(QueryCompletionQueue* queue, uint32 callbackId)
+        {
+            _completions = queue;
+            _completionId = callbackId;
+        }
 
         //! The parameter of this function should be a resultset returned from either .AsyncQuery or .AsyncPQuery
         void SetFutureResult(ACE_Future<Result> value)
         {
+            _result.detach(this);
             _result = value;
+            if (_completions)
+                _result.attach(this);
+        }
+
+        //! Inherited from ACE_Future_Observer, called by the thread that set the result
+        void update(ACE_Future<Result> const& /*future*/)
+        {
+            _completions->Push(_completionId);
         }
 
         ACE_Future<Result> GetFutureResult()
@@ -140,6 +227,7 @@ class QueryCallback_2
 
         void FreeResult()
         {
+            _result.detach(this);
             _result.cancel();
         }
 
@@ -201,6 +289,8 @@ class QueryCallback_2
         ParamType1 _param_1;
         ParamType2 _param_2;
         uint8 _stage;
+        QueryCompletionQueue* _completions;
+        uint32 _completionId;
 };
 
 #endif
\ No newline at end of file
@@ -17,16 +17,61 @@
  */
 
 #include "EventProcessor.h"
+#include "ObjectPool.h"
+
+// size classes of the event pools, larger events come from the global heap
+template<size_t Size>
+struct EventBlock
+{
+    char Data[Size];
+};
+
+void* BasicEvent::operator new(size_t size)
+{
+    if (size <= 96)
+        return ObjectPool<EventBlock<96> >::Allocate(sizeof(EventBlock<96>));
+    if (size <= 128)
+        return ObjectPool<EventBlock<128> >::Allocate(sizeof(EventBlock<128>));
+    if (size <= 192)
+        return ObjectPool<EventBlock<192> >::Allocate(sizeof(EventBlock<192>));
+    if (size <= 256)
+        return ObjectPool<EventBlock<256> >::Allocate(sizeof(EventBlock<256>));
+
+    return ::operator new(size);
+}
+
+void BasicEvent::operator delete(void* ptr, size_t size)
+{
+    if (size <= 96)
+        ObjectPool<EventBlock<96> >::Deallocate(ptr, sizeof(EventBlock<96>));
+    else if (size <= 128)
+        ObjectPool<EventBlock<128> >::Deallocate(ptr, sizeof(EventBlock<128>));
+    else if (size <= 192)
+        ObjectPool<EventBlock<192> >::Deallocate(ptr, sizeof(EventBlock<192>));
+    else if (size <= 256)
+        ObjectPool<EventBlock<256> >::Deallocate(ptr, sizeof(EventBlock<256>));
+    else
+        ::operator delete(ptr);
+}
+
+void BasicEvent::OnExpire()
+{
+    m_processor->ExecuteEvent(this);
+}
 
 EventProcessor::EventProcessor()
 {
     m_time = 0;
+    m_events = NULL;
+    m_idleTime = 0;
+    m_updateTime = 0;
     m_aborting = false;
 }
 
 EventProcessor::~EventProcessor()
 {
     KillAllEvents(true);
+    ReleaseWheel();
 }
 
 void EventProcessor::Update(uint32 p_time)
@@ -34,28 +79,34 @@ void EventProcessor::Update(uint32 p_time)
     // update time
     m_time += p_time;
 
-    // main event loop
-    EventList::iterator i;
-    while (((i = m_events.begin()) != m_events.end()) && i->first <= m_time)
-    {
-        // get and remove event from queue
-        BasicEvent* Event = i->second;
-        m_events.erase(i);
+    if (!m_events)
+        return;
 
-        if (!Event->to_Abort)
-        {
-            if (Event->Execute(m_time, p_time))
-            {
-                // completely destroy event if it is not re-added
-                delete Event;
-            }
-        }
-        else
+    // main event loop, the wheel calls ExecuteEvent for every due event
+    m_updateTime = p_time;
+    m_events->Update(p_time);
+
+    if (m_events->GetSize())
+        m_idleTime = 0;
+    else if ((m_idleTime += p_time) >= EVENT_WHEEL_IDLE_TIME)
+        ReleaseWheel();
+}
+
+void EventProcessor::ExecuteEvent(BasicEvent* Event)
+{
+    if (!Event->to_Abort)
+    {
+        if (Event->Execute(m_time, m_updateTime))
         {
-            Event->Abort(m_time);
+            // completely destroy event if it is not re-added
             delete Event;
         }
     }
+    else
+    {
+        Event->Abort(m_time);
+        delete Event;
+    }
 }
 
 void EventProcessor::KillAllEvents(bool force)
@@ -63,33 +114,35 @@ void EventProcessor::KillAllEvents(bool force)
     // prevent event insertions
     m_aborting = true;
 
+    if (!m_events)
+        return;
+
+    std::vector<TimerWheelEntry*> events;
+    m_events->GetEntries(events);
+
     // first, abort all existing events
-    for (EventList::iterator i = m_events.begin(); i != m_events.end();)
+    for (std::vector<TimerWheelEntry*>::const_iterator i = events.begin(); i != events.end(); ++i)
     {
-        EventList::iterator i_old = i;
-        ++i;
-
-        i_old->second->to_Abort = true;
-        i_old->second->Abort(m_time);
-        if (force || i_old->second->IsDeletable())
-        {
-            delete i_old->second;
+        BasicEvent* Event = static_cast<BasicEvent*>(*i);
+        Event->to_Abort = true;
+        Event->Abort(m_time);
 
-            if (!force)                                      // need per-element cleanup
-                m_events.erase (i_old);
-        }
+        // deleted events unlink themselves from the wheel, the others are deleted when they are due
+        if (force || Event->IsDeletable())
+            delete Event;
     }
-
-    // fast clear event list (in force case)
-    if (force)
-        m_events.clear();
 }
 
 void EventProcessor::AddEvent(BasicEvent* Event, uint64 e_time, bool set_addtime)
 {
     if (set_addtime) Event->m_addTime = m_time;
     Event->m_execTime = e_time;
-    m_events.insert(std::pair<uint64, BasicEvent*>(e_time, Event));
+    Event->m_processor = this;
+
+    if (!m_events)
+        m_events = new (ObjectPool<TimerWheel>::Allocate(sizeof(TimerWheel))) TimerWheel(1, m_time);
+
+    m_events->ScheduleAt(Event, e_time);
 }
 
 uint64 EventProcessor::CalculateTime(uint64 t_offset) const
@@ -97,3 +150,13 @@ uint64 EventProcessor::CalculateTime(uint64 t_offset) const
     return(m_time + t_offset);
 }
 
+void EventProcessor::ReleaseWheel()
+{
+    if (!m_events)
+        return;
+
+    m_events->~TimerWheel();
+    ObjectPool<TimerWheel>::Deallocate(m_events, sizeof(TimerWheel));
+    m_events = NULL;
+    m_idleTime = 0;
+}
@@ -20,17 +20,27 @@
 #define __EVENTPROCESSOR_H
 
 #include "Define.h"
-
-#include <map>
+#include "TimerWheel.h"
 
 // Note. All times are in milliseconds here.
 
-class BasicEvent
+// a processor keeps its timer wheel for this long after its last event before giving it back to the pool
+#define EVENT_WHEEL_IDLE_TIME   10000
+
+class EventProcessor;
+
+class BasicEvent : private TimerWheelEntry
 {
+    friend class EventProcessor;
+
     public:
-        BasicEvent() { to_Abort = false; }
+        BasicEvent() : m_processor(NULL) { to_Abort = false; }
         virtual ~BasicEvent() {}                            // override destructor to perform some actions on event removal
 
+        // events are created all the time, they are allocated from pools of a few size classes
+        static void* operator new(size_t size);
+        static void operator delete(void* ptr, size_t size);
+
         // this method executes when the event is triggered
         // return false if event does not want to be deleted
         // e_time is execution time, p_time is update interval
@@ -46,12 +56,19 @@ class BasicEvent
         // these can be used for time offset control
         uint64 m_addTime;                                   // time when the event was added to queue, filled by event handler
         uint64 m_execTime;                                  // planned time of next execution, filled by event handler
-};
 
-typedef std::multimap<uint64, BasicEvent*> EventList;
+    private:
+        void OnExpire();
+
+        EventProcessor* m_processor;
+};
 
+// Events are kept in a timing wheel, scheduling and removing one is O(1) and an update only
+// visits the slots of the events that are due. The wheel is only allocated while there are events.
 class EventProcessor
 {
+    friend class BasicEvent;
+
     public:
         EventProcessor();
         ~EventProcessor();
@@ -60,9 +77,16 @@ class EventProcessor
         void KillAllEvents(bool force);
         void AddEvent(BasicEvent* Event, uint64 e_time, bool set_addtime = true);
         uint64 CalculateTime(uint64 t_offset) const;
+        uint32 GetEventCount() const { return m_events ? m_events->GetSize() : 0; }
     protected:
         uint64 m_time;
-        EventList m_events;
+        TimerWheel* m_events;
+        uint32 m_idleTime;
+        uint32 m_updateTime;                                // p_time of the running update
         bool m_aborting;
+
+    private:
+        void ExecuteEvent(BasicEvent* Event);
+        void ReleaseWheel();
 };
 #endif
@@ -0,0 +1,300 @@
+/*
+ * Copyright (C) 2008-2013 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_OBJECTPOOL_H
+#define TRINITY_OBJECTPOOL_H
+
+#include "Common.h"
+#include <ace/Atomic_Op.h>
+#include <ace/Guard_T.h>
+#include <ace/Singleton.h>
+#include <ace/Thread_Mutex.h>
+#include <ace/TSS_T.h>
+#include <algorithm>
+#include <new>
+#include <vector>
+
+#define OBJECT_POOL_SLAB_BLOCKS     64      // blocks requested from the system at once
+#define OBJECT_POOL_BATCH_BLOCKS    32      // blocks moved between a thread cache and the shared list at once
+#define OBJECT_POOL_CACHE_BLOCKS    128     // free blocks a thread keeps before giving a batch back
+
+/**
+ * Slab allocator for objects of type T, used by the class specific operator new/delete of
+ * frequently created game objects.
+ *
+ * Every thread (in practice every map update thread) keeps its own list of free blocks and its
+ * own counters so allocations and frees do not contend, the statistics sum the counters when
+ * asked. Threads exchange free blocks in batches with a shared list under a lock, and new
+ * blocks are carved from slabs of OBJECT_POOL_SLAB_BLOCKS.
+ * Slabs are only given back when the pool is destroyed: memory freed by one type is kept for
+ * that type, the pool only grows to the peak live count instead of fragmenting the general heap.
+ * Besides the shared instance used by operator new, private instances can be created to
+ * exercise the allocator without touching the memory of the live objects.
+ */
+template<class T>
+class ObjectPool
+{
+    friend class ACE_Singleton<ObjectPool<T>, ACE_Thread_Mutex>;
+
+    struct FreeBlock
+    {
+        FreeBlock* Next;
+    };
+
+    struct ThreadCache
+    {
+        ThreadCache() : Pool(NULL), Head(NULL), Count(0), Allocations(0), Deallocations(0) { }
+
+        // the free blocks of a thread that exits go back to the shared list
+        ~ThreadCache()
+        {
+            if (Pool)
+                Pool->Release(this);
+        }
+
+        ObjectPool* Pool;                                   // set by the first use, cleared when the pool goes first
+        FreeBlock* Head;
+        uint32 Count;
+        ACE_Atomic_Op<ACE_Thread_Mutex, long> Allocations;  // only changed by the own thread
+        ACE_Atomic_Op<ACE_Thread_Mutex, long> Deallocations;
+    };
+
+    public:
+        static size_t const BlockSize = (sizeof(T) > sizeof(FreeBlock) ? sizeof(T) + 15 : sizeof(FreeBlock) + 15) & ~size_t(15);
+
+        ObjectPool() : _sharedHead(NULL), _sharedCount(0), _slabs(0), _retiredAllocations(0), _retiredDeallocations(0) { }
+
+        // blocks still in use keep their slabs alive, the shared instance outlives most objects but not all
+        ~ObjectPool()
+        {
+            uint64 allocations, deallocations;
+            {
+                TRINITY_GUARD(ACE_Thread_Mutex, _lock);
+                SumCounters(allocations, deallocations);
+
+                // the caches of the threads still running are left to them
+                for (typename std::vector<ThreadCache*>::const_iterator itr = _caches.begin(); itr != _caches.end(); ++itr)
+                    (*itr)->Pool = NULL;
+                _caches.clear();
+            }
+
+            if (allocations != deallocations)
+                return;
+
+            for (std::vector<char*>::const_iterator itr = _slabList.begin(); itr != _slabList.end(); ++itr)
+                ::operator delete(*itr);
+        }
+
+        static ObjectPool* instance() { return ACE_Singleton<ObjectPool<T>, ACE_Thread_Mutex>::instance(); }
+
+        // Classes derived from T have another size, they are left to the global heap
+        static void* Allocate(size_t size)
+        {
+            if (size != sizeof(T))
+                return ::operator new(size);
+
+            return instance()->AllocateBlock();
+        }
+
+        static void Deallocate(void* ptr, size_t size)
+        {
+            if (!ptr)
+                return;
+
+            if (size != sizeof(T))
+            {
+                ::operator delete(ptr);
+                return;
+            }
+
+            instance()->DeallocateBlock(ptr);
+        }
+
+        uint32 GetLiveCount() const
+        {
+            TRINITY_GUARD(ACE_Thread_Mutex, _lock);
+            uint64 allocations, deallocations;
+            SumCounters(allocations, deallocations);
+            return uint32(allocations - deallocations);
+        }
+
+        uint64 GetAllocationCount() const
+        {
+            TRINITY_GUARD(ACE_Thread_Mutex, _lock);
+            uint64 allocations, deallocations;
+            SumCounters(allocations, deallocations);
+            return allocations;
+        }
+
+        uint32 GetSlabCount() const
+        {
+            TRINITY_GUARD(ACE_Thread_Mutex, _lock);
+            return _slabs;
+        }
+
+        // allocations served with recycled memory instead of blocks of new slabs
+        uint64 GetPoolHitCount() const
+        {
+            TRINITY_GUARD(ACE_Thread_Mutex, _lock);
+            uint64 allocations, deallocations;
+            SumCounters(allocations, deallocations);
+            uint64 fresh = uint64(_slabs) * OBJECT_POOL_SLAB_BLOCKS;
+            return allocations > fresh ? allocations - fresh : 0;
+        }
+
+        uint32 GetSharedFreeCount() const
+        {
+            TRINITY_GUARD(ACE_Thread_Mutex, _lock);
+            return _sharedCount;
+        }
+
+        void* AllocateBlock()
+        {
+            ThreadCache* cache = GetCache();
+            if (!cache->Head)
+                Refill(cache);
+
+            FreeBlock* block = cache->Head;
+            cache->Head = block->Next;
+            --cache->Count;
+
+            ++cache->Allocations;
+            return block;
+        }
+
+        void DeallocateBlock(void* ptr)
+        {
+            ThreadCache* cache = GetCache();
+            FreeBlock* block = static_cast<FreeBlock*>(ptr);
+            block->Next = cache->Head;
+            cache->Head = block;
+            ++cache->Deallocations;
+
+            if (++cache->Count > OBJECT_POOL_CACHE_BLOCKS)
+                Flush(cache);
+        }
+
+    private:
+        ThreadCache* GetCache()
+        {
+            ThreadCache* cache = _cache;
+            if (!cache->Pool)
+            {
+                TRINITY_GUARD(ACE_Thread_Mutex, _lock);
+                cache->Pool = this;
+                _caches.push_back(cache);
+            }
+
+            return cache;
+        }
+
+        // called with the thread cache of an exiting thread
+        void Release(ThreadCache* cache)
+        {
+            TRINITY_GUARD(ACE_Thread_Mutex, _lock);
+
+            while (FreeBlock* block = cache->Head)
+            {
+                cache->Head = block->Next;
+                block->Next = _sharedHead;
+                _sharedHead = block;
+                ++_sharedCount;
+            }
+            cache->Count = 0;
+
+            _retiredAllocations += cache->Allocations.value();
+            _retiredDeallocations += cache->Deallocations.value();
+            _caches.erase(std::find(_caches.begin(), _caches.end(), cache));
+            cache->Pool = NULL;
+        }
+
+        // a block freed by another thread than the one that allocated it only balances in the sum, _lock must be held
+        void SumCounters(uint64& allocations, uint64& deallocations) const
+        {
+            allocations = _retiredAllocations;
+            deallocations = _retiredDeallocations;
+            for (typename std::vector<ThreadCache*>::const_iterator itr = _caches.begin(); itr != _caches.end(); ++itr)
+            {
+                allocations += (*itr)->Allocations.value();
+                deallocations += (*itr)->Deallocations.value();
+            }
+        }
+
+        // takes a batch from the shared list, or a new slab if it is empty
+        void Refill(ThreadCache* cache)
+        {
+            TRINITY_GUARD(ACE_Thread_Mutex, _lock);
+
+            if (_sharedHead)
+            {
+                for (uint32 i = 0; i < OBJECT_POOL_BATCH_BLOCKS && _sharedHead; ++i)
+                {
+                    FreeBlock* block = _sharedHead;
+                    _sharedHead = block->Next;
+                    --_sharedCount;
+
+                    block->Next = cache->Head;
+                    cache->Head = block;
+                    ++cache->Count;
+                }
+                return;
+            }
+
+            char* slab = static_cast<char*>(::operator new(BlockSize * OBJECT_POOL_SLAB_BLOCKS));
+            for (uint32 i = 0; i < OBJECT_POOL_SLAB_BLOCKS; ++i)
+            {
+                FreeBlock* block = reinterpret_cast<FreeBlock*>(slab + i * BlockSize);
+                block->Next = cache->Head;
+                cache->Head = block;
+            }
+
+            cache->Count += OBJECT_POOL_SLAB_BLOCKS;
+            _slabList.push_back(slab);
+            ++_slabs;
+        }
+
+        // gives a batch back to the shared list so other threads can use it
+        void Flush(ThreadCache* cache)
+        {
+            TRINITY_GUARD(ACE_Thread_Mutex, _lock);
+
+            for (uint32 i = 0; i < OBJECT_POOL_BATCH_BLOCKS; ++i)
+            {
+                FreeBlock* block = cache->Head;
+                cache->Head = block->Next;
+                --cache->Count;
+
+                block->Next = _sharedHead;
+                _sharedHead = block;
+                ++_sharedCount;
+            }
+        }
+
+        ACE_TSS<ThreadCache> _cache;
+
+        mutable ACE_Thread_Mutex _lock;
+        FreeBlock* _sharedHead;
+        uint32 _sharedCount;
+        std::vector<char*> _slabList;
+        uint32 _slabs;
+
+        std::vector<ThreadCache*> _caches;                  // of the threads that used the pool
+        uint64 _retiredAllocations;                         // counters of the threads that exited
+        uint64 _retiredDeallocations;
+};
+
+#endif
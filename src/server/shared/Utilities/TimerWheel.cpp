@@ -0,0 +1,239 @@
+/*
+ * Copyright (C) 2008-2013 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TimerWheel.h"
+#include "Common.h"
+
+void TimerWheelEntry::Cancel()
+{
+    if (_wheel)
+        _wheel->Unlink(this);
+}
+
+TimerWheel::TimerWheel(uint32 resolution, uint64 time) : _resolution(resolution ? resolution : 1), _time(time), _tick(0),
+    _size(0), _expiredCount(0), _occupied(0), _due(NULL)
+{
+    _tick = _time / _resolution;
+}
+
+TimerWheel::~TimerWheel()
+{
+    CancelAll();
+}
+
+void TimerWheel::CancelAll()
+{
+    for (uint32 level = 0; level < TIMER_WHEEL_LEVELS; ++level)
+        for (uint32 index = 0; index < TIMER_WHEEL_SLOTS; ++index)
+            while (!_slots[level][index].IsEmpty())
+                Unlink(static_cast<TimerWheelEntry*>(_slots[level][index].Next));
+
+    if (_due)
+        while (!_due->IsEmpty())
+            Unlink(static_cast<TimerWheelEntry*>(_due->Next));
+
+    _occupied = 0;
+}
+
+void TimerWheel::GetEntries(std::vector<TimerWheelEntry*>& entries) const
+{
+    entries.reserve(entries.size() + _size);
+    for (uint32 level = 0; level < TIMER_WHEEL_LEVELS; ++level)
+        for (uint32 index = 0; index < TIMER_WHEEL_SLOTS; ++index)
+            for (TimerWheelLink const* link = _slots[level][index].Next; link != &_slots[level][index]; link = link->Next)
+                entries.push_back(static_cast<TimerWheelEntry*>(const_cast<TimerWheelLink*>(link)));
+
+    if (_due)
+        for (TimerWheelLink const* link = _due->Next; link != _due; link = link->Next)
+            entries.push_back(static_cast<TimerWheelEntry*>(const_cast<TimerWheelLink*>(link)));
+}
+
+void TimerWheel::ScheduleAt(TimerWheelEntry* entry, uint64 expiry)
+{
+    entry->Cancel();
+
+    entry->_wheel = this;
+    entry->_expiry = expiry;
+    ++_size;
+
+    Place(entry);
+}
+
+void TimerWheel::Place(TimerWheelEntry* entry)
+{
+    // rounded up, entries never expire early
+    uint64 tick = (entry->_expiry + _resolution - 1) / _resolution;
+    if (tick < _tick)
+        tick = _tick;
+
+    uint64 delta = tick - _tick;
+    uint32 level = 0;
+    while (level < TIMER_WHEEL_LEVELS - 1 && delta >= (uint64(1) << ((level + 1) * TIMER_WHEEL_SLOT_BITS)))
+        ++level;
+
+    // further than the wheel reaches: parked in the last slot, the cascade places it again
+    uint64 const range = uint64(1) << (TIMER_WHEEL_LEVELS * TIMER_WHEEL_SLOT_BITS);
+    if (delta >= range)
+        tick = _tick + range - 1;
+
+    uint32 index = uint32(tick >> (level * TIMER_WHEEL_SLOT_BITS)) & TIMER_WHEEL_SLOT_MASK;
+    TimerWheelLink& slot = _slots[level][index];
+    entry->Prev = slot.Prev;
+    entry->Next = &slot;
+    slot.Prev->Next = entry;
+    slot.Prev = entry;
+
+    if (!level)
+        _occupied |= uint64(1) << index;
+}
+
+void TimerWheel::Unlink(TimerWheelEntry* entry)
+{
+    entry->Prev->Next = entry->Next;
+    entry->Next->Prev = entry->Prev;
+    entry->Prev = entry;
+    entry->Next = entry;
+    entry->_wheel = NULL;
+    --_size;
+}
+
+void TimerWheel::Take(TimerWheelLink& from, TimerWheelLink& to)
+{
+    if (from.IsEmpty())
+        return;
+
+    to.Next = from.Next;
+    to.Prev = from.Prev;
+    to.Next->Prev = &to;
+    to.Prev->Next = &to;
+    from.Next = &from;
+    from.Prev = &from;
+}
+
+// moves the entries of the slot the wheel just reached one level down
+void TimerWheel::Cascade(uint32 level)
+{
+    uint32 index = uint32(_tick >> (level * TIMER_WHEEL_SLOT_BITS)) & TIMER_WHEEL_SLOT_MASK;
+
+    TimerWheelLink moving;
+    Take(_slots[level][index], moving);
+    while (!moving.IsEmpty())
+    {
+        TimerWheelEntry* entry = static_cast<TimerWheelEntry*>(moving.Next);
+        moving.Next = entry->Next;
+        entry->Next->Prev = &moving;
+        Place(entry);
+    }
+
+    if (!index && level + 1 < TIMER_WHEEL_LEVELS)
+        Cascade(level + 1);
+}
+
+// skips the empty level 0 slots, but never past the end of the current turn as the higher levels cascade there
+uint64 TimerWheel::NextTick(uint64 limit) const
+{
+    uint32 index = uint32(_tick) & TIMER_WHEEL_SLOT_MASK;
+    if (!index)
+        return _tick;
+
+    uint64 next = _tick + (TIMER_WHEEL_SLOTS - index);
+    uint64 pending = _occupied >> index;
+    if (pending)
+    {
+        uint32 skip = 0;
+        while (!(pending & 1))
+        {
+            pending >>= 1;
+            ++skip;
+        }
+        next = _tick + skip;
+    }
+
+    return next < limit ? next : limit;
+}
+
+uint32 TimerWheel::Update(uint32 diff)
+{
+    _time += diff;
+    uint64 target = _time / _resolution;
+    uint32 expired = 0;
+
+    while (_tick <= target)
+    {
+        if (!_size)
+        {
+            _tick = target + 1;
+            break;
+        }
+
+        uint32 index = uint32(_tick) & TIMER_WHEEL_SLOT_MASK;
+        if (!index)
+            Cascade(1);
+
+        TimerWheelLink due;
+        if (_occupied & (uint64(1) << index))
+        {
+            _occupied &= ~(uint64(1) << index);
+            Take(_slots[0][index], due);
+        }
+
+        // entries scheduled by OnExpire for the past go to the next tick
+        ++_tick;
+
+        // an expiring entry may cancel or list the others due with it
+        _due = &due;
+        while (!due.IsEmpty())
+        {
+            TimerWheelEntry* entry = static_cast<TimerWheelEntry*>(due.Next);
+            Unlink(entry);
+            ++expired;
+            entry->OnExpire();
+        }
+        _due = NULL;
+
+        _tick = NextTick(target + 1);
+    }
+
+    _expiredCount += expired;
+    return expired;
+}
+
+bool DeadlineTimer::IsPending(TimerWheel& wheel, time_t deadline)
+{
+    if (deadline == _deadline)
+    {
+        if (GetWheel() == &wheel)
+            return true;
+
+        if (_expired)
+            return false;
+    }
+
+    _deadline = deadline;
+
+    time_t now = time(NULL);
+    if (deadline <= now)
+    {
+        Cancel();
+        _expired = true;
+        return false;
+    }
+
+    _expired = false;
+    wheel.Schedule(this, uint64(deadline - now) * IN_MILLISECONDS);
+    return true;
+}
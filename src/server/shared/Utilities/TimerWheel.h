@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) 2008-2013 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_TIMERWHEEL_H
+#define TRINITY_TIMERWHEEL_H
+
+#include "Define.h"
+#include <ctime>
+#include <vector>
+
+// Note. All times are in milliseconds here, except for the time_t deadlines of DeadlineTimer.
+
+#define TIMER_WHEEL_SLOT_BITS   6
+#define TIMER_WHEEL_SLOTS       (1 << TIMER_WHEEL_SLOT_BITS)
+#define TIMER_WHEEL_SLOT_MASK   (TIMER_WHEEL_SLOTS - 1)
+#define TIMER_WHEEL_LEVELS      5                           // 2^30 ticks, ~12 days with 1 ms ticks
+
+class TimerWheel;
+
+struct TimerWheelLink
+{
+    TimerWheelLink() : Prev(this), Next(this) { }
+
+    bool IsEmpty() const { return Next == this; }
+
+    TimerWheelLink* Prev;
+    TimerWheelLink* Next;
+};
+
+// Something to do at a given time, linked into the slot of a TimerWheel.
+// Entries unlink themselves when destroyed, owners simply keep them as members.
+class TimerWheelEntry : private TimerWheelLink
+{
+    friend class TimerWheel;
+
+    public:
+        TimerWheelEntry() : _wheel(NULL), _expiry(0) { }
+        virtual ~TimerWheelEntry() { Cancel(); }
+
+        // executes when the timer expires, the entry is already unlinked and may be scheduled again or deleted
+        virtual void OnExpire() = 0;
+
+        void Cancel();
+
+        bool IsScheduled() const { return _wheel != NULL; }
+        TimerWheel* GetWheel() const { return _wheel; }
+        uint64 GetExpiry() const { return _expiry; }        // in the time of the wheel
+
+    private:
+        TimerWheelEntry(TimerWheelEntry const&);
+        TimerWheelEntry& operator=(TimerWheelEntry const&);
+
+        TimerWheel* _wheel;
+        uint64 _expiry;
+};
+
+/**
+ * Hierarchical timing wheel (Varghese & Lauck).
+ *
+ * Level 0 has one slot per tick for the next TIMER_WHEEL_SLOTS ticks, every further level
+ * covers TIMER_WHEEL_SLOTS times the range of the previous one. Scheduling and cancelling are
+ * O(1), entries of the higher levels are moved down when the wheel reaches their slot and
+ * Update only visits the level 0 slots that hold entries, so a wheel only costs anything for
+ * the timers that actually expire.
+ */
+class TimerWheel
+{
+    friend class TimerWheelEntry;
+
+    public:
+        explicit TimerWheel(uint32 resolution = 1, uint64 time = 0);
+        ~TimerWheel();
+
+        // (re)schedules the entry to expire after delay ms
+        void Schedule(TimerWheelEntry* entry, uint64 delay) { ScheduleAt(entry, _time + delay); }
+        void ScheduleAt(TimerWheelEntry* entry, uint64 expiry);
+        void CancelAll();
+        // all scheduled entries, including the ones due in the tick being expired
+        void GetEntries(std::vector<TimerWheelEntry*>& entries) const;
+
+        // advances the time and expires the due entries, returns how many expired
+        uint32 Update(uint32 diff);
+
+        uint64 GetTime() const { return _time; }
+        uint32 GetResolution() const { return _resolution; }
+        uint32 GetSize() const { return _size; }
+        uint64 GetExpiredCount() const { return _expiredCount; }
+
+    private:
+        void Place(TimerWheelEntry* entry);
+        void Unlink(TimerWheelEntry* entry);
+        void Cascade(uint32 level);
+        uint64 NextTick(uint64 limit) const;
+
+        static void Take(TimerWheelLink& from, TimerWheelLink& to);
+
+        uint32 _resolution;                                 // ms per tick
+        uint64 _time;
+        uint64 _tick;                                       // next tick to expire
+        uint32 _size;
+        uint64 _expiredCount;
+
+        TimerWheelLink _slots[TIMER_WHEEL_LEVELS][TIMER_WHEEL_SLOTS];
+        uint64 _occupied;                                   // level 0 slots holding entries
+        TimerWheelLink* _due;                               // entries of the tick being expired, they are still scheduled
+};
+
+// Wheel entry standing for a time_t deadline kept by its owner (respawn times, corpse removal).
+// Owners keep setting their deadline as usual and ask IsPending before comparing it with the clock,
+// the timer is moved on the wheel whenever the deadline changed.
+class DeadlineTimer : public TimerWheelEntry
+{
+    public:
+        DeadlineTimer() : _deadline(0), _expired(false) { }
+
+        // false once the deadline may have been reached
+        bool IsPending(TimerWheel& wheel, time_t deadline);
+
+        void OnExpire() { _expired = true; }
+
+    private:
+        time_t _deadline;
+        bool _expired;
+};
+
+#endif
@@ -376,6 +376,7 @@ bool Master::_StartDB()
 
     std::string dbstring;
     uint8 async_threads, synch_threads;
+    uint32 queue_limit;
 
     dbstring = ConfigMgr::GetStringDefault("WorldDatabaseInfo", "");
     if (dbstring.empty())
@@ -393,8 +394,9 @@ bool Master::_StartDB()
     }
 
     synch_threads = uint8(ConfigMgr::GetIntDefault("WorldDatabase.SynchThreads", 1));
+    queue_limit = uint32(ConfigMgr::GetIntDefault("WorldDatabase.QueueLimit", 0));
     ///- Initialise the world database
-    if (!WorldDatabase.Open(dbstring, async_threads, synch_threads))
+    if (!WorldDatabase.Open(dbstring, async_threads, synch_threads, queue_limit))
     {
         sLog->outError(LOG_FILTER_WORLDSERVER, "Cannot connect to world database %s", dbstring.c_str());
         return false;
@@ -417,9 +419,10 @@ bool Master::_StartDB()
     }
 
     synch_threads = uint8(ConfigMgr::GetIntDefault("CharacterDatabase.SynchThreads", 2));
+    queue_limit = uint32(ConfigMgr::GetIntDefault("CharacterDatabase.QueueLimit", 0));
 
     ///- Initialise the Character database
-    if (!CharacterDatabase.Open(dbstring, async_threads, synch_threads))
+    if (!CharacterDatabase.Open(dbstring, async_threads, synch_threads, queue_limit))
     {
         sLog->outError(LOG_FILTER_WORLDSERVER, "Cannot connect to Character database %s", dbstring.c_str());
         return false;
@@ -442,8 +445,9 @@ bool Master::_StartDB()
     }
 
     synch_threads = uint8(ConfigMgr::GetIntDefault("LoginDatabase.SynchThreads", 1));
+    queue_limit = uint32(ConfigMgr::GetIntDefault("LoginDatabase.QueueLimit", 0));
     ///- Initialise the login database
-    if (!LoginDatabase.Open(dbstring, async_threads, synch_threads))
+    if (!LoginDatabase.Open(dbstring, async_threads, synch_threads, queue_limit))
     {
         sLog->outError(LOG_FILTER_WORLDSERVER, "Cannot connect to login database %s", dbstring.c_str());
         return false;
@@ -31,6 +31,7 @@
 #include "Timer.h"
 #include "WorldRunnable.h"
 #include "OutdoorPvPMgr.h"
+#include "GuildMgr.h"
 
 #define WORLD_SLEEP_CONST 50
 
@@ -75,6 +76,8 @@ void WorldRunnable::run()
     sWorld->KickAll();                                       // save and kick all players
     sWorld->UpdateSessions( 1 );                             // real players unload required UpdateSessions call
 
+    sGuildMgr->SaveGuilds();                                 // changes not written since the last guild save
+
     // unload battleground templates before different singletons destroyed
     sBattlegroundMgr->DeleteAllBattlegrounds();
 